@@ -0,0 +1,215 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AnimationSystem/AnimationSystem.hpp"
+#include "Components/NetworkComponents.hpp"
+#include "Components/serialize/StandardComponents_serialize.hpp"
+
+namespace {
+
+const char* const CLIP_NAMES[] = {"idle", "move", "hit", "die"};
+
+AnimationClip makeClip(handle_t<TextureAsset> handle, int row) {
+    AnimationClip clip;
+
+    clip.handle = handle;
+    clip.frameDuration = 0.05f + 0.01f * static_cast<float>(row);
+    for (int i = 0; i < 8; i++)
+        clip.frames.push_back({i * 32, row * 32, 32, 32});
+    return clip;
+}
+
+// How a sprite held its clips before: its own map, looked up by name every tick
+struct NamedSprite {
+    RenderLayer layer = RenderLayer::Midground;
+    std::unordered_map<std::string, AnimationClip> animations;
+    std::string currentAnimation;
+    std::string previousAnimation;
+    std::size_t currentFrameIndex = 0;
+    int loopDirection = 1;
+    float timer = 0.0f;
+    bool playing = true;
+    bool flipX = false;
+    bool flipY = false;
+};
+
+// Sprites spread over the clips and out of phase, as a wave of bullets and mobs would be
+std::vector<AnimatedSprite2D> makeSprites(int64_t count, ResourceManager<TextureAsset>& textures) {
+    handle_t<TextureAsset> handle = textures.load("bench_sheet.png", TextureAsset("bench_sheet.png"));
+    AnimatedSprite2D prefab;
+    std::vector<AnimatedSprite2D> sprites(static_cast<std::size_t>(count));
+
+    for (int row = 0; row < 4; row++)
+        prefab.addClip(CLIP_NAMES[row], makeClip(handle, row));
+    for (std::size_t idx = 0; idx < sprites.size(); ++idx) {
+        sprites[idx] = prefab;
+        sprites[idx].play(CLIP_NAMES[idx % 4]);
+        sprites[idx].timer = 0.001f * static_cast<float>(idx % 50);
+    }
+    return sprites;
+}
+
+std::vector<NamedSprite> makeNamedSprites(const std::vector<AnimatedSprite2D>& sprites) {
+    std::vector<NamedSprite> named(sprites.size());
+
+    for (std::size_t idx = 0; idx < sprites.size(); ++idx) {
+        for (std::size_t clip = 0; clip < sprites[idx].animations->clips.size(); ++clip)
+            named[idx].animations.emplace(sprites[idx].animations->names[clip], sprites[idx].animations->clips[clip]);
+        named[idx].currentAnimation = std::string(sprites[idx].currentName());
+        named[idx].timer = sprites[idx].timer;
+    }
+    return named;
+}
+
+void stepNamed(NamedSprite& anim, float dt) {
+    auto it = anim.animations.find(anim.currentAnimation);
+    if (!anim.playing || it == anim.animations.end())
+        return;
+
+    const AnimationClip& clip = it->second;
+    anim.timer += dt;
+    while (anim.timer >= clip.frameDuration) {
+        anim.timer -= clip.frameDuration;
+        anim.currentFrameIndex = anim.currentFrameIndex + 1 >= clip.frames.size() ? 0 : anim.currentFrameIndex + 1;
+    }
+}
+
+void serializeNamed(std::vector<uint8_t>& buffer, const NamedSprite& sprite,
+                    ResourceManager<TextureAsset>& textures) {
+    serialize::serialize(buffer, static_cast<int>(sprite.layer));
+    serialize::serialize(buffer, static_cast<uint32_t>(sprite.animations.size()));
+    for (const auto& [name, clip] : sprite.animations) {
+        serialize::serialize(buffer, name);
+        serialize::serialize(buffer, clip, textures);
+    }
+    serialize::serialize(buffer, sprite.currentAnimation);
+    serialize::serialize(buffer, sprite.previousAnimation);
+    serialize::serialize(buffer, static_cast<uint32_t>(sprite.currentFrameIndex));
+    serialize::serialize(buffer, sprite.loopDirection);
+    serialize::serialize(buffer, sprite.timer);
+    serialize::serialize(buffer, sprite.playing);
+    serialize::serialize(buffer, sprite.flipX);
+    serialize::serialize(buffer, sprite.flipY);
+}
+
+// A tick of the animation system followed by the collision systems reading every hitbox
+void BM_AnimateNamedClips(benchmark::State& state) {
+    ResourceManager<TextureAsset> textures;
+    auto sprites = makeNamedSprites(makeSprites(state.range(0), textures));
+    int64_t area = 0;
+
+    for (auto _ : state) {
+        for (auto& sprite : sprites) {
+            stepNamed(sprite, 1.0f / 60.0f);
+            const Rect2D& frame = sprite.animations.at(sprite.currentAnimation).frames.at(sprite.currentFrameIndex);
+            area += frame.width * frame.height;
+        }
+        benchmark::DoNotOptimize(area);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_AnimateClipIds(benchmark::State& state) {
+    ResourceManager<TextureAsset> textures;
+    auto sprites = makeSprites(state.range(0), textures);
+    int64_t area = 0;
+
+    for (auto _ : state) {
+        for (auto& sprite : sprites) {
+            AnimationSystem::step(sprite, 1.0f / 60.0f);
+            area += sprite.hitboxWidth * sprite.hitboxHeight;
+        }
+        benchmark::DoNotOptimize(area);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+    Bytes a tick of animation puts on the wire once every baseline is acknowledged:
+    unchanged sprites are skipped, the others go as a diff against the last copy
+*/
+template <typename Sprite, typename Step, typename Write>
+void replicate(benchmark::State& state, std::vector<Sprite>& sprites, Step step, Write write) {
+    std::vector<std::vector<uint8_t>> baselines(sprites.size());
+    std::vector<uint8_t> current;
+    std::vector<uint8_t> delta;
+    int64_t bytes = 0;
+    int64_t records = 0;
+
+    for (std::size_t idx = 0; idx < sprites.size(); ++idx)
+        write(baselines[idx], sprites[idx]);
+    for (auto _ : state) {
+        for (std::size_t idx = 0; idx < sprites.size(); ++idx) {
+            step(sprites[idx]);
+            current.clear();
+            write(current, sprites[idx]);
+            if (current == baselines[idx])
+                continue;
+            bool encoded = network::encodeSnapshotDelta(baselines[idx], current, delta);
+            bytes += static_cast<int64_t>(encoded ? delta.size() : current.size());
+            records++;
+            baselines[idx].swap(current);
+        }
+    }
+    state.counters["bytes_per_tick"] = benchmark::Counter(static_cast<double>(bytes) / state.iterations());
+    state.counters["records_per_tick"] = benchmark::Counter(static_cast<double>(records) / state.iterations());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ReplicateNamedClips(benchmark::State& state) {
+    ResourceManager<TextureAsset> textures;
+    auto sprites = makeNamedSprites(makeSprites(state.range(0), textures));
+
+    replicate(
+        state, sprites, [](NamedSprite& sprite) { stepNamed(sprite, 1.0f / 60.0f); },
+        [&](std::vector<uint8_t>& buffer, const NamedSprite& sprite) { serializeNamed(buffer, sprite, textures); });
+}
+
+void BM_ReplicateClipIds(benchmark::State& state) {
+    ResourceManager<TextureAsset> textures;
+    auto sprites = makeSprites(state.range(0), textures);
+
+    replicate(
+        state, sprites, [](AnimatedSprite2D& sprite) { AnimationSystem::step(sprite, 1.0f / 60.0f); },
+        [&](std::vector<uint8_t>& buffer, const AnimatedSprite2D& sprite) {
+            serialize::serialize(buffer, sprite, textures);
+        });
+}
+
+// What a client does with each sprite it receives once it has the definition of their set
+void BM_ReceiveClipIds(benchmark::State& state) {
+    ResourceManager<TextureAsset> server;
+    ResourceManager<TextureAsset> client;
+    auto sprites = makeSprites(state.range(0), server);
+    std::vector<std::vector<uint8_t>> packets(sprites.size());
+    std::vector<uint8_t> definition;
+    std::size_t read = 0;
+
+    for (std::size_t idx = 0; idx < sprites.size(); ++idx)
+        serialize::serialize(packets[idx], sprites[idx], server);
+    // The sprites share one set, sent once
+    serialize::AnimationSetWire::definition(serialize::AnimationSetWire::key(*sprites[0].animations, server),
+                                            definition);
+    serialize::AnimationSetWire::define(definition, read, client);
+    for (auto _ : state) {
+        for (const auto& packet : packets) {
+            std::size_t offset = 0;
+            AnimatedSprite2D sprite = serialize::deserialize_animated_sprite_2d(packet, offset, client);
+            benchmark::DoNotOptimize(sprite);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+// Argument: animated sprites
+BENCHMARK(BM_AnimateNamedClips)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AnimateClipIds)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ReplicateNamedClips)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ReplicateClipIds)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ReceiveClipIds)->Arg(5000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_context.hpp"
+#include "CollisionSystem.hpp"
+#include "Components/LobbyIdComponent.hpp"
+#include "Components/StandardComponents.hpp"
+#include "Components/Sprite/Sprite2D.hpp"
+#include "registry.hpp"
+
+namespace {
+
+constexpr uint32_t LOBBY_COUNT = 4;
+constexpr float FIELD_WIDTH = 1920.0f;
+constexpr float FIELD_HEIGHT = 1080.0f;
+
+// Mimics a busy wave: players and enemies spread over a few lobbies, all
+// colliding against each other's tags.
+void populate(Registry& registry, int64_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos_x(0.0f, FIELD_WIDTH);
+    std::uniform_real_distribution<float> pos_y(0.0f, FIELD_HEIGHT);
+    std::uniform_real_distribution<float> speed(-300.0f, 300.0f);
+
+    for (int64_t i = 0; i < count; ++i) {
+        Entity entity = registry.createEntity();
+        bool is_enemy = (i % 4) != 0;
+        Sprite2D sprite;
+
+        sprite.rect = {0, 0, 32, 32};
+        registry.addComponent<transform_component_s>(entity, {pos_x(rng), pos_y(rng)});
+        registry.addComponent<Velocity2D>(entity, {speed(rng), speed(rng)});
+        registry.addComponent<Sprite2D>(entity, sprite);
+        registry.addComponent<LobbyIdComponent>(entity, {static_cast<uint32_t>(i % LOBBY_COUNT) + 1});
+        registry.addComponent<TagComponent>(entity, {{is_enemy ? "ENEMY" : "PLAYER"}});
+        registry.addComponent<BoxCollisionComponent>(entity, {{}, {is_enemy ? "PLAYER" : "ENEMY"}, nullptr});
+    }
+}
+
+void BM_BoxCollisionTick(benchmark::State& state) {
+    BenchEnvironment env;
+    Registry registry;
+    BoxCollision system;
+
+    populate(registry, state.range(0));
+    for (auto _ : state) {
+        system.update(registry, env.context(1.0f / 60.0f));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+constexpr int64_t CANDIDATES_PER_COLLIDER = 64;
+
+const std::vector<std::vector<std::string>> ENTITY_TAGS = {
+    {"AI"}, {"AI", "BOSS"}, {"ENEMY_PROJECTILE"}, {"FRIENDLY_PROJECTILE"}, {"PLAYER"}, {"OBSTACLE", "WALL"},
+};
+const std::vector<std::vector<std::string>> COLLISION_TAGS = {
+    {"FRIENDLY_PROJECTILE", "ENEMY_PROJECTILE", "PLAYER"}, {"ENEMY_PROJECTILE", "AI", "OBSTACLE"}, {"AI"},
+    {"PLAYER"},
+};
+
+// Tag tests of a crowded tick: each collider against the candidates its grid cells hold
+template <typename Tags, typename Match>
+void runTagMatch(benchmark::State& state, Match match) {
+    std::mt19937 rng(42);
+    std::vector<Tags> entity_tags;
+    std::vector<Tags> collision_tags;
+
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        entity_tags.emplace_back(ENTITY_TAGS[rng() % ENTITY_TAGS.size()]);
+        collision_tags.emplace_back(COLLISION_TAGS[rng() % COLLISION_TAGS.size()]);
+    }
+    for (auto _ : state) {
+        int64_t hits = 0;
+        for (std::size_t a = 0; a < collision_tags.size(); ++a) {
+            std::size_t b = a;
+            for (int64_t candidate = 0; candidate < CANDIDATES_PER_COLLIDER; ++candidate) {
+                b = b + 1 == entity_tags.size() ? 0 : b + 1;
+                hits += match(collision_tags[a], entity_tags[b]);
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * CANDIDATES_PER_COLLIDER);
+}
+
+// How tags were matched before TagSet
+void BM_TagMatchStrings(benchmark::State& state) {
+    runTagMatch<std::vector<std::string>>(
+        state, [](const std::vector<std::string>& to_collide, const std::vector<std::string>& tags) {
+            for (const auto& tag_to_collide : to_collide) {
+                for (const auto& tag : tags) {
+                    if (tag_to_collide == tag)
+                        return true;
+                }
+            }
+            return false;
+        });
+}
+
+void BM_TagMatchSet(benchmark::State& state) {
+    runTagMatch<TagSet>(state, [](const TagSet& to_collide, const TagSet& tags) { return to_collide.intersects(tags); });
+}
+
+}  // namespace
+
+BENCHMARK(BM_TagMatchStrings)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TagMatchSet)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BoxCollisionTick)->RangeMultiplier(2)->Range(125, 1000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Context.hpp"
+#include "InputConfig.hpp"
+#include "ResourceConfig.hpp"
+
+#if defined(SERVER_BUILD)
+#include "NetworkEngine/NetworkEngine.hpp"
+#endif
+
+/**
+ * @brief Owns everything a system_context references so systems can be
+ * benchmarked without a running game engine.
+ */
+struct BenchEnvironment {
+    ResourceManager<TextureAsset> textures;
+    ResourceManager<SoundAsset> sounds;
+    ResourceManager<MusicAsset> musics;
+    InputManager input;
+#if defined(SERVER_BUILD)
+    engine::core::NetworkEngine network{engine::core::NetworkEngine::NetworkRole::CLIENT};
+
+    system_context context(float dt, uint32_t tick = 0) {
+        return system_context{dt, tick, textures, sounds, musics, input, network, {}, nullptr};
+    }
+#else
+    sf::RenderWindow window;
+
+    system_context context(float dt, uint32_t tick = 0) {
+        return system_context{dt, tick, textures, sounds, musics, window, input, 0, nullptr};
+    }
+#endif
+};
@@ -0,0 +1,199 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Credentials.hpp"
+#include "Database.hpp"
+
+namespace {
+
+constexpr int USER_COUNT = 10000;
+
+std::filesystem::path databasePath(const char* name) {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "rtype_bench" / name;
+
+    std::filesystem::create_directories(directory);
+    return directory / "rtype.db";
+}
+
+void removeDatabase(const std::filesystem::path& path) {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::filesystem::remove(path.string() + suffix);
+    }
+}
+
+std::string username(int idx) {
+    return "player" + std::to_string(idx);
+}
+
+// How the queries ran before: prepared and finalized each time, rollback journal, one commit per write
+class DirectDatabase {
+   public:
+    explicit DirectDatabase(const std::string& filename) {
+        sqlite3_open(filename.c_str(), &_db);
+        sqlite3_exec(_db,
+                     "CREATE TABLE IF NOT EXISTS Users (ID INTEGER PRIMARY KEY AUTOINCREMENT,"
+                     "Username TEXT UNIQUE NOT NULL, Password TEXT NOT NULL, Token TEXT);"
+                     "CREATE TABLE IF NOT EXISTS Scores (UserID INTEGER PRIMARY KEY, Score INTEGER NOT NULL);",
+                     nullptr, nullptr, nullptr);
+    }
+    ~DirectDatabase() { sqlite3_close(_db); }
+
+    int login(const std::string& name, const std::string& password) {
+        sqlite3_stmt* stmt;
+        int userID = -1;
+
+        sqlite3_prepare_v2(_db, "SELECT ID FROM Users WHERE Username = ? AND Password = ?;", -1, &stmt, nullptr);
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 2, password.c_str(), -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            userID = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+        return userID;
+    }
+
+    bool name(int userID) {
+        sqlite3_stmt* stmt;
+
+        sqlite3_prepare_v2(_db, "SELECT USERNAME FROM Users WHERE ID = ?;", -1, &stmt, nullptr);
+        sqlite3_bind_int(stmt, 1, userID);
+        bool found = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_finalize(stmt);
+        return found;
+    }
+
+    void score(int userID, int score) {
+        sqlite3_stmt* stmt;
+
+        sqlite3_prepare_v2(_db,
+                           "INSERT INTO Scores (UserID, Score) VALUES (?, ?) "
+                           "ON CONFLICT(UserID) DO UPDATE SET Score = MAX(Score, excluded.Score);",
+                           -1, &stmt, nullptr);
+        sqlite3_bind_int(stmt, 1, userID);
+        sqlite3_bind_int(stmt, 2, score);
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+    }
+
+    void fill() {
+        sqlite3_exec(_db, "BEGIN;", nullptr, nullptr, nullptr);
+        for (int idx = 0; idx < USER_COUNT; ++idx) {
+            std::string sql = "INSERT INTO Users (Username, Password, Token) VALUES ('" + username(idx) +
+                              "', 'pw', 'TOKEN" + std::to_string(idx) + "');";
+            sqlite3_exec(_db, sql.c_str(), nullptr, nullptr, nullptr);
+        }
+        sqlite3_exec(_db, "COMMIT;", nullptr, nullptr, nullptr);
+    }
+
+   private:
+    sqlite3* _db = nullptr;
+};
+
+void BM_LoginsDirect(benchmark::State& state) {
+    auto path = databasePath("direct");
+    removeDatabase(path);
+    DirectDatabase database(path.string());
+    database.fill();
+
+    for (auto _ : state) {
+        int found = 0;
+        for (int idx = 0; idx < USER_COUNT; ++idx) {
+            int userID = database.login(username(idx), "pw");
+            found += userID != -1 && database.name(userID);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * USER_COUNT);
+    removeDatabase(path);
+}
+
+std::vector<std::future<std::pair<int, std::string>>> submitLogins(Database& database) {
+    std::vector<std::future<std::pair<int, std::string>>> results;
+
+    for (int idx = 0; idx < USER_COUNT; ++idx) {
+        results.push_back(database.Submit([name = username(idx)](Database& db) {
+            int userID = db.LoginUser(name, "pw");
+            return std::make_pair(userID, userID == -1 ? std::string() : db.GetNameById(userID));
+        }));
+    }
+    return results;
+}
+
+// Every login submitted at once, as a storm reaches the game thread, then all results awaited.
+// Hashes cost 1 iteration, this measures the queue and the statements, BM_HashPassword the hash
+void BM_LoginsWorker(benchmark::State& state) {
+    auto path = databasePath("worker");
+    removeDatabase(path);
+    DirectDatabase(path.string()).fill();
+    Database database(path.string(), 1);
+    std::vector<std::future<std::pair<int, std::string>>> results;
+
+    // The first login of each user replaces the password the fill stored in clear
+    for (auto& result : submitLogins(database)) {
+        result.get();
+    }
+    for (auto _ : state) {
+        results = submitLogins(database);
+        int found = 0;
+        for (auto& result : results) {
+            found += result.get().first != -1;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * USER_COUNT);
+    removeDatabase(path);
+}
+
+void BM_ScoresDirect(benchmark::State& state) {
+    auto path = databasePath("direct_scores");
+    removeDatabase(path);
+    DirectDatabase database(path.string());
+    database.fill();
+    int score = 0;
+
+    for (auto _ : state) {
+        for (int64_t idx = 0; idx < state.range(0); ++idx) {
+            database.score(static_cast<int>(idx) + 1, ++score);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    removeDatabase(path);
+}
+
+void BM_ScoresBatched(benchmark::State& state) {
+    auto path = databasePath("batched_scores");
+    removeDatabase(path);
+    DirectDatabase(path.string()).fill();
+    Database database(path.string());
+    int score = 0;
+
+    for (auto _ : state) {
+        for (int64_t idx = 0; idx < state.range(0); ++idx) {
+            database.UpdateScore(static_cast<int>(idx) + 1, ++score);
+        }
+        // Queued after the scores, done once they are committed
+        database.Submit([](Database&) {}).get();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    removeDatabase(path);
+}
+
+void BM_HashPassword(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(credentials::HashPassword("correct horse battery staple"));
+    }
+}
+
+}  // namespace
+
+// Real time, the worker runs the queries on the database thread
+BENCHMARK(BM_LoginsDirect)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoginsWorker)->UseRealTime()->Unit(benchmark::kMillisecond);
+// Argument: scores written, 8 per lobby reaching its game over
+BENCHMARK(BM_ScoresDirect)->Arg(8)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScoresBatched)->Arg(8)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashPassword)->Unit(benchmark::kMillisecond);
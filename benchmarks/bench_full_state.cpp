@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Components/NetworkComponents.hpp"
+#include "NetworkEngine/FullState.hpp"
+
+namespace {
+
+// A mid-game world: every entity has a transform-like component (two floats moving, the rest
+// constant) and a sprite-like one naming a texture, the same across entities of a kind
+std::vector<ComponentPacket> makeWorld(int64_t entities) {
+    std::vector<ComponentPacket> world;
+
+    for (int64_t idx = 0; idx < entities; ++idx) {
+        ComponentPacket transform;
+        transform.entity_guid = static_cast<uint32_t>(idx + 1);
+        transform.component_type = 0x1234;
+        transform.data.resize(24, 0);
+        float x = static_cast<float>(idx * 37 % 1920);
+        float y = static_cast<float>(idx * 91 % 1080);
+        std::memcpy(transform.data.data(), &x, sizeof(x));
+        std::memcpy(transform.data.data() + sizeof(x), &y, sizeof(y));
+        world.push_back(transform);
+
+        ComponentPacket sprite;
+        sprite.entity_guid = transform.entity_guid;
+        sprite.component_type = 0x5678;
+        const char* texture = idx % 3 == 0 ? "assets/sprites/enemy_small.png" : "assets/sprites/bullet_blue.png";
+        sprite.data.assign(texture, texture + std::strlen(texture));
+        sprite.data.resize(48, 0);
+        world.push_back(sprite);
+    }
+    return world;
+}
+
+// How a join was sent before: the world as S_SNAPSHOT_BATCH datagrams
+void BM_JoinStateBatches(benchmark::State& state) {
+    auto world = makeWorld(state.range(0));
+    network::SnapshotBatchWriter writer;
+    std::size_t bytes = 0;
+
+    for (auto _ : state) {
+        writer.reset(1);
+        for (const auto& packet : world) {
+            writer.add(packet);
+        }
+        bytes = 0;
+        for (std::size_t idx = 0; idx < writer.size(); ++idx) {
+            bytes += sizeof(writer.at(idx).header) + writer.at(idx).body.size();
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.counters["messages"] = static_cast<double>(writer.size());
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+void BM_JoinStateCompressed(benchmark::State& state) {
+    auto world = makeWorld(state.range(0));
+    engine::core::FullStateWriter writer;
+    network::FullStateChunkPacket chunk;
+    std::size_t chunks = 0;
+
+    for (auto _ : state) {
+        writer.begin(1);
+        for (const auto& packet : world) {
+            writer.add(packet);
+        }
+        writer.finish();
+        chunks = 0;
+        while (!writer.done()) {
+            while (writer.nextChunk(chunk)) {
+                chunks++;
+            }
+            writer.acknowledge(chunk.offset + static_cast<uint32_t>(chunk.data.size()));
+        }
+        benchmark::DoNotOptimize(chunks);
+    }
+    state.counters["messages"] = static_cast<double>(chunks);
+    // Each chunk adds its message header and its four uint32 fields
+    std::size_t overhead = sizeof(network::message_header<network::GameEvents>) + 4 * sizeof(uint32_t);
+    state.counters["bytes"] = static_cast<double>(writer.compressedSize() + chunks * overhead);
+    state.counters["raw_bytes"] = static_cast<double>(writer.rawSize());
+}
+
+}  // namespace
+
+// Argument: networked entities in the lobby
+BENCHMARK(BM_JoinStateBatches)->Arg(500)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_JoinStateCompressed)->Arg(500)->Arg(5000)->Unit(benchmark::kMicrosecond);
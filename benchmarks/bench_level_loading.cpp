@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Core/Scene/LevelArchive.hpp"
+#include "Core/Scene/SceneLoader.hpp"
+#include "Core/Scene/SceneManager.hpp"
+
+namespace {
+
+// A long level: a wall, a turret and a spawn line every 100 pixels
+struct LevelFiles {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "rtype_bench_level_loading";
+    std::string scene = (dir / "level.scene").string();
+    std::string spawns = (dir / "level_spawns.cfg").string();
+    std::string archive = LevelArchive::compiledPath(scene);
+
+    explicit LevelFiles(int64_t count) {
+        std::filesystem::create_directories(dir);
+        std::ofstream level(scene, std::ios::trunc);
+        std::ofstream script(spawns, std::ios::trunc);
+        const char* formations[] = {"SINGLE", "LINE_HORIZONTAL", "V_FORMATION", "SNAKE"};
+
+        level << "[LEVEL]\nname=Bench\nbackground=bg.png\nspawn_script=" << spawns << "\n[WALL]\n";
+        for (int64_t i = 0; i < count; i++)
+            level << "wall=" << i * 100 << ",900,800,180,src/RType/Common/content/sprites/wall.gif,true\n";
+        level << "[TURRET]\n";
+        for (int64_t i = 0; i < count; i++)
+            level << "turret=" << i * 100 << ",850,2.5,AIM_PLAYER,src/RType/Common/content/sprites/r-typesheet13.gif\n";
+        for (int64_t i = 0; i < count; i++)
+            script << "spawn=" << i * 0.5 << ",SCOUT,1970," << (i * 37) % 900 << ",3,100," << formations[i % 4]
+                   << ",0,0\n";
+        level.close();
+        script.close();
+        LevelArchive::save(SceneLoader::loadFromText(scene), archive);
+    }
+
+    ~LevelFiles() {
+        std::filesystem::remove_all(dir);
+        std::filesystem::remove(archive);
+    }
+};
+
+// The scene manager logs every entity it creates, which would be most of what is measured
+struct QuietLog {
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    ~QuietLog() {
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+    }
+};
+
+// Load a level and place its entities, with prefabs that only read their position
+std::size_t loadLevel(const LevelConfig& config) {
+    QuietLog quiet;
+    Registry registry;
+    SceneManager scenes(registry);
+    std::size_t placed = 0;
+
+    for (const char* type : {"Wall", "Turret"}) {
+        scenes.registerPrefab(type, [&](Registry&, Entity, const std::unordered_map<std::string, std::any>& props) {
+            placed += std::any_cast<float>(props.at("x")) >= 0.f;
+        });
+    }
+    scenes.loadScene(config);
+    return placed;
+}
+
+void BM_LoadLevelText(benchmark::State& state) {
+    LevelFiles files(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(loadLevel(SceneLoader::loadFromText(files.scene)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The scene manager reads the records of the mapped archive, no LevelConfig is built in between
+void BM_LoadLevelArchive(benchmark::State& state) {
+    LevelFiles files(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(loadLevel(SceneLoader::loadFromFile(files.scene)));
+    state.counters["archive_bytes"] = static_cast<double>(std::filesystem::file_size(files.archive));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Spawn events only, what a lobby reads for its scripted spawner
+void BM_MapLevelSpawns(benchmark::State& state) {
+    LevelFiles files(state.range(0));
+
+    for (auto _ : state) {
+        LevelArchive archive(files.archive);
+        float last = 0.f;
+        for (const auto& spawn : archive.spawns())
+            last = spawn.trigger_time;
+        benchmark::DoNotOptimize(last);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+// Argument: walls, turrets and spawn lines each. Their entities have to fit in a registry of MAX_ENTITIES
+BENCHMARK(BM_LoadLevelText)->Arg(400)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadLevelArchive)->Arg(400)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapLevelSpawns)->Arg(1000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Components/NetworkComponents.hpp"
+#include "MessagePool.hpp"
+
+namespace {
+
+constexpr std::size_t SNAPSHOT_SIZE = 2048;
+
+ComponentPacket makeSnapshot() {
+    ComponentPacket packet{42, 0xC0FFEE, 7, {}};
+
+    packet.data.resize(SNAPSHOT_SIZE);
+    for (std::size_t i = 0; i < SNAPSHOT_SIZE; ++i) {
+        packet.data[i] = static_cast<uint8_t>(i * 31);
+    }
+    return packet;
+}
+
+// The way packets were written before the bulk operators: one push per byte, in a new message
+void encodePerByte(network::message<network::GameEvents>& msg, const ComponentPacket& packet) {
+    for (const auto& byte : packet.data) {
+        msg << byte;
+    }
+    msg << static_cast<uint32_t>(packet.data.size()) << packet.owner_id << packet.component_type
+        << packet.entity_guid;
+}
+
+// And read: copy the message, then one pop per byte
+void decodePerByte(const network::message<network::GameEvents>& msg, ComponentPacket& packet) {
+    auto copy = msg;
+    uint32_t size = 0;
+
+    copy >> packet.entity_guid >> packet.component_type >> packet.owner_id >> size;
+    packet.data.resize(size);
+    for (uint32_t idx = 0; idx < size; ++idx) {
+        copy >> packet.data[size - 1 - idx];
+    }
+}
+
+void BM_EncodeSnapshotPerByte(benchmark::State& state) {
+    ComponentPacket packet = makeSnapshot();
+
+    for (auto _ : state) {
+        network::message<network::GameEvents> msg;
+        encodePerByte(msg, packet);
+        benchmark::DoNotOptimize(msg.body.data());
+    }
+    state.SetBytesProcessed(state.iterations() * SNAPSHOT_SIZE);
+}
+
+void BM_EncodeSnapshotPooled(benchmark::State& state) {
+    network::MessagePool<network::GameEvents> pool;
+    ComponentPacket packet = makeSnapshot();
+
+    for (auto _ : state) {
+        auto msg = pool.acquire();
+        msg << packet;
+        benchmark::DoNotOptimize(msg.body.data());
+        pool.release(std::move(msg));
+    }
+    state.SetBytesProcessed(state.iterations() * SNAPSHOT_SIZE);
+}
+
+void BM_DecodeSnapshotPerByte(benchmark::State& state) {
+    network::message<network::GameEvents> msg;
+    ComponentPacket packet;
+
+    msg << makeSnapshot();
+    for (auto _ : state) {
+        decodePerByte(msg, packet);
+        benchmark::DoNotOptimize(packet.data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * SNAPSHOT_SIZE);
+}
+
+void BM_DecodeSnapshotReader(benchmark::State& state) {
+    network::message<network::GameEvents> msg;
+    ComponentPacket packet;
+
+    msg << makeSnapshot();
+    for (auto _ : state) {
+        network::MessageReader<network::GameEvents> reader(msg);
+        reader >> packet;
+        benchmark::DoNotOptimize(packet.data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * SNAPSHOT_SIZE);
+}
+
+}  // namespace
+
+BENCHMARK(BM_EncodeSnapshotPerByte);
+BENCHMARK(BM_EncodeSnapshotPooled);
+BENCHMARK(BM_DecodeSnapshotPerByte);
+BENCHMARK(BM_DecodeSnapshotReader);
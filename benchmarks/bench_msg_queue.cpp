@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "MsgQueue.hpp"
+#include "RingQueue.hpp"
+#include "message.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class BenchEvents : uint32_t { C_INPUT };
+using Message = network::owned_message<BenchEvents>;
+
+constexpr std::size_t BODY_SIZE = 64;
+// The game thread drains the queue this often while the asio thread keeps pushing
+constexpr auto DRAIN_PERIOD = std::chrono::milliseconds(1);
+
+Message makeMessage(uint32_t sequence) {
+    Message message;
+    message.msg.header.id = BenchEvents::C_INPUT;
+    message.msg.header.tick = sequence;
+    message.msg.header.size = BODY_SIZE;
+    message.msg.body.assign(BODY_SIZE, static_cast<uint8_t>(sequence));
+    return message;
+}
+
+// The old queue is drained the way ServerInterface::Update used to do it
+void push(network::MsgQueue<Message>& queue, Message&& message) { queue.push_back(message); }
+void push(network::RingQueue<Message>& queue, Message&& message) { queue.push_back(std::move(message)); }
+
+std::size_t drain(network::MsgQueue<Message>& queue, std::vector<Message>& out) {
+    std::size_t count = 0;
+    while (!queue.empty()) {
+        out.push_back(queue.pop_front());
+        count++;
+    }
+    return count;
+}
+
+std::size_t drain(network::RingQueue<Message>& queue, std::vector<Message>& out) { return queue.pop_all(out); }
+
+// Stands for the asio thread: pushes at a fixed rate, or as fast as it can with a rate of 0
+template <typename Queue>
+class Producer {
+   public:
+    Producer(Queue& queue, int64_t rate) : _queue(queue) {
+        _thread = std::thread([this, &queue, rate]() {
+            auto period = rate > 0 ? std::chrono::nanoseconds(1'000'000'000 / rate) : std::chrono::nanoseconds(0);
+            auto next = Clock::now();
+            uint32_t sequence = 0;
+
+            while (!_stop.load(std::memory_order_relaxed)) {
+                Message message = makeMessage(sequence++);
+                auto start = Clock::now();
+                push(queue, std::move(message));
+                _pushNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                _pushes++;
+                if (rate > 0) {
+                    next += period;
+                    std::this_thread::sleep_until(next);
+                }
+            }
+            _done.store(true);
+        });
+    }
+
+    ~Producer() { stop(); }
+
+    void stop() {
+        std::vector<Message> rest;
+
+        _stop.store(true);
+        // The producer may be waiting for room in a full queue
+        while (!_done.load()) {
+            drain(_queue, rest);
+            rest.clear();
+            std::this_thread::yield();
+        }
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    double averagePushNs() const { return _pushes ? static_cast<double>(_pushNs) / _pushes : 0.0; }
+
+   private:
+    Queue& _queue;
+    std::atomic<bool> _stop{false};
+    std::atomic<bool> _done{false};
+    int64_t _pushNs = 0;
+    int64_t _pushes = 0;
+    std::thread _thread;
+};
+
+// Times only the drain of the game thread, the producer rate is the first argument
+template <typename Queue>
+void drainUnderContention(benchmark::State& state, Queue& queue) {
+    std::vector<Message> batch;
+    uint64_t drained = 0;
+    uint64_t checksum = 0;
+    Producer<Queue> producer(queue, state.range(0));
+
+    for (auto _ : state) {
+        if (state.range(0) > 0)
+            std::this_thread::sleep_for(DRAIN_PERIOD);
+
+        auto start = Clock::now();
+        batch.clear();
+        drained += drain(queue, batch);
+        for (const auto& message : batch) {
+            checksum += message.msg.body[0];
+        }
+        state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    producer.stop();
+    benchmark::DoNotOptimize(checksum);
+    state.SetItemsProcessed(static_cast<int64_t>(drained));
+    state.counters["push_ns"] = producer.averagePushNs();
+}
+
+void BM_DrainMutexQueue(benchmark::State& state) {
+    network::MsgQueue<Message> queue;
+    drainUnderContention(state, queue);
+}
+
+void BM_DrainRingQueue(benchmark::State& state) {
+    network::RingQueue<Message> queue(network::INBOUND_QUEUE_CAPACITY);
+    drainUnderContention(state, queue);
+}
+
+}  // namespace
+
+// 10k msgs/s is a full lobby sending inputs, each paced iteration sleeps a whole drain period so their count is fixed
+BENCHMARK(BM_DrainMutexQueue)->Arg(10000)->Iterations(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DrainRingQueue)->Arg(10000)->Iterations(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+// A rate of 0 keeps the producer pushing without pause
+BENCHMARK(BM_DrainMutexQueue)->Arg(0)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DrainRingQueue)->Arg(0)->UseManualTime()->Unit(benchmark::kMicrosecond);
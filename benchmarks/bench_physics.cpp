@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench_context.hpp"
+#include "Components/GravityComponent.hpp"
+#include "Components/StandardComponents.hpp"
+#include "PhysicsSystem.hpp"
+#include "registry.hpp"
+
+namespace {
+
+struct Body {
+    transform_component_s transform;
+    Velocity2D velocity;
+};
+
+std::vector<Body> makeBodies(int64_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> speed(-300.0f, 300.0f);
+    std::vector<Body> bodies(static_cast<std::size_t>(count));
+
+    for (auto& body : bodies) {
+        body.transform.x = position(rng);
+        body.transform.y = position(rng);
+        body.velocity = {speed(rng), speed(rng)};
+    }
+    return bodies;
+}
+
+// Bodies as the component pools hold them, each field next to the rest of its component
+void BM_IntegrateComponents(benchmark::State& state) {
+    auto bodies = makeBodies(state.range(0));
+
+    for (auto _ : state) {
+        for (auto& body : bodies) {
+            PhysicsSystem::applyMovement(body.transform, body.velocity, 1.0f / 60.0f);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Bodies as the PhysicsBody pool holds them, one array per field, moved in place
+void BM_IntegrateFields(benchmark::State& state) {
+    auto source = makeBodies(state.range(0));
+    std::vector<float> x, y, vx, vy;
+
+    for (const auto& body : source) {
+        x.push_back(body.transform.x);
+        y.push_back(body.transform.y);
+        vx.push_back(body.velocity.vx);
+        vy.push_back(body.velocity.vy);
+    }
+    for (auto _ : state) {
+        PhysicsSystem::integrate(x, y, vx, vy, 1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void populate(Registry& registry, const std::vector<Body>& bodies) {
+    for (std::size_t idx = 0; idx < bodies.size(); ++idx) {
+        Entity entity = registry.createEntity();
+
+        registry.addComponent<transform_component_s>(entity, bodies[idx].transform);
+        registry.addComponent<Velocity2D>(entity, bodies[idx].velocity);
+        if (idx % 8 == 0)
+            registry.addComponent<GravityComponent>(entity, {10.0f, 0.5f, false});
+    }
+}
+
+// How the physics ran before: one body at a time through the registry view
+void BM_PhysicsTickEach(benchmark::State& state) {
+    Registry registry;
+    const float dt = 1.0f / 60.0f;
+
+    populate(registry, makeBodies(state.range(0)));
+    auto& gravities = registry.getPool<GravityComponent>();
+    for (auto _ : state) {
+        registry.each<const Velocity2D, transform_component_s>(
+            [&](Entity entity, const Velocity2D& vel, transform_component_s& pos) {
+                if (const auto* gravity = gravities.tryGetDataFromId(entity))
+                    pos.y += gravity->vectorY;
+                PhysicsSystem::applyMovement(pos, vel, dt);
+            });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PhysicsTick(benchmark::State& state) {
+    BenchEnvironment env;
+    Registry registry;
+    PhysicsSystem system;
+
+    populate(registry, makeBodies(state.range(0)));
+    for (auto _ : state) {
+        system.update(registry, env.context(1.0f / 60.0f));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+// Argument: moving bodies
+BENCHMARK(BM_IntegrateComponents)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IntegrateFields)->Arg(100000)->Unit(benchmark::kMicrosecond);
+// A registry holds at most MAX_ENTITIES entities
+BENCHMARK(BM_PhysicsTickEach)->Arg(MAX_ENTITIES)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PhysicsTick)->Arg(MAX_ENTITIES)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Components/LobbyIdComponent.hpp"
+#include "Components/StandardComponents.hpp"
+#include "Components/Sprite/Sprite2D.hpp"
+#include "registry.hpp"
+
+namespace {
+
+constexpr int64_t ENTITY_COUNT = 1000;
+
+// Same shape as a gameplay scene: a dozen pools alive, most entities carrying
+// only part of the components a system asks for.
+void populate(Registry& registry) {
+    for (int64_t i = 0; i < ENTITY_COUNT; ++i) {
+        Entity entity = registry.createEntity();
+
+        registry.addComponent<transform_component_s>(entity, {static_cast<float>(i), 0.0f});
+        registry.addComponent<LobbyIdComponent>(entity, {1});
+        if (i % 2 == 0)
+            registry.addComponent<Velocity2D>(entity, {1.0f, 1.0f});
+        if (i % 3 == 0)
+            registry.addComponent<Sprite2D>(entity, Sprite2D{});
+        if (i % 4 == 0)
+            registry.addComponent<TagComponent>(entity, {{"ENEMY"}});
+        if (i % 5 == 0)
+            registry.addComponent<BoxCollisionComponent>(entity, {});
+        if (i % 7 == 0)
+            registry.addComponent<ResourceComponent>(entity, {});
+        if (i % 11 == 0)
+            registry.addComponent<Scroll>(entity, {});
+    }
+}
+
+void BM_RegistryHasComponent(benchmark::State& state) {
+    Registry registry;
+    populate(registry);
+
+    for (auto _ : state) {
+        int64_t count = 0;
+        for (Entity entity = 0; entity < ENTITY_COUNT; ++entity) {
+            count += registry.hasComponent<Velocity2D>(entity);
+            count += registry.hasComponent<Sprite2D>(entity);
+            count += registry.hasComponent<TagComponent>(entity);
+            count += registry.hasComponent<ResourceComponent>(entity);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT * 4);
+}
+
+void BM_RegistryGetConstComponent(benchmark::State& state) {
+    Registry registry;
+    populate(registry);
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (Entity entity = 0; entity < ENTITY_COUNT; ++entity) {
+            sum += registry.getConstComponent<transform_component_s>(entity).x;
+            sum += static_cast<float>(registry.getConstComponent<LobbyIdComponent>(entity).lobby_id);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT * 2);
+}
+
+void BM_RegistryGetComponent(benchmark::State& state) {
+    Registry registry;
+    populate(registry);
+
+    for (auto _ : state) {
+        for (Entity entity = 0; entity < ENTITY_COUNT; ++entity) {
+            registry.getComponent<transform_component_s>(entity).y += 1.0f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+}
+
+// The typical system loop: driver pool, membership test, then fetch
+void BM_RegistryJoinLoop(benchmark::State& state) {
+    Registry registry;
+    populate(registry);
+
+    for (auto _ : state) {
+        for (auto entity : registry.getEntities<Velocity2D>()) {
+            if (!registry.hasComponent<transform_component_s>(entity))
+                continue;
+            const auto& vel = registry.getConstComponent<Velocity2D>(entity);
+            auto& pos = registry.getComponent<transform_component_s>(entity);
+            pos.x += vel.vx;
+            pos.y += vel.vy;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT / 2);
+}
+
+// A level reset: most of the world goes, one entity at a time or in one pass per pool
+template <bool Bulk>
+void runRegistryDestroy(benchmark::State& state) {
+    std::vector<Entity> doomed;
+
+    for (Entity entity = 0; entity < ENTITY_COUNT; ++entity) {
+        if (entity % 4 != 0)
+            doomed.push_back(entity);
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto registry = std::make_unique<Registry>();
+        populate(*registry);
+        state.ResumeTiming();
+
+        if constexpr (Bulk) {
+            registry->destroyEntities(doomed);
+        } else {
+            for (auto entity : doomed)
+                registry->destroyEntity(entity);
+        }
+        benchmark::ClobberMemory();
+
+        state.PauseTiming();
+        registry.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(doomed.size()));
+}
+
+void BM_RegistryDestroyEach(benchmark::State& state) {
+    runRegistryDestroy<false>(state);
+}
+
+void BM_RegistryDestroyBulk(benchmark::State& state) {
+    runRegistryDestroy<true>(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_RegistryHasComponent);
+BENCHMARK(BM_RegistryGetConstComponent);
+BENCHMARK(BM_RegistryGetComponent);
+BENCHMARK(BM_RegistryJoinLoop);
+BENCHMARK(BM_RegistryDestroyEach)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RegistryDestroyBulk)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Network.hpp"
+#include "ServerInterface.hpp"
+
+namespace {
+
+using GameEvents = network::GameEvents;
+
+// A server whose connections are opened sockets that never connect: enough to route messages to them
+class SimulatedServer : public network::ServerInterface<GameEvents> {
+   public:
+    explicit SimulatedServer(int64_t connections) : network::ServerInterface<GameEvents>(0) {
+        for (int64_t i = 0; i < connections; ++i) {
+            asio::ip::tcp::socket socket(_asioContext);
+            socket.open(asio::ip::tcp::v4());
+            auto connection = std::make_shared<network::Connection<GameEvents>>(
+                network::Connection<GameEvents>::owner::server, _asioContext, std::move(socket), _MessagesIn,
+                _messagePool, _udpSender);
+            connection->ConnectToClient(static_cast<uint32_t>(10000 + i));
+            RegisterConnection(connection);
+            ids.push_back(connection->GetID());
+        }
+    }
+
+    // How AddMessageToPlayer found its target before the index
+    std::shared_ptr<network::Connection<GameEvents>> scan(uint32_t id) {
+        for (auto& client : _deqConnections) {
+            if (client->GetID() == id)
+                return client;
+        }
+        return nullptr;
+    }
+
+    std::vector<uint32_t> ids;
+};
+
+// One snapshot fan-out: a message routed to every connection
+void BM_RouteLinearScan(benchmark::State& state) {
+    SimulatedServer server(state.range(0));
+
+    for (auto _ : state) {
+        for (uint32_t id : server.ids) {
+            benchmark::DoNotOptimize(server.scan(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RouteIndexed(benchmark::State& state) {
+    SimulatedServer server(state.range(0));
+
+    for (auto _ : state) {
+        for (uint32_t id : server.ids) {
+            benchmark::DoNotOptimize(server.GetConnection(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_RouteLinearScan)->Arg(50)->Arg(500)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RouteIndexed)->Arg(50)->Arg(500)->Unit(benchmark::kMicrosecond);
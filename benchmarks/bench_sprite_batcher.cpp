@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <SFML/Graphics/Sprite.hpp>
+
+#include "NewRenderSystem/SpriteBatcher.hpp"
+
+namespace {
+
+const sf::FloatRect VIEW({0.f, 0.f}, {1920.f, 1080.f});
+
+struct SpriteInput {
+    int layer;
+    int texture;
+    Rect2D rect;
+    sf::Vector2f position;
+};
+
+// A frame of a busy level: a few sprite sheets over four layers, a quarter of the sprites off screen
+std::vector<SpriteInput> makeSprites(int64_t count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> layer(0, 3);
+    std::uniform_int_distribution<int> texture(0, 7);
+    std::uniform_real_distribution<float> x(-480.f, 2400.f);
+    std::uniform_real_distribution<float> y(0.f, 1080.f);
+    std::vector<SpriteInput> sprites(static_cast<std::size_t>(count));
+
+    for (auto& sprite : sprites)
+        sprite = {layer(rng), texture(rng), {0, 0, 32, 32}, {x(rng), y(rng)}};
+    return sprites;
+}
+
+// What the render system did before: one sf::Sprite per entity, stable sorted by layer, one draw call each
+void BM_SortSprites(benchmark::State& state) {
+    struct DrawCmd {
+        int layer;
+        std::uint64_t order;
+        sf::Sprite sprite;
+    };
+    std::vector<sf::Texture> textures(8);
+    auto sprites = makeSprites(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<DrawCmd> cmds;
+        std::uint64_t order = 0;
+
+        cmds.reserve(sprites.size());
+        for (const auto& input : sprites) {
+            sf::Sprite spr(textures[input.texture]);
+            spr.setTextureRect(sf::IntRect({input.rect.x, input.rect.y}, {input.rect.width, input.rect.height}));
+            spr.setOrigin({16.f, 16.f});
+            spr.setPosition(input.position);
+            cmds.push_back(DrawCmd{input.layer, order++, std::move(spr)});
+        }
+        std::stable_sort(cmds.begin(), cmds.end(), [](const DrawCmd& a, const DrawCmd& b) {
+            if (a.layer != b.layer)
+                return a.layer < b.layer;
+            return a.order < b.order;
+        });
+        benchmark::DoNotOptimize(cmds.data());
+        state.counters["draw_calls"] = static_cast<double>(cmds.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BatchSprites(benchmark::State& state) {
+    std::vector<sf::Texture> textures(8);
+    auto sprites = makeSprites(state.range(0));
+    SpriteBatcher batcher;
+
+    for (auto _ : state) {
+        batcher.begin(VIEW);
+        for (const auto& input : sprites)
+            batcher.add(input.layer, &textures[input.texture], input.rect, input.position, {1.f, 1.f});
+        batcher.build();
+        benchmark::DoNotOptimize(batcher.vertexCount());
+    }
+    state.counters["draw_calls"] = static_cast<double>(batcher.size());
+    state.counters["culled"] = static_cast<double>(batcher.culledCount());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+// Argument: sprites in the frame
+BENCHMARK(BM_SortSprites)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchSprites)->Arg(5000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "Connection.hpp"
+#include "MessagePool.hpp"
+#include "UdpSender.hpp"
+
+namespace {
+
+enum class BenchEvents : uint32_t { S_CANCEL_READY_BROADCAST };
+
+// A server socket writing a burst of small lobby messages to its client, both ends on loopback
+class LoopbackStream {
+   public:
+    LoopbackStream()
+        : _socket(_context), _peer(_context), _udpSocket(_context), _udpSender(_context, _udpSocket, _pool) {
+        asio::ip::tcp::acceptor acceptor(_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        _peer.connect(acceptor.local_endpoint());
+        acceptor.accept(_socket);
+        _socket.set_option(asio::ip::tcp::no_delay(true));
+
+        _msg.header.id = BenchEvents::S_CANCEL_READY_BROADCAST;
+        _msg << static_cast<uint32_t>(10000);
+        _msg.header.size = _msg.body.size();
+    }
+
+    ~LoopbackStream() { _connection.reset(); }
+
+    // How Connection wrote before: a header write then a body write, one message after the other
+    void sendLegacy(int64_t messages) {
+        _legacyLeft = messages;
+        writeLegacyHeader();
+        receive(messages);
+    }
+
+    void sendCoalesced(int64_t messages) {
+        if (!_connection) {
+            _connection = std::make_shared<network::Connection<BenchEvents>>(
+                network::Connection<BenchEvents>::owner::server, _context, std::move(_socket), _in, _pool,
+                _udpSender);
+        }
+        for (int64_t i = 0; i < messages; ++i) {
+            _connection->Send(build());
+        }
+        receive(messages);
+    }
+
+   private:
+    // How the server builds a message now: in a body taken from the pool, then moved into the connection
+    network::message<BenchEvents> build() {
+        network::message<BenchEvents> msg = _pool.acquire(_msg.size());
+        msg.header = _msg.header;
+        network::MessageWriter<BenchEvents>(msg, _msg.size()).write(_msg.body.data(), _msg.size());
+        return msg;
+    }
+
+    void writeLegacyHeader() {
+        asio::async_write(_socket, asio::buffer(&_msg.header, sizeof(_msg.header)),
+                          [this](std::error_code ec, std::size_t) {
+                              if (!ec)
+                                  writeLegacyBody();
+                          });
+    }
+
+    void writeLegacyBody() {
+        asio::async_write(_socket, asio::buffer(_msg.body.data(), _msg.body.size()),
+                          [this](std::error_code ec, std::size_t) {
+                              if (!ec && --_legacyLeft > 0)
+                                  writeLegacyHeader();
+                          });
+    }
+
+    // Runs the asio thread until the client has read every byte of the burst
+    void receive(int64_t messages) {
+        std::size_t expected = static_cast<std::size_t>(messages) * (sizeof(_msg.header) + _msg.body.size());
+        std::size_t received = 0;
+
+        _context.restart();
+        while (received < expected) {
+            _context.poll();
+            if (_peer.available() > 0)
+                received += _peer.read_some(asio::buffer(_readBuffer));
+        }
+    }
+
+    asio::io_context _context;
+    network::MessagePool<BenchEvents> _pool;
+    network::RingQueue<network::owned_message<BenchEvents>> _in{network::INBOUND_QUEUE_CAPACITY};
+    asio::ip::tcp::socket _socket;
+    asio::ip::tcp::socket _peer;
+    asio::ip::udp::socket _udpSocket;
+    network::UdpSender<BenchEvents> _udpSender;
+    std::shared_ptr<network::Connection<BenchEvents>> _connection;
+
+    int64_t _legacyLeft = 0;
+    network::message<BenchEvents> _msg;
+    std::array<uint8_t, 64 * 1024> _readBuffer{};
+};
+
+// Argument: messages queued on the connection per tick, the N x N ready broadcast of a lobby of N players
+void BM_TcpBurstLegacy(benchmark::State& state) {
+    LoopbackStream stream;
+
+    for (auto _ : state) {
+        stream.sendLegacy(state.range(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["messages/s"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * state.range(0)), benchmark::Counter::kIsRate);
+}
+
+void BM_TcpBurstCoalesced(benchmark::State& state) {
+    LoopbackStream stream;
+
+    for (auto _ : state) {
+        stream.sendCoalesced(state.range(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["messages/s"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * state.range(0)), benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+BENCHMARK(BM_TcpBurstLegacy)->Arg(4)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TcpBurstCoalesced)->Arg(4)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "MessagePool.hpp"
+#include "RingQueue.hpp"
+#include "UdpReceiver.hpp"
+
+namespace {
+
+enum class BenchEvents : uint32_t { C_INPUT };
+
+constexpr std::size_t BODY_SIZE = 16;
+
+// Input datagrams of every player of a lobby landing on the server socket during one tick, on loopback
+class LoopbackInputs {
+   public:
+    explicit LoopbackInputs(int64_t players) : _socket(_context), _receiver(_socket, _pool) {
+        _socket.open(asio::ip::udp::v4());
+        _socket.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        _socket.set_option(asio::socket_base::receive_buffer_size(4 * 1024 * 1024));
+
+        for (int64_t i = 0; i < players; ++i) {
+            auto& player = _players.emplace_back(std::make_unique<asio::ip::udp::socket>(_context));
+            player->open(asio::ip::udp::v4());
+            player->bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        }
+
+        network::message_header<BenchEvents> header;
+        header.id = BenchEvents::C_INPUT;
+        header.size = BODY_SIZE;
+        _datagram.resize(sizeof(header) + BODY_SIZE, 0xAB);
+        std::memcpy(_datagram.data(), &header, sizeof(header));
+    }
+
+    ~LoopbackInputs() { _socket.close(); }
+
+    void sendInputs(int64_t perPlayer) {
+        for (int64_t i = 0; i < perPlayer; ++i) {
+            for (auto& player : _players) {
+                player->send_to(asio::buffer(_datagram), _socket.local_endpoint());
+            }
+        }
+    }
+
+    // How ReceiveUDP read a datagram: one async_receive_from and one queue push each
+    int64_t receiveLegacy(int64_t expected) {
+        _received = 0;
+        _legacyWakeups = 0;
+        receiveOne(expected);
+        _context.restart();
+        _context.run();
+        return _legacyWakeups;
+    }
+
+    void receiveBatched(int64_t expected) {
+        if (!_started) {
+            _receiver.start([this](std::vector<network::received_datagram<BenchEvents>>& batch) {
+                for (auto& datagram : batch) {
+                    _out.push_back({nullptr, std::move(datagram.msg)});
+                }
+                _received += static_cast<int64_t>(_out.size());
+                _queue.push_all(_out);
+                _out.clear();
+            });
+            _started = true;
+        }
+        _received = 0;
+        while (_received < expected) {
+            _context.restart();
+            _context.run_one();
+        }
+    }
+
+    // Empties the queue the game thread would drain
+    void drain() {
+        _in.clear();
+        _queue.pop_all(_in);
+        for (auto& msg : _in) {
+            _pool.release(std::move(msg.msg));
+        }
+    }
+
+    const network::UdpReceiveStats& stats() const { return _receiver.getStats(); }
+
+   private:
+    void receiveOne(int64_t expected) {
+        _socket.async_receive_from(asio::buffer(_legacyBuffer), _from, [this, expected](std::error_code ec,
+                                                                                         std::size_t len) {
+            _legacyWakeups++;
+            if (!ec && len >= sizeof(network::message_header<BenchEvents>)) {
+                network::message<BenchEvents> msg = _pool.acquire(len);
+                std::memcpy(&msg.header, _legacyBuffer.data(), sizeof(msg.header));
+                msg.body.resize(msg.header.size);
+                std::memcpy(msg.body.data(), _legacyBuffer.data() + sizeof(msg.header), msg.header.size);
+                _queue.push_back({nullptr, std::move(msg)});
+            }
+            if (++_received < expected)
+                receiveOne(expected);
+        });
+    }
+
+    asio::io_context _context;
+    network::MessagePool<BenchEvents> _pool;
+    asio::ip::udp::socket _socket;
+    network::UdpReceiver<BenchEvents> _receiver;
+    std::vector<std::unique_ptr<asio::ip::udp::socket>> _players;
+    std::vector<uint8_t> _datagram;
+
+    network::RingQueue<network::owned_message<BenchEvents>> _queue{network::INBOUND_QUEUE_CAPACITY};
+    std::vector<network::owned_message<BenchEvents>> _out;
+    std::vector<network::owned_message<BenchEvents>> _in;
+    bool _started = false;
+    int64_t _received = 0;
+
+    std::array<uint8_t, 4096> _legacyBuffer{};
+    asio::ip::udp::endpoint _from;
+    int64_t _legacyWakeups = 0;
+};
+
+// First argument: players in the lobby, second: input datagrams per player and tick
+void BM_UdpReceiveLegacy(benchmark::State& state) {
+    LoopbackInputs inputs(state.range(0));
+    int64_t datagrams = state.range(0) * state.range(1);
+    int64_t wakeups = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        inputs.sendInputs(state.range(1));
+        state.ResumeTiming();
+        wakeups += inputs.receiveLegacy(datagrams);
+        state.PauseTiming();
+        inputs.drain();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * datagrams);
+    state.counters["datagrams/s"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * datagrams), benchmark::Counter::kIsRate);
+    state.counters["wakeups/tick"] =
+        static_cast<double>(wakeups) / static_cast<double>(std::max<int64_t>(state.iterations(), 1));
+}
+
+void BM_UdpReceiveBatched(benchmark::State& state) {
+    LoopbackInputs inputs(state.range(0));
+    int64_t datagrams = state.range(0) * state.range(1);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        inputs.sendInputs(state.range(1));
+        state.ResumeTiming();
+        inputs.receiveBatched(datagrams);
+        state.PauseTiming();
+        inputs.drain();
+        state.ResumeTiming();
+    }
+    double ticks = static_cast<double>(std::max<int64_t>(state.iterations(), 1));
+    state.SetItemsProcessed(state.iterations() * datagrams);
+    state.counters["datagrams/s"] =
+        benchmark::Counter(static_cast<double>(inputs.stats().datagrams), benchmark::Counter::kIsRate);
+    state.counters["wakeups/tick"] = static_cast<double>(inputs.stats().wakeups) / ticks;
+    state.counters["syscalls/tick"] = static_cast<double>(inputs.stats().syscalls) / ticks;
+}
+
+}  // namespace
+
+BENCHMARK(BM_UdpReceiveLegacy)->Args({4, 4})->Args({16, 4})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_UdpReceiveBatched)->Args({4, 4})->Args({16, 4})->Unit(benchmark::kMicrosecond);
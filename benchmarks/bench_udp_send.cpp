@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Connection.hpp"
+#include "MessagePool.hpp"
+#include "UdpSender.hpp"
+
+namespace {
+
+enum class BenchEvents : uint32_t { S_SNAPSHOT };
+
+constexpr std::size_t BODY_SIZE = 200;
+
+// A lobby sending its snapshot datagrams for one tick, each client with its own socket on loopback
+class LoopbackTick {
+   public:
+    explicit LoopbackTick(int64_t clients) : _socket(_context), _sender(_context, _socket, _pool) {
+        _socket.open(asio::ip::udp::v4());
+        _socket.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        _socket.set_option(asio::socket_base::send_buffer_size(4 * 1024 * 1024));
+        _sender.setAutoFlush(false);
+
+        for (int64_t i = 0; i < clients; ++i) {
+            auto& receiver = _receivers.emplace_back(std::make_unique<asio::ip::udp::socket>(_context));
+            receiver->open(asio::ip::udp::v4());
+            receiver->bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+            receiver->set_option(asio::socket_base::receive_buffer_size(4 * 1024 * 1024));
+
+            auto connection = std::make_shared<network::Connection<BenchEvents>>(
+                network::Connection<BenchEvents>::owner::server, _context, asio::ip::tcp::socket(_context), _in,
+                _pool, _sender);
+            connection->SetUDPEndpoint(receiver->local_endpoint());
+            _connections.push_back(connection);
+        }
+
+        _msg.header.id = BenchEvents::S_SNAPSHOT;
+        _msg.body.assign(BODY_SIZE, 0xAB);
+        _msg.header.size = BODY_SIZE;
+    }
+
+    ~LoopbackTick() {
+        _context.run();
+        _connections.clear();
+    }
+
+    // How Connection::WriteUDP sent a datagram: copied next to its header, then one async_send_to each
+    void sendLegacy(int64_t perClient) {
+        for (auto& connection : _connections) {
+            for (int64_t i = 0; i < perClient; ++i) {
+                std::vector<uint8_t> buffer(sizeof(_msg.header) + _msg.body.size());
+                std::memcpy(buffer.data(), &_msg.header, sizeof(_msg.header));
+                std::memcpy(buffer.data() + sizeof(_msg.header), _msg.body.data(), _msg.body.size());
+
+                auto send_buffer = asio::buffer(buffer.data(), buffer.size());
+                _socket.async_send_to(send_buffer, connection->GetUDPEndpoint(),
+                                      [buffer = std::move(buffer)](std::error_code, std::size_t) {});
+            }
+        }
+        _context.restart();
+        _context.run();
+    }
+
+    void sendBatched(int64_t perClient) {
+        for (auto& connection : _connections) {
+            for (int64_t i = 0; i < perClient; ++i) {
+                connection->SendUdp(build());
+            }
+        }
+        _sender.flush();
+        _context.restart();
+        _context.run();
+    }
+
+    // Empties the receivers so the next tick is not dropped by a full socket buffer
+    void drain() {
+        asio::ip::udp::endpoint from;
+
+        for (auto& receiver : _receivers) {
+            while (receiver->available() > 0) {
+                receiver->receive_from(asio::buffer(_recvBuffer), from);
+            }
+        }
+    }
+
+    const network::UdpSendStats& stats() const { return _sender.getStats(); }
+
+   private:
+    // How the server builds a datagram now: in a body taken from the pool, then moved into the connection
+    network::message<BenchEvents> build() {
+        network::message<BenchEvents> msg = _pool.acquire(_msg.size());
+        msg.header = _msg.header;
+        network::MessageWriter<BenchEvents>(msg, _msg.size()).write(_msg.body.data(), _msg.size());
+        return msg;
+    }
+
+    asio::io_context _context;
+    network::MessagePool<BenchEvents> _pool;
+    network::RingQueue<network::owned_message<BenchEvents>> _in{network::INBOUND_QUEUE_CAPACITY};
+    asio::ip::udp::socket _socket;
+    network::UdpSender<BenchEvents> _sender;
+    std::vector<std::unique_ptr<asio::ip::udp::socket>> _receivers;
+    std::vector<std::shared_ptr<network::Connection<BenchEvents>>> _connections;
+    network::message<BenchEvents> _msg;
+    std::array<uint8_t, 2048> _recvBuffer{};
+};
+
+// First argument: clients in the lobby, second: datagrams per client and tick
+void BM_UdpTickLegacy(benchmark::State& state) {
+    LoopbackTick tick(state.range(0));
+    int64_t datagrams = state.range(0) * state.range(1);
+
+    for (auto _ : state) {
+        tick.sendLegacy(state.range(1));
+        state.PauseTiming();
+        tick.drain();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * datagrams);
+    state.counters["datagrams/s"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * datagrams), benchmark::Counter::kIsRate);
+    state.counters["syscalls/tick"] = static_cast<double>(datagrams);
+}
+
+void BM_UdpTickBatched(benchmark::State& state) {
+    LoopbackTick tick(state.range(0));
+    int64_t datagrams = state.range(0) * state.range(1);
+
+    for (auto _ : state) {
+        tick.sendBatched(state.range(1));
+        state.PauseTiming();
+        tick.drain();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * datagrams);
+    state.counters["datagrams/s"] =
+        benchmark::Counter(static_cast<double>(tick.stats().datagrams), benchmark::Counter::kIsRate);
+    state.counters["syscalls/tick"] =
+        static_cast<double>(tick.stats().syscalls) / static_cast<double>(std::max<int64_t>(state.iterations(), 1));
+}
+
+}  // namespace
+
+BENCHMARK(BM_UdpTickLegacy)->Args({4, 8})->Args({16, 8})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_UdpTickBatched)->Args({4, 8})->Args({16, 8})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+#include "Components/StandardComponents.hpp"
+#include "registry.hpp"
+
+namespace {
+
+// A registry holds at most MAX_ENTITIES, so the 10k-entity scene is spread over
+// ten worlds, like ten busy lobbies.
+constexpr std::size_t WORLD_COUNT = 10;
+constexpr std::size_t ENTITIES_PER_WORLD = MAX_ENTITIES;
+
+struct Scene {
+    std::array<Registry, WORLD_COUNT> worlds;
+
+    Scene() {
+        for (auto& registry : worlds) {
+            for (std::size_t i = 0; i < ENTITIES_PER_WORLD; ++i) {
+                Entity entity = registry.createEntity();
+
+                // Sprinkle the components so each pool has its own order and size
+                if (i % 5 != 0)
+                    registry.addComponent<transform_component_s>(entity, {static_cast<float>(i), 0.0f});
+                if (i % 2 == 0)
+                    registry.addComponent<Velocity2D>(entity, {1.0f, 0.5f});
+                if (i % 8 == 0)
+                    registry.addComponent<Scroll>(entity, {-10.0f, 0.0f, false});
+            }
+        }
+    }
+};
+
+void BM_JoinHandRolled(benchmark::State& state) {
+    Scene scene;
+
+    for (auto _ : state) {
+        for (auto& registry : scene.worlds) {
+            for (auto entity : registry.getEntities<Velocity2D>()) {
+                if (!registry.hasComponent<transform_component_s>(entity))
+                    continue;
+                const auto& vel = registry.getConstComponent<Velocity2D>(entity);
+                auto& pos = registry.getComponent<transform_component_s>(entity);
+                pos.x += vel.vx * 0.016f;
+                pos.y += vel.vy * 0.016f;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * WORLD_COUNT * ENTITIES_PER_WORLD);
+}
+
+void BM_JoinEach(benchmark::State& state) {
+    Scene scene;
+
+    for (auto _ : state) {
+        for (auto& registry : scene.worlds) {
+            registry.each<const Velocity2D, transform_component_s>(
+                [](Entity, const Velocity2D& vel, transform_component_s& pos) {
+                    pos.x += vel.vx * 0.016f;
+                    pos.y += vel.vy * 0.016f;
+                });
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * WORLD_COUNT * ENTITIES_PER_WORLD);
+}
+
+// Three pools, the rarest one last: the hand-rolled loop walks the big pool
+void BM_Join3HandRolled(benchmark::State& state) {
+    Scene scene;
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (auto& registry : scene.worlds) {
+            for (auto entity : registry.getEntities<transform_component_s>()) {
+                if (!registry.hasComponent<Velocity2D>(entity) || !registry.hasComponent<Scroll>(entity))
+                    continue;
+                const auto& pos = registry.getConstComponent<transform_component_s>(entity);
+                const auto& vel = registry.getConstComponent<Velocity2D>(entity);
+                const auto& scroll = registry.getConstComponent<Scroll>(entity);
+                sum += pos.x + vel.vx + scroll.scroll_speed_x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * WORLD_COUNT * ENTITIES_PER_WORLD);
+}
+
+void BM_Join3Each(benchmark::State& state) {
+    Scene scene;
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (auto& registry : scene.worlds) {
+            registry.each<const transform_component_s, const Velocity2D, const Scroll>(
+                [&](Entity, const transform_component_s& pos, const Velocity2D& vel, const Scroll& scroll) {
+                    sum += pos.x + vel.vx + scroll.scroll_speed_x;
+                });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * WORLD_COUNT * ENTITIES_PER_WORLD);
+}
+
+}  // namespace
+
+BENCHMARK(BM_JoinHandRolled)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_JoinEach)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Join3HandRolled)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Join3Each)->Unit(benchmark::kMicrosecond);
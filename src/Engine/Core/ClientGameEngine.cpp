@@ -186,9 +186,9 @@ void ClientGameEngine::processNetworkEvents() {
     if (pending.count(network::GameEvents::S_SEND_ID)) {
         auto& msgs = pending.at(network::GameEvents::S_SEND_ID);
         for (const auto& msg : msgs) {
-            auto mutable_msg = msg;
+            network::MessageReader<network::GameEvents> reader(msg);
             uint32_t id;
-            mutable_msg >> id;
+            reader >> id;
             _clientId = id;
         }
     }
@@ -196,6 +196,9 @@ void ClientGameEngine::processNetworkEvents() {
     if (pending.count(network::GameEvents::S_REGISTER_OK)) {
         _env->setGameState(Environment::GameState::CORRECT_PASSWORD);
     }
+    if (pending.count(network::GameEvents::S_REGISTER_KO)) {
+        _env->setGameState(Environment::GameState::INCORRECT_PASSWORD);
+    }
     if (pending.count(network::GameEvents::S_LOGIN_OK)) {
         _env->setGameState(Environment::GameState::CORRECT_PASSWORD);
     }
@@ -205,32 +208,140 @@ void ClientGameEngine::processNetworkEvents() {
     if (pending.count(network::GameEvents::S_INVALID_TOKEN)) {
         _env->setGameState(Environment::GameState::INCORRECT_PASSWORD);
     }
+    auto applySnapshot = [this](const ComponentPacket& packet, uint32_t tick) {
+        processComponentPacket(packet.entity_guid, packet.component_type, packet.data, packet.owner_id);
+        if (_localPlayerEntity.has_value() && packet.entity_guid == _localPlayerEntity.value()) {
+            Entity localId = getLocalPlayerEntity().value();
+            if (_ecs.registry.hasComponent<PredictionComponent>(localId) &&
+                _ecs.registry.hasComponent<transform_component_s>(localId)) {
+                auto serverPos = _ecs.registry.getComponent<transform_component_s>(localId);
+                _predictionSystem->onServerUpdate(_ecs.registry, localId, serverPos, tick);
+            }
+        }
+    };
+
+    // Sprites read before the definition of their set hold a placeholder until now
+    if (pending.count(network::GameEvents::S_ANIMATION_SET)) {
+        network::AnimationSetPacket packet;
+        bool defined = false;
+
+        for (auto& msg : pending.at(network::GameEvents::S_ANIMATION_SET)) {
+            std::size_t offset = 0;
+            msg >> packet;
+            if (serialize::AnimationSetWire::define(packet.data, offset, _texture_manager)) {
+                defined = true;
+            } else {
+                std::cerr << "[Network] Dropped a malformed animation set" << std::endl;
+            }
+        }
+        if (defined) {
+            _ecs.registry.each<AnimatedSprite2D>([](Entity, AnimatedSprite2D& sprite) {
+                const AnimationSet* set = serialize::AnimationSetWire::resolve(sprite.animations);
+                if (set != sprite.animations) {
+                    sprite.animations = set;
+                    sprite.refreshHitbox();
+                }
+            });
+        }
+    }
+
     if (pending.count(network::GameEvents::S_SNAPSHOT)) {
         auto& snapshot_packets = pending.at(network::GameEvents::S_SNAPSHOT);
 
+        ComponentPacket packet;
+
         for (const auto& msg : snapshot_packets) {
-            auto mutable_msg = msg;
-            ComponentPacket packet;
-            mutable_msg >> packet;
-            processComponentPacket(packet.entity_guid, packet.component_type, packet.data, packet.owner_id);
-            if (_localPlayerEntity.has_value() && packet.entity_guid == _localPlayerEntity.value()) {
-                Entity localId = getLocalPlayerEntity().value();
-                if (_ecs.registry.hasComponent<PredictionComponent>(localId) &&
-                    _ecs.registry.hasComponent<transform_component_s>(localId)) {
-                    auto serverPos = _ecs.registry.getComponent<transform_component_s>(localId);
-                    _predictionSystem->onServerUpdate(_ecs.registry, localId, serverPos, msg.header.tick);
+            network::MessageReader<network::GameEvents> reader(msg);
+            reader >> packet;
+            applySnapshot(packet, msg.header.tick);
+        }
+    }
+
+    // The whole world is applied at once when its last chunk arrives, except the components a
+    // batch already updated since the server captured it
+    if (pending.count(network::GameEvents::S_FULL_STATE_CHUNK)) {
+        auto& baselines = _network->getReceivedSnapshots();
+        network::FullStateChunkPacket chunk;
+        ComponentPacket packet;
+
+        for (auto& msg : pending.at(network::GameEvents::S_FULL_STATE_CHUNK)) {
+            msg >> chunk;
+            auto result = _fullState.feed(chunk);
+            if (result == engine::core::FullStateReader::Result::MALFORMED) {
+                std::cerr << "[Network] Dropped a malformed full state, asking for it again" << std::endl;
+                _network->transmitEvent(network::GameEvents::C_FULL_STATE_RESEND, chunk.sequence, _currentTick);
+                continue;
+            }
+            if (result != engine::core::FullStateReader::Result::COMPLETE) {
+                continue;
+            }
+            bool valid = _fullState.read(packet, [&](const ComponentPacket& record) {
+                if (baselines.latestSequence(record.entity_guid, record.component_type) >= _fullState.sequence()) {
+                    return;
+                }
+                applySnapshot(record, msg.header.tick);
+            });
+            if (!valid) {
+                std::cerr << "[Network] Dropped the end of a malformed full state" << std::endl;
+            }
+        }
+        _network->transmitEvent(network::GameEvents::C_FULL_STATE_ACK, _fullState.received(), _currentTick);
+    }
+
+    if (pending.count(network::GameEvents::S_SNAPSHOT_BATCH)) {
+        auto& batches = pending.at(network::GameEvents::S_SNAPSHOT_BATCH);
+        auto& baselines = _network->getReceivedSnapshots();
+        network::SnapshotAckPacket ack;
+        network::SnapshotRecord record;
+        ComponentPacket packet;
+
+        for (const auto& msg : batches) {
+            uint32_t sequence = 0;
+            bool acknowledge = true;
+            bool valid = network::readSnapshotBatch(msg, sequence, record, [&](const network::SnapshotRecord& rec) {
+                using Result = engine::core::ClientSnapshotBaselines::Result;
+                Result result = baselines.decode(sequence, rec, packet.data);
+
+                if (result == Result::MISSING_BASELINE) {
+                    ack.resync = true;
+                }
+                if (result == Result::DROPPED || result == Result::MISSING_BASELINE) {
+                    acknowledge = false;
                 }
+                if (result != Result::APPLY) {
+                    return;
+                }
+                packet.entity_guid = rec.entity_guid;
+                packet.component_type = rec.component_type;
+                packet.owner_id = rec.owner_id;
+                applySnapshot(packet, msg.header.tick);
+            });
+            if (!valid) {
+                std::cerr << "[Network] Dropped the end of a malformed snapshot batch" << std::endl;
+                continue;
+            }
+            if (acknowledge) {
+                ack.sequences.push_back(sequence);
+            }
+            if (ack.sequences.size() == network::MAX_SNAPSHOT_ACKS) {
+                _network->transmitEvent(network::GameEvents::C_SNAPSHOT_ACK, ack, _currentTick);
+                ack.sequences.clear();
             }
         }
+        if (!ack.sequences.empty() || ack.resync) {
+            _network->transmitEvent(network::GameEvents::C_SNAPSHOT_ACK, ack, _currentTick);
+        }
     }
 
     if (pending.count(network::GameEvents::S_ENTITY_DESTROY)) {
         auto& destroy_packets = pending.at(network::GameEvents::S_ENTITY_DESTROY);
         for (const auto& msg : destroy_packets) {
-            auto mutable_msg = msg;
+            network::MessageReader<network::GameEvents> reader(msg);
             uint32_t guid;
-            mutable_msg >> guid;
+            reader >> guid;
 
+            _network->getReceivedSnapshots().forgetEntity(guid);
+            _fullState.forget(guid);
             auto it = _networkToLocalEntity.find(guid);
             if (it != _networkToLocalEntity.end()) {
                 Entity localId = it->second;
@@ -270,8 +381,8 @@ void ClientGameEngine::processNetworkEvents() {
                 Entity playerScoreEntity = _ecs.registry.createEntity();
 
                 TagComponent tags;
-                tags.tags.push_back("PLAYER");
-                tags.tags.push_back("LEADERBOARD_DATA");
+                tags.tags.add("PLAYER");
+                tags.tags.add("LEADERBOARD_DATA");
                 _ecs.registry.addComponent<TagComponent>(playerScoreEntity, tags);
                 ScoreComponent score;
                 score.current_score = packet.players[i].score;
@@ -665,13 +776,9 @@ int ClientGameEngine::run() {
                                       auto& registry = _ecs.registry;
 
                                       // Destroy all tagged entities (roughly resets the scene)
-                                      auto all_tags = registry.getEntities<TagComponent>();
-                                      auto to_kill = std::vector<Entity>();
-                                      for (auto eid : all_tags)
-                                          to_kill.push_back(static_cast<Entity>(eid));
-                                      for (auto e : to_kill) {
-                                          registry.destroyEntity(e);
-                                      }
+                                      const auto& all_tags = registry.getEntities<TagComponent>();
+                                      auto to_kill = std::vector<Entity>(all_tags.begin(), all_tags.end());
+                                      registry.destroyEntities(to_kill);
 
                                       // Reset StatusDisplaySystem player entity tracking
                                       auto statusEntities = registry.getEntities<StatusDisplayComponent>();
@@ -25,6 +25,7 @@
 #include "LobbyState.hpp"
 #include "Voice/VoiceManager.hpp"
 #include "NetworkEngine/NetworkEngine.hpp"
+#include "NetworkEngine/FullState.hpp"
 
 #define SUCCESS 0
 #define FAILURE -1
@@ -116,6 +117,7 @@ class ClientGameEngine : public GameEngineBase<ClientGameEngine> {
                                      std::vector<network::message<engine::core::NetworkEngine::EventType>>>& pending);
 
     std::shared_ptr<Environment> _env;
+    engine::core::FullStateReader _fullState;  // World of the lobby sent when joining, chunk by chunk
 
     std::function<void()> _authSuccessCallback;
     std::function<void()> _authFailedCallback;
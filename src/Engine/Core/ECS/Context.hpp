@@ -25,6 +25,7 @@ struct system_context {
     std::vector<uint32_t> active_clients;
     engine::core::LobbyManager* lobby_manager;
     std::unordered_set<uint32_t>* networked_component_types = nullptr;  // Hash of component types to send over network
+    uint32_t lobby_id = 0;  // Lobby owning the whole registry, 0 when it holds every lobby
 };
 
 #elif defined(CLIENT_BUILD)
@@ -47,4 +48,5 @@ struct system_context {
 
 struct SerializationContext {
     ResourceManager<TextureAsset>& textureManager;
+    std::vector<uint64_t>* animationSets = nullptr;  // receives the key of every AnimationSet written, if set
 };
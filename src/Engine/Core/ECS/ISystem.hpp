@@ -9,10 +9,17 @@
 
 #include "Registry/registry.hpp"
 #include "Context.hpp"
+#include "SystemAccess.hpp"
 
 class ISystem {
    public:
     virtual ~ISystem() = default;
 
     virtual void update(Registry& registry, system_context context) = 0;
+
+    /**
+        A function to declare the components the system uses so it can run in parallel with others
+        @return The access of the system, exclusive by default
+    */
+    virtual SystemAccess access() const { return SystemAccess::exclusive(); }
 };
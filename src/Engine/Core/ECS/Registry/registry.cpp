@@ -1,4 +1,5 @@
 #include "registry.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include "Components/NetworkComponents.hpp"
@@ -23,14 +24,29 @@ Entity Registry::createEntity() {
 }
 
 void Registry::destroyEntity(Entity id) {
-    for (auto& [type, pool] : _pools) {
-        if (pool->has(id))
+    for (auto& pool : _pools) {
+        if (pool && pool->has(id))
             pool->removeId(id);
     }
     _deadEntities.push_back(id);
     return;
 }
 
+void Registry::destroyEntities(std::span<const Entity> ids) {
+    if (ids.empty())
+        return;
+    // A duplicate would hand the same id to two entities once recycled
+    _destroyScratch.assign(ids.begin(), ids.end());
+    std::sort(_destroyScratch.begin(), _destroyScratch.end());
+    _destroyScratch.erase(std::unique(_destroyScratch.begin(), _destroyScratch.end()), _destroyScratch.end());
+
+    for (auto& pool : _pools) {
+        if (pool)
+            pool->removeIds(_destroyScratch);
+    }
+    _deadEntities.insert(_deadEntities.end(), _destroyScratch.begin(), _destroyScratch.end());
+}
+
 Pool_storage& Registry::getComponentPools() {
     return _pools;
 }
@@ -1,28 +1,120 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <span>
 #include <tuple>
-#include <typeindex>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 #include <typeinfo>
 #include <stdexcept>
 #include <iostream>
 #include <string>
+#include <utility>
 
 #include "../Utils/sparse_set/SparseSet.hpp"
+#include "../Utils/sparse_set/SoaSparseSet.hpp"
+#include "../Utils/ComponentId/ComponentId.hpp"
 #include "../EcsType.hpp"
 
 std::string& GetDebugCurrentSystem();
 
-using Pool_storage = std::unordered_map<std::type_index, std::unique_ptr<ISparseSet>>;
+// Indexed by componentId<Component>(), null for the types this registry never used
+using Pool_storage = std::vector<std::unique_ptr<ISparseSet>>;
+
+// Pool of a component type, field by field for the components opting in with soa_layout
+template <typename Component>
+using Pool_type = std::conditional_t<soa_layout<Component>::enabled, SoaSparseSet<Component>, SparseSet<Component>>;
+
+/**
+ * @brief Write access to a component, returned by Registry::writeComponent.
+ *
+ * The component is flagged for replication when the guard is committed or
+ * destroyed, and only if it was modified. Trivially copyable components are
+ * compared byte by byte with their value when the guard was taken; the other
+ * ones are flagged as soon as they are written through the guard.
+ * Like a reference from getComponent, the guard must not outlive a change of
+ * the pool (adding or removing a component of the same type).
+ */
+template <typename Component>
+class ComponentWriteGuard {
+   public:
+    ComponentWriteGuard(SparseSet<Component>& pool, Entity entity)
+        : ComponentWriteGuard(pool, entity, pool.getDataFromId(entity)) {}
+
+    ComponentWriteGuard(SparseSet<Component>& pool, Entity entity, Component& component)
+        : _pool(&pool), _entity(entity), _component(&component) {
+        if constexpr (std::is_trivially_copyable_v<Component>) {
+            std::memcpy(_before, _component, sizeof(Component));
+        }
+    }
+
+    ComponentWriteGuard(const ComponentWriteGuard&) = delete;
+    ComponentWriteGuard& operator=(const ComponentWriteGuard&) = delete;
+
+    ComponentWriteGuard(ComponentWriteGuard&& other) noexcept
+        : _pool(std::exchange(other._pool, nullptr)),
+          _entity(other._entity),
+          _component(other._component),
+          _written(other._written) {
+        if constexpr (std::is_trivially_copyable_v<Component>) {
+            std::memcpy(_before, other._before, sizeof(Component));
+        }
+    }
+
+    ~ComponentWriteGuard() { commit(); }
+
+    /**
+        A function to read the component without flagging it
+        @return The function returns a const reference to the component
+    */
+    const Component& read() const { return *_component; }
+
+    Component& operator*() {
+        _written = true;
+        return *_component;
+    }
+
+    Component* operator->() {
+        _written = true;
+        return _component;
+    }
+
+    /**
+        A function to flag the component now if it changed. The guard can't be used after.
+    */
+    void commit() {
+        if (!_pool) {
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<Component>) {
+            if (_written && _pool->has(_entity) && std::memcmp(_before, _component, sizeof(Component)) != 0) {
+                _pool->markAsDirty(_entity);
+            }
+        } else {
+            if (_written) {
+                _pool->markAsDirty(_entity);
+            }
+        }
+        _pool = nullptr;
+    }
+
+   private:
+    SparseSet<Component>* _pool;
+    Entity _entity;
+    Component* _component;
+    bool _written = false;
+    alignas(Component) unsigned char _before[std::is_trivially_copyable_v<Component> ? sizeof(Component) : 1];
+};
 
 class Registry {
    private:
     Entity _nextId = 0;
     Pool_storage _pools;
     std::vector<Entity> _deadEntities;
+    std::vector<Entity> _destroyScratch;
 
    public:
     Registry() = default;
@@ -40,18 +132,30 @@ class Registry {
     */
     void destroyEntity(Entity id);
 
+    /**
+        A function to destroy many entities at once, each pool is visited a single time
+        for all of them instead of once per entity. An id given twice is destroyed once.
+        @param std::span<const Entity> ids
+    */
+    void destroyEntities(std::span<const Entity> ids);
+
     /**
         A function to get the component pool from the given type or create it if it doesn't exist
+        The components opting in with soa_layout get a SoaSparseSet, only read and written by value:
+        getComponent, writeComponent, getView and each are for the other ones.
         @return The pool of the corresponding type
     */
     template <typename Component>
-    SparseSet<Component>& getPool() {
-        std::type_index index(typeid(Component));
+    Pool_type<Component>& getPool() {
+        std::size_t index = componentId<Component>();
 
-        if (_pools.find(index) == _pools.end()) {
-            _pools[index] = std::make_unique<SparseSet<Component>>();
+        if (index >= _pools.size()) [[unlikely]] {
+            _pools.resize(index + 1);
         }
-        return *static_cast<SparseSet<Component>*>(_pools[index].get());
+        if (!_pools[index]) [[unlikely]] {
+            _pools[index] = std::make_unique<Pool_type<Component>>();
+        }
+        return *static_cast<Pool_type<Component>*>(_pools[index].get());
     }
 
     /**
@@ -82,7 +186,8 @@ class Registry {
 
     /**
         A function to get the reference from a component of an entity.
-        The function add a dirty flag on the component so it can be send
+        The function add a dirty flag on the component so it can be send, even if it is only read:
+        use getConstComponent to read and writeComponent when the write is conditional.
         @param Entity entity
         @return The function returns a reference to a component
     */
@@ -95,6 +200,29 @@ class Registry {
         return getPool<Component>().getDataFromId(entity);
     }
 
+    /**
+        A function to get write access to the component of an entity.
+        The component is flagged dirty only if it was really modified once the guard is released.
+        @param Entity entity
+        @return The function returns a guard giving access to the component
+    */
+    template <typename Component>
+    ComponentWriteGuard<Component> writeComponent(Entity entity) {
+        if (entity == static_cast<Entity>(-1)) {
+            throw std::out_of_range("Registry::writeComponent called with INVALID_ENTITY");
+        }
+        return ComponentWriteGuard<Component>(getPool<Component>(), entity);
+    }
+
+    /**
+        A function to flag a component as modified, after writing it through getView for example
+        @param Entity entity
+    */
+    template <typename Component>
+    void markDirty(Entity entity) {
+        getPool<Component>().markAsDirty(entity);
+    }
+
     /**
         A function to get the component of an entity
         @param Entity entity
@@ -139,6 +267,20 @@ class Registry {
         return std::tuple<SparseSet<Components>&...>(getPool<Components>()...);
     }
 
+    /**
+        A function to call fn(entity, components...) for every entity having all the given components.
+        The smallest pool drives the iteration and each component is looked up once per entity.
+        Components given as const are passed as const references and never flagged; the other ones are
+        flagged for replication like with writeComponent, when fn really modified them.
+        fn must not add or remove components of the given types, defer it after the loop.
+        @param Function fn callable as fn(Entity, Components&...)
+    */
+    template <typename... Components, typename Function>
+    void each(Function&& fn) {
+        static_assert(sizeof...(Components) > 0, "Registry::each needs at least one component type");
+        eachImpl<Components...>(fn, std::index_sequence_for<Components...>{});
+    }
+
     /**
         A function to get the entities from a component pool
     */
@@ -147,5 +289,56 @@ class Registry {
         return getPool<Component>().getIdList();
     }
 
+    /**
+        A function to get every pool, indexed by component id. Entries of unused types are null.
+        @return The pools of the registry
+    */
     Pool_storage& getComponentPools();
+
+   private:
+    template <typename... Components, typename Function, std::size_t... Index>
+    void eachImpl(Function& fn, std::index_sequence<Index...>) {
+        std::tuple<SparseSet<std::remove_const_t<Components>>*...> pools(
+            &getPool<std::remove_const_t<Components>>()...);
+        const std::vector<std::size_t>* candidates[] = {&std::get<Index>(pools)->getIdList()...};
+        const std::vector<std::size_t>* driver = candidates[0];
+
+        for (auto* ids : candidates) {
+            if (ids->size() < driver->size()) {
+                driver = ids;
+            }
+        }
+        for (std::size_t i = 0; i < driver->size(); ++i) {
+            Entity entity = static_cast<Entity>((*driver)[i]);
+            std::tuple<std::remove_const_t<Components>*...> data(std::get<Index>(pools)->tryGetDataFromId(entity)...);
+
+            if (((std::get<Index>(data) != nullptr) && ...)) {
+                std::tuple<EachAccess<Components>...> access(
+                    EachAccess<Components>(*std::get<Index>(pools), entity, *std::get<Index>(data))...);
+                fn(entity, std::get<Index>(access).get()...);
+            }
+        }
+    }
+
+    // Const components are handed as is, the others through a write guard
+    template <typename Component>
+    class EachAccess {
+       public:
+        EachAccess(SparseSet<std::remove_const_t<Component>>& pool, Entity entity, Component& component)
+            : _guard(pool, entity, component) {}
+        Component& get() { return *_guard; }
+
+       private:
+        ComponentWriteGuard<Component> _guard;
+    };
+
+    template <typename Component>
+    class EachAccess<const Component> {
+       public:
+        EachAccess(SparseSet<Component>&, Entity, const Component& component) : _component(component) {}
+        const Component& get() { return _component; }
+
+       private:
+        const Component& _component;
+    };
 };
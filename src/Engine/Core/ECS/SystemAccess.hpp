@@ -0,0 +1,101 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type
+** File description:
+** SystemAccess.hpp
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Registry/registry.hpp"
+
+/**
+ * @brief Components a system reads and writes, used by the SystemManager to
+ * run systems that don't conflict at the same time.
+ *
+ * A system that doesn't declare its access is exclusive: it runs alone, on the
+ * thread calling updateAll, after every system added before it. A declared
+ * system may run on any thread, so it must only touch the registry through the
+ * declared components (no entity creation or destruction, no callbacks) and
+ * must not use the window, the network or other shared engine state.
+ */
+class SystemAccess {
+   public:
+    static SystemAccess exclusive() { return SystemAccess(); }
+
+    template <typename... Components>
+    SystemAccess& reads() {
+        (add<Components>(_reads), ...);
+        _exclusive = false;
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& writes() {
+        (add<Components>(_writes), ...);
+        _exclusive = false;
+        return *this;
+    }
+
+    bool isExclusive() const { return _exclusive; }
+
+    /**
+        A function to know if two systems must keep their relative order
+        @param SystemAccess access of the other system
+        @return True if one writes a component the other one uses, or if one is exclusive
+    */
+    bool conflictsWith(const SystemAccess& other) const {
+        if (_exclusive || other._exclusive) {
+            return true;
+        }
+        return intersects(_writes, other._writes) || intersects(_writes, other._reads) ||
+               intersects(_reads, other._writes);
+    }
+
+    /**
+        A function to create the declared pools up front, pools must not be created while systems run in parallel
+        @param Registry registry
+    */
+    void createPools(Registry& registry) const {
+        for (const auto& entry : _reads) {
+            entry.create(registry);
+        }
+        for (const auto& entry : _writes) {
+            entry.create(registry);
+        }
+    }
+
+   private:
+    struct Entry {
+        std::size_t id;
+        void (*create)(Registry&);
+    };
+
+    template <typename Component>
+    static void createPool(Registry& registry) {
+        registry.getPool<Component>();
+    }
+
+    template <typename Component>
+    static void add(std::vector<Entry>& entries) {
+        entries.push_back({componentId<Component>(), &createPool<Component>});
+    }
+
+    static bool intersects(const std::vector<Entry>& a, const std::vector<Entry>& b) {
+        for (const auto& left : a) {
+            for (const auto& right : b) {
+                if (left.id == right.id) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    std::vector<Entry> _reads;
+    std::vector<Entry> _writes;
+    bool _exclusive = true;
+};
@@ -6,9 +6,163 @@
 */
 
 #include "SystemManager.hpp"
+#include <chrono>
+#include <vector>
+
+namespace {
+
+constexpr double TIMING_SMOOTHING = 0.1;
+
+}  // namespace
 
 void SystemManager::updateAll(system_context context) {
-    for (auto& system : _systems) {
-        system->update(_registry, context);
+    if (!_graphBuilt) {
+        buildGraph();
+    }
+    if (_hasParallelSystems && _pool && _pool->size() > 0) {
+        updateParallel(context);
+    } else {
+        updateSequential(context);
+    }
+    updateTimings();
+}
+
+void SystemManager::buildGraph() {
+    _nodes.clear();
+    _nodes.resize(_systems.size());
+    _hasParallelSystems = false;
+
+    for (std::size_t i = 0; i < _systems.size(); ++i) {
+        _nodes[i].access = _systems[i]->access();
+        if (!_nodes[i].access.isExclusive()) {
+            _hasParallelSystems = true;
+            _nodes[i].access.createPools(_registry);
+        }
+        // Conflicting systems keep their insertion order
+        for (std::size_t j = 0; j < i; ++j) {
+            if (_nodes[i].access.conflictsWith(_nodes[j].access)) {
+                _nodes[i].dependencies.push_back(j);
+                _nodes[j].dependents.push_back(i);
+            }
+        }
+    }
+    std::vector<std::atomic<std::size_t>>(_systems.size()).swap(_missingDependencies);
+    _durations.assign(_systems.size(), 0.0);
+    _graphBuilt = true;
+}
+
+void SystemManager::updateSequential(const system_context& context) {
+    for (std::size_t i = 0; i < _systems.size(); ++i) {
+        auto start = std::chrono::steady_clock::now();
+        _systems[i]->update(_registry, context);
+        _durations[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+void SystemManager::updateParallel(const system_context& context) {
+    _context = &context;
+    _error = nullptr;
+    _remaining.store(_systems.size());
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+        _missingDependencies[i].store(_nodes[i].dependencies.size());
+    }
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+        if (_nodes[i].dependencies.empty()) {
+            schedule(i);
+        }
+    }
+
+    // Run the exclusive systems here and help the pool while waiting for the others
+    while (_remaining.load() > 0) {
+        std::size_t index = 0;
+        bool has_main_task = false;
+        {
+            std::lock_guard<std::mutex> lock(_mainMutex);
+            if (!_mainQueue.empty()) {
+                index = _mainQueue.front();
+                _mainQueue.pop_front();
+                has_main_task = true;
+            }
+        }
+        if (has_main_task) {
+            runSystem(index);
+            continue;
+        }
+        if (_pool->runPendingTask()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_mainMutex);
+        _mainCv.wait(lock, [this] { return !_mainQueue.empty() || _remaining.load() == 0; });
+    }
+    _context = nullptr;
+
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+}
+
+void SystemManager::schedule(std::size_t index) {
+    if (_nodes[index].access.isExclusive()) {
+        {
+            std::lock_guard<std::mutex> lock(_mainMutex);
+            _mainQueue.push_back(index);
+        }
+        _mainCv.notify_one();
+        return;
+    }
+    _pool->submit([this, index] { runSystem(index); });
+}
+
+void SystemManager::runSystem(std::size_t index) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        _systems[index]->update(_registry, *_context);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(_mainMutex);
+        if (!_error) {
+            _error = std::current_exception();
+        }
+    }
+    _durations[index] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (auto dependent : _nodes[index].dependents) {
+        if (_missingDependencies[dependent].fetch_sub(1) == 1) {
+            schedule(dependent);
+        }
+    }
+    if (_remaining.fetch_sub(1) == 1) {
+        { std::lock_guard<std::mutex> lock(_mainMutex); }
+        _mainCv.notify_one();
+    }
+}
+
+void SystemManager::updateTimings() {
+    // Edges always go from an earlier system to a later one, insertion order is a topological order
+    std::vector<double> path(_systems.size(), 0.0);
+    std::vector<std::size_t> previous(_systems.size(), _systems.size());
+    std::size_t last = _systems.size();
+
+    _criticalPathMs = 0.0;
+    for (std::size_t i = 0; i < _systems.size(); ++i) {
+        double longest = 0.0;
+        for (auto dependency : _nodes[i].dependencies) {
+            if (path[dependency] > longest) {
+                longest = path[dependency];
+                previous[i] = dependency;
+            }
+        }
+        path[i] = longest + _durations[i];
+        if (path[i] >= _criticalPathMs) {
+            _criticalPathMs = path[i];
+            last = i;
+        }
+
+        auto& timing = _timings[i];
+        timing.last_ms = _durations[i];
+        timing.average_ms += (_durations[i] - timing.average_ms) * TIMING_SMOOTHING;
+        timing.on_critical_path = false;
+    }
+    for (std::size_t i = last; i < _systems.size(); i = previous[i]) {
+        _timings[i].on_critical_path = true;
     }
 }
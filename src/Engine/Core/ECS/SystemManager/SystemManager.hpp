@@ -1,18 +1,46 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
 #include <vector>
 #include <utility>
 
 #include "../ISystem.hpp"
+#include "../Utils/WorkStealingPool/WorkStealingPool.hpp"
 
+/**
+ * @brief Duration of a system during the last ticks.
+ */
+struct SystemTiming {
+    std::string name;
+    double last_ms = 0.0;
+    double average_ms = 0.0;        // exponential moving average over the last ticks
+    bool on_critical_path = false;  // part of the longest dependency chain of the last tick
+};
+
+/**
+ * @brief Runs the systems of a registry once per tick.
+ *
+ * Systems keep their insertion order whenever their declared accesses conflict
+ * (see SystemAccess); the other ones run at the same time on a work-stealing
+ * pool. Exclusive systems always run on the thread calling updateAll.
+ */
 class SystemManager {
    public:
-    explicit SystemManager(Registry& registry) : _registry(registry) {}
+    explicit SystemManager(Registry& registry) : _registry(registry), _pool(&WorkStealingPool::shared()) {}
 
     template <typename T, typename... Args>
     void addSystem(Args&&... args) {
         _systems.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+        _timings.push_back({typeid(T).name()});
+        _graphBuilt = false;
     }
 
     template <typename T>
@@ -28,7 +56,56 @@ class SystemManager {
 
     void updateAll(system_context context);
 
+    /**
+        A function to choose the pool running the parallel systems
+        @param WorkStealingPool pool, nullptr to run every system on the calling thread
+    */
+    void setWorkerPool(WorkStealingPool* pool) { _pool = pool; }
+
+    /**
+        A function to get the duration of every system, in insertion order
+        @return The timings of the systems
+    */
+    const std::vector<SystemTiming>& getTimings() const { return _timings; }
+
+    /**
+        A function to get the duration of the longest dependency chain of the last tick
+        @return The duration in milliseconds, the tick can't be shorter whatever the number of cores
+    */
+    double getCriticalPathMs() const { return _criticalPathMs; }
+
    private:
+    struct Node {
+        SystemAccess access;
+        std::vector<std::size_t> dependencies;  // earlier systems in conflict with this one
+        std::vector<std::size_t> dependents;
+    };
+
+    void buildGraph();
+    void updateSequential(const system_context& context);
+    void updateParallel(const system_context& context);
+    void schedule(std::size_t index);
+    void runSystem(std::size_t index);
+    void updateTimings();
+
     Registry& _registry;
+    WorkStealingPool* _pool;
     std::vector<std::unique_ptr<ISystem>> _systems;
+
+    std::vector<Node> _nodes;
+    bool _graphBuilt = false;
+    bool _hasParallelSystems = false;
+
+    // State of the tick being run
+    const system_context* _context = nullptr;
+    std::vector<std::atomic<std::size_t>> _missingDependencies;
+    std::atomic<std::size_t> _remaining{0};
+    std::mutex _mainMutex;
+    std::condition_variable _mainCv;
+    std::deque<std::size_t> _mainQueue;
+    std::exception_ptr _error;
+
+    std::vector<double> _durations;
+    std::vector<SystemTiming> _timings;
+    double _criticalPathMs = 0.0;
 };
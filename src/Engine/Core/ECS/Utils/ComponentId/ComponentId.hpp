@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Dense index of a component type, used to find its pool in the registry.
+ *
+ * Ids are handed out on first use, starting at 0, so they stay small and can
+ * index a flat array. They are shared by every registry of the process.
+ */
+class ComponentIdCounter {
+   private:
+    static std::size_t next() {
+        static std::atomic<std::size_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename Component>
+    friend std::size_t componentId();
+};
+
+/**
+    A function to get the index of a component type
+    @return The id of the component type
+*/
+template <typename Component>
+std::size_t componentId() {
+    static const std::size_t id = ComponentIdCounter::next();
+    return id;
+}
@@ -1,9 +1,9 @@
 #include "Guid.hpp"
 
 uint32_t generateRandomGuid() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<uint32_t> dis;
+    // One generator per thread, lobby worlds create entities concurrently
+    thread_local std::mt19937 gen(std::random_device{}());
+    thread_local std::uniform_int_distribution<uint32_t> dis;
 
     return dis(gen);
 }
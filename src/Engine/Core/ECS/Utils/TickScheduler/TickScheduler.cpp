@@ -0,0 +1,85 @@
+#include "TickScheduler.hpp"
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr double TIMING_SMOOTHING = 0.1;
+
+// Sleeps usually end a little late, the last part of a wait is spent yielding
+constexpr auto SPIN_MARGIN = std::chrono::microseconds(200);
+
+}  // namespace
+
+TickScheduler::TickScheduler(uint32_t tick_rate, uint32_t max_catch_up) : _maxCatchUp(max_catch_up) {
+    if (_maxCatchUp == 0) {
+        throw std::invalid_argument("TickScheduler: the catch-up limit must allow at least one tick");
+    }
+    setTickRate(tick_rate);
+}
+
+void TickScheduler::setTickRate(uint32_t tick_rate) {
+    if (tick_rate == 0 || tick_rate > MAX_TICK_RATE) {
+        throw std::invalid_argument("TickScheduler: the tick rate must be between 1 and " +
+                                    std::to_string(MAX_TICK_RATE) + " Hz");
+    }
+    _tickRate = tick_rate;
+    _period = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000 / tick_rate));
+    reset();
+}
+
+void TickScheduler::reset(Clock::time_point now) {
+    _last = now;
+    _accumulator = Clock::duration::zero();
+}
+
+uint32_t TickScheduler::waitForTicks() {
+    while (true) {
+        uint32_t due = collectTicks(Clock::now());
+        if (due > 0) {
+            return due;
+        }
+
+        auto deadline = getNextDeadline();
+        if (deadline - Clock::now() > SPIN_MARGIN) {
+            std::this_thread::sleep_until(deadline - SPIN_MARGIN);
+        }
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t TickScheduler::collectTicks(Clock::time_point now) {
+    if (now > _last) {
+        _accumulator += now - _last;
+        _last = now;
+    }
+
+    auto due = static_cast<uint64_t>(_accumulator / _period);
+    if (due > _maxCatchUp) {
+        // Too late to catch up: skip the oldest ticks so the loop does not spiral
+        _stats.dropped_ticks += due - _maxCatchUp;
+        due = _maxCatchUp;
+    }
+    _accumulator -= _period * static_cast<Clock::rep>(due);
+    if (_accumulator >= _period) {
+        _accumulator %= _period;
+    }
+    return static_cast<uint32_t>(due);
+}
+
+void TickScheduler::recordTick(Clock::duration work) {
+    double work_ms = std::chrono::duration<double, std::milli>(work).count();
+
+    _stats.ticks++;
+    _stats.last_work_ms = work_ms;
+    _stats.average_work_ms += (work_ms - _stats.average_work_ms) * TIMING_SMOOTHING;
+    if (work_ms > _stats.max_work_ms) {
+        _stats.max_work_ms = work_ms;
+    }
+    if (work > _period) {
+        _stats.overruns++;
+    }
+}
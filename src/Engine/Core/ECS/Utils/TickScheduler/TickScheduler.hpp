@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Overrun statistics of a TickScheduler.
+ */
+struct TickStats {
+    uint64_t ticks = 0;          // ticks recorded since the start
+    uint64_t overruns = 0;       // ticks whose work took longer than one period
+    uint64_t dropped_ticks = 0;  // late ticks given up because of the catch-up limit
+    double last_work_ms = 0.0;
+    double average_work_ms = 0.0;  // exponential moving average over the last ticks
+    double max_work_ms = 0.0;
+};
+
+/**
+ * @brief Fixed-timestep clock of the simulation.
+ *
+ * Elapsed time is accumulated and consumed by whole ticks of 1 / rate second,
+ * so every tick advances the simulation by the same dt whatever the load. When
+ * the loop falls behind, at most max_catch_up ticks are run back to back and
+ * the rest is dropped instead of piling up. Waits go to the deadline of the
+ * next tick on steady_clock.
+ */
+class TickScheduler {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t DEFAULT_TICK_RATE = 60;
+    static constexpr uint32_t DEFAULT_MAX_CATCH_UP = 5;
+    static constexpr uint32_t MAX_TICK_RATE = 1000;
+
+    explicit TickScheduler(uint32_t tick_rate = DEFAULT_TICK_RATE, uint32_t max_catch_up = DEFAULT_MAX_CATCH_UP);
+
+    /**
+        A function to change the number of ticks per second, restarts the accumulator
+        @param uint32_t tick_rate, usually 30, 60 or 120
+        @throw std::invalid_argument if tick_rate is 0 or above MAX_TICK_RATE
+    */
+    void setTickRate(uint32_t tick_rate);
+    uint32_t getTickRate() const { return _tickRate; }
+
+    /**
+        A function to get the dt given to every tick
+        @return The duration of a tick in seconds
+    */
+    float getTickDt() const { return 1.0f / static_cast<float>(_tickRate); }
+    Clock::duration getPeriod() const { return _period; }
+
+    /**
+        A function to forget the time elapsed so far, the next tick is due one period after now
+        @param Clock::time_point now
+    */
+    void reset(Clock::time_point now = Clock::now());
+
+    /**
+        A function to wait until the deadline of the next tick
+        @return The number of ticks due, between 1 and the catch-up limit
+    */
+    uint32_t waitForTicks();
+
+    /**
+        A function to consume the ticks due at a given time, without waiting
+        @param Clock::time_point now, never earlier than the previous call
+        @return The number of ticks due, 0 if the next deadline is not reached
+    */
+    uint32_t collectTicks(Clock::time_point now);
+
+    /**
+        A function to get the time at which the next tick is due
+        @return The deadline
+    */
+    Clock::time_point getNextDeadline() const { return _last + (_period - _accumulator); }
+
+    /**
+        A function to record how long the work of one tick took
+        @param Clock::duration work
+    */
+    void recordTick(Clock::duration work);
+
+    const TickStats& getStats() const { return _stats; }
+
+   private:
+    uint32_t _tickRate;
+    uint32_t _maxCatchUp;
+    Clock::duration _period;
+    Clock::time_point _last;
+    Clock::duration _accumulator{0};
+    TickStats _stats;
+};
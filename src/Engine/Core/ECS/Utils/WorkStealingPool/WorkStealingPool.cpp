@@ -0,0 +1,115 @@
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Pool and queue of the worker running on this thread, if any
+thread_local const WorkStealingPool* t_pool = nullptr;
+thread_local std::size_t t_queue = 0;
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t workers) {
+    for (std::size_t i = 0; i < workers; ++i) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < workers; ++i) {
+        _workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _sleepCv.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    if (_queues.empty()) {
+        task();
+        return;
+    }
+
+    std::size_t index = t_queue;
+    if (t_pool != this) {
+        index = _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+    }
+    {
+        // Counted first, under the sleep mutex, so a worker going to sleep can't miss the task
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(std::move(task));
+    }
+    _sleepCv.notify_one();
+}
+
+bool WorkStealingPool::runPendingTask() {
+    Task task;
+
+    if (_queues.empty() || !steal(0, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index) {
+    t_pool = this;
+    t_queue = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index + 1, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCv.wait(lock, [this] { return _stopping || _pending.load(std::memory_order_relaxed) > 0; });
+        if (_stopping && _pending.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(std::size_t index, Task& task) {
+    std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+    auto& tasks = _queues[index]->tasks;
+
+    if (tasks.empty()) {
+        return false;
+    }
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    _pending.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t first, Task& task) {
+    for (std::size_t i = 0; i < _queues.size(); ++i) {
+        auto& queue = *_queues[(first + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            _pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+WorkStealingPool& WorkStealingPool::shared() {
+    static WorkStealingPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
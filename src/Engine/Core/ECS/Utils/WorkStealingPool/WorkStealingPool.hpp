@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread pool where every worker owns a task queue.
+ *
+ * A worker runs the tasks it submitted itself first (newest first, they touch
+ * the data it just used) and steals the oldest task of another worker when its
+ * own queue is empty. Threads outside the pool can help with runPendingTask.
+ */
+class WorkStealingPool {
+   public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(std::size_t workers);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+        A function to queue a task, on the queue of the calling worker if it belongs to the pool
+        @param Task task
+    */
+    void submit(Task task);
+
+    /**
+        A function to run one queued task on the calling thread
+        @return False if there was nothing to run
+    */
+    bool runPendingTask();
+
+    std::size_t size() const { return _workers.size(); }
+
+    /**
+        A function to get the pool shared by the whole process, one worker per spare core
+        @return The shared pool
+    */
+    static WorkStealingPool& shared();
+
+   private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool popLocal(std::size_t index, Task& task);
+    bool steal(std::size_t first, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCv;
+    std::atomic<std::size_t> _pending{0};
+    std::atomic<std::size_t> _nextQueue{0};
+    bool _stopping = false;
+};
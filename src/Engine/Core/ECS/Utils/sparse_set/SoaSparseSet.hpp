@@ -0,0 +1,235 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "SparseSet.hpp"
+
+/**
+ * @brief Opt-in field by field storage of a component.
+ *
+ * A trivially copyable component made of floats opts in by specializing this
+ * trait with enabled = true and the list of its members:
+ *
+ *     template <>
+ *     struct soa_layout<Body> {
+ *         static constexpr bool enabled = true;
+ *         static constexpr std::array fields{&Body::x, &Body::y};
+ *     };
+ *
+ * Registry::getPool then hands out a SoaSparseSet for it.
+ */
+template <typename Component>
+struct soa_layout {
+    static constexpr bool enabled = false;
+};
+
+/**
+ * @brief Pool keeping each field of its components in its own array.
+ *
+ * Same sparse and dense indexing as SparseSet, but the dense side is one
+ * contiguous float array per field (x[], y[], ...), so a system can run over a
+ * field with full SIMD registers. There is no component in memory to reference:
+ * components are read and written by value, or through field().
+ */
+template <typename data_type>
+class SoaSparseSet : public ISparseSet {
+    static_assert(std::is_trivially_copyable_v<data_type>, "SoaSparseSet only stores trivially copyable components");
+
+    static constexpr auto fields = soa_layout<data_type>::fields;
+    static constexpr std::size_t field_count = fields.size();
+
+    template <auto Member>
+    static constexpr std::size_t fieldIndex() {
+        for (std::size_t i = 0; i < field_count; ++i) {
+            if (fields[i] == Member)
+                return i;
+        }
+        throw std::logic_error("Member is not in the soa_layout of the component");
+    }
+
+   private:
+    std::vector<int> _sparse;
+    std::array<std::vector<float>, field_count> _fields;
+    std::vector<std::size_t> _reverse_dense;
+    std::vector<uint8_t> _dirty_dense;
+
+    void erase(std::size_t id);
+
+   public:
+    void addID(std::size_t id, const data_type& data);
+    void removeId(std::size_t id) override;
+    void removeIds(std::span<const Entity> ids) override;
+    bool has(std::size_t id) const override;
+    void markAsDirty(std::size_t id) override;
+    data_type getDataFromId(std::size_t id) const;
+    void setDataFromId(std::size_t id, const data_type& data);
+    std::vector<std::size_t>& getIdList() override;
+    std::vector<std::size_t> getUpdatedEntities() override;
+    ComponentPacket createPacket(uint32_t entity, SerializationContext& context) override;
+    void markAllUpdated() override;
+    void clearUpdatedEntities() override;
+    uint32_t getTypeHash() const override { return Hash::fnv1a(data_type::name); }
+
+    /**
+        A function to find where a component is in the field arrays
+        @param id entity
+        @return the index in the arrays, or -1 if the entity does not have the component
+    */
+    int indexOf(std::size_t id) const { return id < _sparse.size() ? _sparse[id] : -1; }
+
+    std::size_t size() const { return _reverse_dense.size(); }
+
+    /**
+        A function to get every value of a field, in the order of getIdList
+        Writing through it does not flag anything, call markAsDirty when it matters
+        @return the array of the member given as template argument
+    */
+    template <auto Member>
+    std::span<float> field() {
+        return _fields[fieldIndex<Member>()];
+    }
+};
+
+template <typename data_type>
+void SoaSparseSet<data_type>::addID(std::size_t id, const data_type& data) {
+    if (id >= MAX_ENTITIES) {
+        std::cerr << "[SoaSparseSet] Refusing to add component to entity id=" << id << " (MAX_ENTITIES=" << MAX_ENTITIES
+                  << ")" << std::endl;
+        return;
+    }
+    if (id >= _sparse.size()) {
+        _sparse.resize(id + 1, -1);
+    }
+    if (_sparse[id] != -1) {
+        setDataFromId(id, data);
+        return;
+    }
+    _sparse[id] = _reverse_dense.size();
+    for (std::size_t i = 0; i < field_count; ++i) {
+        _fields[i].push_back(data.*fields[i]);
+    }
+    _dirty_dense.push_back(true);
+    _reverse_dense.push_back(id);
+}
+
+template <typename data_type>
+void SoaSparseSet<data_type>::removeId(std::size_t id) {
+    if (!has(id)) {
+        std::cerr << "Error: removeId: " << id << " does not have any components from this type." << std::endl;
+        return;
+    }
+    erase(id);
+}
+
+template <typename data_type>
+void SoaSparseSet<data_type>::removeIds(std::span<const Entity> ids) {
+    for (Entity id : ids) {
+        if (has(id))
+            erase(id);
+    }
+}
+
+// Swap the last component into the hole, field by field, the id must be in the set
+template <typename data_type>
+void SoaSparseSet<data_type>::erase(std::size_t id) {
+    std::size_t indexToRemove = _sparse[id];
+    std::size_t lastIndex = _reverse_dense.size() - 1;
+    if (indexToRemove != lastIndex) {
+        std::size_t lastEntity = _reverse_dense[lastIndex];
+
+        for (auto& values : _fields) {
+            values[indexToRemove] = values[lastIndex];
+        }
+        _reverse_dense[indexToRemove] = lastEntity;
+        _sparse[lastEntity] = indexToRemove;
+        _dirty_dense[indexToRemove] = _dirty_dense[lastIndex];
+    }
+    _sparse[id] = -1;
+    for (auto& values : _fields) {
+        values.pop_back();
+    }
+    _dirty_dense.pop_back();
+    _reverse_dense.pop_back();
+}
+
+template <typename data_type>
+bool SoaSparseSet<data_type>::has(std::size_t id) const {
+    return indexOf(id) > -1;
+}
+
+template <typename data_type>
+data_type SoaSparseSet<data_type>::getDataFromId(std::size_t id) const {
+    if (!has(id)) {
+        throw std::runtime_error("Entity does not have component!");
+    }
+    data_type data{};
+    for (std::size_t i = 0; i < field_count; ++i) {
+        data.*fields[i] = _fields[i][_sparse[id]];
+    }
+    return data;
+}
+
+template <typename data_type>
+void SoaSparseSet<data_type>::setDataFromId(std::size_t id, const data_type& data) {
+    if (!has(id)) {
+        throw std::runtime_error("Entity does not have component!");
+    }
+    for (std::size_t i = 0; i < field_count; ++i) {
+        _fields[i][_sparse[id]] = data.*fields[i];
+    }
+    _dirty_dense[_sparse[id]] = true;
+}
+
+template <typename data_type>
+std::vector<std::size_t>& SoaSparseSet<data_type>::getIdList() {
+    return _reverse_dense;
+}
+
+template <typename data_type>
+void SoaSparseSet<data_type>::markAsDirty(std::size_t id) {
+    if (has(id)) {
+        _dirty_dense[_sparse[id]] = true;
+    }
+}
+
+template <typename data_type>
+std::vector<std::size_t> SoaSparseSet<data_type>::getUpdatedEntities() {
+    std::vector<std::size_t> updated_entities;
+
+    for (std::size_t i = 0; i < _dirty_dense.size(); ++i) {
+        if (_dirty_dense[i]) {
+            updated_entities.push_back(_reverse_dense[i]);
+            _dirty_dense[i] = false;
+        }
+    }
+    return updated_entities;
+}
+
+template <typename data_type>
+void SoaSparseSet<data_type>::markAllUpdated() {
+    for (std::size_t i = 0; i < _dirty_dense.size(); ++i) {
+        _dirty_dense[i] = true;
+    }
+}
+
+template <typename data_type>
+void SoaSparseSet<data_type>::clearUpdatedEntities() {
+    for (std::size_t i = 0; i < _dirty_dense.size(); ++i) {
+        _dirty_dense[i] = false;
+    }
+}
+
+// Field by field components are engine state, never replicated: the packet only names the type
+template <typename data_type>
+ComponentPacket SoaSparseSet<data_type>::createPacket(uint32_t entity, SerializationContext&) {
+    ComponentPacket packet;
+    packet.entity_guid = entity;
+    packet.component_type = getTypeHash();
+    return packet;
+}
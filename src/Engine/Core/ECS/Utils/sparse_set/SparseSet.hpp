@@ -2,6 +2,8 @@
 #include <iostream>
 #include <iterator>
 #include <ostream>
+#include <span>
+#include <utility>
 #include <vector>
 #include "ECS/EcsType.hpp"
 #include "Components/NetworkComponents.hpp"
@@ -16,6 +18,7 @@ class ISparseSet {
    public:
     virtual ~ISparseSet() = default;
     virtual void removeId(std::size_t Entity) = 0;
+    virtual void removeIds(std::span<const Entity> ids) = 0;  // skips the ids without this component
     virtual bool has(std::size_t Entity) const = 0;
     virtual void markAsDirty(std::size_t id) = 0;
     virtual std::vector<std::size_t> getUpdatedEntities() = 0;
@@ -32,15 +35,21 @@ class SparseSet : public ISparseSet {
     std::vector<int> _sparse;
     std::vector<data_type> _dense;
     std::vector<std::size_t> _reverse_dense;
-    std::vector<bool> _dirty_dense;
+    std::vector<uint8_t> _dirty_dense;
+    // Written since the last consumeChanges, apart from the replication flags which the network clears
+    std::vector<uint8_t> _changed_dense;
+
+    void erase(std::size_t id);
 
    public:
     void addID(std::size_t id, const data_type& data);
     void removeId(std::size_t id) override;
+    void removeIds(std::span<const Entity> ids) override;
     bool has(std::size_t id) const override;
     void markAsDirty(std::size_t id) override;
     data_type& getDataFromId(std::size_t id);
     const data_type& getConstDataFromId(std::size_t id);
+    data_type* tryGetDataFromId(std::size_t id);
     std::vector<data_type>& getDataList();
     std::vector<std::size_t>& getIdList();
     std::vector<std::size_t> getUpdatedEntities() override;
@@ -48,6 +57,21 @@ class SparseSet : public ISparseSet {
     void markAllUpdated() override;
     void clearUpdatedEntities() override;
     uint32_t getTypeHash() const override { return Hash::fnv1a(data_type::name); }
+
+    /**
+        A function to flag a component for replication without reporting it to consumeChanges,
+        for the system keeping a copy of the pool that writes its own results back
+        @param id entity
+    */
+    void markForReplication(std::size_t id);
+
+    /**
+        A function to call fn(id, component) for every component added or flagged since the last call.
+        There is one consumer per pool: PhysicsSystem, which follows the transforms and velocities.
+        @param Function fn callable as fn(std::size_t, const data_type&)
+    */
+    template <typename Function>
+    void consumeChanges(Function&& fn);
 };
 
 template <typename data_type>
@@ -65,11 +89,13 @@ void SparseSet<data_type>::addID(std::size_t id, const data_type& data) {
     if (_sparse[id] != -1) {
         _dense[_sparse[id]] = data;
         _dirty_dense[_sparse[id]] = true;
+        _changed_dense[_sparse[id]] = true;
         return;
     }
     _sparse[id] = _dense.size();
     _dense.push_back(data);
     _dirty_dense.push_back(true);
+    _changed_dense.push_back(true);
     _reverse_dense.push_back(id);
     return;
 }
@@ -80,23 +106,36 @@ void SparseSet<data_type>::removeId(std::size_t id) {
         std::cerr << "Error: removeId: " << id << " does not have any components from this type." << std::endl;
         return;
     }
+    erase(id);
+}
+
+template <typename data_type>
+void SparseSet<data_type>::removeIds(std::span<const Entity> ids) {
+    for (Entity id : ids) {
+        if (has(id))
+            erase(id);
+    }
+}
+
+// Swap the last component into the hole, the id must be in the set
+template <typename data_type>
+void SparseSet<data_type>::erase(std::size_t id) {
     std::size_t indexToRemove = _sparse[id];
     std::size_t lastIndex = _dense.size() - 1;
     if (indexToRemove != lastIndex) {
-        data_type lastData = _dense[lastIndex];
         std::size_t lastEntity = _reverse_dense[lastIndex];
 
-        _dense[indexToRemove] = lastData;
+        _dense[indexToRemove] = std::move(_dense[lastIndex]);
         _reverse_dense[indexToRemove] = lastEntity;
         _sparse[lastEntity] = indexToRemove;
         _dirty_dense[indexToRemove] = _dirty_dense[lastIndex];
+        _changed_dense[indexToRemove] = _changed_dense[lastIndex];
     }
     _sparse[id] = -1;
     _dense.pop_back();
     _dirty_dense.pop_back();
+    _changed_dense.pop_back();
     _reverse_dense.pop_back();
-
-    return;
 }
 
 template <typename data_type>
@@ -122,6 +161,13 @@ const data_type& SparseSet<data_type>::getConstDataFromId(std::size_t id) {
     return _dense[_sparse[id]];
 }
 
+template <typename data_type>
+data_type* SparseSet<data_type>::tryGetDataFromId(std::size_t id) {
+    if (id >= _sparse.size() || _sparse[id] < 0)
+        return nullptr;
+    return &_dense[_sparse[id]];
+}
+
 template <typename data_type>
 std::vector<data_type>& SparseSet<data_type>::getDataList() {
     return _dense;
@@ -134,11 +180,30 @@ std::vector<std::size_t>& SparseSet<data_type>::getIdList() {
 
 template <typename data_type>
 void SparseSet<data_type>::markAsDirty(std::size_t id) {
+    if (has(id)) {
+        _dirty_dense[_sparse[id]] = true;
+        _changed_dense[_sparse[id]] = true;
+    }
+}
+
+template <typename data_type>
+void SparseSet<data_type>::markForReplication(std::size_t id) {
     if (has(id)) {
         _dirty_dense[_sparse[id]] = true;
     }
 }
 
+template <typename data_type>
+template <typename Function>
+void SparseSet<data_type>::consumeChanges(Function&& fn) {
+    for (std::size_t i = 0; i < _changed_dense.size(); ++i) {
+        if (_changed_dense[i]) {
+            _changed_dense[i] = false;
+            fn(_reverse_dense[i], static_cast<const data_type&>(_dense[i]));
+        }
+    }
+}
+
 template <typename data_type>
 std::vector<std::size_t> SparseSet<data_type>::getUpdatedEntities() {
     std::vector<std::size_t> updated_entities;
@@ -190,6 +255,11 @@ ComponentPacket SparseSet<data_type>::createPacket(uint32_t entity, Serializatio
     if constexpr (std::is_same_v<data_type, sprite2D_component_s> || std::is_same_v<data_type, BackgroundComponent> ||
                   std::is_same_v<data_type, AnimatedSprite2D>) {
         serialize::serialize(packet.data, comp, context.textureManager);
+        if constexpr (std::is_same_v<data_type, AnimatedSprite2D>) {
+            if (context.animationSets)
+                context.animationSets->push_back(
+                    serialize::AnimationSetWire::key(*comp.animations, context.textureManager));
+        }
     } else {
         serialize::serialize(packet.data, comp);
     }
@@ -0,0 +1,65 @@
+#include "LobbyWorld.hpp"
+#include <utility>
+
+namespace engine {
+namespace core {
+
+LobbyWorld::LobbyWorld(uint32_t lobbyId, InputManager& input)
+    : _lobbyId(lobbyId),
+      _ecs(_textures, input),
+      _env(std::make_shared<Environment>(_ecs, _textures, _sounds, _musics, EnvMode::SERVER)) {
+    // Lobbies already run side by side, a lobby runs its own systems one after the other
+    _ecs.systems.setWorkerPool(nullptr);
+    _thread = std::thread(&LobbyWorld::threadLoop, this);
+}
+
+LobbyWorld::~LobbyWorld() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+}
+
+void LobbyWorld::step(const system_context& context) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _context.emplace(context);
+        _error = nullptr;
+    }
+    _cv.notify_all();
+}
+
+void LobbyWorld::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this] { return !_context.has_value(); });
+    if (_error) {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+void LobbyWorld::threadLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _cv.wait(lock, [this] { return _stopping || _context.has_value(); });
+        if (_stopping) {
+            return;
+        }
+
+        lock.unlock();
+        try {
+            _ecs.update(*_context);
+        } catch (...) {
+            _error = std::current_exception();
+        }
+        lock.lock();
+
+        _context.reset();
+        _cv.notify_all();
+    }
+}
+
+}  // namespace core
+}  // namespace engine
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "ECS/ECS.hpp"
+#include "ECS/Context.hpp"
+#include "../Lib/Environment/Environment.hpp"
+
+namespace engine {
+namespace core {
+
+/**
+ * @brief Game world of one lobby.
+ *
+ * Every lobby simulates its entities in its own registry, with its own systems
+ * and resources, so the systems never have to tell lobbies apart. The systems
+ * run on the thread of the world: step() starts a tick and wait() joins it.
+ * The server thread keeps the network and only touches the world between
+ * wait() and the next step().
+ */
+class LobbyWorld {
+   public:
+    using GameFunction = std::function<void(std::shared_ptr<Environment>, InputManager&)>;
+
+    LobbyWorld(uint32_t lobbyId, InputManager& input);
+    ~LobbyWorld();
+
+    LobbyWorld(const LobbyWorld&) = delete;
+    LobbyWorld& operator=(const LobbyWorld&) = delete;
+
+    /**
+        A function to start a tick of the systems on the thread of the world
+        @param system_context context of the tick, it must only hold clients of this lobby
+    */
+    void step(const system_context& context);
+
+    /**
+        A function to wait for the tick started by step, does nothing if none is running
+        Rethrows the error of a system, if any
+    */
+    void wait();
+
+    /**
+        A function to give the world the game logic the server thread runs before each of its ticks
+        The function may own game state of this lobby only, it is destroyed with the world
+        @param GameFunction loop
+    */
+    void setLoopFunction(GameFunction loop) { _loop = std::move(loop); }
+
+    /**
+        A function to run the game logic of the world, between wait() and the next step()
+        @param InputManager& input shared by every lobby
+    */
+    void runLoopFunction(InputManager& input) {
+        if (_loop) {
+            _loop(_env, input);
+        }
+    }
+
+    uint32_t getLobbyId() const { return _lobbyId; }
+    ECS& getECS() { return _ecs; }
+    std::shared_ptr<Environment> getEnvironment() { return _env; }
+    ResourceManager<TextureAsset>& getTextureManager() { return _textures; }
+    ResourceManager<SoundAsset>& getSoundManager() { return _sounds; }
+    ResourceManager<MusicAsset>& getMusicManager() { return _musics; }
+
+   private:
+    void threadLoop();
+
+    uint32_t _lobbyId;
+    ResourceManager<TextureAsset> _textures;
+    ResourceManager<SoundAsset> _sounds;
+    ResourceManager<MusicAsset> _musics;
+    ECS _ecs;
+    std::shared_ptr<Environment> _env;
+    GameFunction _loop;  // destroyed before the ECS it plays in
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::optional<system_context> _context;  // set while a tick is running
+    std::exception_ptr _error;
+    bool _stopping = false;
+    std::thread _thread;  // started last, once everything it uses exists
+};
+
+}  // namespace core
+}  // namespace engine
@@ -0,0 +1,28 @@
+#include "AnimationSets.hpp"
+#include <mutex>
+#include "Context.hpp"
+#include "Components/serialize/StandardComponents_serialize.hpp"
+
+namespace engine {
+namespace core {
+
+void ServerAnimationSets::send(network::Server& server, uint32_t client_id, std::span<const uint64_t> keys) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& sent = _sent[client_id];
+
+    for (uint64_t key : keys) {
+        if (sent.contains(key) || !serialize::AnimationSetWire::definition(key, _packet.data)) {
+            continue;
+        }
+        server.AddMessageToPlayer(network::GameEvents::S_ANIMATION_SET, client_id, _packet);
+        sent.insert(key);
+    }
+}
+
+void ServerAnimationSets::removeClient(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sent.erase(client_id);
+}
+
+}  // namespace core
+}  // namespace engine
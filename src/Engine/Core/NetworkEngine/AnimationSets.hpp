@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include "../../../Network/Server/Server.hpp"
+#include "../../Lib/Components/NetworkComponents.hpp"
+
+namespace engine {
+namespace core {
+
+/**
+ * @brief Server side of AnimationSet replication.
+ *
+ * Component records carry the key of their set only. Every client is sent the
+ * definition of a key once (S_ANIMATION_SET), over TCP and ahead of the records
+ * that use it, so it is in when they are read. Lobby worlds send at the same
+ * time, every call is guarded.
+ */
+class ServerAnimationSets {
+   public:
+    /**
+        Send a client the definitions it was not sent yet
+        @param network::Server server
+        @param uint32_t client id
+        @param std::span<const uint64_t> keys of the sets the next records of the client use
+    */
+    void send(network::Server& server, uint32_t client_id, std::span<const uint64_t> keys);
+
+    void removeClient(uint32_t client_id);
+
+   private:
+    std::mutex _mutex;
+    std::unordered_map<uint32_t, std::unordered_set<uint64_t>> _sent;
+    network::AnimationSetPacket _packet;
+};
+
+}  // namespace core
+}  // namespace engine
@@ -0,0 +1,248 @@
+#include "FullState.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace engine {
+namespace core {
+
+namespace {
+
+constexpr std::size_t LZ77_MIN_MATCH = 4;
+constexpr std::size_t LZ77_MAX_OFFSET = 0xFFFF;
+constexpr unsigned LZ77_HASH_BITS = 12;
+
+uint32_t hashSequence(const uint8_t* data) {
+    uint32_t sequence;
+    std::memcpy(&sequence, data, sizeof(sequence));
+    return (sequence * 2654435761u) >> (32 - LZ77_HASH_BITS);
+}
+
+// Lengths past the 15 a token nibble holds continue in bytes, 255 meaning more follows
+void writeLength(std::vector<uint8_t>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+bool readLength(const uint8_t* data, std::size_t size, std::size_t& pos, std::size_t& length) {
+    uint8_t byte;
+    do {
+        if (pos >= size) {
+            return false;
+        }
+        byte = data[pos++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, std::size_t literal_length,
+                   std::size_t offset, std::size_t match_length) {
+    std::size_t match_code = match_length >= LZ77_MIN_MATCH ? match_length - LZ77_MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<std::size_t>(literal_length, 15) << 4) |
+                                         std::min<std::size_t>(match_code, 15));
+
+    out.push_back(token);
+    if (literal_length >= 15) {
+        writeLength(out, literal_length - 15);
+    }
+    out.insert(out.end(), literals, literals + literal_length);
+    if (match_length == 0) {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match_code >= 15) {
+        writeLength(out, match_code - 15);
+    }
+}
+
+template <typename DataType>
+void append(std::vector<uint8_t>& out, const DataType& value) {
+    std::size_t offset = out.size();
+    out.resize(offset + sizeof(DataType));
+    std::memcpy(out.data() + offset, &value, sizeof(DataType));
+}
+
+}  // namespace
+
+void compressLz77(const uint8_t* data, std::size_t size, std::vector<uint8_t>& out) {
+    // Last position + 1 each 4 byte sequence was seen at, 0 when never seen
+    std::array<uint32_t, 1u << LZ77_HASH_BITS> table{};
+    std::size_t anchor = 0;
+    std::size_t pos = 0;
+
+    out.clear();
+    out.reserve(size + size / 255 + 16);
+    while (pos + LZ77_MIN_MATCH <= size) {
+        uint32_t hash = hashSequence(data + pos);
+        std::size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > LZ77_MAX_OFFSET ||
+            std::memcmp(data + candidate - 1, data + pos, LZ77_MIN_MATCH) != 0) {
+            pos++;
+            continue;
+        }
+        std::size_t match = candidate - 1;
+        std::size_t length = LZ77_MIN_MATCH;
+        while (pos + length < size && data[match + length] == data[pos + length]) {
+            length++;
+        }
+        writeSequence(out, data + anchor, pos - anchor, pos - match, length);
+        pos += length;
+        anchor = pos;
+    }
+    writeSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+bool decompressLz77(const uint8_t* data, std::size_t size, std::size_t raw_size, std::vector<uint8_t>& out) {
+    std::size_t pos = 0;
+    bool ended = false;
+
+    out.clear();
+    out.reserve(raw_size);
+    while (pos < size) {
+        uint8_t token = data[pos++];
+        std::size_t literal_length = token >> 4;
+
+        if (literal_length == 15 && !readLength(data, size, pos, literal_length)) {
+            return false;
+        }
+        if (literal_length > size - pos || literal_length > raw_size - out.size()) {
+            return false;
+        }
+        out.insert(out.end(), data + pos, data + pos + literal_length);
+        pos += literal_length;
+        if (pos == size) {
+            ended = true;
+            break;
+        }
+
+        if (size - pos < 2) {
+            return false;
+        }
+        std::size_t offset = data[pos] | (static_cast<std::size_t>(data[pos + 1]) << 8);
+        std::size_t match_length = token & 0x0F;
+        pos += 2;
+        if (match_length == 15 && !readLength(data, size, pos, match_length)) {
+            return false;
+        }
+        match_length += LZ77_MIN_MATCH;
+        if (offset == 0 || offset > out.size() || match_length > raw_size - out.size()) {
+            return false;
+        }
+        // The match may overlap what it writes, so it is copied byte by byte
+        std::size_t from = out.size() - offset;
+        std::size_t start = out.size();
+        out.resize(start + match_length);
+        for (std::size_t idx = 0; idx < match_length; ++idx) {
+            out[start + idx] = out[from + idx];
+        }
+    }
+    // The last sequence is literals only, a stream ending on a match was cut
+    return ended && out.size() == raw_size;
+}
+
+void FullStateWriter::begin(uint32_t sequence) {
+    _sequence = sequence;
+    _count = 0;
+    _sent = 0;
+    _acked = 0;
+    _finished = false;
+    _raw.assign(sizeof(_count), 0);
+    _compressed.clear();
+}
+
+void FullStateWriter::add(const ComponentPacket& packet) {
+    append(_raw, packet.entity_guid);
+    append(_raw, packet.component_type);
+    append(_raw, packet.owner_id);
+    append(_raw, static_cast<uint32_t>(packet.data.size()));
+    _raw.insert(_raw.end(), packet.data.begin(), packet.data.end());
+    _count++;
+}
+
+void FullStateWriter::finish() {
+    std::memcpy(_raw.data(), &_count, sizeof(_count));
+    compressLz77(_raw.data(), _raw.size(), _compressed);
+    _finished = true;
+}
+
+bool FullStateWriter::nextChunk(network::FullStateChunkPacket& chunk) {
+    // Never empty once finished: even a world without records holds its count
+    if (!_finished || _sent == _compressed.size() || _sent - _acked >= FULL_STATE_WINDOW) {
+        return false;
+    }
+    std::size_t size = std::min<std::size_t>(network::FULL_STATE_CHUNK_SIZE, _compressed.size() - _sent);
+
+    chunk.sequence = _sequence;
+    chunk.raw_size = static_cast<uint32_t>(_raw.size());
+    chunk.total_size = static_cast<uint32_t>(_compressed.size());
+    chunk.offset = _sent;
+    chunk.data.assign(_compressed.begin() + _sent, _compressed.begin() + _sent + size);
+    _sent += static_cast<uint32_t>(size);
+    return true;
+}
+
+void FullStateWriter::acknowledge(uint32_t received) {
+    // Never past what was sent, a late ack of a previous world only opens the window a bit early
+    if (received > _acked && received <= _sent) {
+        _acked = received;
+    }
+}
+
+FullStateReader::Result FullStateReader::feed(const network::FullStateChunkPacket& chunk) {
+    if (chunk.offset == 0) {
+        if (chunk.raw_size > network::MAX_FULL_STATE_SIZE || chunk.total_size > network::MAX_FULL_STATE_SIZE) {
+            _active = false;
+            _dropped = true;
+            return Result::MALFORMED;
+        }
+        _active = true;
+        _dropped = false;
+        _sequence = chunk.sequence;
+        _raw_size = chunk.raw_size;
+        _total_size = chunk.total_size;
+        _compressed.clear();
+        _compressed.reserve(_total_size);
+        _destroyed.clear();
+    } else if (_dropped) {
+        return Result::IGNORED;
+    }
+
+    bool follows = _active && chunk.sequence == _sequence && chunk.raw_size == _raw_size &&
+                   chunk.total_size == _total_size && chunk.offset == _compressed.size();
+    if (!follows || chunk.data.size() > _total_size - _compressed.size()) {
+        _active = false;
+        _dropped = true;
+        _compressed.clear();
+        return Result::MALFORMED;
+    }
+    _compressed.insert(_compressed.end(), chunk.data.begin(), chunk.data.end());
+    if (_compressed.size() < _total_size) {
+        return Result::PENDING;
+    }
+
+    _active = false;
+    if (!decompressLz77(_compressed.data(), _compressed.size(), _raw_size, _raw)) {
+        _raw.clear();
+        _dropped = true;
+        return Result::MALFORMED;
+    }
+    return Result::COMPLETE;
+}
+
+void FullStateReader::forget(uint32_t entity_guid) {
+    if (_active) {
+        _destroyed.insert(entity_guid);
+    }
+}
+
+}  // namespace core
+}  // namespace engine
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+#include "../../Lib/Components/NetworkComponents.hpp"
+
+namespace engine {
+namespace core {
+
+// Compressed bytes a client may have in flight before acknowledging, a join cannot flood its connection
+static constexpr uint32_t FULL_STATE_WINDOW = 4 * network::FULL_STATE_CHUNK_SIZE;
+
+/**
+    Compress bytes with a small LZ77 (LZ4 block layout): sequences of
+    [token][literal length][literals][uint16 offset][match length], the last one literals only.
+    @param uint8_t* bytes to compress
+    @param std::size_t number of bytes
+    @param std::vector<uint8_t> output compressed bytes
+*/
+void compressLz77(const uint8_t* data, std::size_t size, std::vector<uint8_t>& out);
+
+/**
+    Rebuild bytes compressed by compressLz77
+    @param uint8_t* compressed bytes
+    @param std::size_t number of compressed bytes
+    @param std::size_t size of the original bytes
+    @param std::vector<uint8_t> output bytes
+    @return false if the input is malformed or does not rebuild raw_size bytes
+*/
+bool decompressLz77(const uint8_t* data, std::size_t size, std::size_t raw_size, std::vector<uint8_t>& out);
+
+/**
+ * @brief Server side of a full state: the world of a lobby for one joining client.
+ *
+ * Every networked component goes into one buffer, [uint32 count] then
+ * [uint32 entity_guid][uint32 component_type][uint32 owner_id][uint32 size][data]
+ * per record. The buffer is compressed once and cut into S_FULL_STATE_CHUNK
+ * packets, at most FULL_STATE_WINDOW bytes ahead of what the client acknowledged.
+ */
+class FullStateWriter {
+   public:
+    /**
+        Start a new world, dropping whatever was left of the previous one
+        @param uint32_t sequence the next S_SNAPSHOT_BATCH of this client will get
+    */
+    void begin(uint32_t sequence);
+
+    void add(const ComponentPacket& packet);
+
+    // Compress the world, chunks can be taken afterwards
+    void finish();
+
+    /**
+        Fill the next chunk, if the client has room for it
+        @param FullStateChunkPacket output chunk
+        @return false once everything was sent or the window is full
+    */
+    bool nextChunk(network::FullStateChunkPacket& chunk);
+
+    /**
+        @param uint32_t bytes of the compressed world the client has
+    */
+    void acknowledge(uint32_t received);
+
+    // The client has the whole world
+    bool done() const { return _finished && _acked == _compressed.size(); }
+
+    std::size_t rawSize() const { return _raw.size(); }
+    std::size_t compressedSize() const { return _compressed.size(); }
+
+   private:
+    uint32_t _sequence = 0;
+    uint32_t _count = 0;
+    uint32_t _sent = 0;
+    uint32_t _acked = 0;
+    bool _finished = false;
+    std::vector<uint8_t> _raw;
+    std::vector<uint8_t> _compressed;
+};
+
+/**
+ * @brief Client side of a full state: puts the chunks back together.
+ */
+class FullStateReader {
+   public:
+    enum class Result {
+        PENDING,    // more chunks are needed
+        COMPLETE,   // the world can be read
+        MALFORMED,  // the stream was dropped, it restarts with the next chunk at offset 0
+        IGNORED,    // a chunk of a dropped stream that was still in flight
+    };
+
+    Result feed(const network::FullStateChunkPacket& chunk);
+
+    // A world is being received
+    bool assembling() const { return _active; }
+
+    /**
+        An entity was destroyed while the world is being received: the world was captured before,
+        its records for the entity are skipped once it is complete
+        @param uint32_t entity_guid of the destroyed entity
+    */
+    void forget(uint32_t entity_guid);
+
+    // Bytes of the compressed world received so far, what C_FULL_STATE_ACK carries
+    uint32_t received() const { return static_cast<uint32_t>(_compressed.size()); }
+
+    // First S_SNAPSHOT_BATCH sequence newer than the world
+    uint32_t sequence() const { return _sequence; }
+
+    /**
+        Walk every record of the last complete world in a single pass
+        @param ComponentPacket scratch packet refilled for each record, so its buffer is reused
+        @param callback called with the scratch packet for each record
+        @return false if the world is malformed, records before the error were still delivered
+    */
+    template <typename Callback>
+    bool read(ComponentPacket& packet, Callback&& callback) const {
+        const uint8_t* cursor = _raw.data();
+        const uint8_t* end = cursor + _raw.size();
+        uint32_t count = 0;
+
+        if (_raw.size() < sizeof(count)) {
+            return false;
+        }
+        std::memcpy(&count, cursor, sizeof(count));
+        cursor += sizeof(count);
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            uint32_t size = 0;
+
+            if (static_cast<std::size_t>(end - cursor) < 4 * sizeof(uint32_t)) {
+                return false;
+            }
+            std::memcpy(&packet.entity_guid, cursor, sizeof(uint32_t));
+            std::memcpy(&packet.component_type, cursor + sizeof(uint32_t), sizeof(uint32_t));
+            std::memcpy(&packet.owner_id, cursor + 2 * sizeof(uint32_t), sizeof(uint32_t));
+            std::memcpy(&size, cursor + 3 * sizeof(uint32_t), sizeof(uint32_t));
+            cursor += 4 * sizeof(uint32_t);
+            if (static_cast<std::size_t>(end - cursor) < size) {
+                return false;
+            }
+            packet.data.assign(cursor, cursor + size);
+            cursor += size;
+            if (!_destroyed.count(packet.entity_guid)) {
+                callback(packet);
+            }
+        }
+        return cursor == end;
+    }
+
+   private:
+    bool _active = false;
+    bool _dropped = false;
+    uint32_t _sequence = 0;
+    uint32_t _raw_size = 0;
+    uint32_t _total_size = 0;
+    std::vector<uint8_t> _compressed;
+    std::vector<uint8_t> _raw;
+    std::unordered_set<uint32_t> _destroyed;
+};
+
+}  // namespace core
+}  // namespace engine
@@ -14,6 +14,8 @@ NetworkEngine::NetworkEngine(NetworkRole role, std::string host, uint16_t port,
     if (role == NetworkRole::SERVER) {
         _networkInstance = std::make_shared<network::Server>(port, timeout);
         std::get<std::shared_ptr<network::Server>>(_networkInstance)->Start();
+        // Snapshots leave once per tick, from flushUdp
+        std::get<std::shared_ptr<network::Server>>(_networkInstance)->SetUdpAutoFlush(false);
     } else {
         _networkInstance = std::make_shared<network::Client>(host, port);
     }
@@ -23,6 +25,8 @@ bool NetworkEngine::isUdpEvent(EventType type) {
     switch (type) {
         case network::GameEvents::C_INPUT:
         case network::GameEvents::S_SNAPSHOT:
+        case network::GameEvents::S_SNAPSHOT_BATCH:
+        case network::GameEvents::C_SNAPSHOT_ACK:
         case network::GameEvents::C_VOICE_PACKET:
         case network::GameEvents::S_VOICE_RELAY:
             return true;
@@ -35,6 +39,7 @@ void NetworkEngine::processIncomingPackets(uint32_t tick) {
     if (std::holds_alternative<std::shared_ptr<network::Server>>(_networkInstance)) {
         auto server = std::get<std::shared_ptr<network::Server>>(_networkInstance);
         server->Update(-1, false);
+        server->PollDatabase();
     }
 
     while (true) {
@@ -63,15 +68,13 @@ void NetworkEngine::processIncomingPackets(uint32_t tick) {
             uint32_t sequence_guid = user_guid;
 
             if (msg.id == network::GameEvents::S_SNAPSHOT) {
-                auto temp_msg = msg.msg;
-                ComponentPacket temp_packet;
-                temp_msg >> temp_packet;
-                sequence_guid = temp_packet.entity_guid;
+                // The entity guid is the last value pushed, no need to copy the message to peek at it
+                network::MessageReader<network::GameEvents> reader(msg.msg);
+                reader >> sequence_guid;
 
-                if (_lastPacketTickMap.count(sequence_guid) && packetTick < _lastPacketTickMap[sequence_guid]) {
+                if (isSnapshotOutdated(sequence_guid, packetTick)) {
                     continue;
                 }
-                _lastPacketTickMap[sequence_guid] = packetTick;
             }
             _processedEvents[msg.id].push_back(msg.msg);
 
@@ -81,6 +84,15 @@ void NetworkEngine::processIncomingPackets(uint32_t tick) {
     }
 }
 
+bool NetworkEngine::isSnapshotOutdated(uint32_t entity_guid, uint32_t tick) {
+    auto it = _lastPacketTickMap.find(entity_guid);
+    if (it != _lastPacketTickMap.end() && tick < it->second) {
+        return true;
+    }
+    _lastPacketTickMap[entity_guid] = tick;
+    return false;
+}
+
 std::map<NetworkEngine::EventType, std::vector<network::message<NetworkEngine::EventType>>>
 NetworkEngine::getPendingEvents() {
     auto events = _processedEvents;
@@ -88,6 +100,14 @@ NetworkEngine::getPendingEvents() {
     return events;
 }
 
+void NetworkEngine::flushUdp() {
+    if (std::holds_alternative<std::shared_ptr<network::Server>>(_networkInstance)) {
+        std::get<std::shared_ptr<network::Server>>(_networkInstance)->FlushUdp();
+    } else {
+        std::get<std::shared_ptr<network::Client>>(_networkInstance)->FlushUdp();
+    }
+}
+
 void NetworkEngine::setTimeout(int timeout) {
     if (std::holds_alternative<std::shared_ptr<network::Server>>(_networkInstance)) {
         auto server = std::get<std::shared_ptr<network::Server>>(_networkInstance);
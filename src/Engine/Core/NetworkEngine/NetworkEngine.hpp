@@ -10,6 +10,8 @@
 #include "../../../Network/Network.hpp"
 #include "../../../Network/Server/Server.hpp"
 #include "../../../Network/Client/Client.hpp"
+#include "AnimationSets.hpp"
+#include "SnapshotBaselines.hpp"
 
 namespace engine {
 namespace core {
@@ -26,18 +28,20 @@ class NetworkEngine {
     template <typename Data>
     bool transmitEvent(EventType type, const Data& data, uint32_t tick, uint32_t targetId = 0) {
         try {
-            network::message<network::GameEvents> msg;
-            msg.header.id = type;
-            msg.header.tick = tick;
-            msg << data;
-            msg.header.size = msg.body.size();
+            // The packet is built in a pooled body, which the connection takes over
+            auto build = [&](network::message<network::GameEvents> msg) {
+                msg.header.id = type;
+                msg.header.tick = tick;
+                network::MessageWriter<network::GameEvents>(msg, sizeof(Data)) << data;
+                return msg;
+            };
 
             if (std::holds_alternative<std::shared_ptr<network::Server>>(_networkInstance)) {
                 auto server = std::get<std::shared_ptr<network::Server>>(_networkInstance);
-                server->AddMessageToPlayer(type, targetId, msg);
+                server->AddMessageToPlayer(type, targetId, build(server->AcquireMessage(sizeof(Data))));
             } else {
                 auto client = std::get<std::shared_ptr<network::Client>>(_networkInstance);
-                client->AddMessageToServer(type, msg);
+                client->AddMessageToServer(type, build(client->AcquireMessage(sizeof(Data))));
             }
         } catch (const std::exception& e) {
             std::cerr << "Error transmitting event: " << e.what() << std::endl;
@@ -48,6 +52,8 @@ class NetworkEngine {
 
     void setTimeout(int timeout);
     void processIncomingPackets(uint32_t tick);
+    // Sends the datagrams queued during the tick together
+    void flushUdp();
     std::map<EventType, std::vector<network::message<EventType>>> getPendingEvents();
     uint32_t getClientId() const;
 
@@ -55,14 +61,23 @@ class NetworkEngine {
         return _networkInstance;
     }
 
+    ServerSnapshotBaselines& getSentSnapshots() { return _sentSnapshots; }
+    ClientSnapshotBaselines& getReceivedSnapshots() { return _receivedSnapshots; }
+    ServerAnimationSets& getSentAnimationSets() { return _sentAnimationSets; }
+
    private:
     NetworkRole _role;
     std::variant<std::shared_ptr<network::Server>, std::shared_ptr<network::Client>> _networkInstance;
 
     std::map<uint32_t, uint32_t> _lastPacketTickMap;
     std::map<EventType, std::vector<network::message<EventType>>> _processedEvents;
+    ServerSnapshotBaselines _sentSnapshots;
+    ClientSnapshotBaselines _receivedSnapshots;
+    ServerAnimationSets _sentAnimationSets;
 
     bool isUdpEvent(EventType type);
+    // Records the tick of an entity update, returns true if a newer one was already received
+    bool isSnapshotOutdated(uint32_t entity_guid, uint32_t tick);
 };
 
 }  // namespace core
@@ -0,0 +1,187 @@
+#include "SnapshotBaselines.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace engine {
+namespace core {
+
+namespace {
+
+uint64_t makeKey(uint32_t entity_guid, uint32_t component_type) {
+    return (static_cast<uint64_t>(entity_guid) << 32) | component_type;
+}
+
+}  // namespace
+
+void ServerSnapshotBaselines::begin(uint32_t client_id, network::SnapshotBatchWriter& writer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& client = _clients[client_id];
+
+    if (client.next_sequence - client.last_prune >= 4 * SNAPSHOT_BASELINE_WINDOW) {
+        prune(client);
+    }
+    writer.reset(client.next_sequence);
+}
+
+void ServerSnapshotBaselines::write(uint32_t client_id, const ComponentPacket& packet,
+                                    network::SnapshotBatchWriter& writer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& client = _clients[client_id];
+    uint64_t key = makeKey(packet.entity_guid, packet.component_type);
+    auto& baseline = client.baselines[key];
+    bool usable = baseline.acked != 0 && writer.nextSequence() - baseline.acked < SNAPSHOT_BASELINE_WINDOW;
+    uint32_t sequence;
+
+    // The client has this exact value and nothing newer is in flight
+    if (usable && baseline.last_sent == baseline.acked && baseline.data == packet.data) {
+        return;
+    }
+    if (usable && network::encodeSnapshotDelta(baseline.data, packet.data, _delta)) {
+        sequence = writer.addDelta(packet, baseline.acked, _delta);
+    } else {
+        sequence = writer.add(packet);
+    }
+    baseline.last_sent = sequence;
+
+    auto& sent = client.sent[sequence % SNAPSHOT_BASELINE_WINDOW];
+    if (sent.sequence != sequence) {
+        sent.sequence = sequence;
+        sent.acked = false;
+        sent.records.clear();
+    }
+    sent.records.emplace_back(key, packet.data);
+}
+
+void ServerSnapshotBaselines::end(uint32_t client_id, const network::SnapshotBatchWriter& writer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _clients[client_id].next_sequence = writer.nextSequence();
+}
+
+void ServerSnapshotBaselines::acknowledge(uint32_t client_id, uint32_t sequence) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _clients.find(client_id);
+    if (it == _clients.end()) {
+        return;
+    }
+    auto& client = it->second;
+    auto& sent = client.sent[sequence % SNAPSHOT_BASELINE_WINDOW];
+
+    if (sent.sequence != sequence || sent.acked) {
+        return;
+    }
+    sent.acked = true;
+    for (auto& [key, data] : sent.records) {
+        auto& baseline = client.baselines[key];
+        if (sequence > baseline.acked) {
+            baseline.acked = sequence;
+            baseline.data = std::move(data);
+        }
+    }
+    sent.records.clear();
+}
+
+void ServerSnapshotBaselines::resetClient(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _clients.find(client_id);
+    if (it == _clients.end()) {
+        return;
+    }
+    // Keep the sequence going so late acks of the old batches are ignored
+    auto& client = it->second;
+    client.baselines.clear();
+    for (auto& sent : client.sent) {
+        sent.sequence = 0;
+        sent.acked = false;
+        sent.records.clear();
+    }
+}
+
+void ServerSnapshotBaselines::removeClient(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _clients.erase(client_id);
+}
+
+uint32_t ServerSnapshotBaselines::nextSequence(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _clients[client_id].next_sequence;
+}
+
+void ServerSnapshotBaselines::prune(ClientBaselines& client) {
+    // Baselines too old to be used (destroyed entities, idle components) would be sent in full anyway
+    for (auto it = client.baselines.begin(); it != client.baselines.end();) {
+        uint32_t latest = std::max(it->second.acked, it->second.last_sent);
+        if (client.next_sequence - latest > SNAPSHOT_BASELINE_WINDOW) {
+            it = client.baselines.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    client.last_prune = client.next_sequence;
+}
+
+ClientSnapshotBaselines::Result ClientSnapshotBaselines::decode(uint32_t sequence,
+                                                                const network::SnapshotRecord& record,
+                                                                std::vector<uint8_t>& out) {
+    auto& history = _history[makeKey(record.entity_guid, record.component_type)];
+
+    if (record.encoding == network::SnapshotEncoding::FULL) {
+        out = record.data;
+    } else {
+        auto base = std::find_if(history.begin(), history.end(),
+                                 [&](const auto& entry) { return entry.first == record.baseline; });
+        if (base == history.end()) {
+            // Older than everything we kept: a newer delta already moved past its baseline
+            if (!history.empty() && record.baseline < history.front().first) {
+                return Result::DROPPED;
+            }
+            return Result::MISSING_BASELINE;
+        }
+        if (!network::applySnapshotDelta(base->second, record.data.data(), record.data.size(), out)) {
+            return Result::MISSING_BASELINE;
+        }
+        // The server never goes back to a baseline older than an acknowledged one
+        history.erase(history.begin(), base);
+    }
+
+    if (history.empty() || history.back().first < sequence) {
+        history.emplace_back(sequence, out);
+        if (history.size() > SNAPSHOT_BASELINE_WINDOW) {
+            history.pop_front();
+        }
+        return Result::APPLY;
+    }
+
+    auto pos = std::lower_bound(history.begin(), history.end(), sequence,
+                                [](const auto& entry, uint32_t value) { return entry.first < value; });
+    if (pos == history.end() || pos->first != sequence) {
+        history.emplace(pos, sequence, out);
+        if (history.size() > SNAPSHOT_BASELINE_WINDOW) {
+            history.pop_front();
+        }
+    }
+    return Result::OUTDATED;
+}
+
+uint32_t ClientSnapshotBaselines::latestSequence(uint32_t entity_guid, uint32_t component_type) const {
+    auto it = _history.find(makeKey(entity_guid, component_type));
+    if (it == _history.end() || it->second.empty()) {
+        return 0;
+    }
+    return it->second.back().first;
+}
+
+void ClientSnapshotBaselines::forgetEntity(uint32_t entity_guid) {
+    for (auto it = _history.begin(); it != _history.end();) {
+        if (static_cast<uint32_t>(it->first >> 32) == entity_guid) {
+            it = _history.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace core
+}  // namespace engine
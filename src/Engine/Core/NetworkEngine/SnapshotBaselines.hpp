@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../../Lib/Components/NetworkComponents.hpp"
+
+namespace engine {
+namespace core {
+
+// Number of batch sequences a delta can reach back. Both sides keep at most
+// this much history per client (server) or per component (client).
+static constexpr uint32_t SNAPSHOT_BASELINE_WINDOW = 64;
+
+/**
+ * @brief Server side of delta replication.
+ *
+ * Remembers, for every client, the last value of each (entity, component) the
+ * client acknowledged. Updates are written as a diff against that baseline when
+ * possible, and dropped when the client already has the value. Lobby worlds
+ * write the batches of their own clients at the same time, so every call is
+ * guarded.
+ */
+class ServerSnapshotBaselines {
+   public:
+    /**
+        Prepare the writer for the batches of one client
+        @param uint32_t client id
+        @param SnapshotBatchWriter writer to reset
+    */
+    void begin(uint32_t client_id, network::SnapshotBatchWriter& writer);
+
+    /**
+        Append a component update to the batches of a client, as a delta when a baseline is known
+        @param uint32_t client id, the one given to begin()
+        @param ComponentPacket full update
+        @param SnapshotBatchWriter writer given to begin()
+    */
+    void write(uint32_t client_id, const ComponentPacket& packet, network::SnapshotBatchWriter& writer);
+
+    /**
+        Commit the sequences used by the batches written since begin()
+        @param uint32_t client id
+        @param SnapshotBatchWriter writer given to begin()
+    */
+    void end(uint32_t client_id, const network::SnapshotBatchWriter& writer);
+
+    /**
+        The client received a batch: every value it carried becomes a baseline
+        @param uint32_t client id
+        @param uint32_t sequence of the batch
+    */
+    void acknowledge(uint32_t client_id, uint32_t sequence);
+
+    /**
+        Forget every baseline of a client so the next updates are sent in full
+        @param uint32_t client id
+    */
+    void resetClient(uint32_t client_id);
+
+    void removeClient(uint32_t client_id);
+
+    /**
+        @param uint32_t client id
+        @return The sequence the next batch of the client will get, anything captured now is older
+    */
+    uint32_t nextSequence(uint32_t client_id);
+
+   private:
+    struct Baseline {
+        uint32_t acked = 0;      // sequence of the batch the client acknowledged, 0 if none
+        uint32_t last_sent = 0;  // sequence of the last batch carrying this component
+        std::vector<uint8_t> data;
+    };
+
+    struct SentBatch {
+        uint32_t sequence = 0;
+        bool acked = false;
+        std::vector<std::pair<uint64_t, std::vector<uint8_t>>> records;
+    };
+
+    struct ClientBaselines {
+        uint32_t next_sequence = 1;
+        uint32_t last_prune = 1;
+        std::unordered_map<uint64_t, Baseline> baselines;
+        std::array<SentBatch, SNAPSHOT_BASELINE_WINDOW> sent;
+    };
+
+    static void prune(ClientBaselines& client);
+
+    std::mutex _mutex;
+    std::unordered_map<uint32_t, ClientBaselines> _clients;
+    std::vector<uint8_t> _delta;
+};
+
+/**
+ * @brief Client side of delta replication.
+ *
+ * Keeps the recent values received for each (entity, component) so deltas can
+ * be applied against whichever one the server used as baseline.
+ */
+class ClientSnapshotBaselines {
+   public:
+    enum class Result {
+        APPLY,             // out holds the new value
+        OUTDATED,          // decoded, but a newer value was already applied
+        DROPPED,           // late delta whose baseline was already discarded, do not acknowledge its batch
+        MISSING_BASELINE,  // the delta refers to a value we never had, the server must resync
+    };
+
+    /**
+        Rebuild the value carried by a batch record
+        @param uint32_t sequence of the batch
+        @param SnapshotRecord record read from the batch
+        @param std::vector<uint8_t> output component bytes
+        @return Whether the value must be applied
+    */
+    Result decode(uint32_t sequence, const network::SnapshotRecord& record, std::vector<uint8_t>& out);
+
+    /**
+        @return The sequence of the newest batch that carried this component, 0 if none did
+    */
+    uint32_t latestSequence(uint32_t entity_guid, uint32_t component_type) const;
+
+    void forgetEntity(uint32_t entity_guid);
+    void clear() { _history.clear(); }
+
+   private:
+    std::unordered_map<uint64_t, std::deque<std::pair<uint32_t, std::vector<uint8_t>>>> _history;
+};
+
+}  // namespace core
+}  // namespace engine
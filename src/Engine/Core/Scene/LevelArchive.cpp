@@ -0,0 +1,345 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type
+** File description:
+** LevelArchive - Compiled, memory mapped form of a level
+*/
+
+#include "LevelArchive.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace level_archive;
+
+static_assert(sizeof(Header) == 16 * 4);
+static_assert(sizeof(StringRecord) == 2 * 4);
+static_assert(sizeof(EntityRecord) == 3 * 4);
+static_assert(sizeof(PropertyRecord) == 3 * 4);
+static_assert(sizeof(SpawnRecord) == 9 * 4);
+
+namespace {
+
+class ArchiveWriter {
+   public:
+    uint32_t intern(const std::string& value) {
+        auto [it, inserted] = _ids.try_emplace(value, static_cast<uint32_t>(_strings.size()));
+        if (inserted) {
+            _strings.push_back({static_cast<uint32_t>(_bytes.size()), static_cast<uint32_t>(value.size())});
+            _bytes.insert(_bytes.end(), value.begin(), value.end());
+        }
+        return it->second;
+    }
+
+    PropertyRecord property(const std::string& key, const std::any& value) {
+        PropertyRecord record{intern(key), PropertyKind::Float, 0};
+
+        if (const auto* number = std::any_cast<float>(&value)) {
+            std::memcpy(&record.value, number, sizeof(*number));
+        } else if (const auto* integer = std::any_cast<int>(&value)) {
+            record.kind = PropertyKind::Int;
+            std::memcpy(&record.value, integer, sizeof(*integer));
+        } else if (const auto* flag = std::any_cast<bool>(&value)) {
+            record.kind = PropertyKind::Bool;
+            record.value = *flag ? 1 : 0;
+        } else if (const auto* text = std::any_cast<std::string>(&value)) {
+            record.kind = PropertyKind::String;
+            record.value = intern(*text);
+        } else {
+            throw std::runtime_error("Cannot compile property '" + key + "' of type " + value.type().name());
+        }
+        return record;
+    }
+
+    template <typename T>
+    static void append(std::vector<uint8_t>& out, const T* records, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const uint8_t*>(records);
+        out.insert(out.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    void appendStrings(std::vector<uint8_t>& out) const {
+        append(out, _strings.data(), _strings.size());
+        out.insert(out.end(), _bytes.begin(), _bytes.end());
+        out.resize((out.size() + 3) & ~std::size_t{3}, 0);
+    }
+
+    uint32_t stringCount() const { return static_cast<uint32_t>(_strings.size()); }
+    uint32_t stringBytes() const { return static_cast<uint32_t>((_bytes.size() + 3) & ~std::size_t{3}); }
+
+   private:
+    std::unordered_map<std::string, uint32_t> _ids;
+    std::vector<StringRecord> _strings;
+    std::vector<char> _bytes;
+};
+
+std::filesystem::file_time_type lastWrite(const std::string& path) {
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+
+}  // namespace
+
+LevelArchive::LevelArchive(const std::string& path) : _path(path) {
+    map(path);
+    try {
+        index();
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+LevelArchive::~LevelArchive() {
+    unmap();
+}
+
+std::vector<uint8_t> LevelArchive::compile(const LevelConfig& config) {
+    ArchiveWriter writer;
+    Header header{};
+    std::vector<EntityRecord> entities;
+    std::vector<PropertyRecord> properties;
+    std::vector<SpawnRecord> spawns;
+
+    header.magic = LEVEL_ARCHIVE_MAGIC;
+    header.version = LEVEL_ARCHIVE_VERSION;
+    header.name = writer.intern(config.name);
+    header.background_texture = writer.intern(config.background_texture);
+    header.music_track = writer.intern(config.music_track);
+    header.enemies_config = writer.intern(config.enemies_config);
+    header.boss_config = writer.intern(config.boss_config);
+    header.boss_section = writer.intern(config.boss_section);
+    header.game_config = writer.intern(config.game_config);
+    header.spawn_script = writer.intern(config.spawn_script);
+    header.next_level = writer.intern(config.next_level);
+
+    for (const auto& entity : config.entities) {
+        // Sorted by key so a level always compiles to the same bytes
+        std::vector<const std::pair<const std::string, std::any>*> sorted;
+        for (const auto& property : entity.properties)
+            sorted.push_back(&property);
+        std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+        entities.push_back({writer.intern(entity.type), static_cast<uint32_t>(properties.size()),
+                            static_cast<uint32_t>(sorted.size())});
+        for (const auto* property : sorted)
+            properties.push_back(writer.property(property->first, property->second));
+    }
+
+    for (const auto& event : config.spawn_events) {
+        spawns.push_back({event.trigger_time, writer.intern(event.enemy_type), event.x_position, event.y_position,
+                          event.count, event.spacing, event.formation, event.custom_speed, event.custom_hp});
+    }
+
+    header.stringCount = writer.stringCount();
+    header.stringBytes = writer.stringBytes();
+    header.entityCount = static_cast<uint32_t>(entities.size());
+    header.propertyCount = static_cast<uint32_t>(properties.size());
+    header.spawnCount = static_cast<uint32_t>(spawns.size());
+
+    std::vector<uint8_t> out;
+    ArchiveWriter::append(out, &header, 1);
+    writer.appendStrings(out);
+    ArchiveWriter::append(out, entities.data(), entities.size());
+    ArchiveWriter::append(out, properties.data(), properties.size());
+    ArchiveWriter::append(out, spawns.data(), spawns.size());
+    return out;
+}
+
+void LevelArchive::save(const LevelConfig& config, const std::string& path) {
+    const std::vector<uint8_t> bytes = compile(config);
+    const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    std::error_code error;
+
+    if (!directory.empty())
+        std::filesystem::create_directories(directory, error);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+        throw std::runtime_error("Cannot write level archive: " + path);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+        throw std::runtime_error("Failed to write level archive: " + path);
+}
+
+std::string LevelArchive::compiledPath(const std::string& scenePath) {
+    // The whole path is kept, two levels with the same name in different directories get different archives
+    std::filesystem::path scene = std::filesystem::path(scenePath).lexically_normal().relative_path();
+    return (std::filesystem::path(LEVEL_ARCHIVE_DIR) / scene).replace_extension(LEVEL_ARCHIVE_EXTENSION).string();
+}
+
+bool LevelArchive::isUpToDate(const std::string& scenePath) const {
+    const auto compiled = lastWrite(_path);
+    const std::string_view script = string(_header->spawn_script);
+
+    if (compiled < lastWrite(scenePath))
+        return false;
+    return script.empty() || compiled >= lastWrite(std::string(script));
+}
+
+std::string_view LevelArchive::string(uint32_t id) const {
+    if (id >= _strings.size())
+        return {};
+    return std::string_view(_stringBytes + _strings[id].offset, _strings[id].size);
+}
+
+std::any LevelArchive::value(const PropertyRecord& property) const {
+    switch (property.kind) {
+        case PropertyKind::Float:
+            return std::bit_cast<float>(property.value);
+        case PropertyKind::Int:
+            return std::bit_cast<int32_t>(property.value);
+        case PropertyKind::Bool:
+            return property.value != 0;
+        case PropertyKind::String:
+            return std::string(string(property.value));
+    }
+    return {};
+}
+
+LevelConfig LevelArchive::levelSection() const {
+    LevelConfig config;
+
+    config.name = string(_header->name);
+    config.background_texture = string(_header->background_texture);
+    config.music_track = string(_header->music_track);
+    config.enemies_config = string(_header->enemies_config);
+    config.boss_config = string(_header->boss_config);
+    config.boss_section = string(_header->boss_section);
+    config.game_config = string(_header->game_config);
+    config.spawn_script = string(_header->spawn_script);
+    config.next_level = string(_header->next_level);
+    return config;
+}
+
+LevelConfig LevelArchive::toConfig() const {
+    LevelConfig config = levelSection();
+
+    config.entities.reserve(_entities.size());
+    for (const auto& record : _entities) {
+        SceneEntityConfig& entity = config.entities.emplace_back();
+
+        entity.type = string(record.type);
+        for (const auto& property : _properties.subspan(record.firstProperty, record.propertyCount))
+            entity.properties[std::string(string(property.key))] = value(property);
+    }
+
+    config.spawn_events.reserve(_spawns.size());
+    for (const auto& record : _spawns) {
+        config.spawn_events.push_back({record.trigger_time, std::string(string(record.enemy_type)), record.x_position,
+                                       record.y_position, record.count, record.spacing, record.formation,
+                                       record.custom_speed, record.custom_hp, false});
+    }
+    return config;
+}
+
+void LevelArchive::map(const std::string& path) {
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        throw std::runtime_error("Cannot open level archive: " + path);
+    _copy.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    _data = _copy.data();
+    _size = _copy.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+
+    if (fd < 0)
+        throw std::runtime_error("Cannot open level archive: " + path);
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        throw std::runtime_error("Level archive too small: " + path);
+    }
+
+    void* data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Cannot map level archive: " + path);
+    _data = static_cast<const uint8_t*>(data);
+    _size = static_cast<std::size_t>(info.st_size);
+#endif
+}
+
+void LevelArchive::unmap() {
+#if !defined(_WIN32)
+    if (_data)
+        ::munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+    _copy.clear();
+}
+
+void LevelArchive::index() {
+    auto fail = [this](const std::string& reason) { throw std::runtime_error(_path + ": " + reason); };
+
+    if (_size < sizeof(Header))
+        fail("not a level archive");
+
+    // The mapping is page aligned, and every table starts on a multiple of 4
+    _header = reinterpret_cast<const Header*>(_data);
+    if (_header->magic != LEVEL_ARCHIVE_MAGIC)
+        fail("not a level archive");
+    if (_header->version != LEVEL_ARCHIVE_VERSION)
+        fail("compiled for version " + std::to_string(_header->version) + ", expected " +
+             std::to_string(LEVEL_ARCHIVE_VERSION));
+
+    std::size_t offset = sizeof(Header);
+    auto table = [&](std::size_t count, std::size_t size) {
+        const uint8_t* start = _data + offset;
+        if (count > (_size - offset) / size)
+            fail("truncated");
+        offset += count * size;
+        return start;
+    };
+
+    const auto* strings = reinterpret_cast<const StringRecord*>(table(_header->stringCount, sizeof(StringRecord)));
+    _strings = {strings, _header->stringCount};
+    if (_header->stringBytes % 4 != 0)
+        fail("misaligned string table");
+    _stringBytes = reinterpret_cast<const char*>(table(_header->stringBytes, 1));
+    const auto* entities = reinterpret_cast<const EntityRecord*>(table(_header->entityCount, sizeof(EntityRecord)));
+    _entities = {entities, _header->entityCount};
+    const auto* properties =
+        reinterpret_cast<const PropertyRecord*>(table(_header->propertyCount, sizeof(PropertyRecord)));
+    _properties = {properties, _header->propertyCount};
+    const auto* spawns = reinterpret_cast<const SpawnRecord*>(table(_header->spawnCount, sizeof(SpawnRecord)));
+    _spawns = {spawns, _header->spawnCount};
+
+    // Bounds only, so that reading a record never leaves the file
+    for (const auto& record : _strings) {
+        if (record.offset > _header->stringBytes || record.size > _header->stringBytes - record.offset)
+            fail("string out of bounds");
+    }
+    for (const auto& record : _entities) {
+        if (record.firstProperty > _properties.size() ||
+            record.propertyCount > _properties.size() - record.firstProperty)
+            fail("entity properties out of bounds");
+    }
+    for (const auto& record : _properties) {
+        if (record.kind > PropertyKind::String)
+            fail("unknown property kind");
+    }
+    for (const auto& record : _spawns) {
+        if (record.formation > SpawnFormation::Unknown)
+            fail("unknown spawn formation");
+    }
+}
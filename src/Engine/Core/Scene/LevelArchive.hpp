@@ -0,0 +1,166 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type
+** File description:
+** LevelArchive - Compiled, memory mapped form of a level
+*/
+
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LevelConfig.hpp"
+
+static constexpr uint32_t LEVEL_ARCHIVE_MAGIC = 0x564C5452;  // "RTLV" read as a little endian word
+static constexpr uint32_t LEVEL_ARCHIVE_VERSION = 1;
+static constexpr auto LEVEL_ARCHIVE_EXTENSION = ".rlevel";
+
+// Where the level compiler writes archives. The build sets it to a directory of its build tree
+#ifndef LEVEL_ARCHIVE_DIR
+#define LEVEL_ARCHIVE_DIR "build/levels"
+#endif
+
+/**
+ * Records of a level archive. Every record is made of 4 byte words and read
+ * in place from the mapped file. Strings are interned: a record holds the id
+ * of a string, the string itself is stored once in the string table.
+ *
+ * Layout: Header, StringRecord[stringCount], string bytes padded to 4,
+ * EntityRecord[entityCount], PropertyRecord[propertyCount], SpawnRecord[spawnCount]
+ */
+namespace level_archive {
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stringCount;
+    uint32_t stringBytes;
+    uint32_t entityCount;
+    uint32_t propertyCount;
+    uint32_t spawnCount;
+
+    // Ids of the fields of the LEVEL section
+    uint32_t name;
+    uint32_t background_texture;
+    uint32_t music_track;
+    uint32_t enemies_config;
+    uint32_t boss_config;
+    uint32_t boss_section;
+    uint32_t game_config;
+    uint32_t spawn_script;
+    uint32_t next_level;
+};
+
+struct StringRecord {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct EntityRecord {
+    uint32_t type;
+    uint32_t firstProperty;
+    uint32_t propertyCount;
+};
+
+enum class PropertyKind : uint32_t { Float, Int, Bool, String };
+
+struct PropertyRecord {
+    uint32_t key;
+    PropertyKind kind;
+    uint32_t value;  // Bits of the float or int, 0 or 1, or a string id
+};
+
+struct SpawnRecord {
+    float trigger_time;
+    uint32_t enemy_type;
+    float x_position;
+    float y_position;
+    int32_t count;
+    float spacing;
+    SpawnFormation formation;
+    float custom_speed;
+    int32_t custom_hp;
+};
+
+}  // namespace level_archive
+
+/**
+ * @brief A level compiled by the level compiler, mapped read only.
+ *
+ * Opening one checks its header and the bounds of its tables, nothing is
+ * parsed: records are read where they lie in the mapping.
+ */
+class LevelArchive {
+   public:
+    /**
+        Map a compiled level
+        @param std::string path of the archive
+        @throw std::runtime_error if the file cannot be mapped or is not an archive of this version
+    */
+    explicit LevelArchive(const std::string& path);
+    ~LevelArchive();
+
+    LevelArchive(const LevelArchive&) = delete;
+    LevelArchive& operator=(const LevelArchive&) = delete;
+
+    /**
+        Encode a level, the inverse of toConfig
+        @param LevelConfig level, its properties must hold a float, an int, a bool or a std::string
+        @throw std::runtime_error on a property of another type
+    */
+    static std::vector<uint8_t> compile(const LevelConfig& config);
+
+    // Compile a level and write it to path, creating its directory
+    static void save(const LevelConfig& config, const std::string& path);
+
+    /**
+        @param std::string path of a .scene file
+        @return Path of the archive compiled from it: the path of the scene under LEVEL_ARCHIVE_DIR
+    */
+    static std::string compiledPath(const std::string& scenePath);
+
+    /**
+        @param std::string path of the .scene file the archive was compiled from
+        @return false if the scene or its spawn script changed since the archive was written
+    */
+    bool isUpToDate(const std::string& scenePath) const;
+
+    const level_archive::Header& header() const { return *_header; }
+    std::string_view string(uint32_t id) const;
+
+    std::span<const level_archive::EntityRecord> entities() const { return _entities; }
+    std::span<const level_archive::PropertyRecord> properties() const { return _properties; }
+    std::span<const level_archive::SpawnRecord> spawns() const { return _spawns; }
+
+    // Value of a property, typed as the text loader types it
+    std::any value(const level_archive::PropertyRecord& property) const;
+
+    // The fields of the LEVEL section, entities and spawns are left in the records
+    LevelConfig levelSection() const;
+
+    // Rebuild the LevelConfig the archive was compiled from
+    LevelConfig toConfig() const;
+
+   private:
+    void map(const std::string& path);
+    void unmap();
+    void index();  // Point the tables in the mapping, checking their bounds
+
+    std::string _path;
+    const uint8_t* _data = nullptr;
+    std::size_t _size = 0;
+    std::vector<uint8_t> _copy;  // Content of the file where it cannot be mapped
+
+    const level_archive::Header* _header = nullptr;
+    std::span<const level_archive::StringRecord> _strings;
+    const char* _stringBytes = nullptr;
+    std::span<const level_archive::EntityRecord> _entities;
+    std::span<const level_archive::PropertyRecord> _properties;
+    std::span<const level_archive::SpawnRecord> _spawns;
+};
@@ -1,15 +1,54 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <any>
 
+class LevelArchive;
+
 struct SceneEntityConfig {
     std::string type;
     std::unordered_map<std::string, std::any> properties;
 };
 
+enum class SpawnFormation : uint32_t { Single, LineHorizontal, LineVertical, VFormation, Snake, Unknown };
+
+/**
+    @param std::string_view formation as written in a spawn script, e.g. LINE_HORIZONTAL
+    @return SpawnFormation::Unknown if the name matches no formation
+*/
+inline SpawnFormation parseSpawnFormation(std::string_view name) {
+    if (name == "SINGLE")
+        return SpawnFormation::Single;
+    if (name == "LINE_HORIZONTAL")
+        return SpawnFormation::LineHorizontal;
+    if (name == "LINE_VERTICAL")
+        return SpawnFormation::LineVertical;
+    if (name == "V_FORMATION")
+        return SpawnFormation::VFormation;
+    if (name == "SNAKE")
+        return SpawnFormation::Snake;
+    return SpawnFormation::Unknown;
+}
+
+// One line of a spawn script, sorted by trigger_time
+struct SpawnEvent {
+    float trigger_time;
+    std::string enemy_type;
+    float x_position;
+    float y_position;
+    int count;
+    float spacing;
+    SpawnFormation formation;
+    float custom_speed;
+    int custom_hp;
+    bool executed;
+};
+
 struct LevelConfig {
     std::string name;
     std::string background_texture;
@@ -24,4 +63,9 @@ struct LevelConfig {
     std::string next_level;  // Path to next level scene
 
     std::vector<SceneEntityConfig> entities;
+    std::vector<SpawnEvent> spawn_events;  // Content of spawn_script, loaded with the scene
+
+    // Set when the level was loaded from its compiled archive: entities and spawn_events are then left empty,
+    // the scene manager and the spawner read the records of the archive, which stays mapped while it is shared
+    std::shared_ptr<const LevelArchive> archive;
 };
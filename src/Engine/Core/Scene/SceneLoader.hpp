@@ -7,9 +7,12 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
+#include "LevelArchive.hpp"
 #include "LevelConfig.hpp"
 #include <string>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -17,7 +20,39 @@
 
 class SceneLoader {
    public:
+    /**
+        Load a level from the archive the level compiler made of it, or from its text when the
+        archive is missing or older than the text
+        @param std::string path of the .scene file
+        @return The level, holding the mapped archive if it was loaded from one
+    */
     static LevelConfig loadFromFile(const std::string& filepath) {
+        const std::string compiled = LevelArchive::compiledPath(filepath);
+        std::error_code error;
+
+        if (std::filesystem::exists(compiled, error)) {
+            try {
+                auto archive = std::make_shared<const LevelArchive>(compiled);
+                if (archive->isUpToDate(filepath)) {
+                    LevelConfig config = archive->levelSection();
+                    config.archive = std::move(archive);
+                    return config;
+                }
+                std::cerr << "[SceneLoader] " << compiled << " is older than its sources, parsing " << filepath
+                          << std::endl;
+            } catch (const std::exception& e) {
+                std::cerr << "[SceneLoader] " << e.what() << ", parsing " << filepath << std::endl;
+            }
+        }
+        return loadFromText(filepath);
+    }
+
+    /**
+        Parse a .scene file and the spawn script it names
+        @param std::string path of the .scene file
+        @param std::vector<std::string> if given, gets a message for each line that is skipped or malformed
+    */
+    static LevelConfig loadFromText(const std::string& filepath, std::vector<std::string>* problems = nullptr) {
         LevelConfig config;
         std::ifstream file(filepath);
 
@@ -27,8 +62,14 @@ class SceneLoader {
 
         std::string line;
         std::string current_section;
+        std::size_t line_number = 0;
+        auto report = [&](const std::string& message) {
+            if (problems)
+                problems->push_back(filepath + ":" + std::to_string(line_number) + ": " + message);
+        };
 
         while (std::getline(file, line)) {
+            line_number++;
             line = trim(line);
 
             if (line.empty() || line[0] == '#')
@@ -39,32 +80,125 @@ class SceneLoader {
                 if (end != std::string::npos) {
                     current_section = line.substr(1, end - 1);
                 }
+                if (minimumFields(current_section) == 0 && current_section != "LEVEL")
+                    report("unknown section [" + current_section + "]");
                 continue;
             }
 
             size_t pos = line.find('=');
-            if (pos == std::string::npos)
+            if (pos == std::string::npos) {
+                report("expected key=value");
                 continue;
+            }
 
             std::string key = trim(line.substr(0, pos));
             std::string value = trim(line.substr(pos + 1));
 
             if (current_section == "LEVEL") {
-                parseLevelProperty(config, key, value);
-            } else if (current_section == "WALL") {
-                parseWallEntry(config, value);
-            } else if (current_section == "ENEMY") {
-                parseEnemyEntry(config, value);
-            } else if (current_section == "TURRET") {
-                parseTurretEntry(config, value);
-            } else if (current_section == "DECOR") {
-                parseDecorEntry(config, value);
+                if (!parseLevelProperty(config, key, value))
+                    report("unknown level property '" + key + "'");
+                continue;
+            }
+
+            std::vector<std::string> tokens = split(value);
+            if (tokens.size() < minimumFields(current_section)) {
+                report("expected at least " + std::to_string(minimumFields(current_section)) + " fields");
+            }
+
+            try {
+                if (current_section == "WALL") {
+                    parseWallEntry(config, tokens);
+                    if (tokens.size() >= 6 && tokens[5] != "true" && tokens[5] != "false")
+                        report("destructible should be true or false");
+                } else if (current_section == "ENEMY") {
+                    parseEnemyEntry(config, tokens);
+                } else if (current_section == "TURRET") {
+                    parseTurretEntry(config, tokens);
+                } else if (current_section == "DECOR") {
+                    parseDecorEntry(config, tokens);
+                }
+            } catch (const std::exception&) {
+                if (!problems)
+                    throw;
+                report("invalid number in '" + value + "'");
             }
         }
 
+        if (!config.spawn_script.empty()) {
+            config.spawn_events = loadSpawnScript(config.spawn_script, problems);
+        }
         return config;
     }
 
+    /**
+        Parse a spawn script, one spawn=time,enemy_type,x,y,count,spacing,formation,speed,hp per line
+        @param std::string path of the script
+        @param std::vector<std::string> if given, gets a message for each line that is skipped or malformed
+    */
+    static std::vector<SpawnEvent> loadSpawnScript(const std::string& filepath,
+                                                   std::vector<std::string>* problems = nullptr) {
+        std::vector<SpawnEvent> events;
+        std::ifstream file(filepath);
+
+        if (!file.is_open()) {
+            std::cerr << "Failed to open spawn script: " << filepath << std::endl;
+            if (problems)
+                problems->push_back(filepath + ": cannot open spawn script");
+            return events;
+        }
+
+        std::string line;
+        std::size_t line_number = 0;
+        auto report = [&](const std::string& message) {
+            if (problems)
+                problems->push_back(filepath + ":" + std::to_string(line_number) + ": " + message);
+        };
+
+        while (std::getline(file, line)) {
+            line_number++;
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            if (line.find("spawn=") != 0) {
+                if (!trim(line).empty())
+                    report("expected spawn=");
+                continue;
+            }
+
+            std::vector<std::string> parts = split(line.substr(6));
+            if (parts.size() < 9) {
+                report("expected 9 fields");
+                continue;
+            }
+
+            try {
+                SpawnEvent event;
+                event.trigger_time = std::stof(parts[0]);
+                event.enemy_type = parts[1];
+                event.x_position = std::stof(parts[2]);
+                event.y_position = std::stof(parts[3]);
+                event.count = std::stoi(parts[4]);
+                event.spacing = std::stof(parts[5]);
+                event.formation = parseSpawnFormation(parts[6]);
+                event.custom_speed = std::stof(parts[7]);
+                event.custom_hp = std::stoi(parts[8]);
+                event.executed = false;
+
+                if (event.formation == SpawnFormation::Unknown)
+                    report("unknown formation '" + parts[6] + "'");
+                // The spawn system stops at the first event still to come
+                if (!events.empty() && event.trigger_time < events.back().trigger_time)
+                    report("spawn time goes back to " + parts[0]);
+                events.push_back(event);
+            } catch (const std::exception&) {
+                if (!problems)
+                    throw;
+                report("invalid number in '" + line + "'");
+            }
+        }
+        return events;
+    }
+
    private:
     static std::string trim(const std::string& str) {
         size_t start = str.find_first_not_of(" \t");
@@ -74,7 +208,29 @@ class SceneLoader {
         return str.substr(start, end - start + 1);
     }
 
-    static void parseLevelProperty(LevelConfig& config, const std::string& key, const std::string& value) {
+    static std::vector<std::string> split(const std::string& value) {
+        std::stringstream ss(value);
+        std::string token;
+        std::vector<std::string> tokens;
+
+        while (std::getline(ss, token, ',')) {
+            tokens.push_back(trim(token));
+        }
+        return tokens;
+    }
+
+    // Fields an entry of the section needs to be placed, 0 for sections without entries
+    static std::size_t minimumFields(const std::string& section) {
+        if (section == "WALL" || section == "ENEMY")
+            return 4;
+        if (section == "DECOR")
+            return 3;
+        if (section == "TURRET")
+            return 2;
+        return 0;
+    }
+
+    static bool parseLevelProperty(LevelConfig& config, const std::string& key, const std::string& value) {
         if (key == "name")
             config.name = value;
         else if (key == "background")
@@ -93,20 +249,15 @@ class SceneLoader {
             config.spawn_script = value;
         else if (key == "next_level")
             config.next_level = value;
+        else
+            return false;
+        return true;
     }
 
-    static void parseWallEntry(LevelConfig& config, const std::string& value) {
+    static void parseWallEntry(LevelConfig& config, const std::vector<std::string>& tokens) {
         SceneEntityConfig entity;
         entity.type = "Wall";
 
-        std::stringstream ss(value);
-        std::string token;
-        std::vector<std::string> tokens;
-
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(trim(token));
-        }
-
         if (tokens.size() >= 4) {
             entity.properties["x"] = std::stof(tokens[0]);
             entity.properties["y"] = std::stof(tokens[1]);
@@ -126,18 +277,10 @@ class SceneLoader {
         config.entities.push_back(entity);
     }
 
-    static void parseEnemyEntry(LevelConfig& config, const std::string& value) {
+    static void parseEnemyEntry(LevelConfig& config, const std::vector<std::string>& tokens) {
         SceneEntityConfig entity;
         entity.type = "Enemy";
 
-        std::stringstream ss(value);
-        std::string token;
-        std::vector<std::string> tokens;
-
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(trim(token));
-        }
-
         if (tokens.size() >= 4) {
             entity.properties["spawn_time"] = std::stof(tokens[0]);
             entity.properties["enemy_type"] = tokens[1];
@@ -148,18 +291,10 @@ class SceneLoader {
         config.entities.push_back(entity);
     }
 
-    static void parseTurretEntry(LevelConfig& config, const std::string& value) {
+    static void parseTurretEntry(LevelConfig& config, const std::vector<std::string>& tokens) {
         SceneEntityConfig entity;
         entity.type = "Turret";
 
-        std::stringstream ss(value);
-        std::string token;
-        std::vector<std::string> tokens;
-
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(trim(token));
-        }
-
         if (tokens.size() >= 2) {
             entity.properties["x"] = std::stof(tokens[0]);
             entity.properties["y"] = std::stof(tokens[1]);
@@ -177,18 +312,10 @@ class SceneLoader {
         config.entities.push_back(entity);
     }
 
-    static void parseDecorEntry(LevelConfig& config, const std::string& value) {
+    static void parseDecorEntry(LevelConfig& config, const std::vector<std::string>& tokens) {
         SceneEntityConfig entity;
         entity.type = "Decor";
 
-        std::stringstream ss(value);
-        std::string token;
-        std::vector<std::string> tokens;
-
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(trim(token));
-        }
-
         // Format: x, y, sprite_path, scale, z_index, scroll_speed_mult
         if (tokens.size() >= 3) {
             entity.properties["x"] = std::stof(tokens[0]);
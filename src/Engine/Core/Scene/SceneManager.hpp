@@ -1,5 +1,6 @@
 #pragma once
 
+#include "LevelArchive.hpp"
 #include "LevelConfig.hpp"
 #include "../ECS/Registry/registry.hpp"
 #include "../../Lib/Components/LobbyIdComponent.hpp"
@@ -33,8 +34,9 @@ class SceneManager {
     void setCurrentLobbyId(uint32_t lobbyId) { _currentLobbyId = lobbyId; }
 
     void loadScene(const LevelConfig& config) {
-        std::cout << "[SceneManager] Loading scene with " << config.entities.size() << " entities for lobby "
-                  << _currentLobbyId << std::endl;
+        std::size_t count = config.archive ? config.archive->entities().size() : config.entities.size();
+        std::cout << "[SceneManager] Loading scene with " << count << " entities for lobby " << _currentLobbyId
+                  << std::endl;
 
         // 1. Create Background Entity
         if (!config.background_texture.empty()) {
@@ -47,6 +49,10 @@ class SceneManager {
         }
 
         // 2. Spawn Entities
+        if (config.archive) {
+            _loadRecords(*config.archive);
+            return;
+        }
         for (const auto& entConfig : config.entities) {
             std::cout << "[SceneManager] Creating entity of type: " << entConfig.type << std::endl;
             _createEntity(entConfig.type, entConfig.properties);
@@ -54,6 +60,21 @@ class SceneManager {
     }
 
    private:
+    // Entities of a compiled level, read from its records where they are mapped
+    void _loadRecords(const LevelArchive& archive) {
+        std::unordered_map<std::string, std::any> props;
+        std::string type;
+
+        for (const auto& record : archive.entities()) {
+            type = archive.string(record.type);
+            props.clear();
+            for (const auto& property : archive.properties().subspan(record.firstProperty, record.propertyCount))
+                props.emplace(archive.string(property.key), archive.value(property));
+            std::cout << "[SceneManager] Creating entity of type: " << type << std::endl;
+            _createEntity(type, props);
+        }
+    }
+
     void _createEntity(const std::string& type, const std::unordered_map<std::string, std::any>& props) {
         if (_prefabs.find(type) == _prefabs.end()) {
             std::cerr << "Warning: Unknown entity type '" << type << "'" << std::endl;
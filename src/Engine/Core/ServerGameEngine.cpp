@@ -7,15 +7,14 @@
 
 #include "ServerGameEngine.hpp"
 #include <chrono>
+#include <exception>
 #include <iostream>
 #include <ostream>
 #include <set>
 #include <memory>
 #include <utility>
-#include <thread>
 #include <vector>
 #include <tuple>
-#include <unordered_set>
 #include <string>
 #include <algorithm>
 #include "Components/NetworkComponents.hpp"
@@ -38,7 +37,6 @@
 #include "../../RType/Common/Components/pod_component.hpp"
 #include "../../RType/Common/Components/scripted_spawn.hpp"
 #include "../Lib/Components/LobbyIdComponent.hpp"
-#include "../Lib/Utils/LobbyUtils.hpp"
 #include "../../RType/Common/Systems/behavior.hpp"
 #include "../../RType/Common/Entities/Player/Player.hpp"
 #include "Components/Sprite/Sprite2D.hpp"
@@ -48,14 +46,11 @@
 #include "CollisionSystem.hpp"
 #include "../Lib/Systems/PhysicsSystem.hpp"
 
-ServerGameEngine::ServerGameEngine(std::string ip)
-    : _env(std::make_shared<Environment>(_ecs, _texture_manager, _sound_manager, _music_manager, EnvMode::SERVER)) {
+ServerGameEngine::ServerGameEngine(std::string ip) {
     _network = std::make_shared<engine::core::NetworkEngine>(engine::core::NetworkEngine::NetworkRole::SERVER);
 }
 
 int ServerGameEngine::init() {
-    _ecs.systems.addSystem<ComponentSenderSystem>();
-
     registerNetworkComponent<Sprite2D>();
     registerNetworkComponent<AnimatedSprite2D>();
     registerNetworkComponent<sprite2D_component_s>();
@@ -78,126 +73,171 @@ int ServerGameEngine::init() {
     registerNetworkComponent<ScoreComponent>();
     registerNetworkComponent<AudioSourceComponent>();
 
-    _env->addFunction("registerPlayer", std::function<void(uint32_t, std::shared_ptr<Player>)>(
-                                            [this](uint32_t clientId, std::shared_ptr<Player> player) {
-                                                if (!player)
-                                                    return;
-                                                _players[clientId] = player;
-                                                _clientToEntityMap[clientId] = player->getId();
-                                                _pendingFullState.insert(clientId);
-                                                std::cout << "SERVER: Registered player entity " << player->getId()
-                                                          << " for client " << clientId << std::endl;
-                                            }));
-
-    _env->addFunction("forEachLobby",
-                      std::function<void(std::function<void(uint32_t, int, const std::vector<uint32_t>&)>)>(
-                          [this](std::function<void(uint32_t, int, const std::vector<uint32_t>&)> callback) {
-                              for (const auto& [id, lobby] : _lobbyManager.getAllLobbies()) {
-                                  std::vector<uint32_t> clientIds;
-                                  for (const auto& client : lobby.getClients()) {
-                                      clientIds.push_back(client.id);
-                                  }
-                                  callback(id, static_cast<int>(lobby.getState()), clientIds);
-                              }
-                          }));
-
-    _env->addFunction(
-        "broadcastGameOver",
-        std::function<void(uint32_t, bool, const std::vector<std::tuple<uint32_t, int, bool>>&)>(
-            [this](uint32_t lobbyId, bool victory, const std::vector<std::tuple<uint32_t, int, bool>>& scores) {
-                network::GameOverPacket packet;
-                packet.victory = victory;
-                packet.player_count = std::min(static_cast<size_t>(8), scores.size());
-                for (size_t i = 0; i < packet.player_count; ++i) {
-                    packet.players[i].client_id = std::get<0>(scores[i]);
-                    packet.players[i].score = std::get<1>(scores[i]);
-                    packet.players[i].is_alive = std::get<2>(scores[i]);
-                }
+    return SUCCESS;
+}
 
-                auto network_instance = _network->getNetworkInstance();
-                if (std::holds_alternative<std::shared_ptr<network::Server>>(network_instance)) {
-                    auto server = std::get<std::shared_ptr<network::Server>>(network_instance);
+std::unique_ptr<engine::core::LobbyWorld> ServerGameEngine::createLobbyWorld(uint32_t lobbyId) {
+    auto world = std::make_unique<engine::core::LobbyWorld>(lobbyId, input_manager);
+    auto env = world->getEnvironment();
+
+    world->getECS().systems.addSystem<ComponentSenderSystem>();
+
+    env->addFunction("registerPlayer", std::function<void(uint32_t, std::shared_ptr<Player>)>(
+                                           [this](uint32_t clientId, std::shared_ptr<Player> player) {
+                                               registerPlayer(clientId, player);
+                                           }));
+
+    // The game logic of a world only ever sees its own lobby
+    env->addFunction("forEachLobby",
+                     std::function<void(std::function<void(uint32_t, int, const std::vector<uint32_t>&)>)>(
+                         [this, lobbyId](std::function<void(uint32_t, int, const std::vector<uint32_t>&)> callback) {
+                             auto lobbyOpt = _lobbyManager.getLobby(lobbyId);
+                             if (!lobbyOpt) {
+                                 return;
+                             }
+                             std::vector<uint32_t> clientIds;
+                             for (const auto& client : lobbyOpt->get().getClients()) {
+                                 clientIds.push_back(client.id);
+                             }
+                             callback(lobbyId, static_cast<int>(lobbyOpt->get().getState()), clientIds);
+                         }));
+
+    env->addFunction("broadcastGameOver",
+                     std::function<void(uint32_t, bool, const std::vector<std::tuple<uint32_t, int, bool>>&)>(
+                         [this, lobbyId](uint32_t, bool victory,
+                                         const std::vector<std::tuple<uint32_t, int, bool>>& scores) {
+                             broadcastGameOver(lobbyId, victory, scores);
+                         }));
+
+    GameFunctions game = _gameFactory ? _gameFactory() : GameFunctions{_init_function, _loop_function};
+    if (game.init) {
+        game.init(env, input_manager);
+    }
+    world->setLoopFunction(std::move(game.loop));
+    std::cout << "SERVER: Created world for lobby " << lobbyId << std::endl;
+    return world;
+}
 
-                    auto lobbyOpt = _lobbyManager.getLobby(lobbyId);
-                    if (lobbyOpt) {
-                        // Broadcast S_GAME_OVER
-                        for (const auto& client : lobbyOpt->get().getClients()) {
-                            network::message<network::GameEvents> msg;
-                            msg.header.id = network::GameEvents::S_GAME_OVER;
-                            msg << packet;
-                            server->AddMessageToPlayer(network::GameEvents::S_GAME_OVER, client.id, msg);
-                        }
+void ServerGameEngine::syncLobbyWorlds() {
+    for (auto lobbyId : _worldsToReset) {
+        _worlds.erase(lobbyId);
+    }
+    _worldsToReset.clear();
 
-                        if (_env->hasFunction("getECS")) {
-                            auto& ecs = _env->getECS();
-                            std::unordered_set<Entity> entitiesToDestroy;
-
-                            auto& lobbyIds = ecs.registry.getEntities<LobbyIdComponent>();
-                            for (auto entity : lobbyIds) {
-                                if (ecs.registry.hasComponent<LobbyIdComponent>(entity)) {
-                                    auto& lobbyComp = ecs.registry.getComponent<LobbyIdComponent>(entity);
-                                    if (lobbyComp.lobby_id == lobbyId) {
-                                        entitiesToDestroy.insert(entity);
-                                    }
-                                }
-                            }
-
-                            auto& taggedEntities = ecs.registry.getEntities<TagComponent>();
-                            for (auto entity : taggedEntities) {
-                                if (!ecs.registry.hasComponent<TagComponent>(entity))
-                                    continue;
-                                auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-
-                                bool isDynamicInfo = false;
-                                for (const auto& tag : tags.tags) {
-                                    if (tag == "PROJECTILE" || tag == "ENEMY_PROJECTILE" ||
-                                        tag == "FRIENDLY_PROJECTILE" || tag == "ENEMY" || tag == "BOSS" ||
-                                        tag == "OBSTACLE" || tag == "POD" || tag == "POWERUP" ||
-                                        tag == "LEADERBOARD_DATA" || tag == "PLAYER") {
-                                        isDynamicInfo = true;
-                                        break;
-                                    }
-                                }
-
-                                if (isDynamicInfo) {
-                                    uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                                    if (entLobby == lobbyId || entLobby == 0) {
-                                        entitiesToDestroy.insert(entity);
-                                    }
-                                }
-                            }
-
-                            for (auto entity : entitiesToDestroy) {
-                                ecs.registry.destroyEntity(entity);
-                            }
-                            std::cout << "SERVER: Destroyed " << entitiesToDestroy.size() << " entities for lobby "
-                                      << lobbyId << std::endl;
-                        }
+    for (auto it = _worlds.begin(); it != _worlds.end();) {
+        if (!_lobbyManager.getLobby(it->first)) {
+            it = _worlds.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto& [lobbyId, lobby] : _lobbyManager.getAllLobbies()) {
+        if (_worlds.find(lobbyId) == _worlds.end()) {
+            _worlds.emplace(lobbyId, createLobbyWorld(lobbyId));
+        }
+    }
+}
 
-                        lobbyOpt->get().setState(engine::core::Lobby::State::WAITING);
+void ServerGameEngine::stepLobbyWorlds(float dt) {
+    std::vector<engine::core::LobbyWorld*> running;
 
-                        for (const auto& client : lobbyOpt->get().getClients()) {
-                            lobbyOpt->get().setPlayerReady(client.id, false);
-                        }
+    for (auto& [lobbyId, world] : _worlds) {
+        auto lobbyOpt = _lobbyManager.getLobby(lobbyId);
+        if (!lobbyOpt || lobbyOpt->get().getState() != engine::core::Lobby::State::IN_GAME) {
+            continue;
+        }
 
-                        for (const auto& client : lobbyOpt->get().getClients()) {
-                            for (const auto& receiver : lobbyOpt->get().getClients()) {
-                                network::message<network::GameEvents> reply;
-                                reply.header.id = network::GameEvents::S_CANCEL_READY_BROADCAST;
-                                reply << client.id;
-                                server->AddMessageToPlayer(network::GameEvents::S_CANCEL_READY_BROADCAST, receiver.id,
-                                                           reply);
-                            }
-                        }
+        system_context ctx = {dt,
+                              _currentTick,
+                              world->getTextureManager(),
+                              world->getSoundManager(),
+                              world->getMusicManager(),
+                              input_manager,
+                              *_network,
+                              {},
+                              &_lobbyManager,
+                              &_networkedComponentTypes,
+                              lobbyId};
+        for (const auto& client : lobbyOpt->get().getClients()) {
+            ctx.active_clients.push_back(client.id);
+        }
+        world->step(ctx);
+        running.push_back(world.get());
+    }
 
-                        server->AddMessageToLobby(network::GameEvents::S_RETURN_TO_LOBBY, lobbyId, 0);
+    // Every world must be idle again before the network thread touches them
+    std::exception_ptr error;
+    for (auto* world : running) {
+        try {
+            world->wait();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
 
-                        std::cout << "SERVER: Broadcasted Game Over for lobby " << lobbyId << std::endl;
-                    }
-                }
-            }));
+void ServerGameEngine::registerPlayer(uint32_t clientId, std::shared_ptr<Player> player) {
+    if (!player)
+        return;
+    _players[clientId] = player;
+    _clientToEntityMap[clientId] = player->getId();
+    _pendingFullState.insert(clientId);
+    std::cout << "SERVER: Registered player entity " << player->getId() << " for client " << clientId << std::endl;
+}
 
-    return SUCCESS;
+void ServerGameEngine::broadcastGameOver(uint32_t lobbyId, bool victory,
+                                         const std::vector<std::tuple<uint32_t, int, bool>>& scores) {
+    network::GameOverPacket packet;
+    packet.victory = victory;
+    packet.player_count = std::min(static_cast<size_t>(8), scores.size());
+    for (size_t i = 0; i < packet.player_count; ++i) {
+        packet.players[i].client_id = std::get<0>(scores[i]);
+        packet.players[i].score = std::get<1>(scores[i]);
+        packet.players[i].is_alive = std::get<2>(scores[i]);
+    }
+
+    auto network_instance = _network->getNetworkInstance();
+    if (!std::holds_alternative<std::shared_ptr<network::Server>>(network_instance)) {
+        return;
+    }
+    auto server = std::get<std::shared_ptr<network::Server>>(network_instance);
+    server->SaveScores(scores);
+
+    auto lobbyOpt = _lobbyManager.getLobby(lobbyId);
+    if (!lobbyOpt) {
+        return;
+    }
+
+    // Broadcast S_GAME_OVER
+    for (const auto& client : lobbyOpt->get().getClients()) {
+        server->AddMessageToPlayer(network::GameEvents::S_GAME_OVER, client.id, packet);
+    }
+
+    resetLobbyWorld(lobbyId);
+
+    lobbyOpt->get().setState(engine::core::Lobby::State::WAITING);
+
+    for (const auto& client : lobbyOpt->get().getClients()) {
+        lobbyOpt->get().setPlayerReady(client.id, false);
+    }
+
+    for (const auto& client : lobbyOpt->get().getClients()) {
+        for (const auto& receiver : lobbyOpt->get().getClients()) {
+            network::message<network::GameEvents> reply;
+            reply.header.id = network::GameEvents::S_CANCEL_READY_BROADCAST;
+            reply << client.id;
+            server->AddMessageToPlayer(network::GameEvents::S_CANCEL_READY_BROADCAST, receiver.id, reply);
+        }
+    }
+
+    server->AddMessageToLobby(network::GameEvents::S_RETURN_TO_LOBBY, lobbyId, 0);
+
+    std::cout << "SERVER: Broadcasted Game Over for lobby " << lobbyId << std::endl;
 }
 
 void ServerGameEngine::processNetworkEvents() {
@@ -285,72 +325,7 @@ void ServerGameEngine::processNetworkEvents() {
                                   << lobbyId << std::endl;
                         lobby.setState(engine::core::Lobby::State::WAITING);
 
-                        auto& ecs = _env->getECS();
-                        std::unordered_set<Entity> entitiesToDestroy;
-
-                        auto& lobbyIds = ecs.registry.getEntities<LobbyIdComponent>();
-                        for (auto entity : lobbyIds) {
-                            if (ecs.registry.hasComponent<LobbyIdComponent>(entity)) {
-                                if (ecs.registry.getComponent<LobbyIdComponent>(entity).lobby_id == lobbyId) {
-                                    entitiesToDestroy.insert(entity);
-                                }
-                            }
-                        }
-
-                        auto& taggedEntities = ecs.registry.getEntities<TagComponent>();
-                        for (auto entity : taggedEntities) {
-                            if (!ecs.registry.hasComponent<TagComponent>(entity))
-                                continue;
-                            auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-                            bool isDynamic = false;
-                            for (const auto& tag : tags.tags) {
-                                if (tag == "PROJECTILE" || tag == "ENEMY_PROJECTILE" || tag == "FRIENDLY_PROJECTILE" ||
-                                    tag == "ENEMY" || tag == "BOSS" || tag == "OBSTACLE" || tag == "POD" ||
-                                    tag == "POWERUP" || tag == "LEADERBOARD_DATA" || tag == "PLAYER" || tag == "AI") {
-                                    isDynamic = true;
-                                    break;
-                                }
-                            }
-                            if (isDynamic) {
-                                uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                                if (entLobby == lobbyId || entLobby == 0) {
-                                    entitiesToDestroy.insert(entity);
-                                }
-                            }
-                        }
-
-                        auto& spawners = ecs.registry.getEntities<EnemySpawnComponent>();
-                        for (auto entity : spawners) {
-                            if (ecs.registry.hasComponent<EnemySpawnComponent>(entity)) {
-                                const auto& spawnComp = ecs.registry.getConstComponent<EnemySpawnComponent>(entity);
-                                if (spawnComp.lobby_id == lobbyId) {
-                                    entitiesToDestroy.insert(entity);
-                                }
-                            }
-                        }
-
-                        auto& timers = ecs.registry.getEntities<GameTimerComponent>();
-                        for (auto entity : timers) {
-                            uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                            if (entLobby == lobbyId) {
-                                entitiesToDestroy.insert(entity);
-                            }
-                        }
-
-                        // Cleanup Scores
-                        auto& scores = ecs.registry.getEntities<ScoreComponent>();
-                        for (auto entity : scores) {
-                            uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                            if (entLobby == lobbyId) {
-                                entitiesToDestroy.insert(entity);
-                            }
-                        }
-
-                        for (auto entity : entitiesToDestroy) {
-                            ecs.registry.destroyEntity(entity);
-                        }
-                        std::cout << "SERVER: Destroyed " << entitiesToDestroy.size() << " entities for lobby "
-                                  << lobbyId << " (Abort Reset)" << std::endl;
+                        resetLobbyWorld(lobbyId);
 
                         // Reset all players ready
                         for (const auto& client : lobby.getClients()) {
@@ -416,21 +391,73 @@ void ServerGameEngine::processNetworkEvents() {
         for (const auto& msg : pending.at(network::GameEvents::C_DISCONNECT)) {
             uint32_t clientId = msg.header.user_id;
             _lobbyManager.onClientDisconnected(clientId);
+            _network->getSentSnapshots().removeClient(clientId);
+            _network->getSentAnimationSets().removeClient(clientId);
+            _fullStateStreams.erase(clientId);
+            input_manager.removeClient(clientId);
             _clientToEntityMap.erase(clientId);
             _players.erase(clientId);
             std::cout << "SERVER: Client " << clientId << " disconnected." << std::endl;
         }
     }
 
+    // Action names come over TCP before the bits that refer to them are read
+    if (pending.count(network::GameEvents::C_INPUT_ACTIONS)) {
+        for (auto& msg : pending.at(network::GameEvents::C_INPUT_ACTIONS)) {
+            InputActionsPacket packet;
+            msg >> packet;
+            input_manager.registerClientActions(packet, msg.header.user_id);
+        }
+    }
+
     if (pending.count(network::GameEvents::C_INPUT)) {
         auto& input_messages = pending.at(network::GameEvents::C_INPUT);
         for (auto& msg : input_messages) {
-            ActionPacket packet;
+            InputPacket packet;
             msg >> packet;
             updateActions(packet, msg.header.user_id);
         }
     }
 
+    if (pending.count(network::GameEvents::C_FULL_STATE_ACK)) {
+        for (auto& msg : pending.at(network::GameEvents::C_FULL_STATE_ACK)) {
+            uint32_t received = 0;
+            msg >> received;
+            auto it = _fullStateStreams.find(msg.header.user_id);
+            if (it != _fullStateStreams.end()) {
+                it->second.acknowledge(received);
+            }
+        }
+    }
+
+    // The client dropped a world it could not put back together, it gets a new capture from offset 0
+    if (pending.count(network::GameEvents::C_FULL_STATE_RESEND)) {
+        auto network_instance = _network->getNetworkInstance();
+        for (const auto& msg : pending.at(network::GameEvents::C_FULL_STATE_RESEND)) {
+            uint32_t clientId = msg.header.user_id;
+            if (!std::holds_alternative<std::shared_ptr<network::Server>>(network_instance) ||
+                _pendingFullState.count(clientId) || !_lobbyManager.getLobbyForClient(clientId).has_value()) {
+                continue;
+            }
+            std::cout << "SERVER: Client " << clientId << " dropped its full state, sending it again" << std::endl;
+            captureFullState(clientId, *std::get<std::shared_ptr<network::Server>>(network_instance));
+        }
+    }
+
+    if (pending.count(network::GameEvents::C_SNAPSHOT_ACK)) {
+        auto& baselines = _network->getSentSnapshots();
+        for (auto& msg : pending.at(network::GameEvents::C_SNAPSHOT_ACK)) {
+            network::SnapshotAckPacket ack;
+            msg >> ack;
+            for (auto sequence : ack.sequences) {
+                baselines.acknowledge(msg.header.user_id, sequence);
+            }
+            if (ack.resync) {
+                baselines.resetClient(msg.header.user_id);
+            }
+        }
+    }
+
     if (pending.count(network::GameEvents::C_TEAM_CHAT)) {
         auto& msgs = pending.at(network::GameEvents::C_TEAM_CHAT);
         for (auto& msg : msgs) {
@@ -485,71 +512,7 @@ void ServerGameEngine::processNetworkEvents() {
 
                 lobby.setState(engine::core::Lobby::State::WAITING);
 
-                auto& ecs = _env->getECS();
-                std::unordered_set<Entity> entitiesToDestroy;
-
-                auto& lobbyIds = ecs.registry.getEntities<LobbyIdComponent>();
-                for (auto entity : lobbyIds) {
-                    if (ecs.registry.hasComponent<LobbyIdComponent>(entity)) {
-                        if (ecs.registry.getComponent<LobbyIdComponent>(entity).lobby_id == lobbyId) {
-                            entitiesToDestroy.insert(entity);
-                        }
-                    }
-                }
-                // Cleanup via Tags (Ghosts)
-                auto& taggedEntities = ecs.registry.getEntities<TagComponent>();
-                for (auto entity : taggedEntities) {
-                    if (!ecs.registry.hasComponent<TagComponent>(entity))
-                        continue;
-                    auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-                    bool isDynamic = false;
-                    for (const auto& tag : tags.tags) {
-                        if (tag == "PROJECTILE" || tag == "ENEMY_PROJECTILE" || tag == "FRIENDLY_PROJECTILE" ||
-                            tag == "ENEMY" || tag == "BOSS" || tag == "OBSTACLE" || tag == "POD" || tag == "POWERUP" ||
-                            tag == "LEADERBOARD_DATA" || tag == "PLAYER" || tag == "AI") {
-                            isDynamic = true;
-                            break;
-                        }
-                    }
-                    if (isDynamic) {
-                        uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                        if (entLobby == lobbyId || entLobby == 0) {
-                            entitiesToDestroy.insert(entity);
-                        }
-                    }
-                }
-
-                auto& spawners = ecs.registry.getEntities<EnemySpawnComponent>();
-                for (auto entity : spawners) {
-                    if (ecs.registry.hasComponent<EnemySpawnComponent>(entity)) {
-                        const auto& spawnComp = ecs.registry.getConstComponent<EnemySpawnComponent>(entity);
-                        if (spawnComp.lobby_id == lobbyId) {
-                            entitiesToDestroy.insert(entity);
-                        }
-                    }
-                }
-
-                auto& timers = ecs.registry.getEntities<GameTimerComponent>();
-                for (auto entity : timers) {
-                    uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                    if (entLobby == lobbyId) {
-                        entitiesToDestroy.insert(entity);
-                    }
-                }
-
-                auto& scores = ecs.registry.getEntities<ScoreComponent>();
-                for (auto entity : scores) {
-                    uint32_t entLobby = engine::utils::getLobbyId(ecs.registry, entity);
-                    if (entLobby == lobbyId) {
-                        entitiesToDestroy.insert(entity);
-                    }
-                }
-
-                for (auto entity : entitiesToDestroy) {
-                    ecs.registry.destroyEntity(entity);
-                }
-                std::cout << "SERVER: Destroyed " << entitiesToDestroy.size() << " entities for lobby " << lobbyId
-                          << " (Manual Reset)" << std::endl;
+                resetLobbyWorld(lobbyId);
 
                 for (const auto& client : lobby.getClients()) {
                     lobby.setPlayerReady(client.id, false);
@@ -587,17 +550,47 @@ void ServerGameEngine::processNetworkEvents() {
             continue;
         }
         auto server = std::get<std::shared_ptr<network::Server>>(network_instance);
-        uint32_t clientLobbyId = 0;
-        auto lobbyOpt = _lobbyManager.getLobbyForClient(clientId);
-        if (lobbyOpt.has_value()) {
-            clientLobbyId = lobbyOpt->get().getId();
+        captureFullState(clientId, *server);
+
+        auto playerIt = _players.find(clientId);
+        if (playerIt != _players.end()) {
+            network::AssignPlayerEntityPacket assignPacket;
+            assignPacket.entityId = playerIt->second->getId();
+            server->AddMessageToPlayer(network::GameEvents::S_ASSIGN_PLAYER_ENTITY, clientId, assignPacket);
         }
+    }
 
-        SerializationContext s_ctx = {_texture_manager};
-        auto& pools = _ecs.registry.getComponentPools();
+    auto network_instance = _network->getNetworkInstance();
+    if (std::holds_alternative<std::shared_ptr<network::Server>>(network_instance)) {
+        streamFullStates(*std::get<std::shared_ptr<network::Server>>(network_instance));
+    }
+}
+
+void ServerGameEngine::captureFullState(uint32_t clientId, network::Server& server) {
+    uint32_t clientLobbyId = 0;
+    auto lobbyOpt = _lobbyManager.getLobbyForClient(clientId);
+    if (lobbyOpt.has_value()) {
+        clientLobbyId = lobbyOpt->get().getId();
+    }
 
-        int totalPacketsSent = 0;
-        for (auto& [type, pool] : pools) {
+    // A (re)joining client has none of our baselines. The world goes whole over TCP, and the
+    // batches sent from now on carry newer values, the client keeps those over the world's
+    auto& baselines = _network->getSentSnapshots();
+    auto& stream = _fullStateStreams[clientId];
+    baselines.resetClient(clientId);
+    stream.begin(baselines.nextSequence(clientId));
+
+    // Everything in the world of its lobby belongs to the game of the client
+    auto worldIt = _worlds.find(clientLobbyId);
+    if (worldIt != _worlds.end()) {
+        auto& registry = worldIt->second->getECS().registry;
+        std::vector<uint64_t> animationSets;
+        SerializationContext s_ctx = {worldIt->second->getTextureManager(), &animationSets};
+
+        for (auto& pool : registry.getComponentPools()) {
+            if (!pool) {
+                continue;
+            }
             uint32_t typeHash = pool->getTypeHash();
             if (_networkedComponentTypes.find(typeHash) == _networkedComponentTypes.end()) {
                 continue;
@@ -605,76 +598,85 @@ void ServerGameEngine::processNetworkEvents() {
 
             auto& entities = pool->getIdList();
             for (auto entity : entities) {
-                if (!_ecs.registry.hasComponent<NetworkIdentity>(entity)) {
-                    continue;
-                }
-
-                uint32_t entityLobbyId = engine::utils::getLobbyId(_ecs.registry, entity);
-                if (entityLobbyId != 0 && entityLobbyId != clientLobbyId) {
+                if (!registry.hasComponent<NetworkIdentity>(entity)) {
                     continue;
                 }
 
                 ComponentPacket packet = pool->createPacket(entity, s_ctx);
-                packet.entity_guid = _ecs.registry.getConstComponent<NetworkIdentity>(entity).guid;
-                packet.owner_id = _ecs.registry.getConstComponent<NetworkIdentity>(entity).ownerId;
-                server->AddMessageToPlayer(network::GameEvents::S_SNAPSHOT, clientId, packet);
-                totalPacketsSent++;
+                packet.entity_guid = registry.getConstComponent<NetworkIdentity>(entity).guid;
+                packet.owner_id = registry.getConstComponent<NetworkIdentity>(entity).ownerId;
+                stream.add(packet);
             }
         }
+        // Ahead of the world on the same connection, the client knows every set once it reads it
+        _network->getSentAnimationSets().send(server, clientId, animationSets);
+    }
+    stream.finish();
+    std::cout << "SERVER: Full state for client " << clientId << ": " << stream.rawSize() << " bytes, "
+              << stream.compressedSize() << " compressed" << std::endl;
+}
 
-        auto playerIt = _players.find(clientId);
-        if (playerIt != _players.end()) {
-            network::AssignPlayerEntityPacket assignPacket;
-            assignPacket.entityId = playerIt->second->getId();
-            server->AddMessageToPlayer(network::GameEvents::S_ASSIGN_PLAYER_ENTITY, clientId, assignPacket);
+void ServerGameEngine::streamFullStates(network::Server& server) {
+    network::FullStateChunkPacket chunk;
+
+    for (auto it = _fullStateStreams.begin(); it != _fullStateStreams.end();) {
+        while (it->second.nextChunk(chunk)) {
+            server.AddMessageToPlayer(network::GameEvents::S_FULL_STATE_CHUNK, it->first, chunk);
+        }
+        if (it->second.done()) {
+            it = _fullStateStreams.erase(it);
+        } else {
+            ++it;
         }
     }
 }
 
-void ServerGameEngine::updateActions(ActionPacket& packet, uint32_t clientId) {
+void ServerGameEngine::updateActions(InputPacket& packet, uint32_t clientId) {
     auto it = _clientToEntityMap.find(clientId);
 
     input_manager.updateActionFromPacket(packet, clientId);
 }
 
-int ServerGameEngine::run() {
-    system_context ctx = {
-        0,         _currentTick, _texture_manager, _sound_manager,           _music_manager, input_manager,
-        *_network, {},           &_lobbyManager,   &_networkedComponentTypes};
-    auto last_time = std::chrono::high_resolution_clock::now();
+void ServerGameEngine::tick(float dt) {
+    processNetworkEvents();
+    syncLobbyWorlds();
 
-    init();
-
-    if (_init_function) {
-        _init_function(_env, input_manager);
+    for (auto& [lobbyId, world] : _worlds) {
+        world->runLoopFunction(input_manager);
     }
 
-    while (1) {
-        auto now = std::chrono::high_resolution_clock::now();
-        ctx.dt = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_time).count() / 1000.0f;
-        last_time = now;
+    stepLobbyWorlds(dt);
+    _network->flushUdp();
+
+    input_manager.resetFrameFlags();
+    _currentTick++;
+}
 
-        processNetworkEvents();
+int ServerGameEngine::run() {
+    init();
 
-        if (_loop_function) {
-            _loop_function(_env, input_manager);
+    TickStats reported;
+    _scheduler.reset();
+    while (1) {
+        // Every tick advances the simulation by the same dt, late ticks are caught up back to back
+        uint32_t due = _scheduler.waitForTicks();
+        for (uint32_t i = 0; i < due; ++i) {
+            auto start = TickScheduler::Clock::now();
+            tick(_scheduler.getTickDt());
+            _scheduler.recordTick(TickScheduler::Clock::now() - start);
         }
 
-        ctx.active_clients.clear();
-        for (const auto& [lobbyId, lobby] : _lobbyManager.getAllLobbies()) {
-            if (lobby.getState() == engine::core::Lobby::State::IN_GAME) {
-                for (const auto& client : lobby.getClients()) {
-                    ctx.active_clients.push_back(client.id);
-                }
+        const auto& stats = _scheduler.getStats();
+        if (stats.ticks - reported.ticks >= 10 * _scheduler.getTickRate()) {
+            if (stats.overruns != reported.overruns || stats.dropped_ticks != reported.dropped_ticks) {
+                std::cout << "SERVER: " << stats.overruns - reported.overruns << " tick overruns and "
+                          << stats.dropped_ticks - reported.dropped_ticks << " dropped ticks in the last "
+                          << stats.ticks - reported.ticks << " ticks (average " << stats.average_work_ms
+                          << " ms, max " << stats.max_work_ms << " ms, budget "
+                          << 1000.0 / _scheduler.getTickRate() << " ms)" << std::endl;
             }
+            reported = stats;
         }
-
-        _ecs.update(ctx);
-
-        input_manager.resetFrameFlags();
-
-        _currentTick++;
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
     }
     return SUCCESS;
 }
@@ -7,6 +7,7 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <tuple>
 
 #include "Components/NetworkComponents.hpp"
 #include "ECS/ECS.hpp"
@@ -21,21 +22,48 @@
 #include "ComponentSenderSystem/ComponentSenderSystem.hpp"
 #include "ServerResourceManager.hpp"
 #include "LobbyManager.hpp"
+#include "LobbyWorld.hpp"
+#include "ECS/Utils/TickScheduler/TickScheduler.hpp"
+#include "NetworkEngine/FullState.hpp"
 
 #define SUCCESS 0
 #define FAILURE -1
 class Player;
+namespace network {
+class Server;
+}
 
 class ServerGameEngine : public GameEngineBase<ServerGameEngine> {
-   private:
-    std::shared_ptr<Environment> _env;
+   public:
+    // Init and loop functions of the game played in one lobby
+    struct GameFunctions {
+        std::function<USER_FUNCTION_SIGNATURE> init;
+        std::function<USER_FUNCTION_SIGNATURE> loop;
+    };
 
+   private:
     engine::core::LobbyManager _lobbyManager;
+    std::map<uint32_t, std::unique_ptr<engine::core::LobbyWorld>> _worlds;  // One game world per lobby
+    std::set<uint32_t> _worldsToReset;  // Lobbies back from a game, their world is rebuilt before the next tick
     std::map<uint32_t, Entity> _clientToEntityMap;
     std::map<uint32_t, std::shared_ptr<Player>> _players;
     std::set<uint32_t> _pendingFullState;  // Clients waiting for UDP confirmation to receive full state
+    std::map<uint32_t, engine::core::FullStateWriter> _fullStateStreams;  // Worlds still streaming to their client
+    TickScheduler _scheduler;
+    std::function<GameFunctions()> _gameFactory;
+    void tick(float dt);
     void processNetworkEvents();
-    void updateActions(ActionPacket& packet, uint32_t clientId);
+    void updateActions(InputPacket& packet, uint32_t clientId);
+    // Start a new full state stream for a client, from its lobby world as it is now
+    void captureFullState(uint32_t clientId, network::Server& server);
+    void streamFullStates(network::Server& server);
+
+    std::unique_ptr<engine::core::LobbyWorld> createLobbyWorld(uint32_t lobbyId);
+    void syncLobbyWorlds();
+    void stepLobbyWorlds(float dt);
+    void resetLobbyWorld(uint32_t lobbyId) { _worldsToReset.insert(lobbyId); }
+    void registerPlayer(uint32_t clientId, std::shared_ptr<Player> player);
+    void broadcastGameOver(uint32_t lobbyId, bool victory, const std::vector<std::tuple<uint32_t, int, bool>>& scores);
 
    public:
     int init();
@@ -43,6 +71,21 @@ class ServerGameEngine : public GameEngineBase<ServerGameEngine> {
     explicit ServerGameEngine(std::string ip = "");
     ~ServerGameEngine() = default;
 
+    /**
+        A function to choose the number of simulation ticks per second
+        @param uint32_t tick_rate, usually 30, 60 or 120
+    */
+    void setTickRate(uint32_t tick_rate) { _scheduler.setTickRate(tick_rate); }
+    const TickStats& getTickStats() const { return _scheduler.getStats(); }
+
+    /**
+        A function to give every lobby world a game of its own
+        The factory is called once per world, the functions it returns may own state no other lobby sees.
+        Without one, every world runs the functions given to setInitFunction and setLoopFunction
+        @param std::function<GameFunctions()> factory
+    */
+    void setGameFactory(std::function<GameFunctions()> factory) { _gameFactory = std::move(factory); }
+
     static constexpr bool IsServer = true;
     std::optional<Entity> getLocalPlayerEntity() const { return std::nullopt; }
     engine::core::LobbyManager& getLobbyManager() { return _lobbyManager; }
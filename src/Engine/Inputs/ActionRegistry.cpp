@@ -5,21 +5,31 @@
 ** ActionRegistry.cpp
 */
 
+#include <iostream>
 #include <string>
 
 #include "ActionRegistry.hpp"
 
-const Action& ActionRegistry::registerAction(const std::string& name) {
-    if (_knownNamesSet.insert(name).second) {
-        _actions.emplace_back(name);
-    }
-    for (const auto& a : _actions) {
-        if (a == name)
-            return a;
+ActionId ActionRegistry::registerAction(const std::string& name) {
+    auto it = _ids.find(name);
+    if (it != _ids.end())
+        return it->second;
+
+    if (_actions.size() >= MAX_INPUT_ACTIONS) {
+        std::cerr << "[INPUT] Too many actions, \"" << name << "\" is ignored" << std::endl;
+        return INVALID_ACTION_ID;
     }
-    return _actions.front();
+    ActionId id = static_cast<ActionId>(_actions.size());
+    _actions.emplace_back(name);
+    _ids.emplace(name, id);
+    return id;
 }
 
 bool ActionRegistry::exists(const std::string& name) const {
-    return _knownNamesSet.find(name) != _knownNamesSet.end();
+    return _ids.find(name) != _ids.end();
+}
+
+ActionId ActionRegistry::getId(const std::string& name) const {
+    auto it = _ids.find(name);
+    return it != _ids.end() ? it->second : INVALID_ACTION_ID;
 }
@@ -5,21 +5,37 @@
 ** ActionRegistry.hpp
 */
 
+#pragma once
+
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 
 #include "InputAction.hpp"
 
 class ActionRegistry {
    public:
-    const Action& registerAction(const std::string& name);
+    /**
+        Give an action its id, the next free one the first time it is seen
+        @param std::string name of the action
+        @return ActionId id of the action, INVALID_ACTION_ID once MAX_INPUT_ACTIONS are registered
+    */
+    ActionId registerAction(const std::string& name);
 
     std::vector<Action>& getActions(void) { return this->_actions; }
 
     bool exists(const std::string& name) const;
 
+    /**
+        @return ActionId id of the action, INVALID_ACTION_ID if it was never registered
+    */
+    ActionId getId(const std::string& name) const;
+
+    const Action& getName(ActionId id) const { return _actions[id]; }
+
+    std::size_t size() const { return _actions.size(); }
+
    private:
     std::vector<Action> _actions;
-    std::unordered_set<std::string> _knownNamesSet;
+    std::unordered_map<std::string, ActionId> _ids;
 };
@@ -7,6 +7,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 using Action = std::string;
+
+// Dense index of an action in its ActionRegistry, the bit it takes in an input mask
+using ActionId = uint8_t;
+
+inline constexpr std::size_t MAX_INPUT_ACTIONS = 32;  // bits of an InputPacket mask
+inline constexpr ActionId INVALID_ACTION_ID = 0xFF;
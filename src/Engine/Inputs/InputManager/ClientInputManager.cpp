@@ -1,4 +1,5 @@
 #include "ClientInputManager.hpp"
+#include <algorithm>
 #include <cstdint>
 #include "Components/NetworkComponents.hpp"
 #include "Context.hpp"
@@ -35,24 +36,19 @@ bool ClientInputManager::isBindingActive(const InputBinding& b) const {
 }
 
 void ClientInputManager::update(engine::core::NetworkEngine& network, uint32_t tick, system_context& ctx) {
-    if (!_hasFocus) {
-        for (auto& [action, state] : _states) {
-            state.pressed = false;
-            state.justPressed = false;
-            state.justReleased = false;
-            state.holdTime = 0.f;
-        }
-        return;
-    }
+    uint32_t mask = 0;
 
-    for (auto& [action, bindings] : _bindings) {
-        ActionState& st = this->_states[action];
+    for (std::size_t id = 0; id < _bindings.size(); ++id) {
+        ActionState& st = this->_states[id];
 
+        // Without focus every action reads as released, the server sees the release like any other
         bool down = false;
-        for (const auto& b : bindings) {
-            if (isBindingActive(b)) {
-                down = true;
-                break;
+        if (_hasFocus) {
+            for (const auto& b : _bindings[id]) {
+                if (isBindingActive(b)) {
+                    down = true;
+                    break;
+                }
             }
         }
 
@@ -70,28 +66,57 @@ void ClientInputManager::update(engine::core::NetworkEngine& network, uint32_t t
         }
         st.pressed = down;
 
-        if (st.justPressed || st.justReleased || st.pressed) {
-            createActionPacket(action, st, network, ctx);
-        }
+        if (down)
+            mask |= 1u << id;
     }
+
+    announceActions(network, tick);
+    sendInputFrame(mask, network, tick);
 }
 
-void ClientInputManager::createActionPacket(Action name, ActionState state, engine::core::NetworkEngine& network,
-                                            system_context& ctx) {
-    ActionPacket packet;
+void ClientInputManager::announceActions(engine::core::NetworkEngine& network, uint32_t tick) {
+    if (_announcedActions >= _actionRegistry.size())
+        return;
 
-    packet.action_name = name;
-    packet.action_state = state;
+    InputActionsPacket packet;
+    packet.first_id = static_cast<uint8_t>(_announcedActions);
+    for (std::size_t id = _announcedActions; id < _actionRegistry.size(); ++id) {
+        packet.actions.push_back(_actionRegistry.getName(static_cast<ActionId>(id)));
+    }
+    network.transmitEvent(network::GameEvents::C_INPUT_ACTIONS, packet, tick);
+    _announcedActions = _actionRegistry.size();
+}
+
+void ClientInputManager::sendInputFrame(uint32_t mask, engine::core::NetworkEngine& network, uint32_t tick) {
+    auto& masks = _inputPacket.masks;
+
+    // A skipped tick has nothing held, and the window only keeps ticks up to this one
+    if (!masks.empty() && tick - _inputPacket.tick > 1) {
+        uint32_t gap = std::min<uint32_t>(tick - _inputPacket.tick - 1, network::INPUT_REDUNDANT_FRAMES);
+        masks.insert(masks.end(), gap, 0u);
+    }
+    masks.push_back(mask);
+    if (masks.size() > network::INPUT_REDUNDANT_FRAMES)
+        masks.erase(masks.begin(), masks.end() - network::INPUT_REDUNDANT_FRAMES);
+    _inputPacket.tick = tick;
 
-    network.transmitEvent(network::GameEvents::C_INPUT, packet, ctx.tick);
-    return;
+    // Idle clients stay quiet once their last release has been repeated enough
+    bool idle = true;
+    for (uint32_t held : masks) {
+        if (held != 0) {
+            idle = false;
+            break;
+        }
+    }
+    if (!idle)
+        network.transmitEvent(network::GameEvents::C_INPUT, _inputPacket, tick);
 }
 
 InputSnapshot ClientInputManager::getCurrentInputSnapshot() const {
     InputSnapshot snapshot;
-    for (const auto& [action, state] : _states) {
-        if (state.pressed) {
-            snapshot.actions[action] = true;
+    for (std::size_t id = 0; id < _states.size() && id < MAX_INPUT_ACTIONS; ++id) {
+        if (_states[id].pressed) {
+            snapshot.pressed |= 1u << id;
         }
     }
     return snapshot;
@@ -19,7 +19,13 @@ class ClientInputManager : public InputManagerBase<ClientInputManager> {
     InputSnapshot getCurrentInputSnapshot() const;
 
    private:
-    void createActionPacket(Action name, ActionState state, engine::core::NetworkEngine& network, system_context& ctx);
+    // Sends the names of the actions bound since the last call, so the server can read their bits
+    void announceActions(engine::core::NetworkEngine& network, uint32_t tick);
+    // Sends the held actions of this tick and of the INPUT_REDUNDANT_FRAMES - 1 before it
+    void sendInputFrame(uint32_t mask, engine::core::NetworkEngine& network, uint32_t tick);
     bool isBindingActive(const InputBinding& binding) const;  // client only
     bool _hasFocus = true;                                    // client only
+
+    std::size_t _announcedActions = 0;
+    InputPacket _inputPacket;
 };
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <unordered_map>
 #include <vector>
 #include "InputAction.hpp"
 #include "InputBinding.hpp"
@@ -10,46 +9,94 @@
 template <class Derived>
 class InputManagerBase {
    public:
-    void bindAction(Action action, const InputBinding& binding) {
-        _actionRegistry.registerAction(action);
-        _bindings[action].push_back(binding);
+    /**
+        Declare an action, so the code reading it can keep its id instead of its name
+        @param Action name of the action
+        @return ActionId id of the action, INVALID_ACTION_ID once MAX_INPUT_ACTIONS are declared
+    */
+    ActionId registerAction(const Action& action) { return _actionRegistry.registerAction(action); }
+
+    ActionId bindAction(Action action, const InputBinding& binding) {
+        ActionId id = registerAction(action);
+        bindAction(id, binding);
+        return id;
+    }
+
+    void bindAction(ActionId id, const InputBinding& binding) {
+        if (id == INVALID_ACTION_ID)
+            return;
+        if (id >= _bindings.size()) {
+            _bindings.resize(id + 1);
+            _states.resize(id + 1);
+        }
+        _bindings[id].push_back(binding);
     }
 
     bool isPressed(Action action) const {
-        auto it = _states.find(action);
-        return it != _states.end() && it->second.pressed;
+        const ActionState* st = findState(action);
+        return st && st->pressed;
     }
 
     bool isJustPressed(Action action) const {
-        auto it = _states.find(action);
-        return it != _states.end() && it->second.justPressed;
+        const ActionState* st = findState(action);
+        return st && st->justPressed;
     }
 
     bool isJustReleased(Action action) const {
-        auto it = _states.find(action);
-        return it != _states.end() && it->second.justReleased;
+        const ActionState* st = findState(action);
+        return st && st->justReleased;
+    }
+
+    // Same queries by the id registerAction returned, without hashing the name
+    bool isPressed(ActionId id) const {
+        const ActionState* st = findState(id);
+        return st && st->pressed;
+    }
+
+    bool isJustPressed(ActionId id) const {
+        const ActionState* st = findState(id);
+        return st && st->justPressed;
+    }
+
+    bool isJustReleased(ActionId id) const {
+        const ActionState* st = findState(id);
+        return st && st->justReleased;
     }
 
     bool isShortPress(Action action, float threshold) const {
-        auto it = _states.find(action);
-        if (it == _states.end())
+        const ActionState* st = findState(action);
+        if (!st)
             return false;
-        const auto& st = it->second;
-        return st.justReleased && st.lastReleaseHoldTime > 0.f && st.lastReleaseHoldTime < threshold;
+        return st->justReleased && st->lastReleaseHoldTime > 0.f && st->lastReleaseHoldTime < threshold;
     }
 
     bool isLongPress(Action action, float threshold) const {
-        auto it = _states.find(action);
-        if (it == _states.end())
+        const ActionState* st = findState(action);
+        if (!st)
             return false;
-        const auto& st = it->second;
-        return st.pressed && st.holdTime >= threshold;
+        return st->pressed && st->holdTime >= threshold;
+    }
+
+    const ActionState& getState(Action action) const {
+        const ActionState* st = findState(action);
+        return st ? *st : _defaultState;
     }
 
-    const ActionState& getState(Action action) const { return _states.at(action); }
+    const ActionState& getState(ActionId id) const {
+        const ActionState* st = findState(id);
+        return st ? *st : _defaultState;
+    }
+
+    const ActionRegistry& getActionRegistry() const { return _actionRegistry; }
 
    protected:
+    const ActionState* findState(const Action& action) const { return findState(_actionRegistry.getId(action)); }
+
+    const ActionState* findState(ActionId id) const { return id < _states.size() ? &_states[id] : nullptr; }
+
     ActionRegistry _actionRegistry;
-    std::unordered_map<Action, std::vector<InputBinding>> _bindings;
-    std::unordered_map<Action, ActionState> _states;
+    // Both indexed by ActionId
+    std::vector<std::vector<InputBinding>> _bindings;
+    std::vector<ActionState> _states;
+    ActionState _defaultState;
 };
@@ -1,46 +1,104 @@
 #include "ServerInputManager.hpp"
 #include "Components/NetworkComponents.hpp"
 
-int ServerInputManager::updateActionFromPacket(ActionPacket packet, uint32_t client_id) {
-    _client_states[client_id][packet.action_name] = packet.action_state;
-    return 0;
+void ServerInputManager::registerClientActions(const InputActionsPacket& packet, uint32_t client_id) {
+    ClientInputs& inputs = _clients[client_id];
+
+    // Names come from the client, they never add to the registry shared by every player
+    for (std::size_t idx = 0; idx < packet.actions.size(); ++idx) {
+        std::size_t client_action = packet.first_id + idx;
+        if (client_action >= MAX_INPUT_ACTIONS)
+            break;
+
+        ActionId id = _actionRegistry.getId(packet.actions[idx]);
+        for (auto& mapped : inputs.remap) {
+            if (mapped == id)
+                mapped = INVALID_ACTION_ID;  // A later name for the same action replaces the earlier one
+        }
+        inputs.remap[client_action] = id;
+    }
 }
 
-const ActionState& ServerInputManager::getClientState(Action action, uint32_t client_id) const {
-    auto client_it = _client_states.find(client_id);
-    if (client_it == _client_states.end()) {
-        return _default_state;
+int ServerInputManager::updateActionFromPacket(const InputPacket& packet, uint32_t client_id) {
+    ClientInputs& inputs = _clients[client_id];
+    int applied = 0;
+
+    // masks.back() is the mask of packet.tick, the ones before are the ticks before it
+    for (std::size_t idx = 0; idx < packet.masks.size(); ++idx) {
+        uint32_t tick = packet.tick - static_cast<uint32_t>(packet.masks.size() - 1 - idx);
+        if (inputs.hasTick && static_cast<int32_t>(tick - inputs.lastTick) <= 0)
+            continue;
+        applyMask(inputs, packet.masks[idx]);
+        inputs.lastTick = tick;
+        inputs.hasTick = true;
+        applied++;
     }
-    auto action_it = client_it->second.find(action);
-    if (action_it == client_it->second.end()) {
-        return _default_state;
+    return applied;
+}
+
+void ServerInputManager::applyMask(ClientInputs& inputs, uint32_t mask) {
+    for (std::size_t client_action = 0; client_action < MAX_INPUT_ACTIONS; ++client_action) {
+        ActionId id = inputs.remap[client_action];
+        if (id == INVALID_ACTION_ID)
+            continue;
+
+        ActionState& st = inputs.states[id];
+        bool down = (mask >> client_action) & 1u;
+        if (down && !st.pressed)
+            st.justPressed = true;
+        if (!down && st.pressed)
+            st.justReleased = true;
+        st.pressed = down;
     }
-    return action_it->second;
+}
+
+const ActionState& ServerInputManager::getClientState(ActionId id, uint32_t client_id) const {
+    auto client_it = _clients.find(client_id);
+    if (client_it == _clients.end() || id >= MAX_INPUT_ACTIONS) {
+        return _defaultState;
+    }
+    return client_it->second.states[id];
 }
 
 bool ServerInputManager::isPressed(Action action, uint32_t client_id) const {
-    return getClientState(action, client_id).pressed;
+    return isPressed(_actionRegistry.getId(action), client_id);
 }
 
 bool ServerInputManager::isJustPressed(Action action, uint32_t client_id) const {
-    return getClientState(action, client_id).justPressed;
+    return isJustPressed(_actionRegistry.getId(action), client_id);
 }
 
 bool ServerInputManager::isJustReleased(Action action, uint32_t client_id) const {
-    return getClientState(action, client_id).justReleased;
+    return isJustReleased(_actionRegistry.getId(action), client_id);
 }
 
 const ActionState& ServerInputManager::getState(Action action, uint32_t client_id) const {
-    return getClientState(action, client_id);
+    return getState(_actionRegistry.getId(action), client_id);
+}
+
+bool ServerInputManager::isPressed(ActionId id, uint32_t client_id) const {
+    return getClientState(id, client_id).pressed;
+}
+
+bool ServerInputManager::isJustPressed(ActionId id, uint32_t client_id) const {
+    return getClientState(id, client_id).justPressed;
+}
+
+bool ServerInputManager::isJustReleased(ActionId id, uint32_t client_id) const {
+    return getClientState(id, client_id).justReleased;
+}
+
+const ActionState& ServerInputManager::getState(ActionId id, uint32_t client_id) const {
+    return getClientState(id, client_id);
 }
 
 void ServerInputManager::removeClient(uint32_t client_id) {
-    _client_states.erase(client_id);
+    _clients.erase(client_id);
 }
 
 void ServerInputManager::resetFrameFlags() {
-    for (auto& [client_id, actions] : _client_states) {
-        for (auto& [action_name, state] : actions) {
+    for (auto& [client_id, inputs] : _clients) {
+        for (auto& state : inputs.states) {
             state.justPressed = false;
             state.justReleased = false;
         }
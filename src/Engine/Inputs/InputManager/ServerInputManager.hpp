@@ -1,22 +1,57 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
 #include "Components/NetworkComponents.hpp"
 #include "InputManagerBase.hpp"
-#include <unordered_map>
 
 class ServerInputManager : public InputManagerBase<ServerInputManager> {
    public:
-    int updateActionFromPacket(ActionPacket packet, uint32_t client_id);
+    // Actions the game reads are declared with registerAction at startup, before any client sends its names
+
+    /**
+        Learn the names behind the ids a client uses in its input masks
+        Only declared actions are mapped, each one to a single client id, other names are ignored
+        @param InputActionsPacket the names, in the client's id order
+        @param uint32_t client_id
+    */
+    void registerClientActions(const InputActionsPacket& packet, uint32_t client_id);
+
+    /**
+        Apply the masks of the ticks not seen yet, in order
+        A press and a release falling between two resetFrameFlags both stay visible
+        @return int number of ticks applied
+    */
+    int updateActionFromPacket(const InputPacket& packet, uint32_t client_id);
 
     bool isPressed(Action action, uint32_t client_id) const;
     bool isJustPressed(Action action, uint32_t client_id) const;
     bool isJustReleased(Action action, uint32_t client_id) const;
     const ActionState& getState(Action action, uint32_t client_id) const;
 
+    // Same queries by the id registerAction returned, what game logic uses every tick
+    bool isPressed(ActionId id, uint32_t client_id) const;
+    bool isJustPressed(ActionId id, uint32_t client_id) const;
+    bool isJustReleased(ActionId id, uint32_t client_id) const;
+    const ActionState& getState(ActionId id, uint32_t client_id) const;
+
     void removeClient(uint32_t client_id);
     void resetFrameFlags();  // Must be called at end of each frame to reset justPressed/justReleased
 
    private:
-    const ActionState& getClientState(Action action, uint32_t client_id) const;
+    struct ClientInputs {
+        // Client action id -> server action id
+        std::array<ActionId, MAX_INPUT_ACTIONS> remap;
+        // Indexed by server action id
+        std::array<ActionState, MAX_INPUT_ACTIONS> states{};
+        uint32_t lastTick = 0;
+        bool hasTick = false;
+
+        ClientInputs() { remap.fill(INVALID_ACTION_ID); }
+    };
+
+    const ActionState& getClientState(ActionId id, uint32_t client_id) const;
+    void applyMask(ClientInputs& inputs, uint32_t mask);
 
-    std::unordered_map<uint32_t, std::unordered_map<Action, ActionState>> _client_states;
-    ActionState _default_state;
+    std::unordered_map<uint32_t, ClientInputs> _clients;
 };
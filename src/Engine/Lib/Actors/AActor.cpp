@@ -35,27 +35,28 @@ Entity AActor::getId() {
 }
 
 std::vector<std::string> AActor::getTags() {
-    return _ecs.registry.getConstComponent<TagComponent>(_id).tags;
+    return _ecs.registry.getConstComponent<TagComponent>(_id).tags.names();
 }
 
 void AActor::setTags(const std::vector<std::string> tags) {
-    _ecs.registry.getComponent<TagComponent>(_id).tags = tags;
+    _ecs.registry.getComponent<TagComponent>(_id).tags = TagSet(tags);
     return;
 }
 
 void AActor::addTag(const std::string tag) {
-    std::vector<std::string>& tags = _ecs.registry.getComponent<TagComponent>(_id).tags;
-    tags.emplace(tags.cbegin(), tag);
+    TagSet& tags = _ecs.registry.getComponent<TagComponent>(_id).tags;
+    if (!tags.add(tag))
+        std::cerr << "The tag " << tag << " couldn't be added, " << MAX_TAGS << " tags already exist" << std::endl;
     return;
 }
 
 void AActor::removeTag(const std::string tag) {
-    std::vector<std::string>& tags = _ecs.registry.getComponent<TagComponent>(_id).tags;
-    if (tags.size() == 1 || find(tags.begin(), tags.end(), tag) == tags.cend()) {
+    TagSet& tags = _ecs.registry.getComponent<TagComponent>(_id).tags;
+    if (tags.size() == 1 || !tags.has(tag)) {
         std::cerr << "The tag " << tag << " coudldn't be removed" << std::endl;
         return;
     }
-    tags.erase(std::remove(tags.begin(), tags.end(), tag), tags.end());
+    tags.remove(tag);
     return;
 }
 
@@ -117,8 +118,8 @@ void AActor::setTextureEnemy(const std::string pathname) {
     } else {
         clip.handle = _textures.load(pathname, TextureAsset(pathname));
     }
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     _ecs.registry.addComponent<AnimatedSprite2D>(_id, animation);
     return;
 }
@@ -160,8 +161,8 @@ void AActor::setTextureBoss(const std::string pathname) {
     } else {
         clip.handle = _textures.load(pathname, TextureAsset(pathname));
     }
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     _ecs.registry.addComponent<AnimatedSprite2D>(_id, animation);
     return;
 }
@@ -198,8 +199,8 @@ void AActor::setTexture(const std::string pathname) {
     } else {
         clip.handle = _textures.load(pathname, TextureAsset(pathname));
     }
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
 
     if (_ecs.registry.hasComponent<AnimatedSprite2D>(_id)) {
         AnimatedSprite2D& comp = _ecs.registry.getComponent<AnimatedSprite2D>(_id);
@@ -238,18 +239,16 @@ void AActor::setTextureDimension(rect dimension) {
     // return;
     if (_ecs.registry.hasComponent<AnimatedSprite2D>(_id)) {
         AnimatedSprite2D& comp = _ecs.registry.getComponent<AnimatedSprite2D>(_id);
-        if (comp.animations.at(comp.currentAnimation).frames.empty()) {
-            comp.animations.at(comp.currentAnimation)
-                .frames.emplace_back(static_cast<int>(dimension.x), static_cast<int>(dimension.y),
-                                     static_cast<int>(dimension.width), static_cast<int>(dimension.height));
-            return;
-        }
-        comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).width =
-            static_cast<int>(dimension.width);
-        comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).height =
-            static_cast<int>(dimension.height);
-        comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).x = static_cast<int>(dimension.x);
-        comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).y = static_cast<int>(dimension.y);
+        Rect2D rect{static_cast<int>(dimension.x), static_cast<int>(dimension.y), static_cast<int>(dimension.width),
+                    static_cast<int>(dimension.height)};
+        std::size_t frame = comp.currentFrameIndex;
+
+        comp.editClip(comp.currentClip, [&](AnimationClip& clip) {
+            if (clip.frames.empty())
+                clip.frames.push_back(rect);
+            else
+                clip.frames.at(frame) = rect;
+        });
         return;
     }
     Sprite2D& comp = _ecs.registry.getComponent<Sprite2D>(_id);
@@ -264,15 +263,15 @@ rect AActor::getDimension() {
     // sprite2D_component_s comp = _ecs.registry.getConstComponent<sprite2D_component_s>(_id);
 
     // return comp.dimension;
-    rect dimension;
+    rect dimension{};
     if (_ecs.registry.hasComponent<AnimatedSprite2D>(_id)) {
         AnimatedSprite2D& comp = _ecs.registry.getComponent<AnimatedSprite2D>(_id);
-        dimension.width =
-            static_cast<float>(comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).width);
-        dimension.height =
-            static_cast<float>(comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).height);
-        dimension.x = static_cast<float>(comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).x);
-        dimension.y = static_cast<float>(comp.animations.at(comp.currentAnimation).frames.at(comp.currentFrameIndex).y);
+        if (const Rect2D* frame = comp.frame()) {
+            dimension.width = static_cast<float>(frame->width);
+            dimension.height = static_cast<float>(frame->height);
+            dimension.x = static_cast<float>(frame->x);
+            dimension.y = static_cast<float>(frame->y);
+        }
         return dimension;
     }
     Sprite2D& comp = _ecs.registry.getComponent<Sprite2D>(_id);
@@ -315,7 +314,7 @@ void AActor::setAnimationSpeed(float speed) {
     // comp.animation_speed = speed;
     if (_ecs.registry.hasComponent<AnimatedSprite2D>(_id)) {
         AnimatedSprite2D& comp = _ecs.registry.getComponent<AnimatedSprite2D>(_id);
-        comp.animations.at(comp.currentAnimation).frameDuration = speed;
+        comp.editClip(comp.currentClip, [speed](AnimationClip& clip) { clip.frameDuration = speed; });
         return;
     }
     Sprite2D& comp = _ecs.registry.getComponent<Sprite2D>(_id);
@@ -328,7 +327,7 @@ float AActor::getAnimationSpeed() {
     // return comp.animation_speed;
     if (_ecs.registry.hasComponent<AnimatedSprite2D>(_id)) {
         AnimatedSprite2D& comp = _ecs.registry.getComponent<AnimatedSprite2D>(_id);
-        return comp.animations.at(comp.currentAnimation).frameDuration;
+        return comp.clip() ? comp.clip()->frameDuration : 0.f;
     }
     Sprite2D& comp = _ecs.registry.getComponent<Sprite2D>(_id);
     return 0.f;
@@ -363,30 +362,31 @@ int AActor::getDisplayLayer() {
 void AActor::setCollisionTags(std::vector<std::string> tags) {
     BoxCollisionComponent& comp = _ecs.registry.getComponent<BoxCollisionComponent>(_id);
 
-    comp.tagCollision = tags;
+    comp.tagCollision = TagSet(tags);
     return;
 }
 
 void AActor::addCollisionTag(const std::string tag) {
-    std::vector<std::string>& tags = _ecs.registry.getComponent<BoxCollisionComponent>(_id).tagCollision;
+    TagSet& tags = _ecs.registry.getComponent<BoxCollisionComponent>(_id).tagCollision;
 
-    tags.push_back(tag);
+    if (!tags.add(tag))
+        std::cerr << "The tag " << tag << " couldn't be added, " << MAX_TAGS << " tags already exist" << std::endl;
     return;
 }
 
 void AActor::removeCollisionTag(const std::string tag) {
-    std::vector<std::string>& tags = _ecs.registry.getComponent<BoxCollisionComponent>(_id).tagCollision;
+    TagSet& tags = _ecs.registry.getComponent<BoxCollisionComponent>(_id).tagCollision;
 
-    if (find(tags.begin(), tags.end(), tag) == tags.cend()) {
+    if (!tags.has(tag)) {
         std::cerr << "The tag " << tag << " coudldn't be removed" << std::endl;
         return;
     }
-    tags.erase(std::remove(tags.begin(), tags.end(), tag), tags.end());
+    tags.remove(tag);
     return;
 }
 
 void AActor::emptyCollisionTags() {
-    std::vector<std::string>& tags = _ecs.registry.getComponent<BoxCollisionComponent>(_id).tagCollision;
+    TagSet& tags = _ecs.registry.getComponent<BoxCollisionComponent>(_id).tagCollision;
 
     tags.clear();
     return;
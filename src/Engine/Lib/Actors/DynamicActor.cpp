@@ -104,60 +104,78 @@ std::pair<float, float> DynamicActor::getvelocity() {
 }
 
 void DynamicActor::bindActionCallbackOnPressed(Action action_name, ActionCallback callback) {
+    bindActionCallbackOnPressed(_ecs.input.registerAction(action_name), callback);
+}
+
+void DynamicActor::bindActionCallbackPressed(Action action_name, ActionCallback callback) {
+    bindActionCallbackPressed(_ecs.input.registerAction(action_name), callback);
+}
+
+void DynamicActor::bindActionCallbackOnReleased(Action action_name, ActionCallback callback) {
+    bindActionCallbackOnReleased(_ecs.input.registerAction(action_name), callback);
+}
+
+void DynamicActor::bindActionCallbackOnPressed(ActionId action, ActionCallback callback) {
     ActionScript& comp = _ecs.registry.getComponent<ActionScript>(_id);
 
-    comp.actionOnPressed[action_name] = callback;
+    if (action == INVALID_ACTION_ID)
+        return;
+    comp.actionOnPressed[action] = callback;
     return;
 }
 
-void DynamicActor::bindActionCallbackPressed(Action action_name, ActionCallback callback) {
+void DynamicActor::bindActionCallbackPressed(ActionId action, ActionCallback callback) {
     ActionScript& comp = _ecs.registry.getComponent<ActionScript>(_id);
 
-    comp.actionPressed[action_name] = callback;
+    if (action == INVALID_ACTION_ID)
+        return;
+    comp.actionPressed[action] = callback;
     return;
 }
 
-void DynamicActor::bindActionCallbackOnReleased(Action action_name, ActionCallback callback) {
+void DynamicActor::bindActionCallbackOnReleased(ActionId action, ActionCallback callback) {
     ActionScript& comp = _ecs.registry.getComponent<ActionScript>(_id);
 
-    comp.actionOnReleased[action_name] = callback;
+    if (action == INVALID_ACTION_ID)
+        return;
+    comp.actionOnReleased[action] = callback;
     return;
 }
 
 void DynamicActor::removeActionCallbackOnPressed(Action action_name) {
     ActionScript& comp = _ecs.registry.getComponent<ActionScript>(_id);
 
-    comp.actionOnPressed.erase(action_name);
+    comp.actionOnPressed.erase(_ecs.input.getActionRegistry().getId(action_name));
     return;
 }
 
 void DynamicActor::removeActionCallbackPressed(Action action_name) {
     ActionScript& comp = _ecs.registry.getComponent<ActionScript>(_id);
 
-    comp.actionPressed.erase(action_name);
+    comp.actionPressed.erase(_ecs.input.getActionRegistry().getId(action_name));
     return;
 }
 
 void DynamicActor::removeActionCallbackOnReleased(Action action_name) {
     ActionScript& comp = _ecs.registry.getComponent<ActionScript>(_id);
 
-    comp.actionOnReleased.erase(action_name);
+    comp.actionOnReleased.erase(_ecs.input.getActionRegistry().getId(action_name));
     return;
 }
 
-std::unordered_map<Action, ActionCallback> DynamicActor::getActionCallbackOnPressed() {
+std::unordered_map<ActionId, ActionCallback> DynamicActor::getActionCallbackOnPressed() {
     ActionScript comp = _ecs.registry.getConstComponent<ActionScript>(_id);
 
     return comp.actionOnPressed;
 }
 
-std::unordered_map<Action, ActionCallback> DynamicActor::getActionCallbackPressed() {
+std::unordered_map<ActionId, ActionCallback> DynamicActor::getActionCallbackPressed() {
     ActionScript comp = _ecs.registry.getConstComponent<ActionScript>(_id);
 
     return comp.actionPressed;
 }
 
-std::unordered_map<Action, ActionCallback> DynamicActor::getActionCallbackOnReleased() {
+std::unordered_map<ActionId, ActionCallback> DynamicActor::getActionCallbackOnReleased() {
     ActionScript comp = _ecs.registry.getConstComponent<ActionScript>(_id);
 
     return comp.actionOnReleased;
@@ -59,21 +59,28 @@ class DynamicActor : public AActor {
     float getPatternSpeed();
 
     /** Controllable */
+    // A name is resolved to its ActionId once, when it is bound
     void bindActionCallbackOnPressed(Action action_name, ActionCallback callback);
 
     void bindActionCallbackPressed(Action action_name, ActionCallback callback);
 
     void bindActionCallbackOnReleased(Action action_name, ActionCallback callback);
 
+    void bindActionCallbackOnPressed(ActionId action, ActionCallback callback);
+
+    void bindActionCallbackPressed(ActionId action, ActionCallback callback);
+
+    void bindActionCallbackOnReleased(ActionId action, ActionCallback callback);
+
     void removeActionCallbackOnPressed(Action action_name);
 
     void removeActionCallbackPressed(Action action_name);
 
     void removeActionCallbackOnReleased(Action action_name);
 
-    std::unordered_map<Action, ActionCallback> getActionCallbackOnPressed();
+    std::unordered_map<ActionId, ActionCallback> getActionCallbackOnPressed();
 
-    std::unordered_map<Action, ActionCallback> getActionCallbackPressed();
+    std::unordered_map<ActionId, ActionCallback> getActionCallbackPressed();
 
-    std::unordered_map<Action, ActionCallback> getActionCallbackOnReleased();
+    std::unordered_map<ActionId, ActionCallback> getActionCallbackOnReleased();
 };
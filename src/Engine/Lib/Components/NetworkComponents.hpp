@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <random>
 #include "InputAction.hpp"
@@ -30,10 +33,28 @@ struct ComponentPacket {
     std::vector<uint8_t> data;
 };
 
-struct ActionPacket {
-    static constexpr auto name = "ActionPacket";
-    Action action_name;
-    ActionState action_state;
+/**
+ * @brief Held actions of one client for its last ticks (C_INPUT), sent once per tick over UDP.
+ *
+ * Bit i of a mask is the action the client announced with id i in its
+ * InputActionsPacket. The frames are the ticks up to `tick`, oldest first:
+ * every packet repeats the previous ones, so a lost datagram costs no input.
+ */
+struct InputPacket {
+    static constexpr auto name = "InputPacket";
+    uint32_t tick = 0;            // tick of the last mask
+    std::vector<uint32_t> masks;  // one per tick, at most network::INPUT_REDUNDANT_FRAMES
+};
+
+/**
+ * @brief Names of the actions a client binds, in id order (C_INPUT_ACTIONS), sent over TCP.
+ *
+ * Sent once for the actions bound so far, then again for the new ones only.
+ */
+struct InputActionsPacket {
+    static constexpr auto name = "InputActionsPacket";
+    uint8_t first_id = 0;  // id of actions[0]
+    std::vector<Action> actions;
 };
 
 struct ResourcePacket {
@@ -47,76 +68,496 @@ namespace network {
 
 static constexpr uint32_t MAX_COMPONENT_PACKET_DATA_SIZE = 256u * 1024u;  // 256 KiB
 static constexpr uint32_t MAX_ACTION_NAME_SIZE = 256u;
+// Ticks of input repeated in every C_INPUT, a client's input survives that many lost datagrams in a row
+static constexpr uint32_t INPUT_REDUNDANT_FRAMES = 4u;
 
 inline message<GameEvents>& operator<<(message<GameEvents>& msg, const ComponentPacket& packet) {
-    for (const auto& byte : packet.data) {
-        msg << byte;
-    }
     uint32_t size = static_cast<uint32_t>(packet.data.size());
-    msg << size;
-    msg << packet.owner_id;  // Serialize owner_id
-    msg << packet.component_type;
-    msg << packet.entity_guid;
+    MessageWriter<GameEvents> writer(msg, packet.data.size() + 4 * sizeof(uint32_t));
+
+    writer.write(packet.data.data(), packet.data.size());
+    writer << size;
+    writer << packet.owner_id;  // Serialize owner_id
+    writer << packet.component_type;
+    writer << packet.entity_guid;
     return msg;
 }
 
-inline message<GameEvents>& operator>>(message<GameEvents>& msg, ComponentPacket& packet) {
-    msg >> packet.entity_guid;
-    msg >> packet.component_type;
-    msg >> packet.owner_id;  // Deserialize owner_id
+inline MessageReader<GameEvents>& operator>>(MessageReader<GameEvents>& reader, ComponentPacket& packet) {
+    reader >> packet.entity_guid;
+    reader >> packet.component_type;
+    reader >> packet.owner_id;  // Deserialize owner_id
     uint32_t size = 0;
-    msg >> size;
+    reader >> size;
 
-    const uint32_t available = static_cast<uint32_t>(msg.body.size());
-    if (size > available || size > MAX_COMPONENT_PACKET_DATA_SIZE) {
+    if (size > reader.remaining() || size > MAX_COMPONENT_PACKET_DATA_SIZE) {
         packet.data.clear();
+        reader.clear();
+        return reader;
+    }
+
+    packet.data.resize(size);
+    reader.read(packet.data.data(), size);
+    return reader;
+}
+
+inline message<GameEvents>& operator>>(message<GameEvents>& msg, ComponentPacket& packet) {
+    MessageReader<GameEvents> reader(msg);
+
+    reader >> packet;
+    msg.body.resize(reader.remaining());
+    msg.header.size = static_cast<uint32_t>(msg.body.size());
+    return msg;
+}
+
+// Budget for one S_SNAPSHOT_BATCH datagram (header included). Stays under the
+// usual 1280 bytes IPv6 minimum MTU so batches are never fragmented.
+static constexpr uint32_t SNAPSHOT_BATCH_DATAGRAM_SIZE = 1200u;
+static constexpr uint32_t SNAPSHOT_BATCH_BODY_SIZE =
+    SNAPSHOT_BATCH_DATAGRAM_SIZE - static_cast<uint32_t>(sizeof(message_header<GameEvents>));
+// [uint32 sequence][uint16 record count]
+static constexpr uint32_t SNAPSHOT_BATCH_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint16_t);
+// [uint16 record size][uint32 entity_guid][uint32 component_type][uint32 owner_id][uint8 encoding]
+static constexpr uint32_t SNAPSHOT_RECORD_HEADER_SIZE = sizeof(uint16_t) + 3 * sizeof(uint32_t) + sizeof(uint8_t);
+
+enum class SnapshotEncoding : uint8_t {
+    FULL,   // data is the serialized component
+    DELTA,  // data is a diff against the value the client received in batch `baseline`
+};
+
+/**
+ * @brief One component update read from an S_SNAPSHOT_BATCH.
+ */
+struct SnapshotRecord {
+    uint32_t entity_guid;
+    uint32_t component_type;
+    uint32_t owner_id;
+    SnapshotEncoding encoding = SnapshotEncoding::FULL;
+    uint32_t baseline = 0;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Acknowledges S_SNAPSHOT_BATCH sequences back to the server (C_SNAPSHOT_ACK).
+ */
+struct SnapshotAckPacket {
+    static constexpr auto name = "SnapshotAckPacket";
+    bool resync = false;  // the client could not decode a delta, the server must send full records again
+    std::vector<uint32_t> sequences;
+};
+
+// Payload of one S_FULL_STATE_CHUNK, the compressed world a joining client receives is cut in such pieces
+static constexpr uint32_t FULL_STATE_CHUNK_SIZE = 16u * 1024u;
+// Largest uncompressed world a client accepts, bounds what a malformed stream can make it allocate
+static constexpr uint32_t MAX_FULL_STATE_SIZE = 64u * 1024u * 1024u;
+
+/**
+ * @brief One piece of the compressed world sent to a joining client (S_FULL_STATE_CHUNK), over TCP.
+ *
+ * Chunks come in order, the one at offset 0 starts a new world. The client
+ * acknowledges the bytes it got with C_FULL_STATE_ACK before the server sends more.
+ */
+struct FullStateChunkPacket {
+    static constexpr auto name = "FullStateChunkPacket";
+    uint32_t sequence = 0;    // first S_SNAPSHOT_BATCH sequence newer than this world
+    uint32_t raw_size = 0;    // size of the world once decompressed
+    uint32_t total_size = 0;  // size of the compressed world
+    uint32_t offset = 0;      // position of data in the compressed world
+    std::vector<uint8_t> data;
+};
+
+// Largest AnimationSet definition a client accepts
+static constexpr uint32_t MAX_ANIMATION_SET_SIZE = 256u * 1024u;
+
+/**
+ * @brief Definition of an AnimationSet (S_ANIMATION_SET), over TCP.
+ *
+ * Sent once per client and set, before the first component record carrying
+ * its key. data is what serialize::AnimationSetWire::definition gives.
+ */
+struct AnimationSetPacket {
+    static constexpr auto name = "AnimationSetPacket";
+    std::vector<uint8_t> data;
+};
+
+/**
+    Encode current as a diff against baseline: one bit per byte telling whether it
+    changed, followed by the changed bytes.
+    @param std::vector<uint8_t> value the client already has
+    @param std::vector<uint8_t> value to send
+    @param std::vector<uint8_t> output diff
+    @return false if the sizes differ or the diff would not be smaller than the full value
+*/
+inline bool encodeSnapshotDelta(const std::vector<uint8_t>& baseline, const std::vector<uint8_t>& current,
+                                std::vector<uint8_t>& delta) {
+    const std::size_t size = current.size();
+    const std::size_t mask_size = (size + 7) / 8;
+
+    if (baseline.size() != size) {
+        return false;
+    }
+    delta.assign(mask_size, 0);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        if (baseline[idx] != current[idx]) {
+            delta[idx / 8] |= static_cast<uint8_t>(1u << (idx % 8));
+            delta.push_back(current[idx]);
+            if (delta.size() >= size) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+    Rebuild a value from its baseline and a diff made by encodeSnapshotDelta
+    @param std::vector<uint8_t> value the diff was made against
+    @param uint8_t* diff
+    @param std::size_t size of the diff
+    @param std::vector<uint8_t> output value
+    @return false if the diff does not match the baseline
+*/
+inline bool applySnapshotDelta(const std::vector<uint8_t>& baseline, const uint8_t* delta, std::size_t delta_size,
+                               std::vector<uint8_t>& out) {
+    const std::size_t size = baseline.size();
+    const std::size_t mask_size = (size + 7) / 8;
+    std::size_t cursor = mask_size;
+
+    if (delta_size < mask_size) {
+        return false;
+    }
+    out = baseline;
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        if (delta[idx / 8] & (1u << (idx % 8))) {
+            if (cursor >= delta_size) {
+                return false;
+            }
+            out[idx] = delta[cursor++];
+        }
+    }
+    return cursor == delta_size;
+}
+
+/**
+ * @brief Packs component updates into as few S_SNAPSHOT_BATCH messages as possible.
+ *
+ * Unlike the other packets, a batch body is read front to back:
+ * [uint32 sequence][uint16 record count] then, for each record,
+ * [uint16 record size][uint32 entity_guid][uint32 component_type][uint32 owner_id][uint8 encoding]
+ * [uint32 baseline, DELTA records only][data].
+ * The record size covers everything after itself. Each batch gets its own
+ * sequence so the client can acknowledge it. A record too big for an empty
+ * batch still gets a batch of its own.
+ */
+class SnapshotBatchWriter {
+   public:
+    /**
+        Start a new set of batches, keeping the messages allocated by the previous ones
+        @param uint32_t sequence of the first batch, the next ones follow
+    */
+    void reset(uint32_t first_sequence = 0) {
+        _used = 0;
+        _first_sequence = first_sequence;
+    }
+
+    /**
+        Append a full component update, opening a new batch when the current one is full
+        @param ComponentPacket to append
+        @return The sequence of the batch the record went into
+    */
+    uint32_t add(const ComponentPacket& packet) {
+        return append(packet, SnapshotEncoding::FULL, 0, packet.data.data(), packet.data.size());
+    }
+
+    /**
+        Append a component update encoded with encodeSnapshotDelta
+        @param ComponentPacket giving the ids of the record
+        @param uint32_t sequence of the batch holding the baseline
+        @param std::vector<uint8_t> diff against the baseline
+        @return The sequence of the batch the record went into
+    */
+    uint32_t addDelta(const ComponentPacket& packet, uint32_t baseline, const std::vector<uint8_t>& delta) {
+        return append(packet, SnapshotEncoding::DELTA, baseline, delta.data(), delta.size());
+    }
+
+    /**
+        @return The number of batches filled since the last reset()
+    */
+    std::size_t size() const { return _used; }
+
+    /**
+        @return The sequence the next opened batch would get
+    */
+    uint32_t nextSequence() const { return _first_sequence + static_cast<uint32_t>(_used); }
+
+    /**
+        @param std::size_t index of the batch, lower than size()
+        @return The batch message, ready to be sent as S_SNAPSHOT_BATCH
+    */
+    message<GameEvents>& at(std::size_t index) { return _batches.at(index); }
+
+   private:
+    uint32_t append(const ComponentPacket& packet, SnapshotEncoding encoding, uint32_t baseline, const uint8_t* data,
+                    std::size_t data_size) {
+        const std::size_t baseline_size = encoding == SnapshotEncoding::DELTA ? sizeof(uint32_t) : 0;
+        const std::size_t record_size = SNAPSHOT_RECORD_HEADER_SIZE + baseline_size + data_size;
+
+        if (record_size - sizeof(uint16_t) > UINT16_MAX) {
+            std::cerr << "[Network] Component of " << data_size << " bytes is too big for a snapshot batch"
+                      << std::endl;
+            return nextSequence();
+        }
+        if (_used == 0 || _batches[_used - 1].body.size() + record_size > SNAPSHOT_BATCH_BODY_SIZE) {
+            openBatch();
+        }
+
+        auto& body = _batches[_used - 1].body;
+        std::size_t offset = body.size();
+        uint16_t size = static_cast<uint16_t>(record_size - sizeof(uint16_t));
+        uint16_t count;
+
+        body.resize(offset + record_size);
+        write(body, offset, size);
+        write(body, offset, packet.entity_guid);
+        write(body, offset, packet.component_type);
+        write(body, offset, packet.owner_id);
+        write(body, offset, static_cast<uint8_t>(encoding));
+        if (encoding == SnapshotEncoding::DELTA) {
+            write(body, offset, baseline);
+        }
+        if (data_size > 0) {
+            std::memcpy(body.data() + offset, data, data_size);
+        }
+        std::memcpy(&count, body.data() + sizeof(uint32_t), sizeof(count));
+        count++;
+        std::memcpy(body.data() + sizeof(uint32_t), &count, sizeof(count));
+        _batches[_used - 1].header.size = static_cast<uint32_t>(body.size());
+        return _first_sequence + static_cast<uint32_t>(_used - 1);
+    }
+
+    void openBatch() {
+        if (_used == _batches.size()) {
+            _batches.emplace_back();
+            _batches.back().body.reserve(SNAPSHOT_BATCH_BODY_SIZE);
+        }
+        uint32_t sequence = nextSequence();
+        auto& batch = _batches[_used++];
+        std::size_t offset = 0;
+        uint16_t count = 0;
+
+        batch.header = message_header<GameEvents>();
+        batch.header.id = GameEvents::S_SNAPSHOT_BATCH;
+        batch.body.resize(SNAPSHOT_BATCH_HEADER_SIZE);
+        write(batch.body, offset, sequence);
+        write(batch.body, offset, count);
+        batch.header.size = static_cast<uint32_t>(batch.body.size());
+    }
+
+    template <typename DataType>
+    static void write(std::vector<uint8_t>& body, std::size_t& offset, const DataType& value) {
+        std::memcpy(body.data() + offset, &value, sizeof(DataType));
+        offset += sizeof(DataType);
+    }
+
+    std::vector<message<GameEvents>> _batches;
+    std::size_t _used = 0;
+    uint32_t _first_sequence = 0;
+};
+
+/**
+    Walk every record of an S_SNAPSHOT_BATCH body in a single pass
+    @param message batch to read, left untouched
+    @param uint32_t output sequence of the batch
+    @param SnapshotRecord scratch record refilled for each record, so its buffer is reused
+    @param callback called with the scratch record for each record
+    @return false if the batch is truncated or malformed, records before the error were still delivered
+*/
+template <typename Callback>
+inline bool readSnapshotBatch(const message<GameEvents>& msg, uint32_t& sequence, SnapshotRecord& record,
+                              Callback&& callback) {
+    const uint8_t* cursor = msg.body.data();
+    const uint8_t* end = cursor + msg.body.size();
+    uint16_t count = 0;
+
+    if (msg.body.size() < SNAPSHOT_BATCH_HEADER_SIZE) {
+        return false;
+    }
+    std::memcpy(&sequence, cursor, sizeof(sequence));
+    std::memcpy(&count, cursor + sizeof(sequence), sizeof(count));
+    cursor += SNAPSHOT_BATCH_HEADER_SIZE;
+
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        uint16_t size = 0;
+        uint8_t encoding = 0;
+
+        if (static_cast<std::size_t>(end - cursor) < SNAPSHOT_RECORD_HEADER_SIZE) {
+            return false;
+        }
+        std::memcpy(&size, cursor, sizeof(size));
+        cursor += sizeof(size);
+        if (size < SNAPSHOT_RECORD_HEADER_SIZE - sizeof(size) || static_cast<std::size_t>(end - cursor) < size) {
+            return false;
+        }
+        const uint8_t* record_end = cursor + size;
+        std::memcpy(&record.entity_guid, cursor, sizeof(uint32_t));
+        std::memcpy(&record.component_type, cursor + sizeof(uint32_t), sizeof(uint32_t));
+        std::memcpy(&record.owner_id, cursor + 2 * sizeof(uint32_t), sizeof(uint32_t));
+        std::memcpy(&encoding, cursor + 3 * sizeof(uint32_t), sizeof(uint8_t));
+        cursor += 3 * sizeof(uint32_t) + sizeof(uint8_t);
+
+        if (encoding == static_cast<uint8_t>(SnapshotEncoding::FULL)) {
+            record.encoding = SnapshotEncoding::FULL;
+            record.baseline = 0;
+        } else if (encoding == static_cast<uint8_t>(SnapshotEncoding::DELTA) &&
+                   static_cast<std::size_t>(record_end - cursor) >= sizeof(uint32_t)) {
+            record.encoding = SnapshotEncoding::DELTA;
+            std::memcpy(&record.baseline, cursor, sizeof(uint32_t));
+            cursor += sizeof(uint32_t);
+        } else {
+            return false;
+        }
+        record.data.assign(cursor, record_end);
+        cursor = record_end;
+        callback(record);
+    }
+    return true;
+}
+
+inline message<GameEvents>& operator<<(message<GameEvents>& msg, const SnapshotAckPacket& packet) {
+    msg.push_bytes(reinterpret_cast<const uint8_t*>(packet.sequences.data()),
+                   packet.sequences.size() * sizeof(uint32_t));
+    uint16_t count = static_cast<uint16_t>(packet.sequences.size());
+    msg << count;
+    uint8_t resync = packet.resync ? 1 : 0;
+    msg << resync;
+    return msg;
+}
+
+inline message<GameEvents>& operator>>(message<GameEvents>& msg, SnapshotAckPacket& packet) {
+    uint8_t resync = 0;
+    uint16_t count = 0;
+    msg >> resync;
+    msg >> count;
+    packet.resync = resync != 0;
+
+    if (count > MAX_SNAPSHOT_ACKS || static_cast<std::size_t>(count) * sizeof(uint32_t) > msg.body.size()) {
+        packet.sequences.clear();
         msg.body.clear();
         msg.header.size = 0;
         return msg;
     }
 
-    packet.data.resize(size);
-    for (uint32_t idx = 0; idx < size; ++idx) {
-        msg >> packet.data[size - 1 - idx];
+    packet.sequences.resize(count);
+    msg.pop_bytes(reinterpret_cast<uint8_t*>(packet.sequences.data()), count * sizeof(uint32_t));
+    return msg;
+}
+
+inline message<GameEvents>& operator<<(message<GameEvents>& msg, const InputPacket& packet) {
+    msg.push_bytes(reinterpret_cast<const uint8_t*>(packet.masks.data()), packet.masks.size() * sizeof(uint32_t));
+    uint8_t count = static_cast<uint8_t>(packet.masks.size());
+    msg << count;
+    msg << packet.tick;
+    return msg;
+}
+
+inline message<GameEvents>& operator>>(message<GameEvents>& msg, InputPacket& packet) {
+    uint8_t count = 0;
+    msg >> packet.tick;
+    msg >> count;
+
+    if (count > INPUT_REDUNDANT_FRAMES || static_cast<std::size_t>(count) * sizeof(uint32_t) > msg.body.size()) {
+        packet.masks.clear();
+        msg.body.clear();
+        msg.header.size = 0;
+        return msg;
     }
+
+    packet.masks.resize(count);
+    msg.pop_bytes(reinterpret_cast<uint8_t*>(packet.masks.data()), count * sizeof(uint32_t));
     return msg;
 }
 
-inline message<GameEvents>& operator<<(message<GameEvents>& msg, const ActionPacket& packet) {
-    for (const auto& c : packet.action_name) {
-        msg << c;
+inline message<GameEvents>& operator<<(message<GameEvents>& msg, const InputActionsPacket& packet) {
+    for (const auto& action : packet.actions) {
+        msg.push_bytes(reinterpret_cast<const uint8_t*>(action.data()), action.size());
+        uint16_t size = static_cast<uint16_t>(action.size());
+        msg << size;
     }
-    uint32_t size = static_cast<uint32_t>(packet.action_name.size());
-    msg << size;
-    msg << packet.action_state.pressed;
-    msg << packet.action_state.justPressed;
-    msg << packet.action_state.justReleased;
-    msg << packet.action_state.holdTime;
-    msg << packet.action_state.lastReleaseHoldTime;
+    uint8_t count = static_cast<uint8_t>(packet.actions.size());
+    msg << count;
+    msg << packet.first_id;
     return msg;
 }
 
-inline message<GameEvents>& operator>>(message<GameEvents>& msg, ActionPacket& packet) {
-    msg >> packet.action_state.lastReleaseHoldTime;
-    msg >> packet.action_state.holdTime;
-    msg >> packet.action_state.justReleased;
-    msg >> packet.action_state.justPressed;
-    msg >> packet.action_state.pressed;
-    uint32_t size = 0;
-    msg >> size;
+inline message<GameEvents>& operator>>(message<GameEvents>& msg, InputActionsPacket& packet) {
+    uint8_t count = 0;
+    msg >> packet.first_id;
+    msg >> count;
 
-    const uint32_t available = static_cast<uint32_t>(msg.body.size());
-    if (size > available || size > MAX_ACTION_NAME_SIZE) {
-        packet.action_name.clear();
+    packet.actions.clear();
+    if (static_cast<std::size_t>(packet.first_id) + count > MAX_INPUT_ACTIONS) {
         msg.body.clear();
         msg.header.size = 0;
         return msg;
     }
 
-    packet.action_name.resize(size);
-    for (uint32_t idx = 0; idx < size; ++idx) {
-        msg >> packet.action_name[size - 1 - idx];
+    // The names come out last first
+    packet.actions.resize(count);
+    for (std::size_t idx = count; idx-- > 0;) {
+        uint16_t size = 0;
+        msg >> size;
+        if (size > msg.body.size() || size > MAX_ACTION_NAME_SIZE) {
+            packet.actions.clear();
+            msg.body.clear();
+            msg.header.size = 0;
+            return msg;
+        }
+        packet.actions[idx].resize(size);
+        msg.pop_bytes(reinterpret_cast<uint8_t*>(packet.actions[idx].data()), size);
+    }
+    return msg;
+}
+
+inline message<GameEvents>& operator<<(message<GameEvents>& msg, const FullStateChunkPacket& packet) {
+    msg.push_bytes(packet.data.data(), packet.data.size());
+    msg << packet.offset;
+    msg << packet.total_size;
+    msg << packet.raw_size;
+    msg << packet.sequence;
+    return msg;
+}
+
+inline message<GameEvents>& operator>>(message<GameEvents>& msg, FullStateChunkPacket& packet) {
+    msg >> packet.sequence;
+    msg >> packet.raw_size;
+    msg >> packet.total_size;
+    msg >> packet.offset;
+
+    // What is left of the body is the data
+    packet.data.clear();
+    if (msg.body.size() > FULL_STATE_CHUNK_SIZE) {
+        msg.body.clear();
+        msg.header.size = 0;
+        return msg;
     }
+    packet.data.swap(msg.body);
+    msg.body.clear();
+    msg.header.size = 0;
+    return msg;
+}
+
+inline message<GameEvents>& operator<<(message<GameEvents>& msg, const AnimationSetPacket& packet) {
+    msg.push_bytes(packet.data.data(), packet.data.size());
+    return msg;
+}
+
+inline message<GameEvents>& operator>>(message<GameEvents>& msg, AnimationSetPacket& packet) {
+    // The whole body is the definition
+    packet.data.clear();
+    if (msg.body.size() <= MAX_ANIMATION_SET_SIZE)
+        packet.data.swap(msg.body);
+    msg.body.clear();
+    msg.header.size = 0;
     return msg;
 }
 
@@ -1,18 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <deque>
 #include <vector>
-#include <map>
 #include "StandardComponents.hpp"
 #include "../../Inputs/InputAction.hpp"  // Pour l'enum Action
 
+// Actions held during a tick, one bit per ActionId
 struct InputSnapshot {
-    std::map<Action, bool> actions;
+    uint32_t pressed = 0;
 
-    bool isPressed(Action a) const {
-        auto it = actions.find(a);
-        return it != actions.end() && it->second;
-    }
+    bool isPressed(ActionId id) const { return id < MAX_INPUT_ACTIONS && ((pressed >> id) & 1u); }
 };
 
 struct SimulationStep {
@@ -7,9 +7,14 @@
 
 #pragma once
 
-#include <vector>
-#include <unordered_map>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <SFML/Graphics/Texture.hpp>
 
@@ -26,39 +31,257 @@ struct AnimationClip {
     std::vector<Rect2D> frames;
     float frameDuration = 0.1f;
     AnimationMode mode = AnimationMode::Loop;
+
+    bool operator==(const AnimationClip& other) const = default;
+};
+
+using AnimationClipId = uint8_t;
+
+// A clip id has to fit an AnimationClipId, the last value meaning no clip
+static constexpr std::size_t MAX_ANIMATION_CLIPS = 255;
+static constexpr AnimationClipId NO_ANIMATION_CLIP = 0xFF;
+
+/**
+ * @brief Named clips of a sprite, shared by every sprite built with the same ones.
+ *
+ * Sets are interned by AnimationLibrary and never change afterwards: adding
+ * or editing a clip moves the sprite to another set.
+ */
+struct AnimationSet {
+    std::vector<std::string> names;
+    std::vector<AnimationClip> clips;
+
+    /**
+        @param std::string_view name of the clip
+        @return NO_ANIMATION_CLIP if the set has no such clip
+    */
+    AnimationClipId find(std::string_view name) const {
+        // A sprite has a handful of clips, a scan beats hashing the name
+        for (std::size_t idx = 0; idx < names.size(); ++idx) {
+            if (names[idx] == name)
+                return static_cast<AnimationClipId>(idx);
+        }
+        return NO_ANIMATION_CLIP;
+    }
+
+    bool operator==(const AnimationSet& other) const = default;
+};
+
+/**
+ * @brief Process wide table of the animation sets in use.
+ *
+ * Five thousand bullets built by the same prefab point to one set instead of
+ * carrying a map of clips each. Sets are never freed, they are built when a
+ * prefab runs, not every tick.
+ */
+class AnimationLibrary {
+   public:
+    static const AnimationSet* empty() {
+        static const AnimationSet set;
+        return &set;
+    }
+
+    /**
+        Get the shared copy of a set, keeping this one the first time it is seen
+        @param AnimationSet clips to share
+        @return A pointer valid for the whole process
+    */
+    static const AnimationSet* intern(AnimationSet set) {
+        if (set.clips.empty())
+            return empty();
+
+        Table& table = instance();
+        uint64_t key = hash(set);
+        std::lock_guard<std::mutex> lock(table.mutex);
+        auto& bucket = table.sets[key];
+
+        for (const auto& known : bucket) {
+            if (*known == set)
+                return known.get();
+        }
+        bucket.push_back(std::make_unique<AnimationSet>(std::move(set)));
+        return bucket.back().get();
+    }
+
+    static std::size_t size() {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        std::size_t count = 0;
+
+        for (const auto& [key, bucket] : table.sets)
+            count += bucket.size();
+        return count;
+    }
+
+   private:
+    struct Table {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, std::vector<std::unique_ptr<AnimationSet>>> sets;
+    };
+
+    static Table& instance() {
+        static Table table;
+        return table;
+    }
+
+    // FNV-1a over every field, sets only differing by a frame land in different buckets
+    static uint64_t hash(const AnimationSet& set) {
+        uint64_t value = 0xcbf29ce484222325ull;
+        auto mix = [&value](const void* data, std::size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (std::size_t idx = 0; idx < size; ++idx)
+                value = (value ^ bytes[idx]) * 0x100000001b3ull;
+        };
+
+        for (std::size_t idx = 0; idx < set.clips.size(); ++idx) {
+            const AnimationClip& clip = set.clips[idx];
+
+            mix(set.names[idx].data(), set.names[idx].size());
+            mix(&clip.handle.id, sizeof(clip.handle.id));
+            mix(&clip.handle.generation, sizeof(clip.handle.generation));
+            mix(clip.frames.data(), clip.frames.size() * sizeof(Rect2D));
+            mix(&clip.frameDuration, sizeof(clip.frameDuration));
+            mix(&clip.mode, sizeof(clip.mode));
+        }
+        return value;
+    }
 };
 
+/**
+ * @brief Sprite playing one clip of a shared AnimationSet.
+ *
+ * The current clip is an index in the set and the size of the current frame
+ * is cached in hitboxWidth and hitboxHeight, so the animation and collision
+ * systems never look a clip up by name. Build the clips once with addClip,
+ * then switch with play.
+ */
 struct AnimatedSprite2D {
     static constexpr auto name = "AnimatedSprite2DComponent";
     RenderLayer layer = RenderLayer::Midground;
 
-    std::unordered_map<std::string, AnimationClip> animations;
-    std::string currentAnimation;
-    std::string previousAnimation;
+    const AnimationSet* animations = AnimationLibrary::empty();
+    AnimationClipId currentClip = NO_ANIMATION_CLIP;
     std::size_t currentFrameIndex = 0;
 
+    // Size of the current frame, 0 without one. Updated by play, setFrame and refreshHitbox
+    int hitboxWidth = 0;
+    int hitboxHeight = 0;
+
     int loopDirection = 1;
     float timer = 0.0f;
     bool playing = true;
     bool flipX = false;
     bool flipY = false;
 
-    void play(const std::string& name, bool restart = true) {
-        if (currentAnimation != name || restart) {
-            currentAnimation = name;
+    /**
+        Add a clip, replacing the one with the same name
+        @param std::string name of the clip
+        @param AnimationClip clip
+    */
+    void addClip(const std::string& name, const AnimationClip& clip) {
+        AnimationSet set = *animations;
+        AnimationClipId id = set.find(name);
+
+        if (id != NO_ANIMATION_CLIP) {
+            set.clips[id] = clip;
+        } else if (set.clips.size() < MAX_ANIMATION_CLIPS) {
+            set.names.push_back(name);
+            set.clips.push_back(clip);
+        }
+        animations = AnimationLibrary::intern(std::move(set));
+        refreshHitbox();
+    }
+
+    /**
+        Change a clip of this sprite only, the other sprites sharing its set keep theirs
+        @param AnimationClipId clip to change
+        @param Edit function taking the AnimationClip& to change
+        @return false if the sprite has no such clip
+    */
+    template <typename Edit>
+    bool editClip(AnimationClipId id, Edit&& edit) {
+        if (id >= animations->clips.size())
+            return false;
+
+        AnimationSet set = *animations;
+        edit(set.clips[id]);
+        animations = AnimationLibrary::intern(std::move(set));
+        refreshHitbox();
+        return true;
+    }
+
+    template <typename Edit>
+    bool editClip(std::string_view name, Edit&& edit) {
+        return editClip(animations->find(name), std::forward<Edit>(edit));
+    }
+
+    bool hasClip(std::string_view name) const { return animations->find(name) != NO_ANIMATION_CLIP; }
+
+    /**
+        @return The clip being played, nullptr if there is none
+    */
+    const AnimationClip* clip() const {
+        return currentClip < animations->clips.size() ? &animations->clips[currentClip] : nullptr;
+    }
+
+    const AnimationClip* clip(std::string_view name) const {
+        AnimationClipId id = animations->find(name);
+        return id != NO_ANIMATION_CLIP ? &animations->clips[id] : nullptr;
+    }
+
+    /**
+        @return The frame being shown, nullptr if there is none
+    */
+    const Rect2D* frame() const {
+        const AnimationClip* current = clip();
+
+        if (!current || currentFrameIndex >= current->frames.size())
+            return nullptr;
+        return &current->frames[currentFrameIndex];
+    }
+
+    // Empty if no clip is playing
+    std::string_view currentName() const {
+        return currentClip < animations->names.size() ? std::string_view(animations->names[currentClip])
+                                                      : std::string_view();
+    }
+
+    bool isCurrent(std::string_view name) const { return currentClip != NO_ANIMATION_CLIP && currentName() == name; }
+
+    void setFrame(std::size_t index) {
+        currentFrameIndex = index;
+        refreshHitbox();
+    }
+
+    // Call after changing currentClip or currentFrameIndex by hand
+    void refreshHitbox() {
+        const Rect2D* current = frame();
+
+        hitboxWidth = current ? current->width : 0;
+        hitboxHeight = current ? current->height : 0;
+    }
+
+    void play(AnimationClipId id, bool restart = true) {
+        if (currentClip != id || restart) {
+            currentClip = id;
             currentFrameIndex = 0;
             loopDirection = 1;
             timer = 0.f;
+            refreshHitbox();
         }
         playing = true;
     }
 
+    void play(std::string_view name, bool restart = true) { play(animations->find(name), restart); }
+
     void stop() { playing = false; }
 
     bool isPlaying() const { return playing; }
 
-    void playIfNotPlaying(const std::string& name) {
-        if (!playing || currentAnimation != name)
-            play(name);
+    void playIfNotPlaying(std::string_view name) {
+        AnimationClipId id = animations->find(name);
+
+        if (!playing || currentClip != id)
+            play(id);
     }
 };
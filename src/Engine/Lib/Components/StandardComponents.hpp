@@ -81,7 +81,7 @@ struct rect {
 struct BoxCollisionComponent {
     static constexpr auto name = "CollisionComponent";
     CollidedEntity collision;
-    std::vector<std::string> tagCollision;
+    TagSet tagCollision;
     std::function<void(Registry& registry, system_context context, Entity current_entity)> callbackOnCollide;
 };
 
@@ -102,7 +102,7 @@ struct sprite2D_component_s {
 
 struct TagComponent {
     static constexpr auto name = "TagComponent";
-    std::vector<std::string> tags;
+    TagSet tags;
 };
 
 struct TextComponent {
@@ -137,11 +137,12 @@ struct InputTextComponent {
 
 using ActionCallback = std::function<void(Registry& registry, system_context context, Entity current_entity)>;
 
+// Keyed by the id the input manager gave the action, so reading the inputs never hashes a name
 struct ActionScript {
     static constexpr auto name = "ActionEffectComponent";
-    std::unordered_map<Action, ActionCallback> actionOnPressed;
-    std::unordered_map<Action, ActionCallback> actionOnReleased;
-    std::unordered_map<Action, ActionCallback> actionPressed;
+    std::unordered_map<ActionId, ActionCallback> actionOnPressed;
+    std::unordered_map<ActionId, ActionCallback> actionOnReleased;
+    std::unordered_map<ActionId, ActionCallback> actionPressed;
 };
 
 // struct Shooter {
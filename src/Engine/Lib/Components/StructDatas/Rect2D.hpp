@@ -5,4 +5,6 @@ struct Rect2D {
     int y;
     int width;
     int height;
+
+    bool operator==(const Rect2D& other) const = default;
 };
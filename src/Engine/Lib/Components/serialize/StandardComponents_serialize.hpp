@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <string>
 #include <iostream>
 #include "Components/StandardComponents.hpp"
 #include "ResourceConfig.hpp"
 #include "serialize.hpp"
+#include "tag_component_serialize.hpp"
 #include "../../../../RType/Common/Components/damage_component.hpp"
 #include "../StructDatas/Rect2D.hpp"
 #include "../Components/Sprite/AnimatedSprite2D.hpp"
@@ -160,7 +166,7 @@ inline void serialize(std::vector<uint8_t>& buffer, const BoxCollisionComponent&
 
 inline BoxCollisionComponent deserialize_box_collision_component(const std::vector<uint8_t>& buffer, size_t& offset) {
     BoxCollisionComponent component;
-    component.tagCollision = deserialize_vector<std::string>(buffer, offset);
+    component.tagCollision = deserialize_tag_set(buffer, offset);
     return component;
 }
 
@@ -262,7 +268,7 @@ inline void serialize(std::vector<uint8_t>& buffer, const TagComponent& componen
 
 inline TagComponent deserialize_tag_component(const std::vector<uint8_t>& buffer, size_t& offset) {
     TagComponent component;
-    component.tags = deserialize_vector<std::string>(buffer, offset);
+    component.tags = deserialize_tag_set(buffer, offset);
     return component;
 }
 
@@ -672,53 +678,233 @@ inline AnimationClip deserialize_animation_clip(const std::vector<uint8_t>& buff
     return clip;
 }
 
-/** AnimatedSprite2D */
-inline void serialize(std::vector<uint8_t>& buffer, const AnimatedSprite2D& component,
+/** AnimationSet */
+inline void serialize(std::vector<uint8_t>& buffer, const AnimationSet& set,
                       ResourceManager<TextureAsset>& resourceManager) {
-    serialize(buffer, static_cast<int>(component.layer));
+    serialize(buffer, static_cast<uint32_t>(set.clips.size()));
+    for (std::size_t idx = 0; idx < set.clips.size(); ++idx) {
+        serialize(buffer, set.names[idx]);
+        serialize(buffer, set.clips[idx], resourceManager);
+    }
+}
+
+inline AnimationSet deserialize_animation_set(const std::vector<uint8_t>& buffer, size_t& offset,
+                                              ResourceManager<TextureAsset>& resourceManager) {
+    AnimationSet set;
+    uint32_t size = deserialize<uint32_t>(buffer, offset);
+    if (size > MAX_ANIMATION_CLIPS)
+        size = 0;  // Safety
+
+    for (uint32_t i = 0; i < size; ++i) {
+        set.names.push_back(deserialize<std::string>(buffer, offset));
+        set.clips.push_back(deserialize_animation_clip(buffer, offset, resourceManager));
+    }
+    return set;
+}
+
+/**
+ * @brief How AnimationSets travel: records carry a key, the definition goes apart.
+ *
+ * The key is a hash of the definition, the same clips and texture names give
+ * the same key in every process. The server encodes a set once per resource
+ * manager and sends each client a definition once, over TCP, before the first
+ * record using its key (S_ANIMATION_SET). A record read before its definition
+ * gets a placeholder set without clips, which resolve() swaps for the real one
+ * once the definition is in.
+ */
+class AnimationSetWire {
+   public:
+    /**
+        Write the key of a set
+        @return The key, its definition can be fetched with definition()
+    */
+    static uint64_t write(std::vector<uint8_t>& buffer, const AnimationSet& set,
+                          ResourceManager<TextureAsset>& resourceManager) {
+        uint64_t key = AnimationSetWire::key(set, resourceManager);
+        serialize(buffer, key);
+        return key;
+    }
 
-    // Serialize animations map manually to handle the resource manager
-    serialize(buffer, static_cast<uint32_t>(component.animations.size()));
-    for (const auto& [name, clip] : component.animations) {
-        serialize(buffer, name);
-        serialize(buffer, clip, resourceManager);
+    // The key write() gives the set
+    static uint64_t key(const AnimationSet& set, ResourceManager<TextureAsset>& resourceManager) {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        Encoded& encoded = table.encoded[{&set, &resourceManager}];
+
+        if (!encoded.valid || !stillNamed(encoded, resourceManager))
+            encode(table, encoded, set, resourceManager);
+        return encoded.key;
+    }
+
+    /**
+        @param uint64_t key given by write
+        @param std::vector<uint8_t> out receives the key, the size of the definition and the definition
+        @return false if no set with this key was written
+    */
+    static bool definition(uint64_t key, std::vector<uint8_t>& out) {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        auto it = table.definitions.find(key);
+
+        if (it == table.definitions.end())
+            return false;
+        out = it->second;
+        return true;
     }
 
-    serialize(buffer, component.currentAnimation);
-    serialize(buffer, component.previousAnimation);
+    /**
+        Read a definition made by definition(), records with its key read its set from then on
+        @return The interned set, nullptr if the definition is malformed
+    */
+    static const AnimationSet* define(const std::vector<uint8_t>& buffer, size_t& offset,
+                                      ResourceManager<TextureAsset>& resourceManager) {
+        uint64_t key = deserialize<uint64_t>(buffer, offset);
+        uint32_t size = deserialize<uint32_t>(buffer, offset);
+        if (offset > buffer.size() || size > buffer.size() - offset)
+            return nullptr;
+
+        std::size_t end = offset;
+        const AnimationSet* set = AnimationLibrary::intern(deserialize_animation_set(buffer, end, resourceManager));
+        bool whole = end == offset + size && hash(buffer.data() + offset, size) == key;
+        offset += size;
+        if (!whole)
+            return nullptr;
+
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        table.known[{&resourceManager, key}] = set;
+        return set;
+    }
+
+    /**
+        Read the key of a set
+        @return The set of the key, a placeholder until its definition is read
+    */
+    static const AnimationSet* read(const std::vector<uint8_t>& buffer, size_t& offset,
+                                    ResourceManager<TextureAsset>& resourceManager) {
+        uint64_t key = deserialize<uint64_t>(buffer, offset);
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+
+        auto known = table.known.find({&resourceManager, key});
+        if (known != table.known.end())
+            return known->second;
+
+        auto& placeholder = table.placeholders[{&resourceManager, key}];
+        if (!placeholder) {
+            placeholder = std::make_unique<AnimationSet>();
+            table.pending[placeholder.get()] = {&resourceManager, key};
+        }
+        return placeholder.get();
+    }
+
+    /**
+        @return The set a placeholder stands for once its definition was read, set itself otherwise
+    */
+    static const AnimationSet* resolve(const AnimationSet* set) {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+
+        auto pending = table.pending.find(set);
+        if (pending == table.pending.end())
+            return set;
+        auto known = table.known.find(pending->second);
+        return known != table.known.end() ? known->second : set;
+    }
+
+   private:
+    struct Encoded {
+        bool valid = false;
+        uint64_t key = 0;
+        std::vector<std::pair<handle_t<TextureAsset>, std::string>> textures;
+    };
+
+    using Source = std::pair<const void*, uint64_t>;  // resource manager of the reader and key
+
+    struct Table {
+        std::mutex mutex;
+        // Writer side
+        std::map<std::pair<const AnimationSet*, const void*>, Encoded> encoded;
+        std::map<uint64_t, std::vector<uint8_t>> definitions;
+        // Reader side, placeholders live as long as the process like interned sets
+        std::map<Source, const AnimationSet*> known;
+        std::map<Source, std::unique_ptr<AnimationSet>> placeholders;
+        std::map<const AnimationSet*, Source> pending;
+    };
+
+    static Table& instance() {
+        static Table table;
+        return table;
+    }
+
+    static uint64_t hash(const uint8_t* data, std::size_t size) {
+        uint64_t value = 0xcbf29ce484222325ull;
+
+        for (std::size_t idx = 0; idx < size; ++idx)
+            value = (value ^ data[idx]) * 0x100000001b3ull;
+        return value;
+    }
+
+    // A manager at the address of a destroyed one may name the same handles otherwise
+    static bool stillNamed(const Encoded& encoded, ResourceManager<TextureAsset>& resourceManager) {
+        for (const auto& [handle, name] : encoded.textures) {
+            auto current = resourceManager.get_handle(name);
+            if (!current || current->get() != handle)
+                return false;
+        }
+        return true;
+    }
+
+    static void encode(Table& table, Encoded& encoded, const AnimationSet& set,
+                       ResourceManager<TextureAsset>& resourceManager) {
+        const std::size_t begin = sizeof(uint64_t) + sizeof(uint32_t);
+        std::vector<uint8_t> bytes(begin, 0);
+
+        serialize(bytes, set, resourceManager);
+        encoded.textures.clear();
+        for (const auto& clip : set.clips) {
+            if (auto name = resourceManager.get_name(clip.handle))
+                encoded.textures.emplace_back(clip.handle, name.value());
+        }
+
+        encoded.key = hash(bytes.data() + begin, bytes.size() - begin);
+        uint32_t size = static_cast<uint32_t>(bytes.size() - begin);
+        std::memcpy(bytes.data(), &encoded.key, sizeof(encoded.key));
+        std::memcpy(bytes.data() + sizeof(encoded.key), &size, sizeof(size));
+        encoded.valid = true;
+        table.definitions.try_emplace(encoded.key, std::move(bytes));
+    }
+};
+
+/** AnimatedSprite2D */
+// Fixed size: the set goes as its key, a sprite changing frame differs from the acknowledged copy in a few bytes
+inline void serialize(std::vector<uint8_t>& buffer, const AnimatedSprite2D& component,
+                      ResourceManager<TextureAsset>& resourceManager) {
+    serialize(buffer, static_cast<int>(component.layer));
+    serialize(buffer, component.currentClip);
     serialize(buffer, static_cast<uint32_t>(component.currentFrameIndex));
     serialize(buffer, component.loopDirection);
-    serialize(buffer, component.timer);
     serialize(buffer, component.playing);
     serialize(buffer, component.flipX);
     serialize(buffer, component.flipY);
+    // The timer is left out, the client runs its own and the sprite is only sent again when its frame changes
+    AnimationSetWire::write(buffer, *component.animations, resourceManager);
 }
 
 inline AnimatedSprite2D deserialize_animated_sprite_2d(const std::vector<uint8_t>& buffer, size_t& offset,
                                                        ResourceManager<TextureAsset>& resourceManager) {
     AnimatedSprite2D component;
     component.layer = static_cast<RenderLayer>(deserialize<int>(buffer, offset));
-
-    // Deserialize animations map
-    uint32_t anims_size = deserialize<uint32_t>(buffer, offset);
-    if (anims_size > 128)
-        anims_size = 0;  // Safety
-
-    for (uint32_t i = 0; i < anims_size; ++i) {
-        std::string name = deserialize<std::string>(buffer, offset);
-        AnimationClip clip = deserialize_animation_clip(buffer, offset, resourceManager);
-        component.animations[name] = clip;
-    }
-
-    component.currentAnimation = deserialize<std::string>(buffer, offset);
-    component.previousAnimation = deserialize<std::string>(buffer, offset);
+    component.currentClip = deserialize<AnimationClipId>(buffer, offset);
     component.currentFrameIndex = deserialize<uint32_t>(buffer, offset);
     component.loopDirection = deserialize<int>(buffer, offset);
-    component.timer = deserialize<float>(buffer, offset);
     component.playing = deserialize<bool>(buffer, offset);
     component.flipX = deserialize<bool>(buffer, offset);
     component.flipY = deserialize<bool>(buffer, offset);
 
+    component.animations = AnimationSetWire::read(buffer, offset, resourceManager);
+    component.refreshHitbox();
+
     return component;
 }
 
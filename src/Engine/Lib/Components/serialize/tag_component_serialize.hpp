@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include "Components/tag_component.hpp"
 #include "serialize.hpp"
@@ -20,4 +21,13 @@ inline CollidedEntity deserialize_collided_entity(const std::vector<uint8_t>& bu
     return component;
 }
 
+/** TagSet, sent as its names since tag ids only hold inside one process */
+inline void serialize(std::vector<uint8_t>& buffer, const TagSet& tags) {
+    serialize(buffer, tags.names());
+}
+
+inline TagSet deserialize_tag_set(const std::vector<uint8_t>& buffer, size_t& offset) {
+    return TagSet(deserialize_vector<std::string>(buffer, offset));
+}
+
 }  // namespace serialize
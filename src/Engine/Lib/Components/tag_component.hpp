@@ -1,5 +1,11 @@
 #pragma once
 
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 #include "EcsType.hpp"
 
@@ -7,3 +13,142 @@ struct CollidedEntity {
     static constexpr auto name = "CollidedEntity";
     std::vector<Entity> tags;
 };
+
+using TagId = uint8_t;
+
+// One bit of a TagSet per tag, a game using more distinct tags cannot add the extra ones
+static constexpr std::size_t MAX_TAGS = 64;
+static constexpr TagId INVALID_TAG_ID = 0xFF;
+
+/**
+ * @brief Process wide table giving each tag name its bit in a TagSet.
+ *
+ * Ids depend on the order names were first seen, so they never leave the
+ * process: the network carries names, interned again on the other side.
+ */
+class TagRegistry {
+   public:
+    /**
+        Get the id of a tag, giving it the next free one the first time
+        @param std::string_view name of the tag
+        @return INVALID_TAG_ID once MAX_TAGS tags exist
+    */
+    static TagId intern(std::string_view name) {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        TagId id = lookup(table, name);
+
+        if (id != INVALID_TAG_ID || table.names.size() >= MAX_TAGS)
+            return id;
+        table.names.emplace_back(name);
+        return static_cast<TagId>(table.names.size() - 1);
+    }
+
+    /**
+        Get the id of a tag without interning it
+        @param std::string_view name of the tag
+        @return INVALID_TAG_ID if no entity ever had this tag
+    */
+    static TagId find(std::string_view name) {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return lookup(table, name);
+    }
+
+    static std::string name(TagId id) {
+        Table& table = instance();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return id < table.names.size() ? table.names[id] : std::string();
+    }
+
+   private:
+    struct Table {
+        std::mutex mutex;
+        std::vector<std::string> names;
+    };
+
+    static Table& instance() {
+        static Table table;
+        return table;
+    }
+
+    // At most MAX_TAGS names, a scan is enough and does not allocate
+    static TagId lookup(const Table& table, std::string_view name) {
+        for (std::size_t idx = 0; idx < table.names.size(); ++idx) {
+            if (table.names[idx] == name)
+                return static_cast<TagId>(idx);
+        }
+        return INVALID_TAG_ID;
+    }
+};
+
+/**
+ * @brief Set of tags as a bitmask of TagRegistry ids.
+ *
+ * Testing a tag or whether two sets share one is a single AND. Hot loops
+ * should keep the TagId or TagSet they test against in a static instead of
+ * going through the name overloads, which look the name up in the registry.
+ */
+class TagSet {
+   public:
+    TagSet() = default;
+
+    TagSet(std::initializer_list<std::string_view> names) {
+        for (auto name : names)
+            add(name);
+    }
+
+    TagSet(const std::vector<std::string>& names) {
+        for (const auto& name : names)
+            add(name);
+    }
+
+    /**
+        @param std::string_view name of the tag
+        @return false if the registry is full and the tag could not be added
+    */
+    bool add(std::string_view name) {
+        TagId id = TagRegistry::intern(name);
+
+        if (id == INVALID_TAG_ID)
+            return false;
+        _mask |= bit(id);
+        return true;
+    }
+
+    void remove(std::string_view name) {
+        TagId id = TagRegistry::find(name);
+
+        if (id != INVALID_TAG_ID)
+            _mask &= ~bit(id);
+    }
+
+    void clear() { _mask = 0; }
+
+    bool has(TagId id) const { return id < MAX_TAGS && (_mask & bit(id)) != 0; }
+    bool has(std::string_view name) const { return has(TagRegistry::find(name)); }
+
+    // True if both sets share at least one tag
+    bool intersects(const TagSet& other) const { return (_mask & other._mask) != 0; }
+
+    bool empty() const { return _mask == 0; }
+    std::size_t size() const { return static_cast<std::size_t>(std::popcount(_mask)); }
+    uint64_t mask() const { return _mask; }
+
+    // Names of the tags in id order, what goes over the network
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+
+        result.reserve(size());
+        for (uint64_t rest = _mask; rest != 0; rest &= rest - 1)
+            result.push_back(TagRegistry::name(static_cast<TagId>(std::countr_zero(rest))));
+        return result;
+    }
+
+    bool operator==(const TagSet& other) const { return _mask == other._mask; }
+
+   private:
+    static uint64_t bit(TagId id) { return uint64_t{1} << id; }
+
+    uint64_t _mask = 0;
+};
@@ -19,18 +19,18 @@ void ActionScriptSystem::update(Registry& registry, system_context context) {
             // Script on a networked entity. Check its owner.
             uint32_t ownerId = registry.getConstComponent<NetworkIdentity>(entity).ownerId;
             if (ownerId != 0) {  // It's owned by a player
-                for (auto& [action_name, function] : script.actionOnPressed) {
-                    if (context.input.isJustPressed(action_name, ownerId)) {
+                for (auto& [action, function] : script.actionOnPressed) {
+                    if (context.input.isJustPressed(action, ownerId)) {
                         function(registry, context, entity);
                     }
                 }
-                for (auto& [action_name, function] : script.actionPressed) {
-                    if (context.input.isPressed(action_name, ownerId)) {
+                for (auto& [action, function] : script.actionPressed) {
+                    if (context.input.isPressed(action, ownerId)) {
                         function(registry, context, entity);
                     }
                 }
-                for (auto& [action_name, function] : script.actionOnReleased) {
-                    if (context.input.isJustReleased(action_name, ownerId)) {
+                for (auto& [action, function] : script.actionOnReleased) {
+                    if (context.input.isJustReleased(action, ownerId)) {
                         function(registry, context, entity);
                     }
                 }
@@ -39,18 +39,18 @@ void ActionScriptSystem::update(Registry& registry, system_context context) {
             // Script on a non-networked, server-side-only entity.
             // This could be a "global" script that reacts to any player's input.
             for (uint32_t client_id : context.active_clients) {
-                for (auto& [action_name, function] : script.actionOnPressed) {
-                    if (context.input.isJustPressed(action_name, client_id)) {
+                for (auto& [action, function] : script.actionOnPressed) {
+                    if (context.input.isJustPressed(action, client_id)) {
                         function(registry, context, entity);
                     }
                 }
-                for (auto& [action_name, function] : script.actionPressed) {
-                    if (context.input.isPressed(action_name, client_id)) {
+                for (auto& [action, function] : script.actionPressed) {
+                    if (context.input.isPressed(action, client_id)) {
                         function(registry, context, entity);
                     }
                 }
-                for (auto& [action_name, function] : script.actionOnReleased) {
-                    if (context.input.isJustReleased(action_name, client_id)) {
+                for (auto& [action, function] : script.actionOnReleased) {
+                    if (context.input.isJustReleased(action, client_id)) {
                         function(registry, context, entity);
                     }
                 }
@@ -71,18 +71,18 @@ void ActionScriptSystem::update(Registry& registry, system_context context) {
         }
 
         ActionScript script = registry.getConstComponent<ActionScript>(entity);
-        for (auto& [action_name, function] : script.actionOnPressed) {
-            if (context.input.isJustPressed(action_name)) {
+        for (auto& [action, function] : script.actionOnPressed) {
+            if (context.input.isJustPressed(action)) {
                 function(registry, context, entity);
             }
         }
-        for (auto& [action_name, function] : script.actionPressed) {
-            if (context.input.isPressed(action_name)) {
+        for (auto& [action, function] : script.actionPressed) {
+            if (context.input.isPressed(action)) {
                 function(registry, context, entity);
             }
         }
-        for (auto& [action_name, function] : script.actionOnReleased) {
-            if (context.input.isJustReleased(action_name)) {
+        for (auto& [action, function] : script.actionOnReleased) {
+            if (context.input.isJustReleased(action)) {
                 function(registry, context, entity);
             }
         }
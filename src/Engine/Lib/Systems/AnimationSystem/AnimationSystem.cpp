@@ -8,36 +8,42 @@
 #include "AnimationSystem.hpp"
 #include <algorithm>
 
+SystemAccess AnimationSystem::access() const {
+    return SystemAccess().writes<AnimatedSprite2D>();
+}
+
 void AnimationSystem::update(Registry& registry, system_context context) {
     const float dt = context.dt;
 
     const auto& animEntities = registry.getEntities<AnimatedSprite2D>();
     for (Entity e : animEntities) {
-        auto& anim = registry.getComponent<AnimatedSprite2D>(e);
+        step(registry.getComponent<AnimatedSprite2D>(e), dt);
+    }
+}
 
-        if (!anim.playing)
-            continue;
+void AnimationSystem::step(AnimatedSprite2D& anim, float dt) {
+    if (!anim.playing)
+        return;
 
-        auto it = anim.animations.find(anim.currentAnimation);
-        if (it == anim.animations.end())
-            continue;
+    const AnimationClip* clip = anim.clip();
+    if (!clip || clip->frames.empty())
+        return;
 
-        const AnimationClip& clip = it->second;
-        if (clip.frames.empty())
-            continue;
+    const std::size_t shown = anim.currentFrameIndex;
 
-        if (anim.currentFrameIndex >= clip.frames.size())
-            anim.currentFrameIndex = clip.frames.size() - 1;
+    if (anim.currentFrameIndex >= clip->frames.size())
+        anim.currentFrameIndex = clip->frames.size() - 1;
 
-        anim.timer += dt;
+    anim.timer += dt;
 
-        const float frameDuration = (clip.frameDuration > 0.f) ? clip.frameDuration : 0.1f;
+    const float frameDuration = (clip->frameDuration > 0.f) ? clip->frameDuration : 0.1f;
 
-        while (anim.timer >= frameDuration && anim.playing) {
-            anim.timer -= frameDuration;
-            advanceFrame(anim, clip);
-        }
+    while (anim.timer >= frameDuration && anim.playing) {
+        anim.timer -= frameDuration;
+        advanceFrame(anim, *clip);
     }
+    if (anim.currentFrameIndex != shown)
+        anim.refreshHitbox();
 }
 
 void AnimationSystem::advanceFrame(AnimatedSprite2D& anim, const AnimationClip& clip) {
@@ -14,6 +14,14 @@ class AnimationSystem : public ISystem {
    public:
     AnimationSystem() = default;
     void update(Registry& registry, system_context context) override;
+    SystemAccess access() const override;
+
+    /**
+        A function to advance the clip of a sprite by dt, what update does for each sprite
+        @param AnimatedSprite2D sprite
+        @param float elapsed time
+    */
+    static void step(AnimatedSprite2D& anim, float dt);
 
    private:
     static void advanceFrame(AnimatedSprite2D& anim, const AnimationClip& clip);
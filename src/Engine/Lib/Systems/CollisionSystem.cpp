@@ -12,94 +12,122 @@
 void BoxCollision::update(Registry& registry, system_context context) {
     auto& entities = registry.getEntities<BoxCollisionComponent>();
 
+    // Colliders that touched nothing last tick are left clean so they are not replicated again
     for (auto entity : entities) {
-        auto& col = registry.getComponent<BoxCollisionComponent>(entity);
-        col.collision.tags.clear();
+        if (!registry.getConstComponent<BoxCollisionComponent>(entity).collision.tags.empty())
+            registry.getComponent<BoxCollisionComponent>(entity).collision.tags.clear();
     }
 
-    for (auto entity_a : entities) {
-        if (!registry.hasComponent<transform_component_s>(entity_a))
-            continue;
-        if (!registry.hasComponent<TagComponent>(entity_a))
-            continue;
+#if defined(SERVER_BUILD)
+    // A lobby world only holds one lobby, its colliders all go in the same bucket
+    buildProxies(registry, context.dt, context.lobby_id == 0);
+#else
+    buildProxies(registry, context.dt, true);
+#endif
 
-        uint32_t lobby_a = engine::utils::getLobbyId(registry, entity_a);
-
-        auto& transform_a = registry.getConstComponent<transform_component_s>(entity_a);
-        auto& collision_comp = registry.getComponent<BoxCollisionComponent>(entity_a);
-        for (auto entity_b : entities) {
-            if (entity_a == entity_b)
-                continue;
+    for (std::size_t i = 0; i < _proxies.size(); ++i) {
+        const ColliderProxy& proxy_a = _proxies[i];
 
-            // Skip collision if entities are from different lobbies
-            uint32_t lobby_b = engine::utils::getLobbyId(registry, entity_b);
-            if (lobby_a != lobby_b && lobby_a != 0 && lobby_b != 0)
-                continue;
+        // A callback of a previous entity may have removed this collider
+        if (!registry.hasComponent<BoxCollisionComponent>(proxy_a.entity))
+            continue;
+        const auto& collision_comp = registry.getConstComponent<BoxCollisionComponent>(proxy_a.entity);
+        if (collision_comp.tagCollision.empty())
+            continue;
 
-            if (!registry.hasComponent<TagComponent>(entity_b))
-                continue;
-            if (!hasTagToCollide(collision_comp, registry.getConstComponent<TagComponent>(entity_b)))
+        gatherCandidates(proxy_a);
+        for (auto index : _candidates) {
+            const ColliderProxy& proxy_b = _proxies[index];
+            if (proxy_a.entity == proxy_b.entity)
                 continue;
-            if (!registry.hasComponent<transform_component_s>(entity_b))
+            if (!registry.hasComponent<TagComponent>(proxy_b.entity))
                 continue;
-            // if (!registry.hasComponent<sprite2D_component_s>(entity_a))
-            //     continue;
-            // if (!registry.hasComponent<sprite2D_component_s>(entity_b))
-            //     continue;
-            float sprite_a_width;
-            float sprite_a_height;
-            float sprite_b_width;
-            float sprite_b_height;
-            if (registry.hasComponent<AnimatedSprite2D>(entity_a)) {
-                auto& sprite_a = registry.getConstComponent<AnimatedSprite2D>(entity_a);
-                sprite_a_width =
-                    sprite_a.animations.at(sprite_a.currentAnimation).frames.at(sprite_a.currentFrameIndex).width;
-                sprite_a_height =
-                    sprite_a.animations.at(sprite_a.currentAnimation).frames.at(sprite_a.currentFrameIndex).height;
-            } else if (registry.hasComponent<Sprite2D>(entity_a)) {
-                auto& sprite_a = registry.getConstComponent<Sprite2D>(entity_a);
-                sprite_a_width = sprite_a.rect.width;
-                sprite_a_height = sprite_a.rect.height;
-            } else {
+            if (!hasTagToCollide(collision_comp, registry.getConstComponent<TagComponent>(proxy_b.entity)))
                 continue;
+            if (checkSize(proxy_a.transform, proxy_b.transform, proxy_a.size, proxy_b.size, proxy_a.velocity,
+                          proxy_b.velocity, context.dt)) {
+                registry.getComponent<BoxCollisionComponent>(proxy_a.entity).collision.tags.push_back(proxy_b.entity);
             }
+        }
+        if (collision_comp.callbackOnCollide && !collision_comp.collision.tags.empty())
+            collision_comp.callbackOnCollide(registry, context, proxy_a.entity);
+    }
+}
 
-            if (registry.hasComponent<AnimatedSprite2D>(entity_b)) {
-                auto& sprite_b = registry.getConstComponent<AnimatedSprite2D>(entity_b);
-                sprite_b_width =
-                    sprite_b.animations.at(sprite_b.currentAnimation).frames.at(sprite_b.currentFrameIndex).width;
-                sprite_b_height =
-                    sprite_b.animations.at(sprite_b.currentAnimation).frames.at(sprite_b.currentFrameIndex).height;
-            } else if (registry.hasComponent<Sprite2D>(entity_b)) {
-                auto& sprite_b = registry.getConstComponent<Sprite2D>(entity_b);
-                sprite_b_width = sprite_b.rect.width;
-                sprite_b_height = sprite_b.rect.height;
-            } else {
-                continue;
-            }
-            auto& transform_b = registry.getConstComponent<transform_component_s>(entity_b);
+void BoxCollision::buildProxies(Registry& registry, float dt, bool split_lobbies) {
+    _proxies.clear();
+    _grid.clear();
+
+    auto& velocities = registry.getPool<Velocity2D>();
+
+    registry.each<const BoxCollisionComponent, const transform_component_s, const TagComponent>(
+        [&](Entity entity, const BoxCollisionComponent&, const transform_component_s& transform, const TagComponent&) {
+            ColliderProxy proxy;
+            proxy.entity = entity;
+            if (!getColliderSize(registry, proxy.entity, proxy.size))
+                return;
+            proxy.lobby_id = split_lobbies ? engine::utils::getLobbyId(registry, proxy.entity) : 0;
+            proxy.transform = transform;
+            proxy.velocity = {0, 0};
+            if (const auto* velocity = velocities.tryGetDataFromId(entity))
+                proxy.velocity = *velocity;
+            proxy.bounds = sweptBounds(proxy.transform, proxy.size, proxy.velocity, dt);
+
+            _grid.insert(proxy.lobby_id, _proxies.size(), proxy.bounds);
+            _proxies.push_back(proxy);
+        });
+    _grid.build();
+}
 
-            Velocity2D vel_a = {0, 0};
-            if (registry.hasComponent<Velocity2D>(entity_a))
-                vel_a = registry.getConstComponent<Velocity2D>(entity_a);
+void BoxCollision::gatherCandidates(const ColliderProxy& proxy) {
+    _candidates.clear();
 
-            Velocity2D vel_b = {0, 0};
-            if (registry.hasComponent<Velocity2D>(entity_b))
-                vel_b = registry.getConstComponent<Velocity2D>(entity_b);
+    // Lobby 0 is global: it collides with every lobby and every lobby collides with it
+    if (proxy.lobby_id == 0) {
+        for (auto bucket : _grid.getBuckets()) {
+            _grid.query(bucket, proxy.bounds, _candidates);
+        }
+    } else {
+        _grid.query(proxy.lobby_id, proxy.bounds, _candidates);
+        _grid.query(0, proxy.bounds, _candidates);
+    }
 
-            // if (checkSize(transform_a, transform_b, {sprite_a.dimension.width, sprite_a.dimension.height},
-            //               {sprite_b.dimension.width, sprite_b.dimension.height}, vel_a, vel_b, context.dt)) {
-            //     collision_comp.collision.tags.push_back(entity_b);
-            // }
+    // Keep the pool order so collision lists are filled in the same order as before
+    std::sort(_candidates.begin(), _candidates.end());
+    _candidates.erase(std::unique(_candidates.begin(), _candidates.end()), _candidates.end());
+}
 
-            if (checkSize(transform_a, transform_b, {sprite_a_width, sprite_a_height},
-                          {sprite_b_width, sprite_b_height}, vel_a, vel_b, context.dt)) {
-                collision_comp.collision.tags.push_back(entity_b);
-            }
-        }
-        if (collision_comp.callbackOnCollide && !collision_comp.collision.tags.empty())
-            collision_comp.callbackOnCollide(registry, context, entity_a);
+bool BoxCollision::getColliderSize(Registry& registry, Entity entity, std::pair<float, float>& size) {
+    if (registry.hasComponent<AnimatedSprite2D>(entity)) {
+        auto& sprite = registry.getConstComponent<AnimatedSprite2D>(entity);
+        size = {sprite.hitboxWidth, sprite.hitboxHeight};
+        return true;
+    }
+    if (registry.hasComponent<Sprite2D>(entity)) {
+        auto& sprite = registry.getConstComponent<Sprite2D>(entity);
+        size = {sprite.rect.width, sprite.rect.height};
+        return true;
     }
+    return false;
+}
+
+engine::utils::AABB BoxCollision::sweptBounds(const transform_component_s& transform, std::pair<float, float> size,
+                                              const Velocity2D& vel, float dt) {
+    // Same box as checkSize, padded so float rounding never drops a pair the narrow phase would accept
+    static constexpr float padding = 1.0f;
+    float width = size.first * transform.scale_x;
+    float height = size.second * transform.scale_y;
+    float min_x = transform.x - width * 0.5f;
+    float min_y = transform.y - height * 0.5f;
+    float dx = vel.vx * dt;
+    float dy = vel.vy * dt;
+
+    engine::utils::AABB box;
+    box.min_x = std::min({min_x, min_x + width, min_x + dx, min_x + width + dx}) - padding;
+    box.max_x = std::max({min_x, min_x + width, min_x + dx, min_x + width + dx}) + padding;
+    box.min_y = std::min({min_y, min_y + height, min_y + dy, min_y + height + dy}) - padding;
+    box.max_y = std::max({min_y, min_y + height, min_y + dy, min_y + height + dy}) + padding;
+    return box;
 }
 
 bool BoxCollision::checkSize(const transform_component_s a, const transform_component_s b,
@@ -130,15 +158,6 @@ bool BoxCollision::checkSize(const transform_component_s a, const transform_comp
     return collision_x && collision_y;
 }
 
-bool BoxCollision::hasTagToCollide(BoxCollisionComponent entity_a, const TagComponent& entity_b) {
-    if (entity_a.tagCollision.empty()) {
-        return false;
-    }
-    for (auto tag_to_collide : entity_a.tagCollision) {
-        for (auto tag : entity_b.tags) {
-            if (tag_to_collide == tag)
-                return true;
-        }
-    }
-    return false;
+bool BoxCollision::hasTagToCollide(const BoxCollisionComponent& entity_a, const TagComponent& entity_b) {
+    return entity_a.tagCollision.intersects(entity_b.tags);
 }
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <utility>
 #include "Components/StandardComponents.hpp"
 #include "Components/tag_component.hpp"
 #include "ISystem.hpp"
 #include "registry.hpp"
+#include "../Utils/SpatialGrid.hpp"
 
 class BoxCollision : public ISystem {
    public:
@@ -14,7 +16,30 @@ class BoxCollision : public ISystem {
     void update(Registry& registry, system_context context) override;
 
    private:
+    /**
+     * @brief Snapshot of everything the narrow phase needs for one collider,
+     * taken once per tick so pairs never go back to the registry.
+     */
+    struct ColliderProxy {
+        Entity entity;
+        uint32_t lobby_id;
+        transform_component_s transform;
+        std::pair<float, float> size;
+        Velocity2D velocity;
+        engine::utils::AABB bounds;
+    };
+
+    void buildProxies(Registry& registry, float dt, bool split_lobbies);
+    void gatherCandidates(const ColliderProxy& proxy);
+    bool getColliderSize(Registry& registry, Entity entity, std::pair<float, float>& size);
+    static engine::utils::AABB sweptBounds(const transform_component_s& transform, std::pair<float, float> size,
+                                           const Velocity2D& vel, float dt);
+
     bool checkSize(const transform_component_s a, const transform_component_s b, std::pair<float, float> size,
                    std::pair<float, float> size_b, Velocity2D vel_a, Velocity2D vel_b, float dt);
-    bool hasTagToCollide(BoxCollisionComponent entity_a, const TagComponent& entity_b);
+    bool hasTagToCollide(const BoxCollisionComponent& entity_a, const TagComponent& entity_b);
+
+    engine::utils::SpatialGrid _grid;
+    std::vector<ColliderProxy> _proxies;
+    std::vector<std::size_t> _candidates;
 };
@@ -7,6 +7,7 @@
 #include "Components/StandardComponents.hpp"  // For sprite2D_component_s, transform_component_s
 #include "ServerGameEngine.hpp"               // For LobbyManager
 #include <iostream>
+#include <utility>
 #include <variant>
 #include "NetworkEngine/NetworkEngine.hpp"
 #include "ECS/Utils/Hash/Hash.hpp"  // For Hash::fnv1a
@@ -33,12 +34,17 @@ void ComponentSenderSystem::update(Registry& reg, system_context ctx) {
     }
     auto server = std::get<std::shared_ptr<network::Server>>(network_instance);
 
-    ComponentPacket packet;
-    SerializationContext s_ctx = {ctx.texture_manager};
+    SerializationContext s_ctx = {ctx.texture_manager, &_animationSets};
     auto& component_pools = reg.getComponentPools();
 
-    // Iterate over pools to send only updated (dirty) components
-    for (auto& [type, pool] : component_pools) {
+    _records.clear();
+    _animationSets.clear();
+
+    // Iterate over pools to collect only updated (dirty) components
+    for (auto& pool : component_pools) {
+        if (!pool) {
+            continue;
+        }
         // Skip components that are not registered for network replication
         uint32_t typeHash = pool->getTypeHash();
         if (ctx.networked_component_types->find(typeHash) == ctx.networked_component_types->end()) {
@@ -51,33 +57,62 @@ void ComponentSenderSystem::update(Registry& reg, system_context ctx) {
             continue;
         }
 
-        // Create packets for all updated entities
         for (auto entity : updated_entities) {
             if (!reg.hasComponent<NetworkIdentity>(entity)) {
                 continue;
             }
 
-            // Get entity's lobby ID (0 means global/all lobbies)
-            uint32_t entityLobbyId = engine::utils::getLobbyId(reg, entity);
-
-            packet = pool->createPacket(entity, s_ctx);
+            PendingRecord record;
+            // Get entity's lobby ID (0 means global/all lobbies), a lobby world only holds its own lobby
+            record.lobby_id = ctx.lobby_id != 0 ? ctx.lobby_id : engine::utils::getLobbyId(reg, entity);
+            std::size_t sets = _animationSets.size();
+            record.packet = pool->createPacket(entity, s_ctx);
+            if (_animationSets.size() > sets) {
+                record.has_animation_set = true;
+                record.animation_set = _animationSets.back();
+            }
             auto& netId = reg.getConstComponent<NetworkIdentity>(entity);
-            packet.entity_guid = netId.guid;
-            packet.owner_id = netId.ownerId;  // Explicitly set owner_id
+            record.packet.entity_guid = netId.guid;
+            record.packet.owner_id = netId.ownerId;  // Explicitly set owner_id
+            _records.push_back(std::move(record));
+        }
+    }
 
-            for (auto const& [lobbyId, lobby] : lobbies) {
-                if (lobby.getState() != engine::core::Lobby::State::IN_GAME) {
-                    continue;
-                }
+    if (_records.empty()) {
+        return;
+    }
 
+    // Each client gets its own batches: updates are encoded against the last
+    // values that client acknowledged, and skipped when it already has them.
+    auto& baselines = ctx.network.getSentSnapshots();
+    for (auto const& [lobbyId, lobby] : lobbies) {
+        if (lobby.getState() != engine::core::Lobby::State::IN_GAME) {
+            continue;
+        }
+        if (ctx.lobby_id != 0 && lobbyId != ctx.lobby_id) {
+            continue;
+        }
+
+        for (const auto& client : lobby.getClients()) {
+            _clientAnimationSets.clear();
+            baselines.begin(client.id, _writer);
+            for (const auto& record : _records) {
                 // Only send to clients in the same lobby, or if entity is global (lobbyId = 0)
-                if (entityLobbyId != 0 && entityLobbyId != lobbyId) {
+                if (record.lobby_id != 0 && record.lobby_id != lobbyId) {
                     continue;  // Skip - entity belongs to a different lobby
                 }
-
-                for (const auto& client : lobby.getClients()) {
-                    server->AddMessageToPlayer(network::GameEvents::S_SNAPSHOT, client.id, packet);
+                if (record.has_animation_set) {
+                    _clientAnimationSets.push_back(record.animation_set);
                 }
+                baselines.write(client.id, record.packet, _writer);
+            }
+            baselines.end(client.id, _writer);
+
+            // The definitions go over TCP first, a record that still outruns them is resolved when they land
+            ctx.network.getSentAnimationSets().send(*server, client.id, _clientAnimationSets);
+
+            for (std::size_t idx = 0; idx < _writer.size(); ++idx) {
+                server->AddMessageToPlayer(network::GameEvents::S_SNAPSHOT_BATCH, client.id, _writer.at(idx));
             }
         }
     }
@@ -1,11 +1,27 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
 #include "ISystem.hpp"
 #include "registry.hpp"
+#include "Components/NetworkComponents.hpp"
 
 class ComponentSenderSystem : public ISystem {
    public:
     ComponentSenderSystem() = default;
     ~ComponentSenderSystem() = default;
     void update(Registry& ref, system_context ctx);
+
+   private:
+    struct PendingRecord {
+        uint32_t lobby_id;
+        ComponentPacket packet;
+        bool has_animation_set = false;
+        uint64_t animation_set = 0;  // key of the AnimationSet the record carries
+    };
+
+    std::vector<PendingRecord> _records;
+    std::vector<uint64_t> _animationSets;        // keys written by createPacket this tick
+    std::vector<uint64_t> _clientAnimationSets;  // keys the records of one client use
+    network::SnapshotBatchWriter _writer;
 };
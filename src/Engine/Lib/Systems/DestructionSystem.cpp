@@ -64,6 +64,9 @@ void DestructionSystem::update(Registry& registry, system_context context) {
                     if (lobby.getState() != engine::core::Lobby::State::IN_GAME) {
                         continue;
                     }
+                    if (context.lobby_id != 0 && lobbyId != context.lobby_id) {
+                        continue;
+                    }
 
                     for (const auto& client : lobby.getClients()) {
                         server->AddMessageToPlayer(network::GameEvents::S_ENTITY_DESTROY, client.id, netId.guid);
@@ -75,7 +78,5 @@ void DestructionSystem::update(Registry& registry, system_context context) {
 #endif
 
     // Perform local destruction
-    for (auto entity : to_destroy) {
-        registry.destroyEntity(entity);
-    }
+    registry.destroyEntities(to_destroy);
 }
@@ -11,34 +11,29 @@
 #include "../../Components/StandardComponents.hpp"
 #include "../../Components/GroundComponent.hpp"
 
-void GravitySystem::update(Registry& registry, system_context context) {
-    auto& gravityPool = registry.getEntities<GravityComponent>();
-
-    for (Entity entity : gravityPool) {
-        if (!registry.hasComponent<Velocity2D>(entity))
-            continue;
-
-        auto& gravity = registry.getComponent<GravityComponent>(entity);
-        auto& velocity = registry.getComponent<Velocity2D>(entity);
-
-        if (!gravity.grounded) {
-            gravity.vectorY += gravity.force * context.dt;
-        } else {
-            gravity.vectorY = 0.0f;
-        }
+SystemAccess GravitySystem::access() const {
+    return SystemAccess().reads<Velocity2D, GroundComponent>().writes<GravityComponent, transform_component_s>();
+}
 
-        checkGrounded(registry, entity, context);
-    }
+void GravitySystem::update(Registry& registry, system_context context) {
+    registry.each<GravityComponent, const Velocity2D, transform_component_s>(
+        [&](Entity, GravityComponent& gravity, const Velocity2D& velocity, transform_component_s& transform) {
+            if (!gravity.grounded) {
+                gravity.vectorY += gravity.force * context.dt;
+            } else {
+                gravity.vectorY = 0.0f;
+            }
+
+            checkGrounded(registry, gravity, velocity, transform, context);
+        });
 }
 
-void GravitySystem::checkGrounded(Registry& registry, Entity entity, system_context context) {
-    auto& gravity = registry.getComponent<GravityComponent>(entity);
-    auto& velocity = registry.getComponent<Velocity2D>(entity);
-    auto& transform = registry.getComponent<transform_component_s>(entity);
+void GravitySystem::checkGrounded(Registry& registry, GravityComponent& gravity, const Velocity2D& velocity,
+                                  transform_component_s& transform, system_context context) {
     auto& ground = registry.getEntities<GroundComponent>();
 
     for (Entity groundEntity : ground) {
-        auto& groundComp = registry.getComponent<GroundComponent>(groundEntity);
+        auto& groundComp = registry.getConstComponent<GroundComponent>(groundEntity);
 
         if (transform.y + (velocity.vy * context.dt) + gravity.vectorY >= groundComp.rect.y &&
             transform.y + (velocity.vy * context.dt) + gravity.vectorY <= groundComp.rect.y + groundComp.rect.height &&
@@ -7,12 +7,15 @@
 
 #include "../../../Core/ECS/ISystem.hpp"
 #include "../../Components/GravityComponent.hpp"
+#include "../../Components/StandardComponents.hpp"
 
 class GravitySystem : public ISystem {
    public:
     GravitySystem() = default;
     void update(Registry& registry, system_context context) override;
+    SystemAccess access() const override;
 
    private:
-    void checkGrounded(Registry& registry, Entity entity, system_context context);
+    void checkGrounded(Registry& registry, GravityComponent& gravity, const Velocity2D& velocity,
+                       transform_component_s& transform, system_context context);
 };
@@ -8,125 +8,95 @@
 #include "NewRenderSystem.hpp"
 #include "Context.hpp"
 
-#include <algorithm>
 #include <iostream>
-#include <vector>
-#include <utility>
 
-static void applyFlip(sf::Sprite& spr, bool flipX, bool flipY) {
-    const auto rect = spr.getTextureRect();
-
-    spr.setOrigin({static_cast<float>(rect.size.x) * 0.5f, static_cast<float>(rect.size.y) * 0.5f});
+static const sf::Texture* findTexture(handle_t<TextureAsset> handle, const system_context& context) {
+    if (!context.texture_manager.has(handle))
+        return nullptr;
+    return &context.texture_manager.get_resource(handle).value().get();
+}
 
-    spr.setScale({(flipX ? -1.f : 1.f), (flipY ? -1.f : 1.f)});
+static sf::Vector2f spriteScale(const transform_component_s& transform, bool flipX, bool flipY) {
+    return {transform.scale_x * (flipX ? -1.f : 1.f), transform.scale_y * (flipY ? -1.f : 1.f)};
 }
 
 void NewRenderSystem::update(Registry& registry, system_context context) {
-    std::vector<DrawCmd> cmds;
-    const auto& spriteEntities = registry.getEntities<Sprite2D>();
-    const auto& animEntities = registry.getEntities<AnimatedSprite2D>();
-    const auto& textIds = registry.getEntities<TextComponent>();
-    cmds.reserve(spriteEntities.size() + animEntities.size());
-    std::uint64_t order = 0;
-
-    for (Entity e : spriteEntities) {
-        if (!registry.hasComponent<transform_component_s>(e))
-            continue;
-
-        const auto& tr = registry.getComponent<transform_component_s>(e);
-        const auto& sp = registry.getComponent<Sprite2D>(e);
-        drawSpriteEntity(tr, sp, context, cmds, order);
+    // The view is assumed unrotated, a rotated one would cull by its unrotated bounds
+    const sf::View& view = context.window.getView();
+    _batcher.begin(sf::FloatRect(view.getCenter() - view.getSize() * 0.5f, view.getSize()));
+
+    registry.each<const transform_component_s, const Sprite2D>(
+        [&](Entity, const transform_component_s& tr, const Sprite2D& sp) { addSpriteEntity(tr, sp, context); });
+
+    registry.each<const transform_component_s, const AnimatedSprite2D>(
+        [&](Entity, const transform_component_s& tr, const AnimatedSprite2D& sp) {
+            addAnimatedSpriteEntity(tr, sp, context);
+        });
+
+    _batcher.build();
+    for (std::size_t idx = 0; idx < _batcher.size(); ++idx) {
+        const SpriteBatch& batch = _batcher.at(idx);
+        context.window.draw(batch.vertices, sf::RenderStates(batch.texture));
     }
 
-    for (Entity e : animEntities) {
-        if (!registry.hasComponent<transform_component_s>(e))
-            continue;
-
-        const auto& tr = registry.getComponent<transform_component_s>(e);
-        const auto& sp = registry.getComponent<AnimatedSprite2D>(e);
-        drawAnimatedSpriteEntity(tr, sp, context, cmds, order);
-    }
-
-    std::stable_sort(cmds.begin(), cmds.end(), [](const DrawCmd& a, const DrawCmd& b) {
-        if (a.layer != b.layer)
-            return a.layer < b.layer;
-        return a.order < b.order;
-    });
-
-    for (auto& cmd : cmds)
-        context.window.draw(cmd.sprite);
-
-    for (Entity entity : textIds) {
-        auto& textComp = registry.getComponent<TextComponent>(entity);
-        drawText(textComp, context);
-    }
+    drawTexts(registry, context);
 }
 
-void NewRenderSystem::drawSpriteEntity(const transform_component_s& transform, const Sprite2D& spriteData,
-                                       const system_context& context, std::vector<DrawCmd>& out, std::uint64_t& order) {
-    if (!context.texture_manager.has(spriteData.handle))
-        return;
-
-    sf::Texture& texture = context.texture_manager.get_resource(spriteData.handle).value().get();
-    sf::Sprite spr(texture);
-
-    spr.setTextureRect(
-        sf::IntRect({spriteData.rect.x, spriteData.rect.y}, {spriteData.rect.width, spriteData.rect.height}));
-
-    applyFlip(spr, spriteData.flipX, spriteData.flipY);
-
-    spr.setPosition({transform.x, transform.y});
-    spr.setScale({transform.scale_x * spr.getScale().x, transform.scale_y * spr.getScale().y});
+void NewRenderSystem::addSpriteEntity(const transform_component_s& transform, const Sprite2D& spriteData,
+                                      const system_context& context) {
+    const sf::Texture* texture = findTexture(spriteData.handle, context);
 
-    out.push_back(DrawCmd{static_cast<int>(spriteData.layer), order++, std::move(spr)});
-}
-
-void NewRenderSystem::drawAnimatedSpriteEntity(const transform_component_s& transform,
-                                               const AnimatedSprite2D& spriteData, const system_context& context,
-                                               std::vector<DrawCmd>& out, std::uint64_t& order) {
-    if (spriteData.currentAnimation.empty() ||
-        spriteData.animations.find(spriteData.currentAnimation) == spriteData.animations.end())
+    if (!texture)
         return;
+    _batcher.add(static_cast<int>(spriteData.layer), texture, spriteData.rect, {transform.x, transform.y},
+                 spriteScale(transform, spriteData.flipX, spriteData.flipY));
+}
 
-    const auto& clip = spriteData.animations.at(spriteData.currentAnimation);
+void NewRenderSystem::addAnimatedSpriteEntity(const transform_component_s& transform,
+                                              const AnimatedSprite2D& spriteData, const system_context& context) {
+    const AnimationClip* clip = spriteData.clip();
+    const Rect2D* frame = spriteData.frame();
 
-    if (!context.texture_manager.has(clip.handle))
+    if (!clip || !frame)
         return;
 
-    if (spriteData.currentFrameIndex >= clip.frames.size())
-        return;
-
-    sf::Texture& texture = context.texture_manager.get_resource(clip.handle).value().get();
-    sf::Sprite spr(texture);
-
-    spr.setTextureRect(sf::IntRect(
-        {clip.frames[spriteData.currentFrameIndex].x, clip.frames[spriteData.currentFrameIndex].y},
-        {clip.frames[spriteData.currentFrameIndex].width, clip.frames[spriteData.currentFrameIndex].height}));
-
-    applyFlip(spr, spriteData.flipX, spriteData.flipY);
+    const sf::Texture* texture = findTexture(clip->handle, context);
 
-    spr.setPosition({transform.x, transform.y});
-    spr.setScale({transform.scale_x * spr.getScale().x, transform.scale_y * spr.getScale().y});
-
-    out.push_back(DrawCmd{static_cast<int>(spriteData.layer), order++, std::move(spr)});
+    if (!texture)
+        return;
+    _batcher.add(static_cast<int>(spriteData.layer), texture, *frame, {transform.x, transform.y},
+                 spriteScale(transform, spriteData.flipX, spriteData.flipY));
 }
 
-void NewRenderSystem::drawText(const TextComponent& textComp, const system_context& context) {
-    if (!_fontLoaded) {
-        if (!_font.openFromFile(textComp.fontPath)) {
-            std::cerr << "Failed to load font: " << textComp.fontPath << std::endl;
-            return;
+void NewRenderSystem::drawTexts(Registry& registry, const system_context& context) {
+    _frame++;
+    for (Entity entity : registry.getEntities<TextComponent>()) {
+        const auto& textComp = registry.getConstComponent<TextComponent>(entity);
+
+        if (!_fontLoaded) {
+            if (!_font.openFromFile(textComp.fontPath)) {
+                std::cerr << "Failed to load font: " << textComp.fontPath << std::endl;
+                return;
+            }
+            _fontLoaded = true;
         }
-        _fontLoaded = true;
-    }
 
-    if (!_fontLoaded)
-        return;
+        auto it = _texts.find(entity);
+        if (it == _texts.end())
+            it = _texts.emplace(entity, CachedText{sf::Text(_font), std::string(), 0}).first;
 
-    sf::Text text(_font);
-    text.setString(textComp.text);
-    text.setCharacterSize(textComp.characterSize);
-    text.setFillColor(textComp.color);
-    text.setPosition({textComp.x, textComp.y});
-    context.window.draw(text);
+        CachedText& cached = it->second;
+        if (cached.string != textComp.text) {
+            cached.text.setString(textComp.text);
+            cached.string = textComp.text;
+        }
+        if (cached.text.getCharacterSize() != textComp.characterSize)
+            cached.text.setCharacterSize(textComp.characterSize);
+        cached.text.setFillColor(textComp.color);
+        cached.text.setPosition({textComp.x, textComp.y});
+        cached.frame = _frame;
+        context.window.draw(cached.text);
+    }
+    // Texts of destroyed entities
+    std::erase_if(_texts, [this](const auto& entry) { return entry.second.frame != _frame; });
 }
@@ -10,12 +10,15 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <cstdint>
+#include <string>
+#include <unordered_map>
 
 #include "../../Components/Sprite/Sprite2D.hpp"
 #include "../../Components/Sprite/AnimatedSprite2D.hpp"
 
 #include "Components/StandardComponents.hpp"
 #include "ISystem.hpp"
+#include "SpriteBatcher.hpp"
 
 class NewRenderSystem : public ISystem {
    public:
@@ -24,21 +27,25 @@ class NewRenderSystem : public ISystem {
     void update(Registry& registry, system_context context) override;
 
    private:
-    struct DrawCmd {
-        int layer;
-        std::uint64_t order;
-        sf::Sprite sprite;
+    // A text kept from frame to frame, its glyphs are only laid out again when the string changes
+    struct CachedText {
+        sf::Text text;
+        std::string string;
+        std::uint64_t frame = 0;  // last frame it was drawn
     };
 
-    void drawSpriteEntity(const transform_component_s& transform, const Sprite2D& spriteData,
-                          const system_context& context, std::vector<DrawCmd>& out, std::uint64_t& order);
+    void addSpriteEntity(const transform_component_s& transform, const Sprite2D& spriteData,
+                         const system_context& context);
 
-    void drawAnimatedSpriteEntity(const transform_component_s& transform, const AnimatedSprite2D& spriteData,
-                                  const system_context& context, std::vector<DrawCmd>& out, std::uint64_t& order);
+    void addAnimatedSpriteEntity(const transform_component_s& transform, const AnimatedSprite2D& spriteData,
+                                 const system_context& context);
 
-    void drawText(const TextComponent& textComp, const system_context& context);
+    void drawTexts(Registry& registry, const system_context& context);
 
    private:
+    SpriteBatcher _batcher;
+    std::unordered_map<Entity, CachedText> _texts;
+    std::uint64_t _frame = 0;
     sf::Font _font;
     bool _fontLoaded = false;
 };
@@ -0,0 +1,137 @@
+/*
+** EPITECH PROJECT, 2025
+** Smash
+** File description:
+** SpriteBatcher.cpp
+*/
+
+#include "SpriteBatcher.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void SpriteBatcher::begin(const sf::FloatRect& view) {
+    _view = view;
+    _quads.clear();
+    _textures.clear();
+    _used = 0;
+    _culled = 0;
+}
+
+bool SpriteBatcher::add(int layer, const sf::Texture* texture, const Rect2D& rect, sf::Vector2f position,
+                        sf::Vector2f scale) {
+    const float halfWidth = std::abs(static_cast<float>(rect.width) * scale.x) * 0.5f;
+    const float halfHeight = std::abs(static_cast<float>(rect.height) * scale.y) * 0.5f;
+
+    if (position.x + halfWidth < _view.position.x || position.x - halfWidth > _view.position.x + _view.size.x ||
+        position.y + halfHeight < _view.position.y || position.y - halfHeight > _view.position.y + _view.size.y) {
+        _culled++;
+        return false;
+    }
+    _quads.push_back(Quad{texture, layer, rect, position, scale});
+    return true;
+}
+
+void SpriteBatcher::build() {
+    _keys.resize(_quads.size());
+    for (std::size_t idx = 0; idx < _quads.size(); ++idx) {
+        // Layer in the high half, biased so negative layers sort first
+        const uint32_t layer = static_cast<uint32_t>(std::clamp(_quads[idx].layer, -0x8000, 0x7FFF) + 0x8000);
+        _keys[idx] = (layer << 16) | textureId(_quads[idx].texture);
+    }
+    sortQuads();
+
+    for (std::size_t first = 0; first < _order.size();) {
+        const uint32_t key = _keys[_order[first]];
+        std::size_t last = first + 1;
+
+        while (last < _order.size() && _keys[_order[last]] == key)
+            last++;
+        if (_used == _batches.size())
+            _batches.emplace_back();
+
+        // Sized once per run, the vertex array keeps its storage from the previous frames
+        SpriteBatch& batch = _batches[_used++];
+        batch.layer = _quads[_order[first]].layer;
+        batch.texture = _quads[_order[first]].texture;
+        batch.vertices.resize((last - first) * 6);
+        for (std::size_t idx = first; idx < last; ++idx)
+            writeQuad(&batch.vertices[(idx - first) * 6], _quads[_order[idx]]);
+        first = last;
+    }
+}
+
+std::size_t SpriteBatcher::vertexCount() const {
+    std::size_t count = 0;
+
+    for (std::size_t idx = 0; idx < _used; ++idx)
+        count += _batches[idx].vertices.getVertexCount();
+    return count;
+}
+
+uint32_t SpriteBatcher::textureId(const sf::Texture* texture) {
+    // A frame uses a few textures, and consecutive sprites often share one
+    if (!_textures.empty() && _textures.back() == texture)
+        return static_cast<uint32_t>(_textures.size() - 1);
+    for (std::size_t idx = 0; idx < _textures.size(); ++idx) {
+        if (_textures[idx] == texture)
+            return static_cast<uint32_t>(idx);
+    }
+    _textures.push_back(texture);
+    return static_cast<uint32_t>(std::min<std::size_t>(_textures.size() - 1, 0xFFFF));
+}
+
+void SpriteBatcher::sortQuads() {
+    const std::size_t count = _keys.size();
+    uint32_t all = count > 0 ? _keys[0] : 0;
+    uint32_t any = 0;
+
+    _order.resize(count);
+    _scratch.resize(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        _order[idx] = static_cast<uint32_t>(idx);
+        all &= _keys[idx];
+        any |= _keys[idx];
+    }
+
+    // LSD radix sort, stable so quads sharing a key keep the order they were added in.
+    // A byte every key shares is skipped, most frames only sort on the layer and the texture id
+    for (int shift = 0; shift < 32; shift += 8) {
+        if (((all ^ any) >> shift & 0xFF) == 0)
+            continue;
+
+        std::size_t counts[256] = {};
+        for (uint32_t idx : _order)
+            counts[_keys[idx] >> shift & 0xFF]++;
+        std::size_t position = 0;
+        for (auto& bucket : counts) {
+            std::size_t size = bucket;
+            bucket = position;
+            position += size;
+        }
+        for (uint32_t idx : _order)
+            _scratch[counts[_keys[idx] >> shift & 0xFF]++] = idx;
+        _order.swap(_scratch);
+    }
+}
+
+void SpriteBatcher::writeQuad(sf::Vertex* vertices, const Quad& quad) {
+    const float width = static_cast<float>(quad.rect.width);
+    const float height = static_cast<float>(quad.rect.height);
+    const float left = static_cast<float>(quad.rect.x);
+    const float top = static_cast<float>(quad.rect.y);
+
+    // Same placement as an sf::Sprite whose origin is the center of its texture rect
+    auto corner = [&](float x, float y) {
+        return sf::Vertex{{quad.position.x + (x - width * 0.5f) * quad.scale.x,
+                           quad.position.y + (y - height * 0.5f) * quad.scale.y},
+                          sf::Color::White,
+                          {left + x, top + y}};
+    };
+    vertices[0] = corner(0.f, 0.f);
+    vertices[1] = corner(width, 0.f);
+    vertices[2] = corner(width, height);
+    vertices[3] = vertices[0];
+    vertices[4] = vertices[2];
+    vertices[5] = corner(0.f, height);
+}
@@ -0,0 +1,94 @@
+/*
+** EPITECH PROJECT, 2025
+** Smash
+** File description:
+** SpriteBatcher.hpp
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include "../../Components/StructDatas/Rect2D.hpp"
+
+/**
+ * @brief Vertices of every quad sharing a layer and a texture, drawn in one call.
+ */
+struct SpriteBatch {
+    int layer = 0;
+    const sf::Texture* texture = nullptr;
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+};
+
+/**
+ * @brief Turns the sprites of a frame into as few draw calls as possible.
+ *
+ * Quads outside the view are dropped, the others are sorted by layer then
+ * texture and the quads of each run are merged into one SpriteBatch. Sprites
+ * of a layer sharing a texture keep the order they were added in. Nothing
+ * here touches a window, it runs the same in a headless test.
+ */
+class SpriteBatcher {
+   public:
+    /**
+        Start a frame, keeping the vertices allocated by the previous ones
+        @param sf::FloatRect area of the world the view shows
+    */
+    void begin(const sf::FloatRect& view);
+
+    /**
+        A function to add a quad drawn like an sf::Sprite with its origin at its center
+        @param int layer, lower layers are drawn first
+        @param sf::Texture texture of the quad
+        @param Rect2D part of the texture to show
+        @param sf::Vector2f position of the center of the quad
+        @param sf::Vector2f scale, negative to flip
+        @return false if the quad is outside the view and was dropped
+    */
+    bool add(int layer, const sf::Texture* texture, const Rect2D& rect, sf::Vector2f position, sf::Vector2f scale);
+
+    // Sort the quads added since begin() and fill the batches
+    void build();
+
+    /**
+        @return The number of batches filled by build(), one draw call each
+    */
+    std::size_t size() const { return _used; }
+
+    /**
+        @param std::size_t index of the batch, lower than size()
+    */
+    const SpriteBatch& at(std::size_t index) const { return _batches.at(index); }
+
+    std::size_t vertexCount() const;
+    std::size_t culledCount() const { return _culled; }
+
+   private:
+    struct Quad {
+        const sf::Texture* texture;
+        int layer;
+        Rect2D rect;
+        sf::Vector2f position;
+        sf::Vector2f scale;
+    };
+
+    uint32_t textureId(const sf::Texture* texture);
+    void sortQuads();
+    static void writeQuad(sf::Vertex* vertices, const Quad& quad);
+
+    sf::FloatRect _view;
+    std::vector<Quad> _quads;
+    std::vector<uint32_t> _keys;
+    std::vector<uint32_t> _order;
+    std::vector<uint32_t> _scratch;
+    std::vector<const sf::Texture*> _textures;  // index is the id of the texture in the sort keys
+    std::vector<SpriteBatch> _batches;
+    std::size_t _used = 0;
+    std::size_t _culled = 0;
+};
@@ -10,60 +10,60 @@
 #include <cmath>
 #include <utility>
 
+SystemAccess PatternSystem::access() const {
+    return SystemAccess().writes<PatternComponent, transform_component_s>();
+}
+
 void PatternSystem::update(Registry& registry, system_context context) {
-    const auto& entities = registry.getEntities<PatternComponent>();
     float dt = context.dt;
-    float tolerance = 5.0f;
-
-    for (auto entity : entities) {
-        if (!registry.hasComponent<transform_component_s>(entity))
-            continue;
-
-        auto& transform = registry.getComponent<transform_component_s>(entity);
-        auto& path = registry.getComponent<PatternComponent>(entity);
 
-        if (!path.is_active)
-            continue;
+    registry.each<PatternComponent, transform_component_s>(
+        [&](Entity, PatternComponent& path, transform_component_s& transform) {
+            if (!path.is_active)
+                return;
 
-        if (path.type == PatternComponent::SINUSOIDAL) {
-            path.time_elapsed += dt;
-            transform.x -= path.speed * dt;
-            transform.y += path.amplitude * path.frequency * std::cos(path.time_elapsed * path.frequency) * dt;
-            continue;
-        }
-
-        if (path.waypoints.empty())
-            continue;
-        if (path.current_index >= path.waypoints.size())
-            continue;
+            if (path.type == PatternComponent::SINUSOIDAL) {
+                float previous = path.time_elapsed;
+                path.time_elapsed += dt;
+                transform.x -= path.speed * dt;
+                // Exact move over the tick, the curve does not depend on the tick rate
+                transform.y += path.amplitude *
+                               (std::sin(path.time_elapsed * path.frequency) - std::sin(previous * path.frequency));
+                return;
+            }
 
-        std::pair<float, float> target = path.waypoints[path.current_index];
+            if (path.waypoints.empty())
+                return;
 
-        float dx = target.first - transform.x;
-        float dy = target.second - transform.y;
-        float distance = std::sqrt(dx * dx + dy * dy);
+            // Waypoints are reached exactly and the rest of the step goes on to the next one,
+            // so a path is walked the same way whatever the tick rate
+            float step = path.speed * dt;
+            for (std::size_t hops = 0; hops <= path.waypoints.size() && path.is_active; ++hops) {
+                if (path.current_index >= static_cast<int>(path.waypoints.size()))
+                    return;
 
-        if (distance <= tolerance) {
-            path.current_index++;
+                std::pair<float, float> target = path.waypoints[path.current_index];
+                float dx = target.first - transform.x;
+                float dy = target.second - transform.y;
+                float distance = std::sqrt(dx * dx + dy * dy);
 
-            if (path.current_index >= path.waypoints.size()) {
-                if (path.loop) {
-                    path.current_index = 0;
-                } else {
-                    path.is_active = false;
+                if (distance > step) {
+                    transform.x += (dx / distance) * step;
+                    transform.y += (dy / distance) * step;
+                    return;
                 }
-            }
-        } else {
-            if (distance != 0) {
-                float moveStep = path.speed * dt;
-                if (moveStep > distance) {
-                    transform.x = target.first;
-                    transform.y = target.second;
-                } else {
-                    transform.x += (dx / distance) * moveStep;
-                    transform.y += (dy / distance) * moveStep;
+                transform.x = target.first;
+                transform.y = target.second;
+                step -= distance;
+
+                path.current_index++;
+                if (path.current_index >= static_cast<int>(path.waypoints.size())) {
+                    if (path.loop) {
+                        path.current_index = 0;
+                    } else {
+                        path.is_active = false;
+                    }
                 }
             }
-        }
-    }
+        });
 }
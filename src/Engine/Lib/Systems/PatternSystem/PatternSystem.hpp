@@ -21,6 +21,7 @@ class PatternSystem : public ISystem {
     ~PatternSystem() = default;
 
     void update(Registry& registry, system_context context) override;
+    SystemAccess access() const override;
 
    private:
 };
@@ -6,26 +6,127 @@
 */
 
 #include "PhysicsSystem.hpp"
+#include <bit>
+#include <cstdint>
 #include "Components/StandardComponents.hpp"
 #include "Components/GravityComponent.hpp"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PHYSICS_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PHYSICS_SSE 1
+#endif
+
+SystemAccess PhysicsSystem::access() const {
+    return SystemAccess().reads<Velocity2D, GravityComponent>().writes<transform_component_s, PhysicsBody>();
+}
+
+void PhysicsSystem::integrate(std::span<float> x, std::span<float> y, std::span<const float> vx,
+                              std::span<const float> vy, float dt) {
+    std::size_t count = x.size();
+    std::size_t i = 0;
+
+    // Same operations in the same order as the scalar tail, every path gives the same positions
+#if defined(PHYSICS_AVX)
+    const __m256 step8 = _mm256_set1_ps(dt);
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(&x[i]), _mm256_mul_ps(_mm256_loadu_ps(&vx[i]), step8));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(&y[i]), _mm256_mul_ps(_mm256_loadu_ps(&vy[i]), step8));
+
+        _mm256_storeu_ps(&x[i], px);
+        _mm256_storeu_ps(&y[i], py);
+    }
+#endif
+#if defined(PHYSICS_SSE)
+    const __m128 step4 = _mm_set1_ps(dt);
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(_mm_loadu_ps(&vx[i]), step4));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(_mm_loadu_ps(&vy[i]), step4));
+
+        _mm_storeu_ps(&x[i], px);
+        _mm_storeu_ps(&y[i], py);
+    }
+#endif
+    for (; i < count; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
 void PhysicsSystem::update(Registry& registry, system_context context) {
-    auto& velocities = registry.getView<Velocity2D>();
-    auto& positions = registry.getView<transform_component_s>();
-    const auto& entities = registry.getEntities<Velocity2D>();
-
-    for (size_t i = 0; i < entities.size(); ++i) {
-        Entity entity = entities[i];
-
-        if (registry.hasComponent<transform_component_s>(entity)) {
-            auto& pos = registry.getComponent<transform_component_s>(entity);
-            auto& vel = velocities[i];
-            if (registry.hasComponent<GravityComponent>(entity)) {
-                auto& gravity = registry.getComponent<GravityComponent>(entity);
-                pos.y += gravity.vectorY;
-            }
-            pos.x += vel.vx * context.dt;
-            pos.y += vel.vy * context.dt;
+    auto& bodies = registry.getPool<PhysicsBody>();
+    auto& gravities = registry.getPool<GravityComponent>();
+
+    syncBodies(registry, bodies);
+
+    // Gravity goes first, like it did when each entity was moved on its own
+    std::span<float> y = bodies.field<&PhysicsBody::y>();
+    const auto& gravity_ids = gravities.getIdList();
+    const auto& gravity_data = gravities.getDataList();
+    for (std::size_t i = 0; i < gravity_ids.size(); ++i) {
+        int idx = bodies.indexOf(gravity_ids[i]);
+
+        if (idx >= 0)
+            y[idx] += gravity_data[i].vectorY;
+    }
+
+    integrate(bodies.field<&PhysicsBody::x>(), y, bodies.field<&PhysicsBody::vx>(), bodies.field<&PhysicsBody::vy>(),
+              context.dt);
+    writeBack(registry, bodies);
+}
+
+// Follows what the other systems wrote since the last tick, the bodies are only rebuilt for it
+void PhysicsSystem::syncBodies(Registry& registry, SoaSparseSet<PhysicsBody>& bodies) {
+    auto& transforms = registry.getPool<transform_component_s>();
+    auto& velocities = registry.getPool<Velocity2D>();
+    const auto& ids = bodies.getIdList();
+
+    // A body whose entity lost its transform or its velocity stops moving
+    for (std::size_t i = ids.size(); i-- > 0;) {
+        if (!transforms.has(ids[i]) || !velocities.has(ids[i]))
+            bodies.removeId(ids[i]);
+    }
+
+    velocities.consumeChanges([&](std::size_t entity, const Velocity2D& velocity) {
+        int idx = bodies.indexOf(entity);
+
+        if (idx >= 0) {
+            bodies.field<&PhysicsBody::vx>()[idx] = velocity.vx;
+            bodies.field<&PhysicsBody::vy>()[idx] = velocity.vy;
+        } else if (const auto* transform = transforms.tryGetDataFromId(entity)) {
+            bodies.addID(entity, {transform->x, transform->y, velocity.vx, velocity.vy});
+        }
+    });
+    transforms.consumeChanges([&](std::size_t entity, const transform_component_s& transform) {
+        int idx = bodies.indexOf(entity);
+
+        if (idx >= 0) {
+            bodies.field<&PhysicsBody::x>()[idx] = transform.x;
+            bodies.field<&PhysicsBody::y>()[idx] = transform.y;
+        } else if (const auto* velocity = velocities.tryGetDataFromId(entity)) {
+            bodies.addID(entity, {transform.x, transform.y, velocity->vx, velocity->vy});
         }
+    });
+}
+
+// Like a write guard, only a transform whose position really changed is flagged for replication
+void PhysicsSystem::writeBack(Registry& registry, SoaSparseSet<PhysicsBody>& bodies) {
+    auto& transforms = registry.getPool<transform_component_s>();
+    const auto& ids = bodies.getIdList();
+    std::span<const float> x = bodies.field<&PhysicsBody::x>();
+    std::span<const float> y = bodies.field<&PhysicsBody::y>();
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        transform_component_s& transform = transforms.getDataFromId(ids[i]);
+
+        if (std::bit_cast<uint32_t>(transform.x) == std::bit_cast<uint32_t>(x[i]) &&
+            std::bit_cast<uint32_t>(transform.y) == std::bit_cast<uint32_t>(y[i]))
+            continue;
+        transform.x = x[i];
+        transform.y = y[i];
+        transforms.markForReplication(ids[i]);
     }
 }
@@ -1,7 +1,19 @@
 #include "PlayerBoundsSystem.hpp"
 #include "Components/StandardComponents.hpp"
 
+SystemAccess PlayerBoundsSystem::access() const {
+#if defined(CLIENT_BUILD)
+    // Reads the window size, which belongs to the main thread
+    return SystemAccess::exclusive();
+#else
+    return SystemAccess()
+        .reads<WorldBoundsComponent, TagComponent, AnimatedSprite2D, Sprite2D, sprite2D_component_s>()
+        .writes<transform_component_s>();
+#endif
+}
+
 void PlayerBoundsSystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
 #if defined(CLIENT_BUILD)
     const float windowWidth = static_cast<float>(context.window.getSize().x);
     const float windowHeight = static_cast<float>(context.window.getSize().y);
@@ -20,66 +32,51 @@ void PlayerBoundsSystem::update(Registry& registry, system_context context) {
         min_y = bounds.min_y;
     }
 
-    auto& tagged_entities = registry.getEntities<TagComponent>();
-    for (auto entity : tagged_entities) {
-        auto& tags = registry.getConstComponent<TagComponent>(entity);
-
-        bool is_player = false;
-        for (const auto& tag : tags.tags) {
-            if (tag == "PLAYER") {
-                is_player = true;
-                break;
-            }
-        }
+    // Only a clamped player is flagged for replication
+    registry.each<const TagComponent, transform_component_s>(
+        [&](Entity entity, const TagComponent& tags, transform_component_s& transform) {
+            if (!tags.tags.has(player_tag))
+                return;
 
-        if (!is_player)
-            continue;
+            float sprite_w = 33.0f;
+            float sprite_h = 17.0f;
+            float scale_x = transform.scale_x;
+            float scale_y = transform.scale_y;
 
-        if (!registry.hasComponent<transform_component_s>(entity))
-            continue;
-
-        auto& transform = registry.getComponent<transform_component_s>(entity);
-
-        float sprite_w = 33.0f;
-        float sprite_h = 17.0f;
-        float scale_x = transform.scale_x;
-        float scale_y = transform.scale_y;
-
-        if (registry.hasComponent<AnimatedSprite2D>(entity)) {
-            auto& sprite = registry.getConstComponent<AnimatedSprite2D>(entity);
-            const auto& frame = sprite.animations.at(sprite.currentAnimation).frames.at(sprite.currentFrameIndex);
-            sprite_w = frame.width;
-            sprite_w = frame.height;
-        }
+            if (registry.hasComponent<AnimatedSprite2D>(entity)) {
+                auto& sprite = registry.getConstComponent<AnimatedSprite2D>(entity);
+                sprite_w = sprite.hitboxWidth;
+                sprite_w = sprite.hitboxHeight;
+            }
 
-        if (registry.hasComponent<Sprite2D>(entity)) {
-            auto& sprite = registry.getConstComponent<Sprite2D>(entity);
-            sprite_h = sprite.rect.width;
-            sprite_w = sprite.rect.height;
-        }
+            if (registry.hasComponent<Sprite2D>(entity)) {
+                auto& sprite = registry.getConstComponent<Sprite2D>(entity);
+                sprite_h = sprite.rect.width;
+                sprite_w = sprite.rect.height;
+            }
 
-        if (registry.hasComponent<sprite2D_component_s>(entity)) {
-            auto& sprite = registry.getConstComponent<sprite2D_component_s>(entity);
-            if (sprite.is_animated && !sprite.frames.empty()) {
-                const auto& frame = sprite.frames[sprite.current_animation_frame];
-                sprite_w = frame.width;
-                sprite_h = frame.height;
-            } else if (sprite.dimension.width > 0 && sprite.dimension.height > 0) {
-                sprite_w = sprite.dimension.width;
-                sprite_h = sprite.dimension.height;
+            if (registry.hasComponent<sprite2D_component_s>(entity)) {
+                auto& sprite = registry.getConstComponent<sprite2D_component_s>(entity);
+                if (sprite.is_animated && !sprite.frames.empty()) {
+                    const auto& frame = sprite.frames[sprite.current_animation_frame];
+                    sprite_w = frame.width;
+                    sprite_h = frame.height;
+                } else if (sprite.dimension.width > 0 && sprite.dimension.height > 0) {
+                    sprite_w = sprite.dimension.width;
+                    sprite_h = sprite.dimension.height;
+                }
             }
-        }
 
-        float actual_width = sprite_w * std::abs(scale_x);
-        float actual_height = sprite_h * std::abs(scale_y);
+            float actual_width = sprite_w * std::abs(scale_x);
+            float actual_height = sprite_h * std::abs(scale_y);
 
-        if (transform.x < min_x)
-            transform.x = min_x;
-        if (transform.x > windowWidth - actual_width)
-            transform.x = windowWidth - actual_width;
-        if (transform.y < min_y)
-            transform.y = min_y;
-        if (transform.y > windowHeight - actual_height)
-            transform.y = windowHeight - actual_height;
-    }
+            if (transform.x < min_x)
+                transform.x = min_x;
+            if (transform.x > windowWidth - actual_width)
+                transform.x = windowWidth - actual_width;
+            if (transform.y < min_y)
+                transform.y = min_y;
+            if (transform.y > windowHeight - actual_height)
+                transform.y = windowHeight - actual_height;
+        });
 }
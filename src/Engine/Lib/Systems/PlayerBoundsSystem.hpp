@@ -16,4 +16,5 @@ class PlayerBoundsSystem : public ISystem {
     PlayerBoundsSystem() = default;
     ~PlayerBoundsSystem() = default;
     void update(Registry& registry, system_context context) override;
+    SystemAccess access() const override;
 };
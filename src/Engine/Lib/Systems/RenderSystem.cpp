@@ -97,15 +97,10 @@ void RenderSystem::drawEntity(Entity entity, const transform_component_s& transf
     sprite.setScale({transform.scale_x, transform.scale_y});
 
     // Boss hit feedback (client-side): detect HP drops on entities tagged "BOSS" and draw an additive white flash.
+    static const TagId boss_tag = TagRegistry::intern("BOSS");
     bool is_boss = false;
     if (registry.hasComponent<TagComponent>(entity)) {
-        const auto& tags = registry.getConstComponent<TagComponent>(entity);
-        for (const auto& t : tags.tags) {
-            if (t == "BOSS") {
-                is_boss = true;
-                break;
-            }
-        }
+        is_boss = registry.getConstComponent<TagComponent>(entity).tags.has(boss_tag);
     }
 
     bool flash_active = false;
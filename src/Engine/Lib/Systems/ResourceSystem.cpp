@@ -6,18 +6,27 @@ void ResourceSystem::update(Registry& registry, system_context context) {
     auto& entities = registry.getEntities<ResourceComponent>();
 
     for (auto entity : entities) {
-        ResourceComponent& resComp = registry.getComponent<ResourceComponent>(entity);
-        for (auto& [type, stat] : resComp.resources) {
+        // Full or empty resources without regen don't change, keep them out of the snapshots
+        auto resComp = registry.writeComponent<ResourceComponent>(entity);
+        for (const auto& [type, stat] : resComp.read().resources) {
+            float current = stat.current;
+
             if (stat.regenRate != 0.0f)
-                stat.current += stat.regenRate * context.dt;
+                current += stat.regenRate * context.dt;
+
+            if (current > stat.max)
+                current = stat.max;
+
+            if (current <= 0.0f)
+                current = 0.0f;
 
-            if (stat.current > stat.max)
-                stat.current = stat.max;
+            if (current != stat.current)
+                resComp->resources.at(type).current = current;
 
-            if (stat.current <= 0.0f) {
-                stat.current = 0.0f;
-                if (resComp.empty_effects.find(type) != resComp.empty_effects.end())
-                    resComp.empty_effects[type]();
+            if (current <= 0.0f) {
+                auto effect = resComp.read().empty_effects.find(type);
+                if (effect != resComp.read().empty_effects.end())
+                    effect->second();
             }
         }
     }
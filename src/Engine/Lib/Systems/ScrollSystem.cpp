@@ -7,21 +7,17 @@
 
 #include "ScrollSystem.hpp"
 
-void ScrollSystem::update(Registry& registry, system_context context) {
-    auto& scrolls = registry.getView<Scroll>();
-    const auto& entities = registry.getEntities<Scroll>();
-
-    for (size_t i = 0; i < entities.size(); ++i) {
-        Entity entity = entities[i];
+SystemAccess ScrollSystem::access() const {
+    return SystemAccess().reads<Scroll>().writes<transform_component_s>();
+}
 
-        if (registry.hasComponent<transform_component_s>(entity)) {
-            auto& scroll = scrolls[i];
+void ScrollSystem::update(Registry& registry, system_context context) {
+    registry.each<const Scroll, transform_component_s>(
+        [&](Entity, const Scroll& scroll, transform_component_s& transform) {
             if (scroll.is_paused)
-                continue;
+                return;
 
-            auto& transform = registry.getComponent<transform_component_s>(entity);
             transform.x += scroll.scroll_speed_x * context.dt;
             transform.y += scroll.scroll_speed_y * context.dt;
-        }
-    }
+        });
 }
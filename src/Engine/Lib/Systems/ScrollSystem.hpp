@@ -13,4 +13,5 @@
 class ScrollSystem : public ISystem {
    public:
     void update(Registry& registry, system_context context) override;
+    SystemAccess access() const override;
 };
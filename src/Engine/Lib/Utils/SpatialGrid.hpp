@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine {
+namespace utils {
+
+/**
+ * @brief Axis-aligned bounding box used by the collision broad phase.
+ */
+struct AABB {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+};
+
+/**
+ * @brief Uniform grid used as a collision broad phase.
+ *
+ * Proxies are inserted into every cell their box overlaps, inside a bucket
+ * (the lobby id on the server). The grid is meant to be cleared and rebuilt
+ * every tick: cells are stored as a sorted vector of (cell key, proxy) pairs so
+ * rebuilding does not allocate once the vectors reached their working size.
+ *
+ * Boxes covering more than MAX_CELLS_PER_PROXY cells (walls, terrain, bosses)
+ * go to a per-bucket overflow list that every query of that bucket returns.
+ */
+class SpatialGrid {
+   public:
+    static constexpr std::size_t MAX_CELLS_PER_PROXY = 64;
+
+    explicit SpatialGrid(float cell_size = 128.0f) : _inv_cell_size(1.0f / cell_size) {}
+
+    /**
+        Remove every proxy from the grid, keeping the allocated memory
+    */
+    void clear() {
+        _cells.clear();
+        _oversized.clear();
+        _buckets.clear();
+        _built = false;
+    }
+
+    /**
+        Insert a proxy in every cell covered by the given box
+        @param uint32_t bucket the proxy belongs to
+        @param std::size_t proxy index, returned as is by query()
+        @param AABB box of the proxy
+    */
+    void insert(uint32_t bucket, std::size_t proxy, const AABB& box) {
+        int32_t min_cx;
+        int32_t min_cy;
+        int32_t max_cx;
+        int32_t max_cy;
+
+        toCells(box, min_cx, min_cy, max_cx, max_cy);
+        _buckets.push_back(bucket);
+        std::size_t covered = static_cast<std::size_t>(max_cx - min_cx + 1) * (max_cy - min_cy + 1);
+        if (covered > MAX_CELLS_PER_PROXY) {
+            _oversized.push_back({bucket, proxy});
+            return;
+        }
+        for (int32_t cy = min_cy; cy <= max_cy; ++cy) {
+            for (int32_t cx = min_cx; cx <= max_cx; ++cx) {
+                _cells.push_back({key(bucket, cx, cy), proxy});
+            }
+        }
+    }
+
+    /**
+        Sort the cells so they can be queried. Must be called after the last insert of the tick.
+    */
+    void build() {
+        std::sort(_cells.begin(), _cells.end());
+        std::sort(_oversized.begin(), _oversized.end());
+        std::sort(_buckets.begin(), _buckets.end());
+        _buckets.erase(std::unique(_buckets.begin(), _buckets.end()), _buckets.end());
+        _built = true;
+    }
+
+    /**
+        Append to out every proxy of the bucket sharing at least one cell with the box.
+        A proxy can be appended more than once if it shares several cells with the box.
+        @param uint32_t bucket to look into
+        @param AABB box to test
+        @param std::vector<std::size_t> output list of candidate proxies
+    */
+    void query(uint32_t bucket, const AABB& box, std::vector<std::size_t>& out) const {
+        if (!_built) {
+            return;
+        }
+        int32_t min_cx;
+        int32_t min_cy;
+        int32_t max_cx;
+        int32_t max_cy;
+
+        toCells(box, min_cx, min_cy, max_cx, max_cy);
+        std::size_t covered = static_cast<std::size_t>(max_cx - min_cx + 1) * (max_cy - min_cy + 1);
+        if (covered > MAX_CELLS_PER_PROXY) {
+            // Huge query box: walking the bucket range is cheaper than probing every cell.
+            uint64_t bucket_key = static_cast<uint64_t>(bucket) << 32;
+            auto it =
+                std::lower_bound(_cells.begin(), _cells.end(), std::make_pair(bucket_key, static_cast<std::size_t>(0)));
+            for (; it != _cells.end() && (it->first & BUCKET_MASK) == bucket_key; ++it) {
+                out.push_back(it->second);
+            }
+        } else {
+            for (int32_t cy = min_cy; cy <= max_cy; ++cy) {
+                for (int32_t cx = min_cx; cx <= max_cx; ++cx) {
+                    uint64_t cell = key(bucket, cx, cy);
+                    auto it = std::lower_bound(_cells.begin(), _cells.end(),
+                                               std::make_pair(cell, static_cast<std::size_t>(0)));
+                    for (; it != _cells.end() && it->first == cell; ++it) {
+                        out.push_back(it->second);
+                    }
+                }
+            }
+        }
+        auto over = std::lower_bound(_oversized.begin(), _oversized.end(),
+                                     std::make_pair(bucket, static_cast<std::size_t>(0)));
+        for (; over != _oversized.end() && over->first == bucket; ++over) {
+            out.push_back(over->second);
+        }
+    }
+
+    /**
+        @return The sorted list of buckets that received at least one proxy since the last clear()
+    */
+    const std::vector<uint32_t>& getBuckets() const { return _buckets; }
+
+   private:
+    static constexpr uint64_t BUCKET_MASK = 0xFFFFFFFF00000000ull;
+    static constexpr int32_t CELL_LIMIT = 32767;
+
+    static uint64_t key(uint32_t bucket, int32_t cx, int32_t cy) {
+        return (static_cast<uint64_t>(bucket) << 32) | (static_cast<uint64_t>(static_cast<uint16_t>(cx)) << 16) |
+               static_cast<uint64_t>(static_cast<uint16_t>(cy));
+    }
+
+    int32_t toCell(float value) const {
+        float cell = std::floor(value * _inv_cell_size);
+        if (!(cell > -CELL_LIMIT))
+            return -CELL_LIMIT;
+        if (cell > CELL_LIMIT)
+            return CELL_LIMIT;
+        return static_cast<int32_t>(cell);
+    }
+
+    void toCells(const AABB& box, int32_t& min_cx, int32_t& min_cy, int32_t& max_cx, int32_t& max_cy) const {
+        min_cx = toCell(std::min(box.min_x, box.max_x));
+        max_cx = toCell(std::max(box.min_x, box.max_x));
+        min_cy = toCell(std::min(box.min_y, box.max_y));
+        max_cy = toCell(std::max(box.min_y, box.max_y));
+    }
+
+    float _inv_cell_size;
+    bool _built = false;
+    std::vector<std::pair<uint64_t, std::size_t>> _cells;
+    std::vector<std::pair<uint32_t, std::size_t>> _oversized;
+    std::vector<uint32_t> _buckets;
+};
+
+}  // namespace utils
+}  // namespace engine
@@ -45,8 +45,8 @@ void network::Client::RegisterServer(std::string username, std::string password)
 }
 
 network::coming_message network::Client::ReadIncomingMessage() {
-    while (!Incoming().empty()) {
-        auto msg = Incoming().pop_front();
+    owned_message<GameEvents> msg;
+    while (Incoming().pop(msg)) {
 
         if (msg.msg.header.id == GameEvents::S_REGISTER_OK || msg.msg.header.id == GameEvents::S_LOGIN_OK) {
             auto now = std::chrono::system_clock::now();
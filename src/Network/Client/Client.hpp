@@ -26,21 +26,21 @@ class Client : public ClientInterface<GameEvents> {
 
     template <typename T>
     void AddMessageToServer(GameEvents event, uint32_t id, const T& data) {
-        network::message<GameEvents> msg;
-        msg << data;
-        SendValidatedMessage(event, msg);
+        network::message<GameEvents> msg = AcquireMessage(sizeof(T));
+        MessageWriter<GameEvents>(msg, sizeof(T)) << data;
+        SendValidatedMessage(event, std::move(msg));
     }
 
-    void AddMessageToServer(GameEvents event, uint32_t id) {
-        network::message<GameEvents> msg;
-        SendValidatedMessage(event, msg);
-    }
+    void AddMessageToServer(GameEvents event, uint32_t id) { SendValidatedMessage(event, AcquireMessage()); }
 
-    void AddMessageToServer(GameEvents event, network::message<GameEvents>& msg) { SendValidatedMessage(event, msg); }
+    // msg is best taken with AcquireMessage, its body is handed to the connection as is
+    void AddMessageToServer(GameEvents event, network::message<GameEvents>&& msg) {
+        SendValidatedMessage(event, std::move(msg));
+    }
 
    private:
     template <typename T>
-    void SendValidatedMessage(GameEvents event, network::message<T>& msg) {
+    void SendValidatedMessage(GameEvents event, network::message<T>&& msg) {
         msg.header.id = event;
         msg.header.user_id = _id;
         msg.header.size = msg.size();
@@ -53,9 +53,9 @@ class Client : public ClientInterface<GameEvents> {
         }
 
         if (_networkManager.isUdpEvent(event)) {
-            SendUdp(msg);
+            SendUdp(std::move(msg));
         } else {
-            Send(msg);
+            Send(std::move(msg));
         }
     }
 
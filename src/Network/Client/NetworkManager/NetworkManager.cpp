@@ -10,20 +10,22 @@ NetworkManager::NetworkManager() {
 }
 
 void NetworkManager::initializeValidClientEvents() {
-    _validClientEvents = {C_PING_SERVER, C_REGISTER,    C_LOGIN,       C_LOGIN_TOKEN, C_LOGIN_ANONYMOUS,
-                          C_DISCONNECT,  C_CONFIRM_UDP, C_LIST_ROOMS,  C_JOIN_ROOM,   C_JOINT_RANDOM_LOBBY,
-                          C_ROOM_LEAVE,  C_NEW_LOBBY,   C_READY,       C_GAME_START,  C_CANCEL_READY,
-                          C_INPUT,       C_TEAM_CHAT,   C_VOICE_PACKET};
+    _validClientEvents = {C_PING_SERVER, C_REGISTER,      C_LOGIN,       C_LOGIN_TOKEN,  C_LOGIN_ANONYMOUS,
+                          C_DISCONNECT,  C_CONFIRM_UDP,   C_LIST_ROOMS,  C_JOIN_ROOM,    C_JOINT_RANDOM_LOBBY,
+                          C_ROOM_LEAVE,  C_NEW_LOBBY,     C_READY,       C_GAME_START,   C_CANCEL_READY,
+                          C_INPUT,       C_INPUT_ACTIONS, C_TEAM_CHAT,   C_VOICE_PACKET, C_SNAPSHOT_ACK,
+                          C_FULL_STATE_ACK, C_FULL_STATE_RESEND};
 }
 
 void NetworkManager::initializeTcpEvents() {
     _tcpEvents = {C_PING_SERVER, C_REGISTER,   C_LOGIN,        C_LOGIN_TOKEN, C_LOGIN_ANONYMOUS,
                   C_DISCONNECT,  C_LIST_ROOMS, C_JOIN_ROOM,    C_ROOM_LEAVE,  C_NEW_LOBBY,
-                  C_READY,       C_GAME_START, C_CANCEL_READY, C_TEAM_CHAT};
+                  C_READY,       C_GAME_START, C_CANCEL_READY, C_TEAM_CHAT,   C_INPUT_ACTIONS,
+                  C_FULL_STATE_ACK, C_FULL_STATE_RESEND};
 }
 
 void NetworkManager::initializeUdpEvents() {
-    _udpEvents = {C_INPUT, C_CONFIRM_UDP, C_VOICE_PACKET};
+    _udpEvents = {C_INPUT, C_CONFIRM_UDP, C_VOICE_PACKET, C_SNAPSHOT_ACK};
 }
 
 void NetworkManager::initializePayloadConstraints() {
@@ -36,7 +38,11 @@ void NetworkManager::initializePayloadConstraints() {
     _payloadConstraints[C_NEW_LOBBY] = {sizeof(uint32_t) + 1, 128};
     _payloadConstraints[C_READY] = {sizeof(uint32_t), sizeof(uint32_t)};
     _payloadConstraints[C_CANCEL_READY] = {sizeof(uint32_t), sizeof(uint32_t)};
-    _payloadConstraints[C_INPUT] = {sizeof(bool) + sizeof(uint32_t) + 1, 256};
+    // [masks][uint8 count][uint32 tick], 4 redundant ticks max
+    _payloadConstraints[C_INPUT] = {sizeof(uint8_t) + sizeof(uint32_t),
+                                    sizeof(uint8_t) + sizeof(uint32_t) + 4 * sizeof(uint32_t)};
+    // [name][uint16 size] per action then [uint8 count][uint8 first id], 32 actions of 256 characters max
+    _payloadConstraints[C_INPUT_ACTIONS] = {2 * sizeof(uint8_t), 2 * sizeof(uint8_t) + 32 * (sizeof(uint16_t) + 256)};
     _payloadConstraints[C_CONFIRM_UDP] = {sizeof(uint32_t), sizeof(uint32_t)};
     _payloadConstraints[C_PING_SERVER] = {0, 64};
     _payloadConstraints[C_DISCONNECT] = {0, 0};
@@ -44,6 +50,11 @@ void NetworkManager::initializePayloadConstraints() {
     _payloadConstraints[C_GAME_START] = {0, sizeof(uint32_t)};
     _payloadConstraints[C_TEAM_CHAT] = {sizeof(uint32_t) + 1, 1024};
     _payloadConstraints[C_VOICE_PACKET] = {1, 8192};
+    _payloadConstraints[C_SNAPSHOT_ACK] = {
+        sizeof(uint8_t) + sizeof(uint16_t),
+        sizeof(uint8_t) + sizeof(uint16_t) + network::MAX_SNAPSHOT_ACKS * sizeof(uint32_t)};
+    _payloadConstraints[C_FULL_STATE_ACK] = {sizeof(uint32_t), sizeof(uint32_t)};
+    _payloadConstraints[C_FULL_STATE_RESEND] = {sizeof(uint32_t), sizeof(uint32_t)};
 }
 
 bool NetworkManager::isValidClientEvent(network::GameEvents event) const {
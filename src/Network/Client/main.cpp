@@ -20,6 +20,9 @@ void receive_loop(network::Client& client) {
                 case GameEvents::S_REGISTER_OK:
                     std::cout << "[SERVER] Registration Successful! Token received.\n";
                     break;
+                case GameEvents::S_REGISTER_KO:
+                    std::cout << "[SERVER] Registration Failed.\n";
+                    break;
                 case GameEvents::S_LOGIN_OK:
                     std::cout << "[SERVER] Login Successful!\n";
                     break;
@@ -0,0 +1,337 @@
+#include "Credentials.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <bcrypt.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/random.h>
+#else
+#include <cstdlib>
+#endif
+
+namespace credentials {
+
+namespace {
+
+constexpr std::string_view RECORD_SCHEME = "pbkdf2-sha256";
+constexpr std::string_view TOKEN_ALPHABET = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+uint32_t rotateRight(uint32_t value, int count) {
+    return (value >> count) | (value << (32 - count));
+}
+
+class Sha256State {
+   public:
+    void update(const uint8_t* data, std::size_t size) {
+        _length += size;
+        while (size > 0) {
+            std::size_t taken = std::min(size, _block.size() - _buffered);
+
+            std::memcpy(_block.data() + _buffered, data, taken);
+            _buffered += taken;
+            data += taken;
+            size -= taken;
+            if (_buffered == _block.size()) {
+                compress();
+                _buffered = 0;
+            }
+        }
+    }
+
+    void update(std::string_view data) { update(reinterpret_cast<const uint8_t*>(data.data()), data.size()); }
+
+    Digest finish() {
+        uint64_t bits = _length * 8;
+        Digest digest;
+
+        _block[_buffered++] = 0x80;
+        if (_buffered > 56) {
+            std::fill(_block.begin() + _buffered, _block.end(), 0);
+            compress();
+            _buffered = 0;
+        }
+        std::fill(_block.begin() + _buffered, _block.begin() + 56, 0);
+        for (std::size_t idx = 0; idx < 8; ++idx) {
+            _block[56 + idx] = static_cast<uint8_t>(bits >> (56 - idx * 8));
+        }
+        compress();
+        for (std::size_t idx = 0; idx < _state.size(); ++idx) {
+            digest[idx * 4] = static_cast<uint8_t>(_state[idx] >> 24);
+            digest[idx * 4 + 1] = static_cast<uint8_t>(_state[idx] >> 16);
+            digest[idx * 4 + 2] = static_cast<uint8_t>(_state[idx] >> 8);
+            digest[idx * 4 + 3] = static_cast<uint8_t>(_state[idx]);
+        }
+        return digest;
+    }
+
+   private:
+    void compress() {
+        std::array<uint32_t, 64> words;
+
+        for (std::size_t idx = 0; idx < 16; ++idx) {
+            words[idx] = (static_cast<uint32_t>(_block[idx * 4]) << 24) |
+                         (static_cast<uint32_t>(_block[idx * 4 + 1]) << 16) |
+                         (static_cast<uint32_t>(_block[idx * 4 + 2]) << 8) | _block[idx * 4 + 3];
+        }
+        for (std::size_t idx = 16; idx < 64; ++idx) {
+            uint32_t s0 = rotateRight(words[idx - 15], 7) ^ rotateRight(words[idx - 15], 18) ^ (words[idx - 15] >> 3);
+            uint32_t s1 = rotateRight(words[idx - 2], 17) ^ rotateRight(words[idx - 2], 19) ^ (words[idx - 2] >> 10);
+            words[idx] = words[idx - 16] + s0 + words[idx - 7] + s1;
+        }
+
+        uint32_t a = _state[0], b = _state[1], c = _state[2], d = _state[3];
+        uint32_t e = _state[4], f = _state[5], g = _state[6], h = _state[7];
+        for (std::size_t idx = 0; idx < 64; ++idx) {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t choice = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + choice + ROUND_CONSTANTS[idx] + words[idx];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + majority;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        _state[0] += a;
+        _state[1] += b;
+        _state[2] += c;
+        _state[3] += d;
+        _state[4] += e;
+        _state[5] += f;
+        _state[6] += g;
+        _state[7] += h;
+    }
+
+    std::array<uint32_t, 8> _state = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::array<uint8_t, 64> _block{};
+    std::size_t _buffered = 0;
+    uint64_t _length = 0;
+};
+
+// HMAC-SHA256 with the key already absorbed: each MAC then only hashes the message
+class Hmac {
+   public:
+    explicit Hmac(std::string_view key) {
+        std::array<uint8_t, 64> padded{};
+
+        if (key.size() > padded.size()) {
+            Digest hashed = Sha256(key);
+            std::memcpy(padded.data(), hashed.data(), hashed.size());
+        } else {
+            std::memcpy(padded.data(), key.data(), key.size());
+        }
+        for (auto& byte : padded) {
+            byte ^= 0x36;
+        }
+        _inner.update(padded.data(), padded.size());
+        for (auto& byte : padded) {
+            byte ^= 0x36 ^ 0x5c;
+        }
+        _outer.update(padded.data(), padded.size());
+    }
+
+    Digest mac(const uint8_t* data, std::size_t size, const uint8_t* suffix = nullptr,
+               std::size_t suffix_size = 0) const {
+        Sha256State inner = _inner;
+        Sha256State outer = _outer;
+
+        inner.update(data, size);
+        if (suffix)
+            inner.update(suffix, suffix_size);
+        Digest innerDigest = inner.finish();
+        outer.update(innerDigest.data(), innerDigest.size());
+        return outer.finish();
+    }
+
+   private:
+    Sha256State _inner;
+    Sha256State _outer;
+};
+
+std::string toHex(const uint8_t* data, std::size_t size) {
+    constexpr std::string_view digits = "0123456789abcdef";
+    std::string hex(size * 2, '0');
+
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        hex[idx * 2] = digits[data[idx] >> 4];
+        hex[idx * 2 + 1] = digits[data[idx] & 0x0F];
+    }
+    return hex;
+}
+
+bool fromHex(std::string_view hex, std::string& out) {
+    if (hex.size() % 2 != 0)
+        return false;
+    out.resize(hex.size() / 2);
+    for (std::size_t idx = 0; idx < out.size(); ++idx) {
+        unsigned value = 0;
+        auto [end, error] = std::from_chars(hex.data() + idx * 2, hex.data() + idx * 2 + 2, value, 16);
+
+        if (error != std::errc() || end != hex.data() + idx * 2 + 2)
+            return false;
+        out[idx] = static_cast<char>(value);
+    }
+    return true;
+}
+
+struct PasswordRecord {
+    uint32_t iterations = 0;
+    std::string salt;
+    std::string hash;
+};
+
+bool parseRecord(std::string_view record, PasswordRecord& parsed) {
+    std::string_view fields[4];
+
+    for (std::size_t idx = 0; idx < 4; ++idx) {
+        std::size_t separator = record.find('$');
+
+        if ((separator == std::string_view::npos) != (idx == 3))
+            return false;
+        fields[idx] = record.substr(0, separator);
+        record.remove_prefix(separator == std::string_view::npos ? record.size() : separator + 1);
+    }
+    if (fields[0] != RECORD_SCHEME)
+        return false;
+    auto [end, error] = std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), parsed.iterations);
+    if (error != std::errc() || end != fields[1].data() + fields[1].size() || parsed.iterations == 0)
+        return false;
+    return fromHex(fields[2], parsed.salt) && fromHex(fields[3], parsed.hash) &&
+           parsed.hash.size() == std::tuple_size_v<Digest>;
+}
+
+}  // namespace
+
+void RandomBytes(uint8_t* out, std::size_t size) {
+#if defined(_WIN32)
+    if (BCryptGenRandom(nullptr, out, static_cast<ULONG>(size), BCRYPT_USE_SYSTEM_PREFERRED_RNG) != 0)
+        throw std::runtime_error("BCryptGenRandom failed");
+#elif defined(__linux__)
+    while (size > 0) {
+        ssize_t written = getrandom(out, size, 0);
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error("getrandom failed");
+        }
+        out += written;
+        size -= static_cast<std::size_t>(written);
+    }
+#else
+    arc4random_buf(out, size);
+#endif
+}
+
+Digest Sha256(std::string_view data) {
+    Sha256State state;
+
+    state.update(data);
+    return state.finish();
+}
+
+Digest Pbkdf2Sha256(std::string_view password, std::string_view salt, uint32_t iterations) {
+    // Block index 1, the only block since the key is one digest long
+    const uint8_t blockIndex[4] = {0, 0, 0, 1};
+    Hmac hmac(password);
+    Digest block = hmac.mac(reinterpret_cast<const uint8_t*>(salt.data()), salt.size(), blockIndex, 4);
+    Digest result = block;
+
+    for (uint32_t idx = 1; idx < iterations; ++idx) {
+        block = hmac.mac(block.data(), block.size());
+        for (std::size_t byte = 0; byte < result.size(); ++byte) {
+            result[byte] ^= block[byte];
+        }
+    }
+    return result;
+}
+
+std::string HashPassword(std::string_view password, uint32_t iterations) {
+    std::array<uint8_t, SALT_SIZE> salt;
+
+    RandomBytes(salt.data(), salt.size());
+    Digest hash = Pbkdf2Sha256(password, std::string_view(reinterpret_cast<const char*>(salt.data()), salt.size()),
+                               iterations);
+    return std::string(RECORD_SCHEME) + "$" + std::to_string(iterations) + "$" + toHex(salt.data(), salt.size()) +
+           "$" + toHex(hash.data(), hash.size());
+}
+
+bool VerifyPassword(std::string_view password, std::string_view record) {
+    PasswordRecord parsed;
+
+    if (!parseRecord(record, parsed))
+        return false;
+    Digest hash = Pbkdf2Sha256(password, parsed.salt, parsed.iterations);
+    return ConstantTimeEquals(std::string_view(reinterpret_cast<const char*>(hash.data()), hash.size()), parsed.hash);
+}
+
+bool IsPasswordRecord(std::string_view record) {
+    PasswordRecord parsed;
+
+    return parseRecord(record, parsed);
+}
+
+bool NeedsRehash(std::string_view record, uint32_t iterations) {
+    PasswordRecord parsed;
+
+    return !parseRecord(record, parsed) || parsed.iterations < iterations;
+}
+
+std::string GenerateToken() {
+    std::string token;
+    uint8_t bytes[32];
+
+    // Bytes past the last multiple of the alphabet size are dropped so every character is as likely
+    constexpr uint8_t limit = 256 - 256 % TOKEN_ALPHABET.size();
+    while (token.size() < TOKEN_LENGTH) {
+        RandomBytes(bytes, sizeof(bytes));
+        for (uint8_t byte : bytes) {
+            if (byte < limit && token.size() < TOKEN_LENGTH)
+                token += TOKEN_ALPHABET[byte % TOKEN_ALPHABET.size()];
+        }
+    }
+    return token;
+}
+
+std::string HashToken(std::string_view token) {
+    Digest hash = Sha256(token);
+
+    return toHex(hash.data(), hash.size());
+}
+
+bool ConstantTimeEquals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size())
+        return false;
+    volatile uint8_t difference = 0;
+
+    for (std::size_t idx = 0; idx < a.size(); ++idx) {
+        difference = difference | (static_cast<uint8_t>(a[idx]) ^ static_cast<uint8_t>(b[idx]));
+    }
+    return difference == 0;
+}
+
+}  // namespace credentials
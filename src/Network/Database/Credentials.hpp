@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Password hashing and session tokens for the auth path.
+ *
+ * Passwords are kept as versioned records:
+ * "pbkdf2-sha256$<iterations>$<salt hex>$<hash hex>". The record carries its
+ * own cost, so raising PASSWORD_ITERATIONS only rehashes a password at its
+ * owner's next login. Tokens are kept as their SHA-256, a stolen database
+ * does not give away live sessions.
+ */
+namespace credentials {
+
+// Cost of a new hash, two SHA-256 blocks per iteration. It runs on the database thread, not the tick
+static constexpr uint32_t PASSWORD_ITERATIONS = 100000;
+static constexpr std::size_t SALT_SIZE = 16;
+static constexpr std::size_t TOKEN_LENGTH = 24;  // alphanumeric, about 142 bits, fits the 32 char token field
+
+using Digest = std::array<uint8_t, 32>;
+
+/**
+    A function to fill a buffer from the system CSPRNG
+    @throw std::runtime_error if the system has no entropy to give
+*/
+void RandomBytes(uint8_t* out, std::size_t size);
+
+Digest Sha256(std::string_view data);
+
+/**
+    PBKDF2 with HMAC-SHA256, one 32 bytes block
+    @param password
+    @param salt
+    @param iterations
+*/
+Digest Pbkdf2Sha256(std::string_view password, std::string_view salt, uint32_t iterations);
+
+/**
+    A function to hash a password with a new salt
+    @param password
+    @param iterations cost written in the record
+    @return the record to store
+*/
+std::string HashPassword(std::string_view password, uint32_t iterations = PASSWORD_ITERATIONS);
+
+/**
+    @param password what the client sent
+    @param record what HashPassword returned
+    @return false for a wrong password or a record HashPassword did not write
+*/
+bool VerifyPassword(std::string_view password, std::string_view record);
+
+// False for anything but a record HashPassword wrote, such as a password older servers stored in clear
+bool IsPasswordRecord(std::string_view record);
+
+// True if the record is not a hash or cost less than iterations
+bool NeedsRehash(std::string_view record, uint32_t iterations = PASSWORD_ITERATIONS);
+
+std::string GenerateToken();
+
+// What the database keeps of a token, hex of its SHA-256
+std::string HashToken(std::string_view token);
+
+// Time depends on the sizes only, never on where the strings differ
+bool ConstantTimeEquals(std::string_view a, std::string_view b);
+
+}  // namespace credentials
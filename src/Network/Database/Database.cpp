@@ -1,10 +1,34 @@
 #include "Database.hpp"
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "sqlite3.h"
 
-Database::Database(const std::string& filename) {
+namespace {
+
+// Gives a cached statement back ready for its next use once the query is over
+struct StatementReset {
+    sqlite3_stmt* stmt;
+
+    ~StatementReset() {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+};
+
+std::string columnText(sqlite3_stmt* stmt, int column) {
+    const char* result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+
+    return result ? std::string(result) : std::string();
+}
+
+}  // namespace
+
+Database::Database(const std::string& filename, uint32_t passwordIterations)
+    : _passwordIterations(passwordIterations),
+      _dummyRecord(credentials::HashPassword("", passwordIterations)) {
     if (sqlite3_open(filename.c_str(), &db) != SQLITE_OK) {
         std::cerr << "[DB] Impossible d'ouvrir la DB " << filename << "\n";
         std::cerr << "[DB] Message : " << sqlite3_errmsg(db) << "\n";
@@ -14,141 +38,241 @@ Database::Database(const std::string& filename) {
         bConnected = true;
         _initialize();
     }
+    _worker = std::thread([this]() { _run(); });
 }
 
 Database::~Database() {
-    if (bConnected) {
-        sqlite3_close(db);
+    {
+        std::lock_guard<std::mutex> lock(_jobsMutex);
+        _stopping = true;
     }
+    _jobsCondition.notify_one();
+    _worker.join();
+
+    for (auto& [sql, stmt] : _statements) {
+        sqlite3_finalize(stmt);
+    }
+    // Closed even when the open failed, sqlite still allocated the handle
+    sqlite3_close(db);
 }
 
 void Database::_initialize() {
-    const char* sql =
+    // WAL lets a commit append to the log instead of rewriting pages, NORMAL syncs at checkpoints only
+    _exec("PRAGMA journal_mode=WAL;");
+    _exec("PRAGMA synchronous=NORMAL;");
+    _exec(
         "CREATE TABLE IF NOT EXISTS Users ("
         "ID INTEGER PRIMARY KEY AUTOINCREMENT,"
         "Username TEXT UNIQUE NOT NULL,"
         "Password TEXT NOT NULL,"
         "Token TEXT"
-        ");";
+        ");");
+    _exec(
+        "CREATE TABLE IF NOT EXISTS Scores ("
+        "UserID INTEGER PRIMARY KEY REFERENCES Users(ID),"
+        "Score INTEGER NOT NULL"
+        ");");
+    // Token logins look the token up
+    _exec("CREATE INDEX IF NOT EXISTS UsersToken ON Users(Token);");
+    _hashPlaintextTokens();
+}
+
+void Database::_hashPlaintextTokens() {
+    // A token hash is 64 hex characters, the tokens older servers stored were 10
+    sqlite3_stmt* select = nullptr;
+    std::vector<std::pair<int, std::string>> tokens;
+
+    if (sqlite3_prepare_v2(db, "SELECT ID, Token FROM Users WHERE Token IS NOT NULL AND length(Token) <> 64;", -1,
+                           &select, nullptr) != SQLITE_OK)
+        return;
+    while (sqlite3_step(select) == SQLITE_ROW) {
+        tokens.emplace_back(sqlite3_column_int(select, 0), columnText(select, 1));
+    }
+    sqlite3_finalize(select);
+    if (tokens.empty())
+        return;
 
+    _exec("BEGIN;");
+    for (const auto& [userID, token] : tokens) {
+        SaveToken(userID, token);
+    }
+    _exec("COMMIT;");
+}
+
+void Database::_exec(const char* sql) {
     char* errMsg = nullptr;
+
     if (sqlite3_exec(db, sql, 0, 0, &errMsg) != SQLITE_OK) {
-        std::cerr << "[DB] Erreur Init : " << errMsg << "\n";
+        std::cerr << "[DB] Erreur : " << (errMsg ? errMsg : sqlite3_errmsg(db)) << "\n";
         sqlite3_free(errMsg);
     }
 }
 
-bool Database::RegisterUser(std::string username, std::string password) {
-    std::string sql = "INSERT INTO Users (Username, Password) VALUES (?, ?);";
-    sqlite3_stmt* stmt;
+sqlite3_stmt* Database::_prepare(const std::string& sql) {
+    auto it = _statements.find(sql);
 
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-        return false;
+    if (it != _statements.end())
+        return it->second;
+    if (!bConnected)
+        return nullptr;
 
-    sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, password.c_str(), -1, SQLITE_STATIC);
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v3(db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "[DB] Erreur Prepare : " << sqlite3_errmsg(db) << "\n";
+        return nullptr;
+    }
+    _statements.emplace(sql, stmt);
+    return stmt;
+}
 
-    int result = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+void Database::_enqueue(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(_jobsMutex);
+        _jobs.push_back(std::move(job));
+    }
+    _jobsCondition.notify_one();
+}
+
+void Database::_run() {
+    std::vector<Job> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_jobsMutex);
+            _jobsCondition.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+            if (_jobs.empty())
+                return;
+            batch.swap(_jobs);
+        }
 
-    return (result == SQLITE_DONE);
+        // A failing statement only undoes itself, the rest of the batch still commits
+        if (bConnected)
+            _exec("BEGIN;");
+        for (auto& job : batch) {
+            job(*this);
+        }
+        if (bConnected)
+            _exec("COMMIT;");
+        batch.clear();
+    }
 }
 
-int Database::LoginUser(std::string username, std::string password) {
-    std::string sql = "SELECT ID FROM Users WHERE Username = ? AND Password = ?;";
-    sqlite3_stmt* stmt;
+void Database::UpdateScore(int userID, int newScore) {
+    _enqueue([userID, newScore](Database& database) {
+        sqlite3_stmt* stmt = database._prepare(
+            "INSERT INTO Scores (UserID, Score) VALUES (?, ?) "
+            "ON CONFLICT(UserID) DO UPDATE SET Score = MAX(Score, excluded.Score);");
+        if (!stmt)
+            return;
+        StatementReset reset{stmt};
+
+        sqlite3_bind_int(stmt, 1, userID);
+        sqlite3_bind_int(stmt, 2, newScore);
+        sqlite3_step(stmt);
+    });
+}
 
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+int Database::RegisterUser(const std::string& username, const std::string& password) {
+    sqlite3_stmt* stmt = _prepare("INSERT INTO Users (Username, Password) VALUES (?, ?);");
+    if (!stmt)
         return -1;
+    StatementReset reset{stmt};
+    std::string record = credentials::HashPassword(password, _passwordIterations);
 
     sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, password.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, record.c_str(), -1, SQLITE_STATIC);
 
-    int result = sqlite3_step(stmt);
-    int userID = -1;
+    if (sqlite3_step(stmt) != SQLITE_DONE)
+        return -1;
+    return static_cast<int>(sqlite3_last_insert_rowid(db));
+}
 
-    if (result == SQLITE_ROW) {
+int Database::LoginUser(const std::string& username, const std::string& password) {
+    sqlite3_stmt* stmt = _prepare("SELECT ID, Password FROM Users WHERE Username = ?;");
+    if (!stmt)
+        return -1;
+    int userID = -1;
+    std::string record;
+    {
+        StatementReset reset{stmt};
+
+        sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt) != SQLITE_ROW) {
+            credentials::VerifyPassword(password, _dummyRecord);
+            return -1;
+        }
         userID = sqlite3_column_int(stmt, 0);
+        record = columnText(stmt, 1);
     }
 
-    sqlite3_finalize(stmt);
+    bool valid = credentials::IsPasswordRecord(record) ? credentials::VerifyPassword(password, record)
+                                                       : credentials::ConstantTimeEquals(password, record);
+    if (!valid)
+        return -1;
+    if (credentials::NeedsRehash(record, _passwordIterations)) {
+        sqlite3_stmt* update = _prepare("UPDATE Users SET Password = ? WHERE ID = ?;");
+        if (update) {
+            StatementReset reset{update};
+            std::string hashed = credentials::HashPassword(password, _passwordIterations);
+
+            sqlite3_bind_text(update, 1, hashed.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(update, 2, userID);
+            sqlite3_step(update);
+        }
+    }
     return userID;
 }
 
-void Database::SaveToken(int userID, std::string token) {
-    std::string sql = "UPDATE Users SET Token = ? WHERE ID = ?;";
-    sqlite3_stmt* stmt;
-
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+void Database::SaveToken(int userID, const std::string& token) {
+    sqlite3_stmt* stmt = _prepare("UPDATE Users SET Token = ? WHERE ID = ?;");
+    if (!stmt)
         return;
+    StatementReset reset{stmt};
+    std::string hashed = credentials::HashToken(token);
 
-    sqlite3_bind_text(stmt, 1, token.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 1, hashed.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_int(stmt, 2, userID);
 
     sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
 }
 
-int Database::GetUserByToken(std::string token) {
-    std::string sql = "SELECT ID FROM Users WHERE Token = ?;";
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+int Database::GetUserByToken(const std::string& token) {
+    sqlite3_stmt* stmt = _prepare("SELECT ID FROM Users WHERE Token = ?;");
+    if (!stmt)
         return -1;
+    StatementReset reset{stmt};
+    // Looked up by its hash: how long the index takes tells nothing about the token itself
+    std::string hashed = credentials::HashToken(token);
 
-    sqlite3_bind_text(stmt, 1, token.c_str(), -1, SQLITE_STATIC);
-
-    int result = sqlite3_step(stmt);
-    int userID = -1;
-
-    if (result == SQLITE_ROW)
-        userID = sqlite3_column_int(stmt, 0);
+    sqlite3_bind_text(stmt, 1, hashed.c_str(), -1, SQLITE_STATIC);
 
-    sqlite3_finalize(stmt);
-    return userID;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        return sqlite3_column_int(stmt, 0);
+    return -1;
 }
 
 std::string Database::GetNameById(int userId) {
-    std::string sql = "SELECT USERNAME FROM Users WHERE ID = ?;";
-    sqlite3_stmt* stmt;
-    std::string username = "";
-
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    sqlite3_stmt* stmt = _prepare("SELECT USERNAME FROM Users WHERE ID = ?;");
+    if (!stmt)
         return "";
+    StatementReset reset{stmt};
 
     sqlite3_bind_int(stmt, 1, userId);
 
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-        const char* result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-
-        if (result) {
-            username = std::string(result);
-        }
-    }
-
-    sqlite3_finalize(stmt);
-
-    return username;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        return columnText(stmt, 0);
+    return "";
 }
 
-std::string Database::GetTokenById(int userId) {
-    std::string sql = "SELECT Token FROM Users WHERE ID = ?;";
-    sqlite3_stmt* stmt;
-    std::string token = "";
-
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-        return "";
+int Database::GetScoreById(int userId) {
+    sqlite3_stmt* stmt = _prepare("SELECT Score FROM Scores WHERE UserID = ?;");
+    if (!stmt)
+        return 0;
+    StatementReset reset{stmt};
 
     sqlite3_bind_int(stmt, 1, userId);
 
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-        const char* result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-
-        if (result) {
-            token = std::string(result);
-        }
-    }
-
-    sqlite3_finalize(stmt);
-
-    return token;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        return sqlite3_column_int(stmt, 0);
+    return 0;
 }
@@ -1,27 +1,105 @@
 #pragma once
 
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "Credentials.hpp"
 #include "sqlite3.h"
 
+/**
+ * @brief SQLite connection owned by its own thread.
+ *
+ * Every query runs on the database thread, so the game thread never waits on
+ * the disk: it submits a job and gets a future back. The jobs queued while the
+ * thread was busy run together in one transaction, a login storm or a score
+ * flush commits once instead of once per query.
+ */
 class Database {
    private:
+    using Job = std::function<void(Database&)>;
+
     sqlite3* db = nullptr;
     bool bConnected = false;
+    uint32_t _passwordIterations;
+    // Checked against when the user is unknown, so a login costs as long whether the name exists or not
+    std::string _dummyRecord;
+
+    // Prepared once per SQL text, reset after each use
+    std::unordered_map<std::string, sqlite3_stmt*> _statements;
+
+    std::mutex _jobsMutex;
+    std::condition_variable _jobsCondition;
+    std::vector<Job> _jobs;
+    bool _stopping = false;
+    std::thread _worker;
 
    public:
-    Database(const std::string& filename);
+    /**
+        @param filename
+        @param passwordIterations cost of the password hashes written from now on
+    */
+    Database(const std::string& filename, uint32_t passwordIterations = credentials::PASSWORD_ITERATIONS);
+    // Runs the jobs still queued before closing
     ~Database();
 
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
    private:
     void _initialize();
+    void _hashPlaintextTokens();
+    void _exec(const char* sql);
+    sqlite3_stmt* _prepare(const std::string& sql);
+    void _enqueue(Job job);
+    void _run();
 
    public:
-    bool RegisterUser(std::string username, std::string password);
-    int LoginUser(std::string username, std::string password);
-    void SaveToken(int userID, std::string token);
-    int GetUserByToken(std::string token);
+    /**
+        A function to run queries on the database thread
+        @param JobType function taking a Database&, it may call the queries below
+        @return future holding what the job returned, or what it threw
+    */
+    template <typename JobType>
+    auto Submit(JobType&& job) -> std::future<std::invoke_result_t<JobType&, Database&>> {
+        using Result = std::invoke_result_t<JobType&, Database&>;
+        auto task = std::make_shared<std::packaged_task<Result(Database&)>>(std::forward<JobType>(job));
+        std::future<Result> result = task->get_future();
+
+        _enqueue([task](Database& database) { (*task)(database); });
+        return result;
+    }
+
+    /**
+        Record the score of a user, written with the next batch
+        Callable from any thread
+        @param userID id from LoginUser
+        @param newScore score of the game that just ended, the best one is kept
+    */
     void UpdateScore(int userID, int newScore);
+
+    // Queries, only from a job given to Submit. Passwords and tokens are hashed here, on the database thread
+    /**
+        Add a user, its password hashed
+        @return the id of the new user, -1 if the name is taken or the insert failed
+    */
+    int RegisterUser(const std::string& username, const std::string& password);
+    /**
+        Check a password, a plaintext or cheaper hash left by an older server is hashed again on success
+        @return the user id, -1 if the user or the password is wrong
+    */
+    int LoginUser(const std::string& username, const std::string& password);
+    // Only the hash of the token is kept, it cannot be read back
+    void SaveToken(int userID, const std::string& token);
+    int GetUserByToken(const std::string& token);
     std::string GetNameById(int userId);
-    std::string GetTokenById(int userId);
-};
\ No newline at end of file
+    int GetScoreById(int userId);
+};
@@ -21,7 +21,7 @@ class Lobby {
     State GetState() const { return _state; }
     void SetState(State state) { _state = state; }
 
-    std::unordered_map<unsigned int, std::shared_ptr<network::Connection<T>>> getLobbyPlayers() const {
+    const std::unordered_map<unsigned int, std::shared_ptr<network::Connection<T>>>& getLobbyPlayers() const {
         return _mapPlayers;
     }
 
@@ -69,6 +69,15 @@ enum class GameEvents : uint32_t {
     S_GAME_OVER,
 
     S_RETURN_TO_LOBBY,
+
+    // Added after the first release, appended so the values above keep their numbers on the wire
+    S_SNAPSHOT_BATCH,
+    C_SNAPSHOT_ACK,
+    C_INPUT_ACTIONS,
+    S_FULL_STATE_CHUNK,
+    C_FULL_STATE_ACK,
+    C_FULL_STATE_RESEND,
+    S_ANIMATION_SET,
 };
 
 // Hash function for GameEvents enum class
@@ -81,6 +90,9 @@ struct hash<network::GameEvents> {
 }  // namespace std
 namespace network {
 
+// Most S_SNAPSHOT_BATCH sequences a single C_SNAPSHOT_ACK carries
+static constexpr uint32_t MAX_SNAPSHOT_ACKS = 64u;
+
 struct coming_message {
     GameEvents id;
     uint32_t clientID;
@@ -1,13 +1,18 @@
 
 #pragma once
 #include "Connection.hpp"
-#include "MsgQueue.hpp"
+#include "MessagePool.hpp"
+#include "RingQueue.hpp"
+#include "UdpReceiver.hpp"
 
 namespace network {
 template <typename T>
 class ClientInterface {
    public:
-    ClientInterface() : _socketUDP(_context) {}
+    ClientInterface()
+        : _socketUDP(_context),
+          _udpSender(_context, _socketUDP, _messagePool),
+          _udpReceiver(_socketUDP, _messagePool) {}
 
     virtual ~ClientInterface() { Disconnect(); }
 
@@ -18,7 +23,8 @@ class ClientInterface {
             asio::ip::tcp::resolver::results_type endpoints = resolver.resolve(host, std::to_string(port));
 
             _connection = std::make_shared<Connection<T>>(Connection<T>::owner::client, _context,
-                                                          asio::ip::tcp::socket(_context), _qMessagesIn, _socketUDP);
+                                                          asio::ip::tcp::socket(_context), _qMessagesIn,
+                                                          _messagePool, _udpSender);
             _connection->ConnectToServer(endpoints);
 
             _serverUDPEndpoint = asio::ip::udp::endpoint(endpoints.begin()->endpoint().address(), port);
@@ -71,61 +77,53 @@ class ClientInterface {
             _connection->Send(msg);
     }
 
+    void Send(message<T>&& msg) {
+        if (IsConnected())
+            _connection->Send(std::move(msg));
+    }
+
     void SendUdp(const message<T>& msg) {
         if (IsConnected())
             _connection->SendUdp(msg);
     }
 
+    void SendUdp(message<T>&& msg) {
+        if (IsConnected())
+            _connection->SendUdp(std::move(msg));
+    }
+
+    // A message whose body comes back to the pool once sent, to build the next packet in
+    message<T> AcquireMessage(std::size_t reserve = 0) { return _messagePool.acquire(reserve); }
+
+    void FlushUdp() { _udpSender.flush(); }
+    void SetUdpAutoFlush(bool autoFlush) { _udpSender.setAutoFlush(autoFlush); }
+
+    // Every datagram comes from the server, a wakeup goes to the game thread in one push
     void ReceiveUDP() {
-        if (_udpMsgTemporaryIn.size() < 4096)
-            _udpMsgTemporaryIn.resize(4096);
-        _socketUDP.async_receive_from(
-            asio::buffer(_udpMsgTemporaryIn.data(), _udpMsgTemporaryIn.size()), _serverUDPEndpoint,
-            [this](std::error_code ec, std::size_t len) {
-                if (!ec && len > 0) {
-                    message<T> msg;
-
-                    if (len >= sizeof(message_header<T>)) {
-                        std::memcpy(&msg.header, _udpMsgTemporaryIn.data(), sizeof(message_header<T>));
-
-                        if (msg.header.magic_value != MAGIC_VALUE) {
-                            std::cout << "[UDP] Error: Invalid Magic Value " << std::hex << msg.header.magic_value
-                                      << std::dec << "\n";
-                        } else {
-                            if (msg.header.size > 0) {
-                                if (msg.header.size <= len - sizeof(message_header<T>)) {
-                                    msg.body.resize(msg.header.size);
-                                    std::memcpy(msg.body.data(), _udpMsgTemporaryIn.data() + sizeof(message_header<T>),
-                                                msg.header.size);
-                                    _qMessagesIn.push_back({nullptr, msg});
-                                } else {
-                                    std::cout << "[UDP] Error: Invalid Size " << msg.header.size << " (Len: " << len
-                                              << ")\n";
-                                }
-                            } else {
-                                _qMessagesIn.push_back({nullptr, msg});
-                            }
-                        }
-                    }
-
-                    ReceiveUDP();
-                } else if (ec) {
-                    std::cout << "[UDP] Reception Error: " << ec.message() << "\n";
-                }
-            });
+        _udpReceiver.start([this](std::vector<received_datagram<T>>& batch) {
+            for (auto& datagram : batch) {
+                _udpInBatch.push_back({nullptr, std::move(datagram.msg)});
+            }
+            _qMessagesIn.push_all(_udpInBatch);
+            _udpInBatch.clear();
+        });
     }
 
-    MsgQueue<owned_message<T>>& Incoming() { return _qMessagesIn; }
+    RingQueue<owned_message<T>>& Incoming() { return _qMessagesIn; }
 
    protected:
+    MessagePool<T> _messagePool;
+
     asio::io_context _context;
     std::thread thrContext;
     std::shared_ptr<Connection<T>> _connection;
 
     asio::ip::udp::socket _socketUDP;
+    UdpSender<T> _udpSender;
+    UdpReceiver<T> _udpReceiver;
     asio::ip::udp::endpoint _serverUDPEndpoint;
-    std::vector<uint8_t> _udpMsgTemporaryIn;
+    std::vector<owned_message<T>> _udpInBatch;
 
-    MsgQueue<owned_message<T>> _qMessagesIn;
+    RingQueue<owned_message<T>> _qMessagesIn{INBOUND_QUEUE_CAPACITY};
 };
 }  // namespace network
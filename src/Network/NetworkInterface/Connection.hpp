@@ -1,7 +1,10 @@
 #pragma once
 
-#include "MsgQueue.hpp"
+#include <atomic>
+#include "MessagePool.hpp"
 #include "NetworkCommon.hpp"
+#include "RingQueue.hpp"
+#include "UdpSender.hpp"
 #include "message.hpp"
 
 namespace network {
@@ -12,11 +15,12 @@ class Connection : public std::enable_shared_from_this<Connection<T>> {
 
    public:
     Connection(owner parent, asio::io_context& asioContext, asio::ip::tcp::socket socket,
-               MsgQueue<owned_message<T>>& In, asio::ip::udp::socket& udpSocket)
+               RingQueue<owned_message<T>>& In, MessagePool<T>& pool, UdpSender<T>& udpSender)
         : _asioContext(asioContext),
           _socket(std::move(socket)),
           _qMessagesIn(In),
-          _udpSocket(udpSocket),
+          _pool(pool),
+          _udpSender(udpSender),
           m_timerTimeout(asioContext) {
         _OwnerType = parent;
     }
@@ -56,95 +60,95 @@ class Connection : public std::enable_shared_from_this<Connection<T>> {
     void StartListening() {}
 
    public:
-    void Send(const message<T>& msg) {
-        asio::post(_asioContext, [this, msg]() mutable {
+    /**
+        A function to queue a message on the TCP socket, callable from any thread
+        Never waits: when the outbound queue is full the peer is not reading, the message
+        is dropped and counted and the connection is closed
+        @param msg the message to send, best built in a body taken from the pool as it goes back there once written
+    */
+    void Send(message<T>&& msg) {
 #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
-            msg.to_little_endian();
+        msg.to_little_endian();
 #endif
-            bool WritingMessage = !_qMessagesOut.empty();
-            _qMessagesOut.push_back(msg);
-            if (!WritingMessage) {
-                WriteHeader();
-            }
-        });
+        if (!_qMessagesOut.try_push(std::move(msg))) {
+            _pool.release(std::move(msg));
+            // A stream with a hole in it is worse than no stream, the peer has to reconnect
+            if (_droppedMessages.fetch_add(1, std::memory_order_relaxed) == 0)
+                std::cout << "[" << id << "] Outbound queue full, disconnecting.\n";
+            Disconnect();
+            return;
+        }
+        ScheduleWrite(_tcpWriting, &Connection::FlushTcp);
     }
 
-    void SendUdp(const message<T>& msg) {
-        asio::post(_asioContext, [self = this->shared_from_this(), msg]() mutable {
+    // Queues a copy, for a message that is still needed afterwards
+    void Send(const message<T>& msg) { Send(message<T>(msg)); }
+
+    // Messages given up by Send because the outbound queue was full
+    uint64_t GetDroppedMessages() const { return _droppedMessages.load(std::memory_order_relaxed); }
+
+    /**
+        A function to queue a datagram, callable from any thread
+        The datagram leaves with the next flush of the UdpSender shared by all connections
+        @param msg the message to send, its body goes back to the pool once the datagram is out
+    */
+    void SendUdp(message<T>&& msg) {
 #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
-            msg.to_little_endian();
+        msg.to_little_endian();
 #endif
-            bool WritingMessage = !self->_udpMessagesOut.empty();
-            self->_udpMessagesOut.push_back(msg);
-            if (!WritingMessage) {
-                self->WriteUDP();
-            }
-        });
+        _udpSender.send(this->shared_from_this(), std::move(msg));
     }
 
+    // Queues a copy, for a message that is still needed afterwards
+    void SendUdp(const message<T>& msg) { SendUdp(message<T>(msg)); }
+
    protected:
-    void WriteHeader() {
-        asio::async_write(_socket, asio::buffer(&_qMessagesOut.front().header, sizeof(message_header<T>)),
-                          [self = this->shared_from_this()](std::error_code ec, std::size_t length) {
-                              if (!ec) {
-                                  if (self->_qMessagesOut.front().body.size() > 0) {
-                                      self->WriteBody();
-                                  } else {
-                                      self->_qMessagesOut.pop_front();
-                                      if (!self->_qMessagesOut.empty()) {
-                                          self->WriteHeader();
-                                      }
-                                  }
-                              } else {
-                                  std::cout << "[" << self->id << "] Write Header Fail.\n";
-                                  std::cout << ec.message() << "\n";
-                                  self->_socket.close();
-                              }
-                          });
+
+    // Posts a flush unless one is already writing, the flush drains everything queued meanwhile
+    void ScheduleWrite(std::atomic<bool>& writing, void (Connection::*flush)()) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!writing.exchange(true))
+            asio::post(_asioContext, [self = this->shared_from_this(), flush]() { ((*self).*flush)(); });
+    }
+
+    // Takes the next batch of messages, or clears the writing flag once the queue is empty
+    bool NextBatch(RingQueue<message<T>>& queue, std::vector<message<T>>& batch, std::atomic<bool>& writing) {
+        for (auto& sent : batch) {
+            _pool.release(std::move(sent));
+        }
+        batch.clear();
+        while (queue.pop_all(batch) == 0) {
+            writing.store(false);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // A sender that saw the flag still set did not post, its message is ours to write
+            if (queue.empty() || writing.exchange(true))
+                return false;
+        }
+        return true;
     }
 
-    void WriteBody() {
-        asio::async_write(_socket, asio::buffer(_qMessagesOut.front().body.data(), _qMessagesOut.front().body.size()),
+    // Gathers every queued header and body into one buffer sequence, written by a single async_write
+    void FlushTcp() {
+        if (!NextBatch(_qMessagesOut, _tcpBatch, _tcpWriting))
+            return;
+
+        _tcpBuffers.clear();
+        for (const auto& msg : _tcpBatch) {
+            _tcpBuffers.push_back(asio::buffer(&msg.header, sizeof(message_header<T>)));
+            if (!msg.body.empty())
+                _tcpBuffers.push_back(asio::buffer(msg.body.data(), msg.body.size()));
+        }
+        asio::async_write(_socket, _tcpBuffers,
                           [self = this->shared_from_this()](std::error_code ec, std::size_t length) {
                               if (!ec) {
-                                  self->_qMessagesOut.pop_front();
-                                  if (!self->_qMessagesOut.empty()) {
-                                      self->WriteHeader();
-                                  }
+                                  self->FlushTcp();
                               } else {
-                                  std::cout << "[" << self->id << "] Write Body Fail.\n";
+                                  std::cout << "[" << self->id << "] Write Fail.\n";
                                   std::cout << ec.message() << "\n";
                                   self->_socket.close();
                               }
                           });
     }
-    void WriteUDP() {
-        if (_udpMessagesOut.empty())
-            return;
-
-        message<T> msg = _udpMessagesOut.pop_front();
-        std::vector<uint8_t> Buffer;
-        Buffer.resize(sizeof(msg.header) + msg.body.size());
-
-        std::memcpy(Buffer.data(), &msg.header, sizeof(msg.header));
-        if (!msg.body.empty())
-            std::memcpy(Buffer.data() + sizeof(msg.header), msg.body.data(), msg.body.size());
-
-        auto send_buffer = asio::buffer(Buffer.data(), Buffer.size());
-        _udpSocket.async_send_to(
-            send_buffer, _udpRemoteEndpoint,
-            [self = this->shared_from_this(), Buffer = std::move(Buffer)](std::error_code ec, std::size_t bytes_sent) {
-                if (!ec) {
-                    if (!self->_udpMessagesOut.empty()) {
-                        self->WriteUDP();
-                    }
-                } else {
-                    if (!self->_udpMessagesOut.empty()) {
-                        self->WriteUDP();
-                    }
-                }
-            });
-    }
 
     void ReadHeader() {
         asio::async_read(
@@ -193,10 +197,12 @@ class Connection : public std::enable_shared_from_this<Connection<T>> {
     }
 
     void AddToIncomingMessageQueue() {
+        // ReadHeader refills the header and the body, the message can be moved out
         if (_OwnerType == owner::server)
-            _qMessagesIn.push_back({this->shared_from_this(), _msgTemporaryIn});
+            _qMessagesIn.push_back({this->shared_from_this(), std::move(_msgTemporaryIn)});
         else
-            _qMessagesIn.push_back({nullptr, _msgTemporaryIn});
+            _qMessagesIn.push_back({nullptr, std::move(_msgTemporaryIn)});
+        _msgTemporaryIn = _pool.acquire();
 
         ReadHeader();
     }
@@ -230,16 +236,23 @@ class Connection : public std::enable_shared_from_this<Connection<T>> {
 
    protected:
     asio::ip::udp::endpoint _udpRemoteEndpoint;
-    asio::ip::udp::socket& _udpSocket;
+    UdpSender<T>& _udpSender;
 
     asio::ip::tcp::socket _socket;
 
     asio::io_context& _asioContext;
 
-    MsgQueue<message<T>> _qMessagesOut;
-    MsgQueue<message<T>> _udpMessagesOut;
+    // Filled by any thread, drained in batches by the asio thread
+    RingQueue<message<T>> _qMessagesOut{OUTBOUND_QUEUE_CAPACITY};
+    std::atomic<bool> _tcpWriting{false};
+    std::atomic<uint64_t> _droppedMessages{0};
+
+    // Batch being written and the buffers pointing into it, only touched by the asio thread
+    std::vector<message<T>> _tcpBatch;
+    std::vector<asio::const_buffer> _tcpBuffers;
 
-    MsgQueue<owned_message<T>>& _qMessagesIn;
+    RingQueue<owned_message<T>>& _qMessagesIn;
+    MessagePool<T>& _pool;
 
     message<T> _msgTemporaryIn;
 
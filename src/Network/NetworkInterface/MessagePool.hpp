@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include "RingQueue.hpp"
+#include "message.hpp"
+
+namespace network {
+
+// Messages kept for reuse, and the biggest body worth keeping
+inline constexpr std::size_t MESSAGE_POOL_CAPACITY = 1024;
+inline constexpr std::size_t MAX_POOLED_BODY_SIZE = 64u * 1024u;
+
+/**
+ * @brief Free list of messages, so their bodies keep their allocation between packets.
+ *
+ * Built on RingQueue: the asio thread and the game thread can both take and
+ * give back messages. An empty pool hands out a new message, a full pool lets
+ * the returned message go.
+ */
+template <typename T>
+class MessagePool {
+   public:
+    explicit MessagePool(std::size_t capacity = MESSAGE_POOL_CAPACITY) : _free(capacity) {}
+
+    /**
+        A function to take an empty message from the pool
+        @param reserve number of body bytes the message should hold without reallocating
+        @return a message with a default header and an empty body
+    */
+    message<T> acquire(std::size_t reserve = 0) {
+        message<T> msg;
+
+        if (_free.pop(msg)) {
+            msg.header = message_header<T>();
+            msg.body.clear();
+        }
+        msg.body.reserve(reserve);
+        return msg;
+    }
+
+    /**
+        A function to give a message back once it has been sent or read
+        @param msg the message, its body allocation is what gets reused
+    */
+    void release(message<T>&& msg) {
+        if (msg.body.capacity() == 0 || msg.body.capacity() > MAX_POOLED_BODY_SIZE)
+            return;
+        _free.try_push(std::move(msg));
+    }
+
+    std::size_t available() const { return _free.count(); }
+
+   private:
+    RingQueue<message<T>> _free;
+};
+
+}  // namespace network
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace network {
+
+/**
+ * @brief Bounded lock-free queue shared by the asio thread and the game thread.
+ *
+ * Every cell carries a sequence number telling whether it is free for the
+ * producer at that position or filled for the consumer at that position, so
+ * producers and consumers only contend on their own index. The capacity is
+ * rounded up to a power of two and never grows: a full queue makes try_push
+ * fail and push_back wait for the consumer to make room.
+ */
+template <typename T>
+class RingQueue {
+   public:
+    explicit RingQueue(std::size_t capacity) : _mask(roundUp(capacity) - 1), _cells(new Cell[_mask + 1]) {
+        for (std::size_t i = 0; i <= _mask; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingQueue(const RingQueue<T>&) = delete;
+    RingQueue& operator=(const RingQueue<T>&) = delete;
+
+   public:
+    /**
+        A function to add an item if there is room for it
+        @param item the item to move in the queue
+        @return false if the queue is full, the item is left untouched
+    */
+    bool try_push(T&& item) {
+        if (!claimAndStore(item))
+            return false;
+        publish();
+        return true;
+    }
+
+    bool try_push(const T& item) {
+        T copy = item;
+        return try_push(std::move(copy));
+    }
+
+    /**
+        A function to add an item, waiting for the consumer while the queue is full
+        The consumer must not be the calling thread
+        @param item the item to move in the queue
+    */
+    void push_back(T item) {
+        while (!try_push(std::move(item))) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+        A function to add many items, waking a waiting consumer once instead of once per item
+        Waits for the consumer while the queue is full, like push_back
+        @param items moved in the queue in order, the vector is left holding moved-from items
+    */
+    void push_all(std::vector<T>& items) {
+        std::size_t pending = 0;
+
+        for (auto& item : items) {
+            while (!claimAndStore(item)) {
+                // The consumer may be asleep on what is already in, let it make room
+                if (pending > 0) {
+                    publish();
+                    pending = 0;
+                }
+                std::this_thread::yield();
+            }
+            pending++;
+        }
+        if (pending > 0)
+            publish();
+    }
+
+    /**
+        A function to take the oldest item
+        @param out receives the item
+        @return false if the queue is empty
+    */
+    bool pop(T& out) {
+        std::size_t pos = _head.value.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true) {
+            cell = &_cells[pos & _mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (_head.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _head.value.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->item);
+        // Release what the moved-from item still holds (connection, body) before recycling the cell
+        cell->item = T{};
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+        A function to take every item in the queue at once
+        @param out the items are appended to it, in order
+        @param max the maximum number of items to take
+        @return the number of items taken
+    */
+    std::size_t pop_all(std::vector<T>& out, std::size_t max = static_cast<std::size_t>(-1)) {
+        std::size_t taken = 0;
+
+        out.reserve(out.size() + std::min(count(), max));
+        while (taken < max) {
+            out.emplace_back();
+            if (!pop(out.back())) {
+                out.pop_back();
+                break;
+            }
+            taken++;
+        }
+        return taken;
+    }
+
+    bool empty() const {
+        std::size_t pos = _head.value.load(std::memory_order_acquire);
+        return _cells[pos & _mask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    std::size_t count() const {
+        std::size_t head = _head.value.load(std::memory_order_acquire);
+        std::size_t tail = _tail.value.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    std::size_t capacity() const { return _mask + 1; }
+
+    void clear() {
+        T item;
+        while (pop(item)) {
+        }
+    }
+
+    /**
+        A function to block until the queue holds an item
+    */
+    void wait() {
+        while (true) {
+            uint32_t published = _published.load(std::memory_order_acquire);
+            if (!empty())
+                return;
+            _published.wait(published);
+        }
+    }
+
+   private:
+    // Moves the item in the next free cell, without waking the consumer
+    bool claimAndStore(T& item) {
+        std::size_t pos = _tail.value.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true) {
+            cell = &_cells[pos & _mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (_tail.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _tail.value.load(std::memory_order_relaxed);
+            }
+        }
+        cell->item = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    void publish() {
+        _published.fetch_add(1, std::memory_order_release);
+        _published.notify_one();
+    }
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    // Keeps the indices of the two sides on their own cache line
+    struct alignas(64) Index {
+        std::atomic<std::size_t> value{0};
+    };
+
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const std::size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+    Index _tail;
+    Index _head;
+    std::atomic<uint32_t> _published{0};
+};
+
+}  // namespace network
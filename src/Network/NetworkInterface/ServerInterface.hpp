@@ -1,7 +1,12 @@
 #pragma once
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include "Connection.hpp"
-#include "MsgQueue.hpp"
+#include "MessagePool.hpp"
+#include "RingQueue.hpp"
+#include "UdpReceiver.hpp"
 #include "message.hpp"
 #ifdef _WIN32
 #include <winsock2.h>
@@ -21,9 +26,17 @@ class ServerInterface {
     ServerInterface(uint16_t port)
         : asioAcceptor(_asioContext, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
           _socketUDP(_asioContext),
+          _udpSender(_asioContext, _socketUDP, _messagePool),
+          _udpReceiver(_socketUDP, _messagePool),
           _port(port) {}
 
-    virtual ~ServerInterface() { Stop(); }
+    virtual ~ServerInterface() {
+        Stop();
+        // The sockets must go before the io_context they were opened on
+        _connectionsById.clear();
+        _connectionsByEndpoint.clear();
+        _deqConnections.clear();
+    }
 
     bool Start() {
         std::cout << "[SERVER] Starting server on port 4040..." << std::endl;
@@ -118,14 +131,16 @@ class ServerInterface {
                 std::cout << "[SERVER] New Connection: " << socket.remote_endpoint() << "\n";
 
                 std::shared_ptr<Connection<T>> newconn = std::make_shared<Connection<T>>(
-                    Connection<T>::owner::server, _asioContext, std::move(socket), _MessagesIn, _socketUDP);
+                    Connection<T>::owner::server, _asioContext, std::move(socket), _MessagesIn, _messagePool,
+                    _udpSender);
 
                 newconn->ConnectToClient(nIDCounter++);
 
-                _deqConnections.push_back(newconn);
+                RegisterConnection(newconn);
                 if (OnClientConnect(newconn)) {
                     std::cout << "[" << _deqConnections.back()->GetID() << "] Connection Approved\n";
                 } else {
+                    UnregisterConnection(newconn);
                     _deqConnections.pop_back();
                     std::cout << "[-----] Connection Denied\n";
                 }
@@ -142,6 +157,7 @@ class ServerInterface {
             client->Send(msg);
         } else {
             OnClientDisconnect(client);
+            UnregisterConnection(client);
 
             client.reset();
 
@@ -159,6 +175,7 @@ class ServerInterface {
                     client->Send(msg);
             } else {
                 OnClientDisconnect(client);
+                UnregisterConnection(client);
                 client.reset();
 
                 bInvalidClientExists = true;
@@ -175,6 +192,7 @@ class ServerInterface {
             client->SendUdp(msg);
         } else {
             OnClientDisconnect(client);
+            UnregisterConnection(client);
 
             client.reset();
 
@@ -192,6 +210,7 @@ class ServerInterface {
                     client->SendUdp(msg);
             } else {
                 OnClientDisconnect(client);
+                UnregisterConnection(client);
                 client.reset();
 
                 bInvalidClientExists = true;
@@ -203,23 +222,34 @@ class ServerInterface {
                                   _deqConnections.end());
     }
 
+    /**
+        A function to send the datagrams queued since the last flush, callable from any thread
+    */
+    void FlushUdp() { _udpSender.flush(); }
+
+    /**
+        A function to choose between sending every datagram right away, or only on FlushUdp
+        @param autoFlush false lets a whole tick go out in as few syscalls as possible
+    */
+    void SetUdpAutoFlush(bool autoFlush) { _udpSender.setAutoFlush(autoFlush); }
+
     void Update(size_t nMaxMessages = -1, bool bWait = false) {
         if (bWait)
             _MessagesIn.wait();
 
-        size_t nMessageCount = 0;
-        while (nMessageCount < nMaxMessages && !_MessagesIn.empty()) {
-            auto msg = _MessagesIn.pop_front();
-
+        _inBatch.clear();
+        _MessagesIn.pop_all(_inBatch, nMaxMessages);
+        for (auto& msg : _inBatch) {
             OnMessage(msg.remote, msg.msg);
-
-            nMessageCount++;
+            _messagePool.release(std::move(msg.msg));
         }
+        _inBatch.clear();
 
         bool bInvalidClientExists = false;
         for (auto& client : _deqConnections) {
             if (!client->IsConnected()) {
                 OnClientDisconnect(client);
+                UnregisterConnection(client);
                 client.reset();
                 bInvalidClientExists = true;
                 continue;
@@ -234,63 +264,94 @@ class ServerInterface {
     }
 
     virtual void ReceiveUDP() {
-        if (_udpMsgTemporaryIn.size() < 4096)
-            _udpMsgTemporaryIn.resize(4096);
-        _socketUDP.async_receive_from(
-            asio::buffer(_udpMsgTemporaryIn.data(), _udpMsgTemporaryIn.size()), _udpEndpointTemporary,
-            [this](std::error_code ec, std::size_t len) {
-                if (!ec && len > 0) {
-                    network::message<T> msg;
-
-                    if (len >= sizeof(network::message_header<T>)) {
-                        std::memcpy(&msg.header, _udpMsgTemporaryIn.data(), sizeof(network::message_header<T>));
-
-                        if (msg.header.size > 0) {
-                            if (len >= sizeof(network::message_header<T>) + msg.header.size) {
-                                msg.body.resize(msg.header.size);
-                                std::memcpy(msg.body.data(),
-                                            _udpMsgTemporaryIn.data() + sizeof(network::message_header<T>),
-                                            msg.header.size);
-                            } else {
-                                std::cout << "[UDP] Erreur : Paquet corrompu reçu.\n";
-                                ReceiveUDP();
-                                return;
-                            }
-                        }
-
-                        std::shared_ptr<Connection<T>> pClient = nullptr;
-                        bool bClientFound = false;
-
-                        for (auto& client : _deqConnections) {
-                            if (client->IsConnected() && client->GetUDPEndpoint() == _udpEndpointTemporary) {
-                                pClient = client;
-                                bClientFound = true;
-                                break;
-                            }
-                            if (client->GetID() == msg.header.user_id) {
-                                pClient = client;
-                                pClient->SetUDPEndpoint(_udpEndpointTemporary);
-
-                                bClientFound = true;
-                                break;
-                            }
-                        }
-
-                        if (bClientFound) {
-                            _MessagesIn.push_back({pClient, msg});
-                        } else {
-                            std::cout << "[UDP] Error: Packet received from unknown client (ID: " << msg.header.user_id
-                                      << ").\n";
-                        }
-                    }
-                } else if (ec) {
-                    std::cout << "[UDP] Erreur réception : " << ec.message() << "\n";
-                }
-                ReceiveUDP();
-            });
+        _udpReceiver.start([this](std::vector<received_datagram<T>>& batch) { DispatchUDP(batch); });
+    }
+
+    /**
+        A function to find a connection from its id without walking every connection
+        Callable from any thread
+        @param id id the connection got when it was accepted
+        @return the connection, or nullptr if it is gone
+    */
+    std::shared_ptr<Connection<T>> GetConnection(uint32_t id) {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        auto it = _connectionsById.find(id);
+        return it != _connectionsById.end() ? it->second : nullptr;
     }
 
+    /**
+        A function to take a message to build a packet in, callable from any thread
+        Moved into Send or SendUdp, its body comes back to the pool once written
+        @param reserve number of body bytes the packet will need
+        @return an empty message
+    */
+    message<T> AcquireMessage(std::size_t reserve = 0) { return _messagePool.acquire(reserve); }
+
    protected:
+    void RegisterConnection(std::shared_ptr<Connection<T>> client) {
+        {
+            std::lock_guard<std::mutex> lock(_connectionsMutex);
+            _connectionsById[client->GetID()] = client;
+        }
+        _deqConnections.push_back(std::move(client));
+    }
+
+    // Only drops the id, the caller takes the connection out of _deqConnections
+    void UnregisterConnection(const std::shared_ptr<Connection<T>>& client) {
+        if (!client)
+            return;
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        auto it = _connectionsById.find(client->GetID());
+        if (it != _connectionsById.end() && it->second == client)
+            _connectionsById.erase(it);
+        auto byEndpoint = _connectionsByEndpoint.find(client->GetUDPEndpoint());
+        if (byEndpoint != _connectionsByEndpoint.end() && byEndpoint->second == client)
+            _connectionsByEndpoint.erase(byEndpoint);
+    }
+
+    /**
+        A function to hand the datagrams of one wakeup to the game thread
+        Senders are resolved under a single lock, and the messages are pushed together
+        @param batch datagrams read by the UdpReceiver, their messages are moved out
+    */
+    void DispatchUDP(std::vector<received_datagram<T>>& batch) {
+        {
+            std::lock_guard<std::mutex> lock(_connectionsMutex);
+            for (auto& datagram : batch) {
+                std::shared_ptr<Connection<T>> pClient = FindUDPSender(datagram.sender, datagram.msg.header.user_id);
+
+                if (pClient) {
+                    _udpInBatch.push_back({std::move(pClient), std::move(datagram.msg)});
+                } else {
+                    std::cout << "[UDP] Error: Packet received from unknown client (ID: "
+                              << datagram.msg.header.user_id << ").\n";
+                }
+            }
+        }
+        _MessagesIn.push_all(_udpInBatch);
+        _udpInBatch.clear();
+    }
+
+    // Known endpoint first, else the id the client put in the header, whose endpoint is then learnt
+    // _connectionsMutex must be held
+    std::shared_ptr<Connection<T>> FindUDPSender(const asio::ip::udp::endpoint& sender, uint32_t userId) {
+        auto known = _connectionsByEndpoint.find(sender);
+        if (known != _connectionsByEndpoint.end() && known->second->IsConnected())
+            return known->second;
+
+        auto byId = _connectionsById.find(userId);
+        if (byId == _connectionsById.end())
+            return nullptr;
+
+        std::shared_ptr<Connection<T>>& client = byId->second;
+        auto previous = _connectionsByEndpoint.find(client->GetUDPEndpoint());
+        if (previous != _connectionsByEndpoint.end() && previous->second == client)
+            _connectionsByEndpoint.erase(previous);
+        client->SetUDPEndpoint(sender);
+        _connectionsByEndpoint[sender] = client;
+        return client;
+    }
+
     virtual bool OnClientConnect(std::shared_ptr<Connection<T>> client) { return false; }
 
     virtual void OnClientDisconnect(std::shared_ptr<Connection<T>> client) {}
@@ -298,19 +359,32 @@ class ServerInterface {
     virtual void OnMessage(std::shared_ptr<Connection<T>> client, message<T>& msg) {}
 
    protected:
-    MsgQueue<owned_message<T>> _MessagesIn;
+    // Bodies of sent and handled messages, reused by the next ones
+    MessagePool<T> _messagePool;
+
+    // Filled by the asio thread, drained once per tick by the game thread
+    RingQueue<owned_message<T>> _MessagesIn{INBOUND_QUEUE_CAPACITY};
+    std::vector<owned_message<T>> _inBatch;
 
-    std::vector<uint8_t> _udpMsgTemporaryIn;
-    MsgQueue<owned_message<T>> _UDPMessageIn;
-    asio::ip::udp::endpoint _udpEndpointTemporary;
+    // Resolved datagrams of one wakeup, only touched by the asio thread
+    std::vector<owned_message<T>> _udpInBatch;
 
     std::deque<std::shared_ptr<Connection<T>>> _deqConnections;
+    // Same connections by id, read by the threads routing messages to a player
+    std::unordered_map<uint32_t, std::shared_ptr<Connection<T>>> _connectionsById;
+    // Same connections by the endpoint their datagrams come from, once it is known
+    std::unordered_map<asio::ip::udp::endpoint, std::shared_ptr<Connection<T>>, UdpEndpointHash> _connectionsByEndpoint;
+    std::mutex _connectionsMutex;
 
     asio::io_context _asioContext;
     std::thread _threadContext;
 
     asio::ip::tcp::acceptor asioAcceptor;
     asio::ip::udp::socket _socketUDP;
+    // Datagrams of every connection, sent together from the UDP socket
+    UdpSender<T> _udpSender;
+    // Datagrams of every connection, read many per wakeup
+    UdpReceiver<T> _udpReceiver;
 
     uint32_t nIDCounter = 10000;
 
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "MessagePool.hpp"
+#include "NetworkCommon.hpp"
+#include "message.hpp"
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+namespace network {
+
+// Biggest datagram read, anything longer is truncated and dropped
+inline constexpr std::size_t UDP_MAX_DATAGRAM_SIZE = 4096;
+// Datagrams read by one recvmmsg call
+inline constexpr std::size_t UDP_RECEIVE_BATCH_SIZE = 64;
+// recvmmsg calls made per wakeup before handing the batch over, so one busy wakeup does not starve the others
+inline constexpr std::size_t UDP_RECEIVE_MAX_ROUNDS = 4;
+
+template <typename T>
+struct received_datagram {
+    asio::ip::udp::endpoint sender;
+    message<T> msg;
+};
+
+struct UdpReceiveStats {
+    uint64_t datagrams = 0;
+    uint64_t syscalls = 0;
+    uint64_t wakeups = 0;
+};
+
+// std::hash for asio endpoints is not there on every asio version
+struct UdpEndpointHash {
+    std::size_t operator()(const asio::ip::udp::endpoint& endpoint) const {
+        std::size_t hash = std::hash<uint16_t>()(endpoint.port());
+        if (endpoint.address().is_v4()) {
+            hash ^= std::hash<uint32_t>()(endpoint.address().to_v4().to_uint()) + 0x9e3779b9 + (hash << 6) +
+                    (hash >> 2);
+        } else {
+            for (auto byte : endpoint.address().to_v6().to_bytes()) {
+                hash ^= std::hash<uint8_t>()(byte) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+        }
+        return hash;
+    }
+};
+
+/**
+ * @brief Reads the datagrams arriving on a UDP socket, as many as are waiting per wakeup.
+ *
+ * Runs on the asio thread. Once the socket is readable, every waiting
+ * datagram is read into a slab allocated up front: on Linux up to
+ * UDP_RECEIVE_BATCH_SIZE of them per recvmmsg call, elsewhere with
+ * non-blocking receive_from calls. Valid datagrams become pooled messages and
+ * the whole wakeup is handed to the handler at once. Malformed datagrams are
+ * dropped.
+ */
+template <typename T>
+class UdpReceiver {
+   public:
+    using Handler = std::function<void(std::vector<received_datagram<T>>&)>;
+
+    UdpReceiver(asio::ip::udp::socket& socket, MessagePool<T>& pool)
+        : _socket(socket), _pool(pool), _slab(UDP_RECEIVE_BATCH_SIZE * UDP_MAX_DATAGRAM_SIZE) {
+#if defined(__linux__)
+        for (std::size_t i = 0; i < UDP_RECEIVE_BATCH_SIZE; ++i) {
+            _iovecs[i] = {&_slab[i * UDP_MAX_DATAGRAM_SIZE], UDP_MAX_DATAGRAM_SIZE};
+        }
+#endif
+        _batch.reserve(UDP_RECEIVE_BATCH_SIZE * UDP_RECEIVE_MAX_ROUNDS);
+    }
+
+    UdpReceiver(const UdpReceiver&) = delete;
+    UdpReceiver& operator=(const UdpReceiver&) = delete;
+
+    /**
+        A function to start reading, the socket must be open
+        @param handler called on the asio thread with the datagrams of each wakeup, it may move them out
+    */
+    void start(Handler handler) {
+        _handler = std::move(handler);
+        waitReadable();
+    }
+
+    /**
+        @return counters of the asio thread, only meaningful while it is not reading
+    */
+    const UdpReceiveStats& getStats() const { return _stats; }
+
+   private:
+    void waitReadable() {
+        _socket.async_wait(asio::ip::udp::socket::wait_read, [this](std::error_code ec) {
+            if (ec) {
+                if (ec != asio::error::operation_aborted)
+                    std::cout << "[UDP] Reception Error: " << ec.message() << "\n";
+                return;
+            }
+            _stats.wakeups++;
+            drain();
+            if (!_batch.empty())
+                _handler(_batch);
+            for (auto& datagram : _batch) {
+                _pool.release(std::move(datagram.msg));
+            }
+            _batch.clear();
+            waitReadable();
+        });
+    }
+
+#if defined(__linux__)
+    void drain() {
+        for (std::size_t round = 0; round < UDP_RECEIVE_MAX_ROUNDS; ++round) {
+            for (std::size_t i = 0; i < UDP_RECEIVE_BATCH_SIZE; ++i) {
+                _headers[i] = {};
+                _headers[i].msg_hdr.msg_name = &_senders[i];
+                _headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                _headers[i].msg_hdr.msg_iov = &_iovecs[i];
+                _headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int received = ::recvmmsg(_socket.native_handle(), _headers.data(),
+                                      static_cast<unsigned int>(UDP_RECEIVE_BATCH_SIZE), MSG_DONTWAIT, nullptr);
+            _stats.syscalls++;
+            if (received <= 0) {
+                if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                    std::cout << "[UDP] Reception Error: " << std::strerror(errno) << "\n";
+                return;
+            }
+
+            for (int i = 0; i < received; ++i) {
+                if (_headers[i].msg_hdr.msg_flags & MSG_TRUNC)
+                    continue;
+                asio::ip::udp::endpoint sender;
+                std::memcpy(sender.data(), &_senders[i], _headers[i].msg_hdr.msg_namelen);
+                sender.resize(_headers[i].msg_hdr.msg_namelen);
+                parse(sender, &_slab[i * UDP_MAX_DATAGRAM_SIZE], _headers[i].msg_len);
+            }
+            if (static_cast<std::size_t>(received) < UDP_RECEIVE_BATCH_SIZE)
+                return;
+        }
+    }
+#else
+    void drain() {
+        asio::ip::udp::endpoint sender;
+        std::error_code ec;
+        std::size_t limit = UDP_RECEIVE_BATCH_SIZE * UDP_RECEIVE_MAX_ROUNDS;
+
+        _socket.non_blocking(true, ec);
+        for (std::size_t i = 0; i < limit; ++i) {
+            std::size_t len = _socket.receive_from(asio::buffer(_slab.data(), UDP_MAX_DATAGRAM_SIZE), sender, 0, ec);
+            _stats.syscalls++;
+            if (ec == asio::error::would_block || ec == asio::error::try_again)
+                return;
+            if (!ec)
+                parse(sender, _slab.data(), len);
+        }
+    }
+#endif
+
+    void parse(const asio::ip::udp::endpoint& sender, const uint8_t* data, std::size_t len) {
+        if (len < sizeof(message_header<T>))
+            return;
+
+        received_datagram<T> datagram{sender, _pool.acquire(len - sizeof(message_header<T>))};
+        std::memcpy(&datagram.msg.header, data, sizeof(message_header<T>));
+
+        if (datagram.msg.header.magic_value != MAGIC_VALUE) {
+            std::cout << "[UDP] Error: Invalid Magic Value " << std::hex << datagram.msg.header.magic_value << std::dec
+                      << "\n";
+            _pool.release(std::move(datagram.msg));
+            return;
+        }
+        if (datagram.msg.header.size > len - sizeof(message_header<T>)) {
+            std::cout << "[UDP] Error: Invalid Size " << datagram.msg.header.size << " (Len: " << len << ")\n";
+            _pool.release(std::move(datagram.msg));
+            return;
+        }
+        datagram.msg.body.assign(data + sizeof(message_header<T>),
+                                 data + sizeof(message_header<T>) + datagram.msg.header.size);
+        _stats.datagrams++;
+        _batch.push_back(std::move(datagram));
+    }
+
+    asio::ip::udp::socket& _socket;
+    MessagePool<T>& _pool;
+    Handler _handler;
+
+    // One UDP_MAX_DATAGRAM_SIZE slot per datagram of a recvmmsg call
+    std::vector<uint8_t> _slab;
+    std::vector<received_datagram<T>> _batch;
+#if defined(__linux__)
+    std::array<mmsghdr, UDP_RECEIVE_BATCH_SIZE> _headers{};
+    std::array<iovec, UDP_RECEIVE_BATCH_SIZE> _iovecs{};
+    std::array<sockaddr_storage, UDP_RECEIVE_BATCH_SIZE> _senders{};
+#endif
+    UdpReceiveStats _stats;
+};
+
+}  // namespace network
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MessagePool.hpp"
+#include "NetworkCommon.hpp"
+#include "RingQueue.hpp"
+#include "message.hpp"
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+namespace network {
+
+// Datagrams waiting for the socket, for all connections together
+inline constexpr std::size_t UDP_OUTBOUND_QUEUE_CAPACITY = 4096;
+// Datagrams handed to one sendmmsg call
+inline constexpr std::size_t UDP_SEND_BATCH_SIZE = 64;
+
+struct UdpSendStats {
+    uint64_t datagrams = 0;
+    uint64_t syscalls = 0;
+    uint64_t flushes = 0;
+};
+
+/**
+ * @brief Sends the datagrams of every connection sharing a UDP socket.
+ *
+ * Connections queue their datagrams from any thread. A flush runs on the asio
+ * thread and sends everything queued so far: header and body go out as two
+ * buffers, without being copied together, and on Linux up to
+ * UDP_SEND_BATCH_SIZE datagrams leave in a single sendmmsg call. By default
+ * every send schedules a flush, with setAutoFlush(false) nothing leaves until
+ * flush() is called, so a whole tick can go out at once. A lost datagram is not
+ * retried.
+ */
+template <typename T>
+class UdpSender {
+   public:
+    UdpSender(asio::io_context& context, asio::ip::udp::socket& socket, MessagePool<T>& pool)
+        : _context(context), _socket(socket), _pool(pool) {}
+
+    UdpSender(const UdpSender&) = delete;
+    UdpSender& operator=(const UdpSender&) = delete;
+
+    /**
+        A function to queue a datagram, callable from any thread
+        A full queue drops the datagram instead of stalling the sender
+        @param remote connection to send to, its endpoint is read on the asio thread
+        @param msg the datagram
+    */
+    void send(std::shared_ptr<Connection<T>> remote, message<T>&& msg) {
+        owned_message<T> datagram{std::move(remote), std::move(msg)};
+
+        if (!_queue.try_push(std::move(datagram))) {
+            _pool.release(std::move(datagram.msg));
+            return;
+        }
+        if (_autoFlush.load(std::memory_order_relaxed) || _queue.count() >= _queue.capacity() / 2)
+            flush();
+    }
+
+    /**
+        A function to send everything queued so far, callable from any thread
+    */
+    void flush() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!_flushing.exchange(true))
+            asio::post(_context, [this]() { startFlush(); });
+    }
+
+    void setAutoFlush(bool autoFlush) { _autoFlush.store(autoFlush); }
+
+    /**
+        @return counters of the asio thread, only meaningful while it is not flushing
+    */
+    const UdpSendStats& getStats() const { return _stats; }
+
+   private:
+    // Takes the next batch, or clears the flushing flag once the queue is empty
+    void startFlush() {
+        for (auto& sent : _batch) {
+            _pool.release(std::move(sent.msg));
+        }
+        _batch.clear();
+        while (_queue.pop_all(_batch) == 0) {
+            _flushing.store(false);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // A sender that saw the flag still set did not post, its datagram is ours to send
+            if (_queue.empty() || _flushing.exchange(true))
+                return;
+        }
+
+        _endpoints.clear();
+        for (auto& datagram : _batch) {
+            _endpoints.push_back(datagram.remote->GetUDPEndpoint());
+        }
+        _sent = 0;
+        _stats.flushes++;
+        sendPending();
+    }
+
+#if defined(__linux__)
+    void sendPending() {
+        while (_sent < _batch.size()) {
+            std::size_t count = std::min(UDP_SEND_BATCH_SIZE, _batch.size() - _sent);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& msg = _batch[_sent + i].msg;
+                auto& endpoint = _endpoints[_sent + i];
+
+                _iovecs[2 * i] = {&msg.header, sizeof(message_header<T>)};
+                _iovecs[2 * i + 1] = {msg.body.data(), msg.body.size()};
+                _headers[i] = {};
+                _headers[i].msg_hdr.msg_name = endpoint.data();
+                _headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(endpoint.size());
+                _headers[i].msg_hdr.msg_iov = &_iovecs[2 * i];
+                _headers[i].msg_hdr.msg_iovlen = msg.body.empty() ? 1 : 2;
+            }
+
+            int sent = ::sendmmsg(_socket.native_handle(), _headers.data(), static_cast<unsigned int>(count),
+                                  MSG_DONTWAIT);
+            _stats.syscalls++;
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    // The socket buffer is full, carry on once it drains
+                    _socket.async_wait(asio::ip::udp::socket::wait_write, [this](std::error_code ec) {
+                        if (ec)
+                            _sent = _batch.size();
+                        sendPending();
+                    });
+                    return;
+                }
+                // Skip the datagram the kernel refused, like a failed async_send_to did
+                sent = 1;
+            } else {
+                _stats.datagrams += static_cast<uint64_t>(sent);
+            }
+            _sent += static_cast<std::size_t>(sent);
+        }
+        startFlush();
+    }
+#else
+    void sendPending() {
+        if (_sent == _batch.size()) {
+            startFlush();
+            return;
+        }
+
+        auto& msg = _batch[_sent].msg;
+        std::array<asio::const_buffer, 2> buffers = {asio::buffer(&msg.header, sizeof(message_header<T>)),
+                                                     asio::buffer(msg.body.data(), msg.body.size())};
+        _socket.async_send_to(buffers, _endpoints[_sent], [this](std::error_code ec, std::size_t) {
+            _stats.syscalls++;
+            if (!ec)
+                _stats.datagrams++;
+            _sent++;
+            sendPending();
+        });
+    }
+#endif
+
+    asio::io_context& _context;
+    asio::ip::udp::socket& _socket;
+    MessagePool<T>& _pool;
+
+    RingQueue<owned_message<T>> _queue{UDP_OUTBOUND_QUEUE_CAPACITY};
+    std::atomic<bool> _flushing{false};
+    std::atomic<bool> _autoFlush{true};
+
+    // Batch being sent, only touched by the asio thread
+    std::vector<owned_message<T>> _batch;
+    std::vector<asio::ip::udp::endpoint> _endpoints;
+    std::size_t _sent = 0;
+#if defined(__linux__)
+    std::array<mmsghdr, UDP_SEND_BATCH_SIZE> _headers{};
+    std::array<iovec, 2 * UDP_SEND_BATCH_SIZE> _iovecs{};
+#endif
+    UdpSendStats _stats;
+};
+
+}  // namespace network
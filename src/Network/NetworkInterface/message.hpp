@@ -4,6 +4,9 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #define MAGIC_VALUE 0xDEADBEEF
@@ -14,6 +17,11 @@ namespace network {
 // Prevents crashes when a corrupted header advertises an absurd size.
 inline constexpr uint32_t MAX_MESSAGE_BODY_SIZE = 1024u * 1024u;  // 1 MiB
 
+// Messages the game thread can have waiting, for all connections together
+inline constexpr std::size_t INBOUND_QUEUE_CAPACITY = 8192;
+// Messages a connection can have waiting for the socket
+inline constexpr std::size_t OUTBOUND_QUEUE_CAPACITY = 512;
+
 #pragma pack(push, 1)
 
 template <typename T>
@@ -45,20 +53,12 @@ struct message {
     friend message<T>& operator<<(message<T>& msg, const DataType& data) {
         static_assert(std::is_standard_layout<DataType>::value, "Data is too complex to be pushed into vector");
 
-        size_t i = msg.body.size();
-
-        msg.body.resize(msg.body.size() + sizeof(DataType));
-        std::memcpy(msg.body.data() + i, &data, sizeof(DataType));
-        msg.header.size = (uint32_t)msg.size();
-
+        msg.push_bytes(reinterpret_cast<const uint8_t*>(&data), sizeof(DataType));
         return msg;
     }
 
     friend message<T>& operator<<(message<T>& msg, const std::vector<uint8_t>& data) {
-        size_t i = msg.body.size();
-        msg.body.resize(msg.body.size() + data.size());
-        std::memcpy(msg.body.data() + i, data.data(), data.size());
-        msg.header.size = (uint32_t)msg.size();
+        msg.push_bytes(data.data(), data.size());
         return msg;
     }
 
@@ -66,18 +66,37 @@ struct message {
     friend message<T>& operator>>(message<T>& msg, DataType& data) {
         static_assert(std::is_standard_layout<DataType>::value, "Data is too complex to be pulled from vector");
 
-        if (msg.body.size() < sizeof(DataType)) {
-            throw std::runtime_error("Message body too small for pop: " + std::to_string(msg.body.size()) + " < " +
-                                     std::to_string(sizeof(DataType)));
-        }
+        msg.pop_bytes(reinterpret_cast<uint8_t*>(&data), sizeof(DataType));
+        return msg;
+    }
 
-        size_t i = msg.body.size() - sizeof(DataType);
+    /**
+        A function to append raw bytes in one go, without filling the new room first
+        @param data bytes to append
+        @param count number of bytes
+    */
+    void push_bytes(const uint8_t* data, size_t count) {
+        body.insert(body.end(), data, data + count);
+        header.size = (uint32_t)size();
+    }
 
-        std::memcpy(&data, msg.body.data() + i, sizeof(DataType));
-        msg.body.resize(i);
-        msg.header.size = (uint32_t)msg.size();
+    /**
+        A function to pop the last bytes pushed in one go, they keep their order
+        @param out receives the bytes
+        @param count number of bytes
+    */
+    void pop_bytes(uint8_t* out, size_t count) {
+        if (body.size() < count) {
+            throw std::runtime_error("Message body too small for pop: " + std::to_string(body.size()) + " < " +
+                                     std::to_string(count));
+        }
 
-        return msg;
+        size_t i = body.size() - count;
+
+        if (count > 0)
+            std::memcpy(out, body.data() + i, count);
+        body.resize(i);
+        header.size = (uint32_t)size();
     }
 
     void to_little_endian() {
@@ -112,6 +131,82 @@ struct message {
     }
 };
 
+/**
+ * @brief Appends values to a message body sized once up front.
+ *
+ * Writes in the same order as operator<<, so the usual operator>> reads them
+ * back, but a packet made of many values only reallocates the body once.
+ */
+template <typename T>
+class MessageWriter {
+   public:
+    /**
+        @param msg message to append to
+        @param size number of bytes the writes will add, used to reserve the body once
+    */
+    MessageWriter(message<T>& msg, size_t size) : _msg(msg) { msg.body.reserve(msg.body.size() + size); }
+
+    template <typename DataType>
+    MessageWriter& operator<<(const DataType& data) {
+        static_assert(std::is_standard_layout<DataType>::value, "Data is too complex to be pushed into vector");
+
+        _msg.push_bytes(reinterpret_cast<const uint8_t*>(&data), sizeof(DataType));
+        return *this;
+    }
+
+    MessageWriter& write(const uint8_t* data, size_t size) {
+        _msg.push_bytes(data, size);
+        return *this;
+    }
+
+   private:
+    message<T>& _msg;
+};
+
+/**
+ * @brief Pops values from a message without modifying it.
+ *
+ * Reads in the same order as operator>>, from the end of the body, but only
+ * moves a cursor: there is no need to copy a message to peek at it.
+ */
+template <typename T>
+class MessageReader {
+   public:
+    explicit MessageReader(const message<T>& msg) : _data(msg.body.data()), _remaining(msg.body.size()) {}
+
+    template <typename DataType>
+    MessageReader& operator>>(DataType& data) {
+        static_assert(std::is_standard_layout<DataType>::value, "Data is too complex to be pulled from vector");
+
+        return read(reinterpret_cast<uint8_t*>(&data), sizeof(DataType));
+    }
+
+    /**
+        A function to pop the next bytes in one go, they keep the order they were pushed in
+        @param out receives the bytes
+        @param size number of bytes
+    */
+    MessageReader& read(uint8_t* out, size_t size) {
+        if (_remaining < size) {
+            throw std::runtime_error("Message body too small for pop: " + std::to_string(_remaining) + " < " +
+                                     std::to_string(size));
+        }
+        _remaining -= size;
+        if (size > 0)
+            std::memcpy(out, _data + _remaining, size);
+        return *this;
+    }
+
+    // Drops what is left, for readers giving up on a malformed message
+    void clear() { _remaining = 0; }
+
+    size_t remaining() const { return _remaining; }
+
+   private:
+    const uint8_t* _data;
+    size_t _remaining;
+};
+
 template <typename T>
 class Connection;
 
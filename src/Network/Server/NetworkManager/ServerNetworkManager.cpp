@@ -12,24 +12,26 @@ ServerNetworkManager::ServerNetworkManager() {
 
 void ServerNetworkManager::initializeValidClientEvents() {
     // Events that the server expects to RECEIVE from clients (C_...)
-    _validClientEvents = {C_PING_SERVER, C_REGISTER,    C_LOGIN,       C_LOGIN_TOKEN, C_LOGIN_ANONYMOUS,
-                          C_DISCONNECT,  C_CONFIRM_UDP, C_LIST_ROOMS,  C_JOIN_ROOM,   C_JOINT_RANDOM_LOBBY,
-                          C_ROOM_LEAVE,  C_NEW_LOBBY,   C_READY,       C_GAME_START,  C_CANCEL_READY,
-                          C_INPUT,       C_TEAM_CHAT,   C_VOICE_PACKET};
+    _validClientEvents = {C_PING_SERVER, C_REGISTER,      C_LOGIN,       C_LOGIN_TOKEN,  C_LOGIN_ANONYMOUS,
+                          C_DISCONNECT,  C_CONFIRM_UDP,   C_LIST_ROOMS,  C_JOIN_ROOM,    C_JOINT_RANDOM_LOBBY,
+                          C_ROOM_LEAVE,  C_NEW_LOBBY,     C_READY,       C_GAME_START,   C_CANCEL_READY,
+                          C_INPUT,       C_INPUT_ACTIONS, C_TEAM_CHAT,   C_VOICE_PACKET, C_SNAPSHOT_ACK,
+                          C_FULL_STATE_ACK, C_FULL_STATE_RESEND};
 }
 
 void ServerNetworkManager::initializeTcpEvents() {
     // Events that the server SENDS via TCP (S_...)
-    _tcpEvents = {S_REGISTER_OK, S_LOGIN_OK, S_LOGIN_KO, S_ROOMS_LIST, S_ROOM_JOINED, S_ROOM_NOT_JOINED,
+    _tcpEvents = {S_REGISTER_OK, S_REGISTER_KO, S_LOGIN_OK, S_LOGIN_KO, S_ROOMS_LIST, S_ROOM_JOINED, S_ROOM_NOT_JOINED,
                   S_CONFIRM_NEW_LOBBY, S_PLAYER_JOINED,
                   // S_ROOM_INFO, // Doesn't seem to exist in Network.hpp
                   S_ROOM_LEAVE, S_READY_RETURN, S_CANCEL_READY_BROADCAST, S_GAME_START, S_SEND_ID, S_CONFIRM_UDP,
-                  S_TEAM_CHAT, S_RETURN_TO_LOBBY, S_GAME_OVER, S_PLAYER_DEATH};
+                  S_TEAM_CHAT, S_RETURN_TO_LOBBY, S_GAME_OVER, S_PLAYER_DEATH, S_FULL_STATE_CHUNK,
+                  S_ANIMATION_SET};
 }
 
 void ServerNetworkManager::initializeUdpEvents() {
     // Events that the server SENDS via UDP (S_...)
-    _udpEvents = {S_SNAPSHOT, S_VOICE_RELAY};
+    _udpEvents = {S_SNAPSHOT, S_SNAPSHOT_BATCH, S_VOICE_RELAY};
 }
 
 void ServerNetworkManager::initializePayloadConstraints() {
@@ -43,7 +45,11 @@ void ServerNetworkManager::initializePayloadConstraints() {
     _payloadConstraints[C_NEW_LOBBY] = {sizeof(uint32_t) + 1, 128};  // Lobby name
     _payloadConstraints[C_READY] = {sizeof(uint32_t), sizeof(uint32_t)};
     _payloadConstraints[C_CANCEL_READY] = {sizeof(uint32_t), sizeof(uint32_t)};
-    _payloadConstraints[C_INPUT] = {sizeof(bool) + sizeof(uint32_t) + 1, 256};
+    // [masks][uint8 count][uint32 tick], 4 redundant ticks max
+    _payloadConstraints[C_INPUT] = {sizeof(uint8_t) + sizeof(uint32_t),
+                                    sizeof(uint8_t) + sizeof(uint32_t) + 4 * sizeof(uint32_t)};
+    // [name][uint16 size] per action then [uint8 count][uint8 first id], 32 actions of 256 characters max
+    _payloadConstraints[C_INPUT_ACTIONS] = {2 * sizeof(uint8_t), 2 * sizeof(uint8_t) + 32 * (sizeof(uint16_t) + 256)};
     _payloadConstraints[C_CONFIRM_UDP] = {sizeof(uint32_t), sizeof(uint32_t)};  // Usually just sends ID or 0
     _payloadConstraints[C_PING_SERVER] = {0, 64};
     _payloadConstraints[C_DISCONNECT] = {0, 0};
@@ -51,6 +57,11 @@ void ServerNetworkManager::initializePayloadConstraints() {
     _payloadConstraints[C_GAME_START] = {0, sizeof(uint32_t)};
     _payloadConstraints[C_TEAM_CHAT] = {sizeof(uint32_t) + 1, 1024};
     _payloadConstraints[C_VOICE_PACKET] = {1, 8192};
+    _payloadConstraints[C_SNAPSHOT_ACK] = {
+        sizeof(uint8_t) + sizeof(uint16_t),
+        sizeof(uint8_t) + sizeof(uint16_t) + network::MAX_SNAPSHOT_ACKS * sizeof(uint32_t)};
+    _payloadConstraints[C_FULL_STATE_ACK] = {sizeof(uint32_t), sizeof(uint32_t)};  // Bytes of the world received
+    _payloadConstraints[C_FULL_STATE_RESEND] = {sizeof(uint32_t), sizeof(uint32_t)};  // Sequence of the dropped world
 }
 
 bool ServerNetworkManager::isValidClientEvent(network::GameEvents event) const {
@@ -1,5 +1,6 @@
 #include "Server.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -42,8 +43,8 @@ void Server::OnMessage(std::shared_ptr<Connection<GameEvents>> client, message<G
             OnClientNewLobby(client, msg);
             break;
         case GameEvents::C_CONFIRM_UDP:
-            if (_clientStates[client] == ClientState::WAITING_UDP_PING)
-                _clientStates[client] = ClientState::CONNECTED;
+            if (_clientStates[client->GetID()] == ClientState::WAITING_UDP_PING)
+                _clientStates[client->GetID()] = ClientState::CONNECTED;
             // Also forward to game engine so it can send the full game state
             _toGameMessages.push({msg.header.id, client->GetID(), msg});
             break;
@@ -73,12 +74,17 @@ void Server::OnClientDisconnect(std::shared_ptr<Connection<GameEvents>> client)
     uint32_t clientId = client->GetID();
 
     // Check if client is in our state map (avoid double processing)
-    if (_clientStates.find(client) == _clientStates.end()) {
+    if (_clientStates.find(clientId) == _clientStates.end()) {
         return;
     }
 
     // Remove from state map first to prevent re-entry
-    _clientStates.erase(client);
+    _clientStates.erase(clientId);
+    _clientUsernames.erase(clientId);
+    {
+        std::lock_guard<std::mutex> lock(_userIdsMutex);
+        _clientUserIds.erase(clientId);
+    }
 
     // Remove player from lobby if they were in one
     uint32_t lobbyToDelete = 0;
@@ -136,14 +142,14 @@ bool Server::OnClientConnect(std::shared_ptr<Connection<GameEvents>> client) {
     client->SetTimeout(0);
 
     AddMessageToPlayer(GameEvents::S_SEND_ID, client->GetID(), client->GetID());
+    AddMessageToPlayer(GameEvents::S_CONFIRM_UDP, client->GetID(), client->GetID());
     network::message<GameEvents> msg;
     msg << client->GetID();
-    AddMessageToPlayer(GameEvents::S_CONFIRM_UDP, client->GetID(), msg);
 
     msg.header.user_id = client->GetID();
     _toGameMessages.push({GameEvents::C_CONNECTION, client->GetID(), msg});
 
-    _clientStates[client] = ClientState::WAITING_UDP_PING;
+    _clientStates[client->GetID()] = ClientState::WAITING_UDP_PING;
     return true;
 }
 
@@ -156,84 +162,146 @@ coming_message Server::ReadIncomingMessage() {
     return message;
 }
 
+void Server::PollDatabase() {
+    _databaseReplies.erase(std::remove_if(_databaseReplies.begin(), _databaseReplies.end(),
+                                          [](std::function<bool()>& reply) { return reply(); }),
+                           _databaseReplies.end());
+}
+
+void Server::SaveScores(const std::vector<std::tuple<uint32_t, int, bool>>& scores) {
+    std::lock_guard<std::mutex> lock(_userIdsMutex);
+
+    for (const auto& [clientId, score, alive] : scores) {
+        auto user = _clientUserIds.find(clientId);
+        if (user != _clientUserIds.end())
+            _database.UpdateScore(user->second, score);
+    }
+}
+
+void Server::SetUserId(uint32_t clientId, int userId) {
+    std::lock_guard<std::mutex> lock(_userIdsMutex);
+    _clientUserIds[clientId] = userId;
+}
+
 void Server::OnClientRegister(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
     connection_info info;
     msg >> info;
 
-    if (_clientStates[client] != ClientState::CONNECTED) {
+    if (_clientStates[client->GetID()] != ClientState::CONNECTED) {
         AddMessageToPlayer(GameEvents::ASK_UDP, client->GetID(), NULL);
         return;
     }
-    _database.RegisterUser(info.username, info.password);
-
-    std::string tokenStr = "";
-    const std::string charset = ALPHA_NUMERIC;
-    srand(time(nullptr) + client->GetID());
-    for (int i = 0; i < 10; i++) {
-        tokenStr += charset[rand() % charset.length()];
-    }
-    _database.SaveToken(_database.LoginUser(info.username, info.password), tokenStr);
+    std::string username(info.username, strnlen(info.username, sizeof(info.username)));
+    std::string password(info.password, strnlen(info.password, sizeof(info.password)));
 
-    _clientUsernames[client] = info.username;
-    _clientStates[client] = ClientState::LOGGED_IN;
+    // Hashing the password takes a while, it is done with the query on the database thread
+    auto registered = _database.Submit([username, password](Database& db) {
+        int userID = db.RegisterUser(username, password);
+        std::string tokenStr;
 
-    char token[32] = {0};
-    std::strncpy(token, tokenStr.c_str(), 31);
-    AddMessageToPlayer(GameEvents::S_REGISTER_OK, client->GetID(), token);
+        if (userID != -1) {
+            tokenStr = credentials::GenerateToken();
+            db.SaveToken(userID, tokenStr);
+        }
+        return std::make_pair(userID, tokenStr);
+    });
+    WhenDatabaseDone(std::move(registered),
+                     [this, clientId = client->GetID(), username](std::pair<int, std::string> user) {
+                         if (!AwaitsLogin(clientId))
+                             return;
+                         if (user.first == -1) {
+                             AddMessageToPlayer(GameEvents::S_REGISTER_KO, clientId, NULL);
+                             return;
+                         }
+
+                         char token[32] = {0};
+                         std::strncpy(token, user.second.c_str(), 31);
+
+                         SetUserId(clientId, user.first);
+                         _clientUsernames[clientId] = username;
+                         _clientStates[clientId] = ClientState::LOGGED_IN;
+                         AddMessageToPlayer(GameEvents::S_REGISTER_OK, clientId, token);
+                     });
 }
 
 void Server::OnClientLogin(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
     connection_info info;
     msg >> info;
 
-    if (_clientStates[client] != ClientState::CONNECTED) {
+    if (_clientStates[client->GetID()] != ClientState::CONNECTED) {
         AddMessageToPlayer(GameEvents::ASK_UDP, client->GetID(), NULL);
         return;
     }
-    int userID = _database.LoginUser(info.username, info.password);
-    if (userID == -1) {
-        AddMessageToPlayer(GameEvents::S_LOGIN_KO, client->GetID(), NULL);
-        return;
-    }
+    std::string username(info.username, strnlen(info.username, sizeof(info.username)));
+    std::string password(info.password, strnlen(info.password, sizeof(info.password)));
 
-    std::string tokenStr = _database.GetTokenById(userID);
-    char token[32] = {0};
-    std::strncpy(token, tokenStr.c_str(), 31);
+    // Only the hash of a token is stored, each login hands out a new one
+    auto login = _database.Submit([username, password](Database& db) {
+        int userID = db.LoginUser(username, password);
+        std::string tokenStr;
 
-    _clientUsernames[client] = info.username;
-    _clientStates[client] = ClientState::LOGGED_IN;
-    AddMessageToPlayer(GameEvents::S_LOGIN_OK, client->GetID(), token);
+        if (userID != -1) {
+            tokenStr = credentials::GenerateToken();
+            db.SaveToken(userID, tokenStr);
+        }
+        return std::make_pair(userID, tokenStr);
+    });
+    WhenDatabaseDone(std::move(login), [this, clientId = client->GetID(), username](std::pair<int, std::string> user) {
+        if (!AwaitsLogin(clientId))
+            return;
+        if (user.first == -1) {
+            AddMessageToPlayer(GameEvents::S_LOGIN_KO, clientId, NULL);
+            return;
+        }
+
+        char token[32] = {0};
+        std::strncpy(token, user.second.c_str(), 31);
+
+        SetUserId(clientId, user.first);
+        _clientUsernames[clientId] = username;
+        _clientStates[clientId] = ClientState::LOGGED_IN;
+        AddMessageToPlayer(GameEvents::S_LOGIN_OK, clientId, token);
+    });
 }
 
 void Server::OnClientLoginToken(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
     char token[32];
     msg >> token;
-    std::string tokenStr(token);
+    std::string tokenStr(token, strnlen(token, sizeof(token)));
 
-    if (_clientStates[client] != ClientState::CONNECTED) {
+    if (_clientStates[client->GetID()] != ClientState::CONNECTED) {
         AddMessageToPlayer(GameEvents::ASK_UDP, client->GetID(), NULL);
         return;
     }
-    int userID = _database.GetUserByToken(tokenStr);
-    if (userID == -1) {
-        AddMessageToPlayer(GameEvents::S_INVALID_TOKEN, client->GetID(), NULL);
-        return;
-    }
 
-    _clientUsernames[client] = _database.GetNameById(userID);
-    _clientStates[client] = ClientState::LOGGED_IN;
-    AddMessageToPlayer(GameEvents::S_LOGIN_OK, client->GetID(), NULL);
+    auto login = _database.Submit([tokenStr](Database& db) {
+        int userID = db.GetUserByToken(tokenStr);
+        return std::make_pair(userID, userID == -1 ? std::string() : db.GetNameById(userID));
+    });
+    WhenDatabaseDone(std::move(login), [this, clientId = client->GetID()](std::pair<int, std::string> user) {
+        if (!AwaitsLogin(clientId))
+            return;
+        if (user.first == -1) {
+            AddMessageToPlayer(GameEvents::S_INVALID_TOKEN, clientId, NULL);
+            return;
+        }
+
+        SetUserId(clientId, user.first);
+        _clientUsernames[clientId] = user.second;
+        _clientStates[clientId] = ClientState::LOGGED_IN;
+        AddMessageToPlayer(GameEvents::S_LOGIN_OK, clientId, NULL);
+    });
 }
 
 void Server::OnClientLoginAnonymous(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::CONNECTED) {
+    if (_clientStates[client->GetID()] != ClientState::CONNECTED) {
         AddMessageToPlayer(GameEvents::ASK_UDP, client->GetID(), NULL);
         return;
     }
 
     std::string guestName = "Guest_" + std::to_string(client->GetID());
-    _clientUsernames[client] = guestName;
-    _clientStates[client] = ClientState::LOGGED_IN;
+    _clientUsernames[client->GetID()] = guestName;
+    _clientStates[client->GetID()] = ClientState::LOGGED_IN;
 
     // Send empty token
     char token[32] = {0};
@@ -241,7 +309,7 @@ void Server::OnClientLoginAnonymous(std::shared_ptr<Connection<GameEvents>> clie
 }
 
 void Server::OnClientListLobby(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::LOGGED_IN) {
+    if (_clientStates[client->GetID()] != ClientState::LOGGED_IN) {
         AddMessageToPlayer(GameEvents::ASK_LOG, client->GetID(), NULL);
         return;
     }
@@ -272,7 +340,7 @@ void Server::OnClientListLobby(std::shared_ptr<Connection<GameEvents>> client, m
 }
 
 void Server::OnClientJoinLobby(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::LOGGED_IN) {
+    if (_clientStates[client->GetID()] != ClientState::LOGGED_IN) {
         AddMessageToPlayer(GameEvents::ASK_LOG, client->GetID(), NULL);
         return;
     }
@@ -289,7 +357,7 @@ void Server::OnClientJoinLobby(std::shared_ptr<Connection<GameEvents>> client, m
             // ECRIT LE COMMENTAIRE BORIS JE VAIS TE HAGAR)
             struct player p;
             p.id = client->GetID();
-            std::strncpy(p.username, _clientUsernames[client].c_str(), 32);
+            std::strncpy(p.username, _clientUsernames[client->GetID()].c_str(), 32);
             AddMessageToLobby(GameEvents::S_PLAYER_JOINED, lobbyID, p);
 
             // envoyer le message de room joined au joueur (azy j'ai plus besoin de parler)
@@ -307,13 +375,13 @@ void Server::OnClientJoinLobby(std::shared_ptr<Connection<GameEvents>> client, m
                 if (connection != client) {
                     struct player existingPlayer;
                     existingPlayer.id = id;
-                    std::strncpy(existingPlayer.username, _clientUsernames[connection].c_str(), 32);
+                    std::strncpy(existingPlayer.username, _clientUsernames[connection->GetID()].c_str(), 32);
                     AddMessageToPlayer(GameEvents::S_PLAYER_JOINED, client->GetID(), existingPlayer);
                 }
             }
             AddMessageToPlayer(GameEvents::S_ROOM_JOINED, client->GetID(), info);
 
-            _clientStates[client] = ClientState::IN_LOBBY;
+            _clientStates[client->GetID()] = ClientState::IN_LOBBY;
             BroadcastLobbyList();
             // Create a new message with lobby info for the game engine
             message<GameEvents> gameMsg;
@@ -328,7 +396,7 @@ void Server::OnClientJoinLobby(std::shared_ptr<Connection<GameEvents>> client, m
 }
 
 void Server::OnClientJoinRandomLobby(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::LOGGED_IN) {
+    if (_clientStates[client->GetID()] != ClientState::LOGGED_IN) {
         AddMessageToPlayer(GameEvents::ASK_LOG, client->GetID(), NULL);
         return;
     }
@@ -338,7 +406,7 @@ void Server::OnClientJoinRandomLobby(std::shared_ptr<Connection<GameEvents>> cli
             // ECRIT LE COMMENTAIRE BORIS JE VAIS TE HAGAR)
             struct player p;
             p.id = client->GetID();
-            std::strncpy(p.username, _clientUsernames[client].c_str(), 32);
+            std::strncpy(p.username, _clientUsernames[client->GetID()].c_str(), 32);
             AddMessageToLobby(GameEvents::S_PLAYER_JOINED, lobby.GetID(), p);
 
             // envoyer le message de room joined au joueur (azy j'ai plus besoin de parler)
@@ -356,7 +424,7 @@ void Server::OnClientJoinRandomLobby(std::shared_ptr<Connection<GameEvents>> cli
 
             AddMessageToPlayer(GameEvents::S_ROOM_JOINED, client->GetID(), info);
 
-            _clientStates[client] = ClientState::IN_LOBBY;
+            _clientStates[client->GetID()] = ClientState::IN_LOBBY;
             BroadcastLobbyList();  // Broadcast updated state
             // Create a new message with lobby info for the game engine
             message<GameEvents> return_msg;
@@ -370,13 +438,13 @@ void Server::OnClientJoinRandomLobby(std::shared_ptr<Connection<GameEvents>> cli
     AddMessageToPlayer(GameEvents::S_ROOM_NOT_JOINED, client->GetID(), NULL);
 }
 void Server::OnClientLeaveLobby(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::IN_LOBBY)
+    if (_clientStates[client->GetID()] != ClientState::IN_LOBBY)
         return;
     for (Lobby<GameEvents>& lobby : _lobbys) {
         auto mapPlayers = lobby.getLobbyPlayers();
         uint32_t lobbyID;
         if (lobby.HasPlayer(client->GetID())) {
-            _clientStates[client] = ClientState::LOGGED_IN;
+            _clientStates[client->GetID()] = ClientState::LOGGED_IN;
             lobbyID = lobby.GetID();
             AddMessageToPlayer(GameEvents::S_ROOM_LEAVE, client->GetID(), NULL);
             if (mapPlayers[client->GetID()] == lobby.getOwner()) {
@@ -411,7 +479,7 @@ void Server::OnClientLeaveLobby(std::shared_ptr<Connection<GameEvents>> client,
 }
 
 void Server::OnClientNewLobby(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::LOGGED_IN) {
+    if (_clientStates[client->GetID()] != ClientState::LOGGED_IN) {
         return;
     }
 
@@ -429,7 +497,7 @@ void Server::OnClientNewLobby(std::shared_ptr<Connection<GameEvents>> client, me
     Lobby<GameEvents> newLobby(nLobbyIDCounter++, lobbyName);
     newLobby.AddPlayer(client);
     _lobbys.push_back(newLobby);
-    _clientStates[client] = ClientState::IN_LOBBY;
+    _clientStates[client->GetID()] = ClientState::IN_LOBBY;
 
     // Send confirmation
     char lobbyNameBuff[32] = {0};
@@ -439,7 +507,7 @@ void Server::OnClientNewLobby(std::shared_ptr<Connection<GameEvents>> client, me
     // Send S_PLAYER_JOINED to host so they appear in their own player list
     struct player hostPlayer;
     hostPlayer.id = client->GetID();
-    std::strncpy(hostPlayer.username, _clientUsernames[client].c_str(), 32);
+    std::strncpy(hostPlayer.username, _clientUsernames[client->GetID()].c_str(), 32);
     AddMessageToPlayer(GameEvents::S_PLAYER_JOINED, client->GetID(), hostPlayer);
 
     // Also notify game engine about the new lobby
@@ -474,15 +542,16 @@ void Server::BroadcastLobbyList() {
     }
     listMsg << nb_lobbys;
 
-    for (auto& [client, state] : _clientStates) {
+    for (auto& [id, state] : _clientStates) {
+        auto client = GetConnection(id);
         if (client && client->IsConnected()) {
-            MessageClient(client, listMsg);
+            client->Send(listMsg);
         }
     }
 }
 
 void Server::onClientStartGame(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::READY) {
+    if (_clientStates[client->GetID()] != ClientState::READY) {
         return;
     }
     for (Lobby<GameEvents>& lobby : _lobbys) {
@@ -493,7 +562,7 @@ void Server::onClientStartGame(std::shared_ptr<Connection<GameEvents>> client, m
             }
             // Check all players ready
             for (auto& [id, connection] : lobby.getLobbyPlayers()) {
-                if (_clientStates[connection] != ClientState::READY) {
+                if (_clientStates[connection->GetID()] != ClientState::READY) {
                     AddMessageToPlayer(GameEvents::S_GAME_START_KO, client->GetID(), NULL);
                     return;
                 }
@@ -505,7 +574,7 @@ void Server::onClientStartGame(std::shared_ptr<Connection<GameEvents>> client, m
             _toGameMessages.push({GameEvents::S_GAME_START, client->GetID(), msg});
 
             for (auto& [id, connection] : lobby.getLobbyPlayers()) {
-                _clientStates[connection] = ClientState::IN_GAME;
+                _clientStates[connection->GetID()] = ClientState::IN_GAME;
                 connection->SetTimeout(_timeout_seconds);
             }
             AddMessageToLobby(GameEvents::S_GAME_START, lobby.GetID(), NULL);
@@ -515,11 +584,11 @@ void Server::onClientStartGame(std::shared_ptr<Connection<GameEvents>> client, m
 }
 
 void Server::onClientReadyUp(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::IN_LOBBY)
+    if (_clientStates[client->GetID()] != ClientState::IN_LOBBY)
         return;
     for (Lobby<GameEvents>& lobby : _lobbys) {
         if (lobby.HasPlayer(client->GetID())) {
-            _clientStates[client] = ClientState::READY;
+            _clientStates[client->GetID()] = ClientState::READY;
             AddMessageToLobby(GameEvents::S_READY_RETURN, lobby.GetID(), client->GetID());
 
             _toGameMessages.push({GameEvents::C_READY, client->GetID(), msg});
@@ -529,11 +598,11 @@ void Server::onClientReadyUp(std::shared_ptr<Connection<GameEvents>> client, mes
 }
 
 void Server::onClientUnready(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::READY)
+    if (_clientStates[client->GetID()] != ClientState::READY)
         return;
     for (Lobby<GameEvents>& lobby : _lobbys) {
         if (lobby.HasPlayer(client->GetID())) {
-            _clientStates[client] = ClientState::IN_LOBBY;
+            _clientStates[client->GetID()] = ClientState::IN_LOBBY;
             AddMessageToLobby(GameEvents::S_CANCEL_READY_BROADCAST, lobby.GetID(), client->GetID());
 
             _toGameMessages.push({GameEvents::C_CANCEL_READY, client->GetID(), msg});
@@ -543,7 +612,7 @@ void Server::onClientUnready(std::shared_ptr<Connection<GameEvents>> client, mes
 }
 
 void Server::onClientSendText(std::shared_ptr<Connection<GameEvents>> client, message<GameEvents> msg) {
-    if (_clientStates[client] != ClientState::IN_LOBBY && _clientStates[client] != ClientState::READY)
+    if (_clientStates[client->GetID()] != ClientState::IN_LOBBY && _clientStates[client->GetID()] != ClientState::READY)
         return;
 
     // Extract message text from the incoming message
@@ -564,7 +633,7 @@ void Server::onClientSendText(std::shared_ptr<Connection<GameEvents>> client, me
             // Create chat_message struct with sender info and message
             chat_message chatMsg;
             chatMsg.sender_id = client->GetID();
-            std::strncpy(chatMsg.sender_name, _clientUsernames[client].c_str(), 31);
+            std::strncpy(chatMsg.sender_name, _clientUsernames[client->GetID()].c_str(), 31);
             chatMsg.sender_name[31] = '\0';
             std::strncpy(chatMsg.message, messageText, 255);
             chatMsg.message[255] = '\0';
@@ -593,14 +662,14 @@ void Server::onClientVoicePacket(std::shared_ptr<Connection<GameEvents>> client,
             // Relay to all other players in the lobby
             static uint32_t relayCount = 0;
             int relayedTo = 0;
-            for (auto& otherClient : _deqConnections) {
-                if (otherClient && otherClient->GetID() != client->GetID() && lobby.HasPlayer(otherClient->GetID())) {
+            for (auto& [otherId, otherClient] : lobby.getLobbyPlayers()) {
+                if (otherClient && otherId != client->GetID() && otherClient->IsConnected()) {
                     message<GameEvents> relayMsg;
                     relayMsg.header.id = GameEvents::S_VOICE_RELAY;
                     relayMsg.body.resize(sizeof(voice_packet));
                     std::memcpy(relayMsg.body.data(), &voiceData, sizeof(voice_packet));
                     relayMsg.header.size = static_cast<uint32_t>(relayMsg.size());
-                    MessageClient(otherClient, relayMsg);
+                    otherClient->Send(relayMsg);
                     relayedTo++;
                 }
             }
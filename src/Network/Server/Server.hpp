@@ -1,6 +1,11 @@
 #pragma once
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -12,7 +17,6 @@
 #include "NetworkManager/ServerNetworkManager.hpp"
 
 #define DATABASE_FILE "rtype.db"
-#define ALPHA_NUMERIC "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
 
 #define MAX_PLAYERS 20
 
@@ -66,56 +70,43 @@ class Server : public network::ServerInterface<GameEvents> {
     void setTimeout(int timeout) { _timeout_seconds = timeout; };
     void BroadcastLobbyList();
 
-    template <typename T>
-    void AddMessageToPlayer(GameEvents event, uint32_t id, const T& data) {
-        for (std::shared_ptr<network::Connection<GameEvents>>& client : _deqConnections) {
-            if (client->GetID() == id) {
-                if (event == GameEvents::S_RETURN_TO_LOBBY) {
-                    _clientStates[client] = ClientState::IN_LOBBY;
-                    client->SetTimeout(0);
-                    return;
-                }
-                network::message<GameEvents> msg;
-                msg << data;
-                msg.header.id = event;
-                msg.header.size = msg.size();
-
-                if (event == GameEvents::S_PLAYER_JOINED) {
-                    std::cout << "[SERVER_DEBUG] Sending S_PLAYER_JOINED to " << id << " (Body: " << msg.size() << ")"
-                              << std::endl;
-                }
+    /**
+        A function to answer the clients whose database queries are done
+        Called by the game thread each tick, after Update
+    */
+    void PollDatabase();
 
-                if (_networkManager.isUdpEvent(event)) {
-                    MessageClientUDP(client, msg);
-                } else {
-                    MessageClient(client, msg);
-                }
+    /**
+        A function to store the scores of a game that ended, guests are skipped
+        Callable from any thread, the writes go with the next database batch
+        @param scores client id, score and whether the player is alive
+    */
+    void SaveScores(const std::vector<std::tuple<uint32_t, int, bool>>& scores);
 
-                break;
-            }
+    template <typename T>
+    void AddMessageToPlayer(GameEvents event, uint32_t id, const T& data) {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        auto client = GetConnection(id);
+        if (!client)
+            return;
+
+        network::message<GameEvents> msg = AcquireMessage(sizeof(T));
+        MessageWriter<GameEvents>(msg, sizeof(T)) << data;
+        if (event == GameEvents::S_PLAYER_JOINED) {
+            std::cout << "[SERVER_DEBUG] Sending S_PLAYER_JOINED to " << id << " (Body: " << msg.size() << ")"
+                      << std::endl;
         }
+        SendToClient(client, event, std::move(msg));
     }
 
-    void AddMessageToPlayer(GameEvents event, uint32_t id, network::message<GameEvents>& msg) {
-        for (std::shared_ptr<network::Connection<GameEvents>>& client : _deqConnections) {
-            if (client->GetID() == id) {
-                if (event == GameEvents::S_RETURN_TO_LOBBY) {
-                    _clientStates[client] = ClientState::IN_LOBBY;
-                    client->SetTimeout(0);
-                    return;
-                }
-
-                msg.header.id = event;
-                msg.header.size = msg.size();
+    // msg is best taken with AcquireMessage, its body is handed to the connection as is
+    void AddMessageToPlayer(GameEvents event, uint32_t id, network::message<GameEvents>&& msg) {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        auto client = GetConnection(id);
+        if (!client)
+            return;
 
-                if (_networkManager.isUdpEvent(event)) {
-                    MessageClientUDP(client, msg);
-                } else {
-                    MessageClient(client, msg);
-                }
-                break;
-            }
-        }
+        SendToClient(client, event, std::move(msg));
     }
 
     template <typename T>
@@ -124,31 +115,91 @@ class Server : public network::ServerInterface<GameEvents> {
             if (lobby.GetID() == id_lobby) {
                 if (event == GameEvents::S_RETURN_TO_LOBBY) {
                     lobby.SetState(Lobby<GameEvents>::State::WAITING_FOR_PLAYERS);
-                    for (auto& [id, client] : lobby.getLobbyPlayers()) {
-                        _clientStates[client] = ClientState::IN_LOBBY;
-                        client->SetTimeout(0);
-                    }
                 }
+
+                // The lobby already holds its members' connections, the message is built once for all of them
+                network::message<GameEvents> msg = AcquireMessage(sizeof(T));
+                MessageWriter<GameEvents>(msg, sizeof(T)) << data;
+
+                std::lock_guard<std::mutex> lock(_sendMutex);
+                std::size_t left = lobby.getLobbyPlayers().size();
                 for (auto& [id, client] : lobby.getLobbyPlayers()) {
-                    AddMessageToPlayer(event, id, data);
+                    // The last member takes the built message, the others a pooled copy of it
+                    SendToClient(client, event, --left == 0 ? std::move(msg) : PooledCopy(msg));
                 }
                 break;
             }
         }
     }
 
+   private:
+    // The reply runs on the game thread in PollDatabase, once the query is done
+    template <typename Result, typename Reply>
+    void WhenDatabaseDone(std::future<Result> result, Reply reply) {
+        auto shared = std::make_shared<std::future<Result>>(std::move(result));
+
+        _databaseReplies.push_back([shared, reply]() mutable {
+            if (shared->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            reply(shared->get());
+            return true;
+        });
+    }
+
+    // A client may have left or logged in another way while its query ran
+    bool AwaitsLogin(uint32_t clientId) const {
+        auto state = _clientStates.find(clientId);
+        return state != _clientStates.end() && state->second == ClientState::CONNECTED;
+    }
+
+    void SetUserId(uint32_t clientId, int userId);
+
+    // A copy for one more recipient, in a body from the pool
+    network::message<GameEvents> PooledCopy(const network::message<GameEvents>& msg) {
+        network::message<GameEvents> copy = AcquireMessage(msg.size());
+        MessageWriter<GameEvents>(copy, msg.size()).write(msg.body.data(), msg.size());
+        return copy;
+    }
+
+    // Caller holds _sendMutex. A dropped connection is skipped, Update reports it once the game thread gets there
+    void SendToClient(const std::shared_ptr<network::Connection<GameEvents>>& client, GameEvents event,
+                      network::message<GameEvents>&& msg) {
+        if (event == GameEvents::S_RETURN_TO_LOBBY) {
+            _clientStates[client->GetID()] = ClientState::IN_LOBBY;
+            client->SetTimeout(0);
+            return;
+        }
+        if (!client->IsConnected())
+            return;
+
+        msg.header.id = event;
+        msg.header.size = msg.size();
+
+        if (_networkManager.isUdpEvent(event)) {
+            client->SendUdp(std::move(msg));
+        } else {
+            client->Send(std::move(msg));
+        }
+    }
+
    private:
     int _maxConnections = MAX_PLAYERS;
 
     std::vector<Lobby<GameEvents>> _lobbys;
-    std::unordered_map<std::shared_ptr<network::Connection<GameEvents>>, ClientState> _clientStates;
-    std::unordered_map<std::shared_ptr<network::Connection<GameEvents>>, std::string> _clientUsernames;
+    // Keyed by connection id, the connection itself is found with GetConnection
+    std::unordered_map<uint32_t, ClientState> _clientStates;
+    std::unordered_map<uint32_t, std::string> _clientUsernames;
 
     ServerNetworkManager _networkManager;
+    std::mutex _sendMutex;  // The lobby worlds send their updates from their own threads
 
     std::queue<coming_message> _toGameMessages;
 
     Database _database{DATABASE_FILE};
+    std::vector<std::function<bool()>> _databaseReplies;
+    // Database id of the logged in clients, read by SaveScores from the lobby threads
+    std::unordered_map<uint32_t, int> _clientUserIds;
+    std::mutex _userIdsMutex;
 
     int _timeout_seconds = 30;
     uint32_t nLobbyIDCounter = 1;
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <memory>
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <winsock2.h>
@@ -21,13 +22,18 @@ int main() {
 
     try {
         ServerGameEngine gameEngine;
-        GameManager gm;
 
-        gameEngine.setInitFunction(
-            [&gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm.init(env, inputs); });
+        for (const char* action : GameManager::INPUT_ACTIONS) {
+            gameEngine.getInputManager().registerAction(action);
+        }
 
-        gameEngine.setLoopFunction(
-            [&gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm.update(env, inputs); });
+        // A GameManager holds the state of one game, every lobby gets its own
+        gameEngine.setGameFactory([]() {
+            auto gm = std::make_shared<GameManager>();
+            return ServerGameEngine::GameFunctions{
+                [gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm->init(env, inputs); },
+                [gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm->update(env, inputs); }};
+        });
 
         return gameEngine.run();
     } catch (const std::exception& e) {
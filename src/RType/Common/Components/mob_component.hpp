@@ -122,8 +122,8 @@ class MobComponentFactory {
         clip.handle = handle;
         clip.frames.emplace_back(config.sprite_x.value(), config.sprite_y.value(), config.sprite_w.value(),
                                  config.sprite_h.value());
-        animation.animations.emplace("idle", clip);
-        animation.currentAnimation = "idle";
+        animation.addClip("idle", clip);
+        animation.play("idle");
         animation.layer = static_cast<RenderLayer>(z_index);
         return animation;
     }
@@ -142,29 +142,29 @@ class MobComponentFactory {
         BoxCollisionComponent collision;
         if (!config.collision_tags.empty()) {
             for (const auto& tag : config.collision_tags) {
-                collision.tagCollision.push_back(tag);
+                collision.tagCollision.add(tag);
             }
         } else {
-            collision.tagCollision.push_back(MobDefaults::CollisionTags::FRIENDLY_PROJECTILE);
-            collision.tagCollision.push_back(MobDefaults::CollisionTags::ENEMY_PROJECTILE);
-            collision.tagCollision.push_back(MobDefaults::CollisionTags::PLAYER);
+            collision.tagCollision.add(MobDefaults::CollisionTags::FRIENDLY_PROJECTILE);
+            collision.tagCollision.add(MobDefaults::CollisionTags::ENEMY_PROJECTILE);
+            collision.tagCollision.add(MobDefaults::CollisionTags::PLAYER);
         }
         return collision;
     }
 
     static TagComponent createAITags(const std::vector<std::string>& additional_tags = {}) {
         TagComponent tags;
-        tags.tags.push_back(MobDefaults::EntityTags::AI);
+        tags.tags.add(MobDefaults::EntityTags::AI);
         for (const auto& tag : additional_tags) {
-            tags.tags.push_back(tag);
+            tags.tags.add(tag);
         }
         return tags;
     }
 
     static TagComponent createObstacleTags() {
         TagComponent tags;
-        tags.tags.push_back(MobDefaults::EntityTags::OBSTACLE);
-        tags.tags.push_back(MobDefaults::EntityTags::WALL);
+        tags.tags.add(MobDefaults::EntityTags::OBSTACLE);
+        tags.tags.add(MobDefaults::EntityTags::WALL);
         return tags;
     }
 
@@ -7,26 +7,19 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
-struct SpawnEvent {
-    float trigger_time;
-    std::string enemy_type;
-    float x_position;
-    float y_position;
-    int count;
-    float spacing;
-    std::string formation;
-    float custom_speed;
-    int custom_hp;
-    bool executed;
-};
+// SpawnEvent is defined with the level it is loaded from
+#include "../../../Engine/Core/Scene/LevelArchive.hpp"
+#include "../../../Engine/Core/Scene/LevelConfig.hpp"
 
 struct ScriptedSpawnComponent {
     static constexpr auto name = "ScriptedSpawnComponent";
 
     std::vector<SpawnEvent> spawn_events;
+    std::shared_ptr<const LevelArchive> archive;  // when set, the events are its spawn records instead
     std::string script_path;
     int next_event_index = 0;
     bool all_events_completed = false;
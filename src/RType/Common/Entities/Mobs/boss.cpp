@@ -106,8 +106,8 @@ AnimatedSprite2D createBossAnimatedSprite(const EntityConfig& config, handle_t<T
     clip.handle = handle;
     clip.frames.emplace_back(config.sprite_x.value(), config.sprite_y.value(), config.sprite_w.value(),
                              config.sprite_h.value());
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     animation.layer = static_cast<RenderLayer>(BossDefaults::Sprite::Z_INDEX);
     return animation;
 }
@@ -123,22 +123,22 @@ sprite2D_component_s createBossSprite(const EntityConfig& config, handle_t<Textu
 
 BoxCollisionComponent createBossCollision() {
     BoxCollisionComponent collision;
-    collision.tagCollision.push_back("FRIENDLY_PROJECTILE");
-    collision.tagCollision.push_back("PLAYER");
+    collision.tagCollision.add("FRIENDLY_PROJECTILE");
+    collision.tagCollision.add("PLAYER");
     return collision;
 }
 
 TagComponent createBossTags() {
     TagComponent tags;
-    tags.tags.push_back("AI");
-    tags.tags.push_back("BOSS");
+    tags.tags.add("AI");
+    tags.tags.add("BOSS");
     return tags;
 }
 
 TagComponent createTailTags() {
     TagComponent tags;
-    tags.tags.push_back("BOSS_TAIL");
-    tags.tags.push_back("AI");
+    tags.tags.add("BOSS_TAIL");
+    tags.tags.add("AI");
     return tags;
 }
 
@@ -160,8 +160,8 @@ AnimatedSprite2D createTailAnimatedSprite(handle_t<TextureAsset> handle, const B
     clip.frames.emplace_back(static_cast<int>(tail_config.sprite_x), static_cast<int>(tail_config.sprite_y),
                              static_cast<int>(tail_config.sprite_width), static_cast<int>(tail_config.sprite_height));
     animation.layer = static_cast<RenderLayer>(BossDefaults::Tail::Z_INDEX);
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     return animation;
 }
 
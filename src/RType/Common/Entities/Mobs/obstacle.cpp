@@ -46,8 +46,8 @@ Entity ObstacleSpawner::spawn(Registry& registry, system_context context, float
         static_cast<float>(config.sprite_y.value_or(static_cast<int>(MobDefaults::Obstacle::SPRITE_Y))),
         static_cast<float>(config.sprite_w.value_or(static_cast<int>(MobDefaults::Obstacle::SPRITE_W))),
         static_cast<float>(config.sprite_h.value_or(static_cast<int>(MobDefaults::Obstacle::SPRITE_H))));
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     animation.layer = static_cast<RenderLayer>(MobDefaults::Sprite::Z_INDEX);
     registry.addComponent<AnimatedSprite2D>(id, animation);
 
@@ -104,9 +104,9 @@ Player::Player(ECS& ecs, ResourceManager<TextureAsset>& textures, std::pair<floa
     });
 
     BoxCollisionComponent player_collision;
-    player_collision.tagCollision.push_back("ENEMY_PROJECTILE");
-    player_collision.tagCollision.push_back("AI");
-    player_collision.tagCollision.push_back("OBSTACLE");
+    player_collision.tagCollision.add("ENEMY_PROJECTILE");
+    player_collision.tagCollision.add("AI");
+    player_collision.tagCollision.add("OBSTACLE");
     _ecs.registry.addComponent<BoxCollisionComponent>(_id, player_collision);
 }
 
@@ -10,7 +10,6 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
-#include <unordered_set>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
@@ -260,9 +259,7 @@ void GameManager::update(std::shared_ptr<Environment> env, InputManager& inputs)
                 std::sort(toDestroy.begin(), toDestroy.end());
                 toDestroy.erase(std::unique(toDestroy.begin(), toDestroy.end()), toDestroy.end());
 
-                for (auto e : toDestroy) {
-                    ecs.registry.destroyEntity(e);
-                }
+                ecs.registry.destroyEntities(toDestroy);
                 std::cout << "[GameManager] Cleaned up " << toDestroy.size() << " in-game entities" << std::endl;
             } break;
             default:
@@ -432,29 +429,18 @@ void GameManager::onServerGameStart(std::shared_ptr<Environment> env, const std:
     _leaderboardDisplayed = false;
 
     auto& ecs = env->getECS();
-    std::unordered_set<Entity> entitiesToDestroy;
-
-    auto& lobbyIds = ecs.registry.getEntities<LobbyIdComponent>();
-    for (auto entity : lobbyIds) {
-        if (ecs.registry.hasComponent<LobbyIdComponent>(entity)) {
-            if (ecs.registry.getComponent<LobbyIdComponent>(entity).lobby_id == lobbyId) {
-                entitiesToDestroy.insert(entity);
-            }
-        }
-    }
-
-    auto& spawners = ecs.registry.getEntities<EnemySpawnComponent>();
-    for (auto entity : spawners) {
-        if (ecs.registry.hasComponent<EnemySpawnComponent>(entity)) {
-            if (ecs.registry.getComponent<EnemySpawnComponent>(entity).lobby_id == lobbyId) {
-                entitiesToDestroy.insert(entity);
-            }
-        }
-    }
-
-    for (auto entity : entitiesToDestroy) {
-        ecs.registry.destroyEntity(entity);
-    }
+    std::vector<Entity> entitiesToDestroy;
+
+    // The pools are walked densely, an entity in both is dropped once by destroyEntities
+    ecs.registry.each<const LobbyIdComponent>([&](Entity entity, const LobbyIdComponent& lobby) {
+        if (lobby.lobby_id == lobbyId)
+            entitiesToDestroy.push_back(entity);
+    });
+    ecs.registry.each<const EnemySpawnComponent>([&](Entity entity, const EnemySpawnComponent& spawner) {
+        if (spawner.lobby_id == lobbyId)
+            entitiesToDestroy.push_back(entity);
+    });
+    ecs.registry.destroyEntities(entitiesToDestroy);
 
     LevelConfig level_config;
     try {
@@ -521,6 +507,11 @@ void GameManager::loadLevelFiles() {
 }
 
 void GameManager::loadNextLevel(std::shared_ptr<Environment> env) {
+    static const TagSet ui_tags{"UI", "LEADERBOARD", "VICTORY_TIMER"};
+    static const TagSet kept_tags{"PLAYER", "BACKGROUND", "BOUND"};
+    static const TagSet enemy_tags{"ENEMY", "BOSS"};
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
+    static const TagId projectile_tag = TagRegistry::intern("PROJECTILE");
     auto& ecs = env->getECS();
 
     _victory = false;
@@ -565,10 +556,7 @@ void GameManager::loadNextLevel(std::shared_ptr<Environment> env) {
     for (auto entity : leaderboards) {
         leaderboard_entities.push_back(entity);
     }
-    for (auto entity : leaderboard_entities) {
-        std::cout << "[GameManager] Destroying leaderboard entity " << entity << std::endl;
-        ecs.registry.destroyEntity(entity);
-    }
+    ecs.registry.destroyEntities(leaderboard_entities);
 
     std::vector<Entity> ui_entities_to_destroy;
     auto& all_entities = ecs.registry.getEntities<TagComponent>();
@@ -577,40 +565,25 @@ void GameManager::loadNextLevel(std::shared_ptr<Environment> env) {
         if (!ecs.registry.hasComponent<TagComponent>(entity))
             continue;
         auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-        for (const auto& tag : tags.tags) {
-            if (tag == "UI" || tag == "LEADERBOARD" || tag == "VICTORY_TIMER") {
-                ui_entities_to_destroy.push_back(entity);
-                break;
-            }
+        if (tags.tags.intersects(ui_tags)) {
+            ui_entities_to_destroy.push_back(entity);
         }
     }
 
-    for (auto entity : ui_entities_to_destroy) {
-        ecs.registry.destroyEntity(entity);
-    }
+    ecs.registry.destroyEntities(ui_entities_to_destroy);
 
-    auto spawners = ecs.registry.getEntities<EnemySpawnComponent>();
-    for (auto spawner : spawners) {
-        ecs.registry.destroyEntity(spawner);
-    }
-
-    auto scripted_spawners = ecs.registry.getEntities<ScriptedSpawnComponent>();
-    for (auto spawner : scripted_spawners) {
-        ecs.registry.destroyEntity(spawner);
-    }
-
-    auto pod_spawners = ecs.registry.getEntities<PodSpawnComponent>();
-    for (auto spawner : pod_spawners) {
-        ecs.registry.destroyEntity(spawner);
-    }
-    for (auto spawner : pod_spawners) {
-        ecs.registry.destroyEntity(spawner);
-    }
-
-    auto timers = ecs.registry.getEntities<GameTimerComponent>();
-    for (auto timer : timers) {
-        ecs.registry.destroyEntity(timer);
-    }
+    // Spawners and timers of the level go in one pass over the pools
+    std::vector<Entity> level_entities;
+    const auto& spawners = ecs.registry.getEntities<EnemySpawnComponent>();
+    level_entities.insert(level_entities.end(), spawners.begin(), spawners.end());
+    const auto& scripted_spawners = ecs.registry.getEntities<ScriptedSpawnComponent>();
+    level_entities.insert(level_entities.end(), scripted_spawners.begin(), scripted_spawners.end());
+    const auto& pod_spawners = ecs.registry.getEntities<PodSpawnComponent>();
+    level_entities.insert(level_entities.end(), pod_spawners.begin(), pod_spawners.end());
+    const auto& timers = ecs.registry.getEntities<GameTimerComponent>();
+    level_entities.insert(level_entities.end(), timers.begin(), timers.end());
+    std::size_t level_cleaned = timers.size() + scripted_spawners.size() + pod_spawners.size();
+    ecs.registry.destroyEntities(level_entities);
 
     std::vector<Entity> entities_to_destroy;
     all_entities = ecs.registry.getEntities<TagComponent>();
@@ -624,26 +597,10 @@ void GameManager::loadNextLevel(std::shared_ptr<Environment> env) {
         if (!ecs.registry.hasComponent<TagComponent>(entity))
             continue;
         auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-        bool should_keep = false;
-        bool is_player = false;
-        bool is_enemy = false;
-        bool is_projectile = false;
-
-        for (const auto& tag : tags.tags) {
-            if (tag == "PLAYER") {
-                is_player = true;
-                should_keep = true;
-                break;
-            }
-            if (tag == "BACKGROUND" || tag == "BOUND") {
-                should_keep = true;
-                break;
-            }
-            if (tag == "ENEMY" || tag == "BOSS")
-                is_enemy = true;
-            if (tag == "PROJECTILE")
-                is_projectile = true;
-        }
+        bool is_player = tags.tags.has(player_tag);
+        bool should_keep = tags.tags.intersects(kept_tags);
+        bool is_enemy = tags.tags.intersects(enemy_tags);
+        bool is_projectile = tags.tags.has(projectile_tag);
 
         if (!should_keep) {
             entities_to_destroy.push_back(entity);
@@ -658,9 +615,7 @@ void GameManager::loadNextLevel(std::shared_ptr<Environment> env) {
         }
     }
 
-    for (auto entity : entities_to_destroy) {
-        ecs.registry.destroyEntity(entity);
-    }
+    ecs.registry.destroyEntities(entities_to_destroy);
 
     std::vector<Entity> untagged_health_entities;
     auto health_entities = ecs.registry.getEntities<HealthComponent>();
@@ -683,12 +638,9 @@ void GameManager::loadNextLevel(std::shared_ptr<Environment> env) {
 
     std::cout << "[GameManager] Destroying " << untagged_health_entities.size()
               << " untagged health entities (potential invisible enemies)" << std::endl;
-    for (auto entity : untagged_health_entities) {
-        ecs.registry.destroyEntity(entity);
-    }
+    ecs.registry.destroyEntities(untagged_health_entities);
 
-    size_t total_cleaned = entities_to_destroy.size() + timers.size() + scripted_spawners.size() + pod_spawners.size() +
-                           untagged_health_entities.size();
+    size_t total_cleaned = entities_to_destroy.size() + level_cleaned + untagged_health_entities.size();
     std::cout << "[GameManager] Total cleaned: " << total_cleaned << " entities" << std::endl;
 
     std::cout << "[GameManager] All entities cleaned, loading new level scene..." << std::endl;
@@ -714,13 +666,13 @@ void GameManager::predictionLogic(Entity e, Registry& r, const InputSnapshot& in
     vel.vx = 0;
     vel.vy = 0;
 
-    if (inputs.isPressed("move_up"))
+    if (inputs.isPressed(_move_up))
         vel.vy = -speed;
-    if (inputs.isPressed("move_down"))
+    if (inputs.isPressed(_move_down))
         vel.vy = speed;
-    if (inputs.isPressed("move_left"))
+    if (inputs.isPressed(_move_left))
         vel.vx = -speed;
-    if (inputs.isPressed("move_right"))
+    if (inputs.isPressed(_move_right))
         vel.vx = speed;
 
     pos.x += vel.vx * dt;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -79,6 +80,12 @@ class GameManager {
     int _current_level_index = 0;
     LevelConfig _current_level_config;
 
+    // Ids the input manager gave the movement actions when setupMovementControls bound them
+    ActionId _move_left = INVALID_ACTION_ID;
+    ActionId _move_right = INVALID_ACTION_ID;
+    ActionId _move_up = INVALID_ACTION_ID;
+    ActionId _move_down = INVALID_ACTION_ID;
+
     // Voice chat owner
 #ifdef CLIENT_BUILD
     std::unique_ptr<engine::voice::VoiceManager> _voiceManager;
@@ -109,6 +116,10 @@ class GameManager {
     void loadNextLevel(std::shared_ptr<Environment> env);
 
    public:
+    // Every action the setup*Controls functions bind, declared to the server before clients connect
+    static constexpr std::array<const char*, 6> INPUT_ACTIONS = {"move_left", "move_right", "move_up",
+                                                                 "move_down", "shoot",      "toggle_pod"};
+
     GameManager();
     ~GameManager() = default;
 
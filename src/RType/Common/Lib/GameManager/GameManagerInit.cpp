@@ -93,7 +93,7 @@ void GameManager::initBackground(std::shared_ptr<Environment> env, const LevelCo
         ecs.registry.addComponent<BackgroundComponent>(bgEntity, bg);
 
         TagComponent tag;
-        tag.tags.push_back("BACKGROUND");
+        tag.tags.add("BACKGROUND");
         ecs.registry.addComponent<TagComponent>(bgEntity, tag);
     }
 }
@@ -185,6 +185,8 @@ void GameManager::initSpawner(std::shared_ptr<Environment> env, const LevelConfi
         Entity scripted_spawner = ecs.registry.createEntity();
         ScriptedSpawnComponent scripted_spawn_comp;
         scripted_spawn_comp.script_path = config.spawn_script;
+        scripted_spawn_comp.spawn_events = config.spawn_events;
+        scripted_spawn_comp.archive = config.archive;
         ecs.registry.addComponent<ScriptedSpawnComponent>(scripted_spawner, scripted_spawn_comp);
 
         EnemySpawnComponent scripted_base = spawn_comp;
@@ -6,15 +6,15 @@
 #include "Components/StandardComponents.hpp"
 
 void GameManager::setupMovementControls(InputManager& inputs) {
-    inputs.bindAction("move_left", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Left});
-    inputs.bindAction("move_right", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Right});
-    inputs.bindAction("move_up", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Up});
-    inputs.bindAction("move_down", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Down});
+    _move_left = inputs.bindAction("move_left", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Left});
+    _move_right = inputs.bindAction("move_right", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Right});
+    _move_up = inputs.bindAction("move_up", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Up});
+    _move_down = inputs.bindAction("move_down", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Down});
 
     if (_player) {
         float player_speed = _player_config.speed.value();
 
-        _player->bindActionCallbackPressed("move_left",
+        _player->bindActionCallbackPressed(_move_left,
                                            [player_speed](Registry& registry, system_context context, Entity entity) {
                                                if (registry.hasComponent<HealthComponent>(entity) &&
                                                    registry.getComponent<HealthComponent>(entity).current_hp <= 0)
@@ -23,14 +23,14 @@ void GameManager::setupMovementControls(InputManager& inputs) {
                                                    registry.getComponent<Velocity2D>(entity).vx = -player_speed;
                                                }
                                            });
-        _player->bindActionCallbackOnReleased("move_left",
+        _player->bindActionCallbackOnReleased(_move_left,
                                               [](Registry& registry, system_context context, Entity entity) {
                                                   if (registry.hasComponent<Velocity2D>(entity)) {
                                                       registry.getComponent<Velocity2D>(entity).vx = 0.0f;
                                                   }
                                               });
 
-        _player->bindActionCallbackPressed("move_right",
+        _player->bindActionCallbackPressed(_move_right,
                                            [player_speed](Registry& registry, system_context context, Entity entity) {
                                                if (registry.hasComponent<HealthComponent>(entity) &&
                                                    registry.getComponent<HealthComponent>(entity).current_hp <= 0)
@@ -39,14 +39,14 @@ void GameManager::setupMovementControls(InputManager& inputs) {
                                                    registry.getComponent<Velocity2D>(entity).vx = player_speed;
                                                }
                                            });
-        _player->bindActionCallbackOnReleased("move_right",
+        _player->bindActionCallbackOnReleased(_move_right,
                                               [](Registry& registry, system_context context, Entity entity) {
                                                   if (registry.hasComponent<Velocity2D>(entity)) {
                                                       registry.getComponent<Velocity2D>(entity).vx = 0.0f;
                                                   }
                                               });
 
-        _player->bindActionCallbackPressed("move_up",
+        _player->bindActionCallbackPressed(_move_up,
                                            [player_speed](Registry& registry, system_context context, Entity entity) {
                                                if (registry.hasComponent<HealthComponent>(entity) &&
                                                    registry.getComponent<HealthComponent>(entity).current_hp <= 0)
@@ -55,13 +55,13 @@ void GameManager::setupMovementControls(InputManager& inputs) {
                                                    registry.getComponent<Velocity2D>(entity).vy = -player_speed;
                                                }
                                            });
-        _player->bindActionCallbackOnReleased("move_up", [](Registry& registry, system_context context, Entity entity) {
+        _player->bindActionCallbackOnReleased(_move_up, [](Registry& registry, system_context context, Entity entity) {
             if (registry.hasComponent<Velocity2D>(entity)) {
                 registry.getComponent<Velocity2D>(entity).vy = 0.0f;
             }
         });
 
-        _player->bindActionCallbackPressed("move_down",
+        _player->bindActionCallbackPressed(_move_down,
                                            [player_speed](Registry& registry, system_context context, Entity entity) {
                                                if (registry.hasComponent<HealthComponent>(entity) &&
                                                    registry.getComponent<HealthComponent>(entity).current_hp <= 0)
@@ -70,7 +70,7 @@ void GameManager::setupMovementControls(InputManager& inputs) {
                                                    registry.getComponent<Velocity2D>(entity).vy = player_speed;
                                                }
                                            });
-        _player->bindActionCallbackOnReleased("move_down",
+        _player->bindActionCallbackOnReleased(_move_down,
                                               [](Registry& registry, system_context context, Entity entity) {
                                                   if (registry.hasComponent<Velocity2D>(entity)) {
                                                       registry.getComponent<Velocity2D>(entity).vy = 0.0f;
@@ -80,10 +80,10 @@ void GameManager::setupMovementControls(InputManager& inputs) {
 }
 
 void GameManager::setupShootingControls(InputManager& inputs) {
-    inputs.bindAction("shoot", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Space});
+    ActionId shoot = inputs.bindAction("shoot", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::Space});
 
     if (_player) {
-        _player->bindActionCallbackPressed("shoot", [](Registry& registry, system_context context, Entity entity) {
+        _player->bindActionCallbackPressed(shoot, [](Registry& registry, system_context context, Entity entity) {
             if (registry.hasComponent<HealthComponent>(entity) &&
                 registry.getComponent<HealthComponent>(entity).current_hp <= 0)
                 return;
@@ -93,7 +93,7 @@ void GameManager::setupShootingControls(InputManager& inputs) {
                 shoot.trigger_pressed = true;
             }
         });
-        _player->bindActionCallbackOnReleased("shoot", [](Registry& registry, system_context context, Entity entity) {
+        _player->bindActionCallbackOnReleased(shoot, [](Registry& registry, system_context context, Entity entity) {
             if (registry.hasComponent<ShooterComponent>(entity)) {
                 auto& shoot = registry.getComponent<ShooterComponent>(entity);
                 shoot.trigger_pressed = false;
@@ -112,10 +112,11 @@ void GameManager::setupShootingControls(InputManager& inputs) {
 }
 
 void GameManager::setupPodControls(InputManager& inputs) {
-    inputs.bindAction("toggle_pod", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::E});
+    ActionId toggle_pod =
+        inputs.bindAction("toggle_pod", InputBinding{InputDeviceType::Keyboard, sf::Keyboard::Key::E});
 
     if (_player) {
-        _player->bindActionCallbackPressed("toggle_pod", [](Registry& registry, system_context context, Entity entity) {
+        _player->bindActionCallbackPressed(toggle_pod, [](Registry& registry, system_context context, Entity entity) {
             if (registry.hasComponent<HealthComponent>(entity) &&
                 registry.getComponent<HealthComponent>(entity).current_hp <= 0)
                 return;
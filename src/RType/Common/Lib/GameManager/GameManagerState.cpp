@@ -22,10 +22,8 @@ static Entity findPlayerEntity(Registry& registry) {
     auto& entities = registry.getEntities<TagComponent>();
     for (auto entity : entities) {
         auto& tags = registry.getConstComponent<TagComponent>(entity);
-        for (const auto& tag : tags.tags) {
-            if (tag == "PLAYER") {
-                return entity;
-            }
+        if (tags.tags.has("PLAYER")) {
+            return entity;
         }
     }
     return -1;
@@ -69,7 +67,7 @@ void GameManager::updateUI(std::shared_ptr<Environment> env) {
 
         for (auto entity : entities) {
             auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-            if (std::find(tags.tags.begin(), tags.tags.end(), "BOSS") != tags.tags.end()) {
+            if (tags.tags.has("BOSS")) {
                 if (ecs.registry.hasComponent<HealthComponent>(entity)) {
                     auto& health = ecs.registry.getComponent<HealthComponent>(entity);
                     float percent = (static_cast<float>(health.current_hp) / health.max_hp) * 100.0f;
@@ -95,6 +93,8 @@ void GameManager::updateUI(std::shared_ptr<Environment> env) {
 }
 
 void GameManager::checkGameState(std::shared_ptr<Environment> env) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
+    static const TagId boss_tag = TagRegistry::intern("BOSS");
     auto& ecs = env->getECS();
 
     if (!env->isServer()) {
@@ -170,23 +170,20 @@ void GameManager::checkGameState(std::shared_ptr<Environment> env) {
     auto& entities = ecs.registry.getEntities<TagComponent>();
     for (auto entity : entities) {
         auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-        for (const auto& tag : tags.tags) {
-            if (tag == "PLAYER") {
-                total_players++;
-                player_entities.push_back(entity);
-
-                bool is_alive = false;
-                if (ecs.registry.hasComponent<HealthComponent>(entity)) {
-                    auto& health = ecs.registry.getConstComponent<HealthComponent>(entity);
-                    is_alive = health.current_hp > 0;
-                }
+        if (tags.tags.has(player_tag)) {
+            total_players++;
+            player_entities.push_back(entity);
+
+            bool is_alive = false;
+            if (ecs.registry.hasComponent<HealthComponent>(entity)) {
+                auto& health = ecs.registry.getConstComponent<HealthComponent>(entity);
+                is_alive = health.current_hp > 0;
+            }
 
-                if (is_alive) {
-                    alive_players++;
-                } else {
-                    dead_players++;
-                }
-                break;
+            if (is_alive) {
+                alive_players++;
+            } else {
+                dead_players++;
             }
         }
     }
@@ -252,14 +249,10 @@ void GameManager::checkGameState(std::shared_ptr<Environment> env) {
     if (boss_spawned && !_inTransition) {
         for (auto entity : entities) {
             auto& tags = ecs.registry.getConstComponent<TagComponent>(entity);
-            for (const auto& tag : tags.tags) {
-                if (tag == "BOSS") {
-                    boss_exists = true;
-                    break;
-                }
-            }
-            if (boss_exists)
+            if (tags.tags.has(boss_tag)) {
+                boss_exists = true;
                 break;
+            }
         }
 
         if (!boss_exists && alive_players > 0 && !_victory) {
@@ -298,7 +291,7 @@ void GameManager::displayGameOver(std::shared_ptr<Environment> env, bool victory
     _gameStateEntity = ecs.registry.createEntity();
     {
         TagComponent tag;
-        tag.tags.push_back("LEADERBOARD");
+        tag.tags.add("LEADERBOARD");
         ecs.registry.addComponent<TagComponent>(_gameStateEntity, tag);
     }
     ecs.registry.addComponent<TextComponent>(
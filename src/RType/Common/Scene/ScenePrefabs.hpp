@@ -87,8 +87,8 @@ class ScenePrefabs {
                 clip.handle = handle;
                 clip.frames.emplace_back(0, 0, 32, 32);
                 animation.layer = RenderLayer::Foreground;
-                animation.animations.emplace("idle", clip);
-                animation.currentAnimation = "idle";
+                animation.addClip("idle", clip);
+                animation.play("idle");
                 registry.addComponent<AnimatedSprite2D>(entity, animation);
 
                 auto& transform = registry.getComponent<transform_component_s>(entity);
@@ -96,14 +96,14 @@ class ScenePrefabs {
                 transform.scale_y = height / 32.0f;
 
                 BoxCollisionComponent collision;
-                collision.tagCollision.push_back("PLAYER");
-                collision.tagCollision.push_back("FRIENDLY_PROJECTILE");
-                collision.tagCollision.push_back("ENEMY_PROJECTILE");
+                collision.tagCollision.add("PLAYER");
+                collision.tagCollision.add("FRIENDLY_PROJECTILE");
+                collision.tagCollision.add("ENEMY_PROJECTILE");
                 registry.addComponent<BoxCollisionComponent>(entity, collision);
 
                 TagComponent tags;
-                tags.tags.push_back("WALL");
-                tags.tags.push_back("TERRAIN");
+                tags.tags.add("WALL");
+                tags.tags.add("TERRAIN");
                 registry.addComponent<TagComponent>(entity, tags);
 
                 // Add NetworkIdentity for network replication
@@ -193,8 +193,8 @@ class ScenePrefabs {
                 for (int i = 0; i < 4; i++) {
                     clip.frames.emplace_back(static_cast<float>(i * 32), 0, 32, 32);
                 }
-                animation.animations.emplace("idle", clip);
-                animation.currentAnimation = "idle";
+                animation.addClip("idle", clip);
+                animation.play("idle");
                 registry.addComponent<AnimatedSprite2D>(entity, animation);
 
                 auto& transform = registry.getComponent<transform_component_s>(entity);
@@ -202,13 +202,13 @@ class ScenePrefabs {
                 transform.scale_y = 2.5f;
 
                 BoxCollisionComponent collision;
-                collision.tagCollision.push_back("FRIENDLY_PROJECTILE");
-                collision.tagCollision.push_back("PLAYER");
+                collision.tagCollision.add("FRIENDLY_PROJECTILE");
+                collision.tagCollision.add("PLAYER");
                 registry.addComponent<BoxCollisionComponent>(entity, collision);
 
                 TagComponent tags;
-                tags.tags.push_back("AI");
-                tags.tags.push_back("TURRET");
+                tags.tags.add("AI");
+                tags.tags.add("TURRET");
                 registry.addComponent<TagComponent>(entity, tags);
 
                 registry.addComponent<NetworkIdentity>(entity, {static_cast<uint32_t>(entity), 0});
@@ -254,8 +254,8 @@ class ScenePrefabs {
                     clip.handle = handle;
                     animation.layer = RenderLayer::Midground;
                     clip.frames.emplace_back(0, 0, 0, 0);
-                    animation.currentAnimation = "idle";
-                    animation.animations.emplace("idle", clip);
+                    animation.addClip("idle", clip);
+                    animation.play("idle");
                     registry.addComponent<AnimatedSprite2D>(entity, animation);
                 }
                 registry.addComponent<NetworkIdentity>(entity, {static_cast<uint32_t>(entity), 0});
@@ -21,11 +21,13 @@ class AnimationHelper {
         float sprite_h = static_cast<float>(config.sprite_h.value());
         float start_x = static_cast<float>(config.sprite_x.value());
         float start_y = static_cast<float>(config.sprite_y.value());
-        animation.animations.at("idle").frameDuration = animation_speed;
-        animation.animations.at("idle").frames.clear();
-        for (int i = 0; i < num_frames; i++) {
-            animation.animations.at("idle").frames.emplace_back(start_x + i * sprite_w, start_y, sprite_w, sprite_h);
-        }
+        animation.editClip("idle", [&](AnimationClip& clip) {
+            clip.frameDuration = animation_speed;
+            clip.frames.clear();
+            for (int i = 0; i < num_frames; i++) {
+                clip.frames.emplace_back(start_x + i * sprite_w, start_y, sprite_w, sprite_h);
+            }
+        });
 
         // 7
     }
@@ -54,14 +56,15 @@ class AnimationHelper {
 
         auto& animation = registry.getComponent<AnimatedSprite2D>(entity);
 
-        animation.animations.at("idle").frameDuration = animation_speed;
-        animation.animations.at("idle").frames.clear();
+        animation.editClip("idle", [&](AnimationClip& clip) {
+            clip.frameDuration = animation_speed;
+            clip.frames.clear();
 
-        for (int i = 0; i < num_frames; i++) {
-            animation.animations.at("idle").frames.emplace_back(start_x + i * (width + padding_x), start_y, width,
-                                                                height);
-        }
-        animation.animations.at("idle").mode = mode;
+            for (int i = 0; i < num_frames; i++) {
+                clip.frames.emplace_back(start_x + i * (width + padding_x), start_y, width, height);
+            }
+            clip.mode = mode;
+        });
     }
 
     static void setupStaticSprite(Registry& registry, Entity entity, const EntityConfig& config) {
@@ -7,19 +7,15 @@
 #include <cmath>
 
 void BehaviorSystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
     Entity player_entity = -1;
     auto& teams = registry.getEntities<TeamComponent>();
     for (auto entity : teams) {
         auto& team = registry.getConstComponent<TeamComponent>(entity);
         if (team.team == TeamComponent::ALLY) {
             if (registry.hasComponent<TagComponent>(entity)) {
-                auto& tags = registry.getConstComponent<TagComponent>(entity);
-                for (const auto& tag : tags.tags) {
-                    if (tag == "PLAYER") {
-                        player_entity = entity;
-                        break;
-                    }
-                }
+                if (registry.getConstComponent<TagComponent>(entity).tags.has(player_tag))
+                    player_entity = entity;
             }
         }
         if (player_entity != -1)
@@ -31,7 +27,7 @@ void BehaviorSystem::update(Registry& registry, system_context context) {
 
     auto& behaviors = registry.getEntities<BehaviorComponent>();
     for (auto entity : behaviors) {
-        auto& behavior = registry.getComponent<BehaviorComponent>(entity);
+        auto& behavior = registry.getConstComponent<BehaviorComponent>(entity);
 
         if (behavior.follow_player) {
             updateFollowPlayer(registry, context, entity, player_entity);
@@ -48,7 +44,7 @@ void BehaviorSystem::updateFollowPlayer(Registry& registry, system_context conte
         return;
     }
 
-    auto& enemy_transform = registry.getComponent<transform_component_s>(enemy);
+    auto& enemy_transform = registry.getConstComponent<transform_component_s>(enemy);
     auto& player_transform = registry.getConstComponent<transform_component_s>(player);
     auto& behavior = registry.getConstComponent<BehaviorComponent>(enemy);
 
@@ -58,9 +54,9 @@ void BehaviorSystem::updateFollowPlayer(Registry& registry, system_context conte
 
     if (distance > 5.0f) {
         if (registry.hasComponent<Velocity2D>(enemy)) {
-            auto& vel = registry.getComponent<Velocity2D>(enemy);
-            vel.vx = (dx / distance) * behavior.follow_speed;
-            vel.vy = (dy / distance) * behavior.follow_speed;
+            auto vel = registry.writeComponent<Velocity2D>(enemy);
+            vel->vx = (dx / distance) * behavior.follow_speed;
+            vel->vy = (dy / distance) * behavior.follow_speed;
         }
     }
 }
@@ -68,6 +64,7 @@ void BehaviorSystem::updateFollowPlayer(Registry& registry, system_context conte
 void BehaviorSystem::updateShootAtPlayer(Registry& registry, Entity enemy, Entity player) {}
 
 void BoundsSystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
 #if defined(CLIENT_BUILD)
     const float windowWidth = static_cast<float>(context.window.getSize().x);
     const float windowHeight = static_cast<float>(context.window.getSize().y);
@@ -94,26 +91,16 @@ void BoundsSystem::update(Registry& registry, system_context context) {
 
         if (!registry.hasComponent<TagComponent>(entity))
             continue;
-        auto& tags = registry.getConstComponent<TagComponent>(entity);
-
-        bool is_player = false;
-        for (const auto& tag : tags.tags) {
-            if (tag == "PLAYER") {
-                is_player = true;
-                break;
-            }
-        }
-
-        if (!is_player)
+        if (!registry.getConstComponent<TagComponent>(entity).tags.has(player_tag))
             continue;
 
         if (registry.hasComponent<transform_component_s>(entity)) {
-            auto& transform = registry.getComponent<transform_component_s>(entity);
+            auto transform = registry.writeComponent<transform_component_s>(entity);
 
             float sprite_w = 33.0f;
             float sprite_h = 17.0f;
-            float scale_x = transform.scale_x;
-            float scale_y = transform.scale_y;
+            float scale_x = transform.read().scale_x;
+            float scale_y = transform.read().scale_y;
 
             // if (registry.hasComponent<sprite2D_component_s>(entity)) {
             //     auto& sprite = registry.getConstComponent<sprite2D_component_s>(entity);
@@ -129,14 +116,9 @@ void BoundsSystem::update(Registry& registry, system_context context) {
 
             if (registry.hasComponent<AnimatedSprite2D>(entity)) {
                 auto& animation = registry.getConstComponent<AnimatedSprite2D>(entity);
-                if (!animation.animations.at(animation.currentAnimation).frames.empty()) {
-                    const auto& frame = animation.animations.at(animation.currentAnimation).frames;
-                    sprite_w = animation.animations.at(animation.currentAnimation)
-                                   .frames.at(animation.currentFrameIndex)
-                                   .width;
-                    sprite_h = animation.animations.at(animation.currentAnimation)
-                                   .frames.at(animation.currentFrameIndex)
-                                   .height;
+                if (animation.frame()) {
+                    sprite_w = animation.hitboxWidth;
+                    sprite_h = animation.hitboxHeight;
                 }
             } else if (registry.hasComponent<Sprite2D>(entity)) {
                 auto& sprite = registry.getConstComponent<Sprite2D>(entity);
@@ -148,14 +130,14 @@ void BoundsSystem::update(Registry& registry, system_context context) {
             float actual_width = sprite_w * std::abs(scale_x);
             float actual_height = sprite_h * std::abs(scale_y);
 
-            if (transform.x < min_x)
-                transform.x = min_x;
-            if (transform.x > windowWidth - actual_width)
-                transform.x = windowWidth - actual_width;
-            if (transform.y < min_y)
-                transform.y = min_y;
-            if (transform.y > windowHeight - actual_height)
-                transform.y = windowHeight - actual_height;
+            if (transform.read().x < min_x)
+                transform->x = min_x;
+            if (transform.read().x > windowWidth - actual_width)
+                transform->x = windowWidth - actual_width;
+            if (transform.read().y < min_y)
+                transform->y = min_y;
+            if (transform.read().y > windowHeight - actual_height)
+                transform->y = windowHeight - actual_height;
         }
     }
 }
@@ -382,7 +382,7 @@ void BossSystem::createBossProjectile(Registry& registry, system_context context
 
     // Tag pour collision avec le joueur
     TagComponent tags;
-    tags.tags.push_back("ENEMY_PROJECTILE");
+    tags.tags.add("ENEMY_PROJECTILE");
     registry.addComponent<TagComponent>(projectile, tags);
 
     // Marquer comme projectile
@@ -416,8 +416,8 @@ void BossSystem::createBossProjectile(Registry& registry, system_context context
     // Projectile ennemi (boule d'énergie rouge)
     clip.frames.emplace_back(BossDefaults::Projectile::SPRITE_X, BossDefaults::Projectile::SPRITE_Y,
                              BossDefaults::Projectile::SPRITE_W, BossDefaults::Projectile::SPRITE_H);
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     registry.addComponent<AnimatedSprite2D>(projectile, animation);
 
     // Échelle pour rendre visible
@@ -427,7 +427,7 @@ void BossSystem::createBossProjectile(Registry& registry, system_context context
 
     // Collision avec le joueur
     BoxCollisionComponent collision;
-    collision.tagCollision.push_back("PLAYER");
+    collision.tagCollision.add("PLAYER");
     registry.addComponent<BoxCollisionComponent>(projectile, collision);
     registry.addComponent<NetworkIdentity>(projectile, {static_cast<uint32_t>(projectile), 0});
 
@@ -567,7 +567,7 @@ void BossSystem::spawnTentacle(Registry& registry, Entity boss_entity, int index
     }
 
     TagComponent tags;
-    tags.tags.push_back("BOSS_PART");
+    tags.tags.add("BOSS_PART");
     registry.addComponent<TagComponent>(tentacle, tags);
     registry.addComponent<NetworkIdentity>(tentacle, {static_cast<uint32_t>(tentacle), 0});
 
@@ -604,7 +604,7 @@ void BossSystem::spawnCannon(Registry& registry, Entity boss_entity, int index,
     }
 
     TagComponent tags;
-    tags.tags.push_back("BOSS_PART");
+    tags.tags.add("BOSS_PART");
     registry.addComponent<TagComponent>(cannon, tags);
     registry.addComponent<NetworkIdentity>(cannon, {static_cast<uint32_t>(cannon), 0});
 
@@ -7,8 +7,7 @@ void BossTailSystem::update(Registry& registry, system_context context) {
     auto& tail_segments = registry.getEntities<BossTailSegmentComponent>();
 
     // Animation parameters
-    static float global_time = 0.0f;
-    global_time += context.dt;
+    _time += context.dt;
 
     const float wave_frequency = 2.0f;   // Oscillations per second
     const float wave_amplitude = 25.0f;  // Smaller amplitude keeps the chain tighter
@@ -69,14 +68,8 @@ void BossTailSystem::update(Registry& registry, system_context context) {
                 if (registry.hasComponent<AnimatedSprite2D>(tail_comp.boss_entity_id)) {
                     auto& boss_sprite = registry.getConstComponent<AnimatedSprite2D>(tail_comp.boss_entity_id);
 
-                    const float boss_w = boss_sprite.animations.at(boss_sprite.currentAnimation)
-                                             .frames.at(boss_sprite.currentFrameIndex)
-                                             .width *
-                                         parent_transform.scale_x;
-                    const float boss_h = boss_sprite.animations.at(boss_sprite.currentAnimation)
-                                             .frames.at(boss_sprite.currentFrameIndex)
-                                             .height *
-                                         parent_transform.scale_y;
+                    const float boss_w = boss_sprite.hitboxWidth * parent_transform.scale_x;
+                    const float boss_h = boss_sprite.hitboxHeight * parent_transform.scale_y;
 
                     // User tuning: move attachment more to the right and lower
                     float anchor_x = parent_transform.x + (boss_w * -0.05f);
@@ -85,14 +78,8 @@ void BossTailSystem::update(Registry& registry, system_context context) {
                     // Center the segment sprite on the anchor point (if available)
                     if (registry.hasComponent<AnimatedSprite2D>(segment_entity)) {
                         auto& seg_sprite = registry.getConstComponent<AnimatedSprite2D>(segment_entity);
-                        const float seg_w = seg_sprite.animations.at(seg_sprite.currentAnimation)
-                                                .frames.at(seg_sprite.currentFrameIndex)
-                                                .width *
-                                            segment_transform.scale_x;
-                        const float seg_h = seg_sprite.animations.at(seg_sprite.currentAnimation)
-                                                .frames.at(seg_sprite.currentFrameIndex)
-                                                .height *
-                                            segment_transform.scale_y;
+                        const float seg_w = seg_sprite.hitboxWidth * segment_transform.scale_x;
+                        const float seg_h = seg_sprite.hitboxHeight * segment_transform.scale_y;
                         anchor_x -= seg_w * 0.50f;
                         anchor_y -= seg_h * 0.50f;
                     }
@@ -114,7 +101,7 @@ void BossTailSystem::update(Registry& registry, system_context context) {
         }
 
         // Calculate target position with sine wave
-        float sine_wave = std::sin((global_time * wave_frequency) + tail_comp.sine_offset) * wave_amplitude;
+        float sine_wave = std::sin((_time * wave_frequency) + tail_comp.sine_offset) * wave_amplitude;
 
         float target_x = parent_transform.x + tail_comp.base_offset_x;
         float target_y = parent_transform.y + tail_comp.base_offset_y + sine_wave;
@@ -5,4 +5,7 @@
 class BossTailSystem : public ISystem {
    public:
     void update(Registry& registry, system_context context) override;
+
+   private:
+    float _time = 0.0f;
 };
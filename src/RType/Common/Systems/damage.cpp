@@ -13,6 +13,7 @@
 #include "../../../../Engine/Lib/Utils/LobbyUtils.hpp"
 
 void Damage::update(Registry& registry, system_context context) {
+    static const TagId obstacle_tag = TagRegistry::intern("OBSTACLE");
     auto& attackers = registry.getEntities<DamageOnCollision>();
     std::set<Entity> damaged_this_frame;
     std::vector<Entity> attackers_to_destroy;
@@ -40,9 +41,8 @@ void Damage::update(Registry& registry, system_context context) {
             if (attacker_lobby != target_lobby && attacker_lobby != 0 && target_lobby != 0)
                 continue;
 
-            auto& health = registry.getComponent<HealthComponent>(hit_id);
-
-            if (health.last_damage_time > 0) {
+            // Invincible targets are only read, the hit is ignored
+            if (registry.getConstComponent<HealthComponent>(hit_id).last_damage_time > 0) {
                 continue;
             }
 
@@ -79,17 +79,14 @@ void Damage::update(Registry& registry, system_context context) {
 
             int damage_value = dmg.damage_value;
             if (registry.hasComponent<TagComponent>(attacker)) {
-                const auto& tags = registry.getConstComponent<TagComponent>(attacker);
-                for (const auto& tag : tags.tags) {
-                    if (tag == "OBSTACLE") {
-                        damage_value = 1;
-                        break;
-                    }
-                }
+                if (registry.getConstComponent<TagComponent>(attacker).tags.has(obstacle_tag))
+                    damage_value = 1;
             }
 
             damaged_this_frame.insert(hit_id);
 
+            auto& health = registry.getComponent<HealthComponent>(hit_id);
+
             if (health.current_hp - damage_value <= 0) {
                 health.current_hp = 0;
             } else {
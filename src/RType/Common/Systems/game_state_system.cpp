@@ -16,6 +16,7 @@
 #include "../Systems/health.hpp"
 
 void GameStateSystem::update(Registry& registry, system_context context) {
+    static const TagId boss_tag = TagRegistry::intern("BOSS");
 #if defined(SERVER_BUILD)
     if (!context.lobby_manager) {
         return;
@@ -38,6 +39,10 @@ void GameStateSystem::update(Registry& registry, system_context context) {
         if (lobby.getState() != engine::core::Lobby::State::IN_GAME) {
             continue;
         }
+        // A lobby world only runs the game of its own lobby
+        if (context.lobby_id != 0 && lobbyId != context.lobby_id) {
+            continue;
+        }
 
         any_in_game_lobby = true;
 
@@ -116,10 +121,7 @@ void GameStateSystem::update(Registry& registry, system_context context) {
 
                 // Broadcast ONLY to this lobby
                 for (const auto& client : lobby.getClients()) {
-                    network::message<network::GameEvents> msg;
-                    msg.header.id = network::GameEvents::S_GAME_OVER;
-                    msg << gameOverPacket;
-                    server->AddMessageToPlayer(network::GameEvents::S_GAME_OVER, client.id, msg);
+                    server->AddMessageToPlayer(network::GameEvents::S_GAME_OVER, client.id, gameOverPacket);
                 }
 
                 // Mark game as over for this lobby - we need a better way than a global _gameOverSent flag if we have
@@ -169,15 +171,10 @@ void GameStateSystem::update(Registry& registry, system_context context) {
         for (auto entity : tagged) {
             if (!registry.hasComponent<TagComponent>(entity))
                 continue;
-            auto& tags = registry.getConstComponent<TagComponent>(entity);
-            for (const auto& tag : tags.tags) {
-                if (tag == "BOSS") {
-                    boss_exists = true;
-                    break;
-                }
-            }
-            if (boss_exists)
+            if (registry.getConstComponent<TagComponent>(entity).tags.has(boss_tag)) {
+                boss_exists = true;
                 break;
+            }
         }
     }
 
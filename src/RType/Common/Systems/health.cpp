@@ -10,15 +10,16 @@
 #include "health.hpp"
 
 void HealthSystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
     auto& entities = registry.getEntities<HealthComponent>();
     std::vector<Entity> dead_entities;
 
     for (auto entity : entities) {
         if (!registry.hasComponent<HealthComponent>(entity))
             continue;
-        auto& health = registry.getComponent<HealthComponent>(entity);
+        auto& health = registry.getConstComponent<HealthComponent>(entity);
         if (health.last_damage_time > 0) {
-            health.last_damage_time -= context.dt;
+            registry.getComponent<HealthComponent>(entity).last_damage_time -= context.dt;
         }
         if (health.current_hp <= 0) {
             if (registry.hasComponent<BossComponent>(entity)) {
@@ -26,15 +27,7 @@ void HealthSystem::update(Registry& registry, system_context context) {
             }
             // Fix: Do not destroy players immediately, let GameManagerState handle Game Over
             if (registry.hasComponent<TagComponent>(entity)) {
-                auto& tags = registry.getComponent<TagComponent>(entity);
-                bool isPlayer = false;
-                for (const auto& tag : tags.tags) {
-                    if (tag == "PLAYER") {
-                        isPlayer = true;
-                        break;
-                    }
-                }
-                if (isPlayer)
+                if (registry.getConstComponent<TagComponent>(entity).tags.has(player_tag))
                     continue;
             }
             dead_entities.push_back(entity);
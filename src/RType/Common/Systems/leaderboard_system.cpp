@@ -41,7 +41,7 @@ class LeaderBoard {
 };
 
 static bool has_tag(const TagComponent& component, const std::string& target) {
-    return std::find(component.tags.begin(), component.tags.end(), target) != component.tags.end();
+    return component.tags.has(target);
 }
 
 template <typename Filter, typename NameGen>
@@ -76,6 +76,9 @@ static std::vector<PlayerScoreEntry> collect_scores(Registry& registry, Filter f
 }
 
 void LeaderboardSystem::update(Registry& registry, system_context context) {
+    static const TagSet leaderboard_tags{"LEADERBOARD", "VICTORY_TIMER"};
+    static const TagId timer_tag = TagRegistry::intern("VICTORY_TIMER");
+    static const TagId button_tag = TagRegistry::intern("RETURN_BTN");
     auto& entities = registry.getEntities<LeaderboardComponent>();
     if (entities.empty())
         return;
@@ -89,20 +92,11 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
             if (!registry.hasComponent<TagComponent>(e))
                 continue;
             const auto& tags = registry.getConstComponent<TagComponent>(e);
-            bool should_destroy = false;
-            for (const auto& t : tags.tags) {
-                if (t == "LEADERBOARD" || t == "VICTORY_TIMER") {
-                    should_destroy = true;
-                    break;
-                }
-            }
-            if (should_destroy)
+            if (tags.tags.intersects(leaderboard_tags))
                 to_destroy.push_back(e);
         }
 
-        for (auto e : to_destroy) {
-            registry.destroyEntity(e);
-        }
+        registry.destroyEntities(to_destroy);
     };
 
     float deltaTime = context.dt;
@@ -141,7 +135,7 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
 
             {
                 TagComponent tag;
-                tag.tags.push_back("LEADERBOARD");
+                tag.tags.add("LEADERBOARD");
                 registry.addComponent<TagComponent>(gameOverTitle, tag);
                 registry.addComponent<TagComponent>(leaderboardTitle, tag);
             }
@@ -165,8 +159,8 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
             if (leaderboard.victory) {
                 Entity timerEntity = registry.createEntity();
                 TagComponent timerTag;
-                timerTag.tags.push_back("LEADERBOARD");
-                timerTag.tags.push_back("VICTORY_TIMER");
+                timerTag.tags.add("LEADERBOARD");
+                timerTag.tags.add("VICTORY_TIMER");
                 registry.addComponent<TagComponent>(timerEntity, timerTag);
 
                 int remaining = static_cast<int>(leaderboard.auto_hide_duration);
@@ -177,8 +171,8 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
             } else {
                 Entity returnButton = registry.createEntity();
                 TagComponent btnTag;
-                btnTag.tags.push_back("LEADERBOARD");
-                btnTag.tags.push_back("RETURN_BTN");
+                btnTag.tags.add("LEADERBOARD");
+                btnTag.tags.add("RETURN_BTN");
                 registry.addComponent<TagComponent>(returnButton, btnTag);
 
                 registry.addComponent<TextComponent>(
@@ -193,7 +187,7 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
                 Entity scoreEntity = registry.createEntity();
                 {
                     TagComponent tag;
-                    tag.tags.push_back("LEADERBOARD");
+                    tag.tags.add("LEADERBOARD");
                     registry.addComponent<TagComponent>(scoreEntity, tag);
                 }
                 std::string name_text = entry.player_name;
@@ -211,13 +205,7 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
                     continue;
 
                 auto& tags = registry.getConstComponent<TagComponent>(timer_entity);
-                bool is_timer = false;
-                for (const auto& tag : tags.tags) {
-                    if (tag == "VICTORY_TIMER") {
-                        is_timer = true;
-                        break;
-                    }
-                }
+                bool is_timer = tags.tags.has(timer_tag);
                 if (is_timer && registry.hasComponent<TextComponent>(timer_entity)) {
                     int remaining = static_cast<int>(leaderboard.auto_hide_duration - leaderboard.elapsed_time);
                     if (remaining < 0)
@@ -239,13 +227,7 @@ void LeaderboardSystem::update(Registry& registry, system_context context) {
                     continue;
                 const auto& tags = registry.getConstComponent<TagComponent>(e);
 
-                bool is_btn = false;
-                for (const auto& t : tags.tags) {
-                    if (t == "RETURN_BTN") {
-                        is_btn = true;
-                        break;
-                    }
-                }
+                bool is_btn = tags.tags.has(button_tag);
 
 #if defined(CLIENT_BUILD)
                 if (is_btn && registry.hasComponent<TextComponent>(e)) {
@@ -19,20 +19,13 @@
 #include "../../../../Engine/Lib/Components/LobbyIdComponent.hpp"
 
 bool PodSystem::allPlayersHavePods(Registry& registry) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
     auto& players = registry.getEntities<TagComponent>();
     int player_count = 0;
     int players_with_pods = 0;
 
     for (auto entity : players) {
-        const auto& tags = registry.getConstComponent<TagComponent>(entity);
-        bool is_player = false;
-        for (const auto& tag : tags.tags) {
-            if (tag == "PLAYER") {
-                is_player = true;
-                break;
-            }
-        }
-        if (is_player) {
+        if (registry.getConstComponent<TagComponent>(entity).tags.has(player_tag)) {
             player_count++;
             if (registry.hasComponent<PlayerPodComponent>(entity)) {
                 const auto& pod_comp = registry.getConstComponent<PlayerPodComponent>(entity);
@@ -72,8 +65,8 @@ void PodSystem::spawnPod(Registry& registry, system_context context, uint32_t lo
     registry.addComponent<Velocity2D>(pod_id, {-80.0f, 0.0f});
 
     TagComponent tags;
-    tags.tags.emplace_back("POD");
-    tags.tags.emplace_back("ITEM");
+    tags.tags.add("POD");
+    tags.tags.add("ITEM");
     registry.addComponent<TagComponent>(pod_id, tags);
 
     PodComponent pod_comp;
@@ -87,7 +80,7 @@ void PodSystem::spawnPod(Registry& registry, system_context context, uint32_t lo
     registry.addComponent<TeamComponent>(pod_id, {TeamComponent::ALLY});
 
     BoxCollisionComponent collision;
-    collision.tagCollision.emplace_back("PLAYER");
+    collision.tagCollision.add("PLAYER");
     registry.addComponent<BoxCollisionComponent>(pod_id, collision);
 
     handle_t<TextureAsset> handle =
@@ -107,8 +100,8 @@ void PodSystem::spawnPod(Registry& registry, system_context context, uint32_t lo
 
     clip.handle = handle;
     clip.frames.emplace_back(1, 0, POD_FRAME_WIDTH, POD_FRAME_HEIGHT);
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     registry.addComponent<AnimatedSprite2D>(pod_id, animation);
 
     // Animation: 6 frames horizontales, start à (1,0) avec padding de 0
@@ -162,6 +155,7 @@ void PodSystem::updateFloatingPodMovement(Registry& registry, const system_conte
 }
 
 void PodSystem::handlePodCollection(Registry& registry) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
     auto& pods = registry.getEntities<PodComponent>();
 
     for (auto pod_entity : pods) {
@@ -177,16 +171,7 @@ void PodSystem::handlePodCollection(Registry& registry) {
         for (Entity collided_entity : pod_collision.collision.tags) {
             if (!registry.hasComponent<TagComponent>(collided_entity))
                 continue;
-            const auto& collided_tags = registry.getConstComponent<TagComponent>(collided_entity);
-
-            bool is_player = false;
-            for (const auto& tag : collided_tags.tags) {
-                if (tag == "PLAYER") {
-                    is_player = true;
-                    break;
-                }
-            }
-            if (!is_player)
+            if (!registry.getConstComponent<TagComponent>(collided_entity).tags.has(player_tag))
                 continue;
 
             Entity player_entity = collided_entity;
@@ -218,7 +203,7 @@ void PodSystem::handlePodCollection(Registry& registry) {
             if (registry.hasComponent<BoxCollisionComponent>(pod_entity)) {
                 auto& pod_col = registry.getComponent<BoxCollisionComponent>(pod_entity);
                 pod_col.tagCollision.clear();
-                pod_col.tagCollision.emplace_back("AI");
+                pod_col.tagCollision.add("AI");
             }
 
             registry.addComponent<DamageOnCollision>(pod_entity, {50});
@@ -434,7 +419,7 @@ void PodSystem::handlePodToggle(Registry& registry) {
             if (registry.hasComponent<BoxCollisionComponent>(pod_entity)) {
                 auto& collision = registry.getComponent<BoxCollisionComponent>(pod_entity);
                 collision.tagCollision.clear();
-                collision.tagCollision.emplace_back("AI");
+                collision.tagCollision.add("AI");
             }
         }
     }
@@ -452,8 +437,8 @@ void PodSystem::createPodLaserProjectile(Registry& registry, system_context cont
     registry.addComponent<Velocity2D>(projectile_id, {vx, vy});
 
     TagComponent tags;
-    tags.tags.emplace_back("FRIENDLY_PROJECTILE");
-    tags.tags.emplace_back("POD_LASER");
+    tags.tags.add("FRIENDLY_PROJECTILE");
+    tags.tags.add("POD_LASER");
     registry.addComponent<TagComponent>(projectile_id, tags);
 
     registry.addComponent<TeamComponent>(projectile_id, {TeamComponent::ALLY});
@@ -482,13 +467,13 @@ void PodSystem::createPodLaserProjectile(Registry& registry, system_context cont
     clip.frameDuration = 0;
     // Coordonnées du petit projectile bleu circulaire
     clip.frames.emplace_back(263, 120, 32, 28);
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
 
     registry.addComponent<AnimatedSprite2D>(projectile_id, animation);
 
     BoxCollisionComponent collision;
-    collision.tagCollision.emplace_back("AI");
+    collision.tagCollision.add("AI");
     registry.addComponent<BoxCollisionComponent>(projectile_id, collision);
 
     AudioSourceComponent audio;
@@ -54,19 +54,15 @@ void PowerUpSystem::updateActivePowerUps(Registry& registry, system_context cont
 }
 
 void PowerUpSystem::checkPowerUpCollisions(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
     Entity player_entity = -1;
     auto& teams = registry.getEntities<TeamComponent>();
     for (auto entity : teams) {
         auto& team = registry.getConstComponent<TeamComponent>(entity);
         if (team.team == TeamComponent::ALLY) {
             if (registry.hasComponent<TagComponent>(entity)) {
-                auto& tags = registry.getConstComponent<TagComponent>(entity);
-                for (const auto& tag : tags.tags) {
-                    if (tag == "PLAYER") {
-                        player_entity = entity;
-                        break;
-                    }
-                }
+                if (registry.getConstComponent<TagComponent>(entity).tags.has(player_tag))
+                    player_entity = entity;
             }
         }
         if (player_entity != -1)
@@ -133,8 +129,8 @@ void PowerUpSystem::spawnSpeedUp(Registry& registry, system_context context, flo
 
     clip.handle = handle;
     clip.frames.emplace_back(1, 99, 16, 16);  // Power-up sprite
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
     registry.addComponent<AnimatedSprite2D>(id, animation);
 
     auto& transform = registry.getComponent<transform_component_s>(id);
@@ -142,11 +138,11 @@ void PowerUpSystem::spawnSpeedUp(Registry& registry, system_context context, flo
     transform.scale_y = 2.5f;
 
     BoxCollisionComponent collision;
-    collision.tagCollision.push_back("PLAYER");
+    collision.tagCollision.add("PLAYER");
     registry.addComponent<BoxCollisionComponent>(id, collision);
 
     TagComponent tags;
-    tags.tags.push_back("POWERUP");
+    tags.tags.add("POWERUP");
     registry.addComponent<TagComponent>(id, tags);
 
     // Add NetworkIdentity
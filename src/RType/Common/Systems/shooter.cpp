@@ -78,9 +78,9 @@ void ShooterSystem::create_projectile_with_pattern(Registry& registry, Entity ow
 
     TagComponent tags;
     if (team == TeamComponent::ALLY) {
-        tags.tags.push_back("FRIENDLY_PROJECTILE");
+        tags.tags.add("FRIENDLY_PROJECTILE");
     } else {
-        tags.tags.push_back("ENEMY_PROJECTILE");
+        tags.tags.add("ENEMY_PROJECTILE");
     }
 
     registry.addComponent<ProjectileComponent>(id, {static_cast<int>(owner_entity)});
@@ -134,8 +134,8 @@ void ShooterSystem::create_projectile_with_pattern(Registry& registry, Entity ow
         clip.handle = handle;
         clip.frames.emplace_back(sprite_x, sprite_y, sprite_w, sprite_h);
     }
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
 
     registry.addComponent<AnimatedSprite2D>(id, animation);
 
@@ -151,9 +151,9 @@ void ShooterSystem::create_projectile_with_pattern(Registry& registry, Entity ow
     registry.addComponent<BoxCollisionComponent>(id, {});
     BoxCollisionComponent& collision = registry.getComponent<BoxCollisionComponent>(id);
     if (team == TeamComponent::ALLY) {
-        collision.tagCollision.push_back("AI");
+        collision.tagCollision.add("AI");
     } else {
-        collision.tagCollision.push_back("PLAYER");
+        collision.tagCollision.add("PLAYER");
     }
 
     registry.addComponent<NetworkIdentity>(id, {static_cast<uint32_t>(id), 0});
@@ -177,9 +177,9 @@ void ShooterSystem::create_charged_projectile(Registry& registry, Entity owner_e
 
     TagComponent tags;
     if (team == TeamComponent::ALLY) {
-        tags.tags.push_back("FRIENDLY_PROJECTILE");
+        tags.tags.add("FRIENDLY_PROJECTILE");
     } else {
-        tags.tags.push_back("ENEMY_PROJECTILE");
+        tags.tags.add("ENEMY_PROJECTILE");
     }
 
     registry.addComponent<ProjectileComponent>(id, {static_cast<int>(owner_entity)});
@@ -250,17 +250,17 @@ void ShooterSystem::create_charged_projectile(Registry& registry, Entity owner_e
         clip.frames.emplace_back(sprite_x + base_w * 2, sprite_y, w, h);
         clip.frames.emplace_back(sprite_x + base_w * 3, sprite_y, w, h);
     }
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
 
     registry.addComponent<AnimatedSprite2D>(id, animation);
 
     registry.addComponent<BoxCollisionComponent>(id, {});
     BoxCollisionComponent& collision = registry.getComponent<BoxCollisionComponent>(id);
     if (team == TeamComponent::ALLY) {
-        collision.tagCollision.push_back("AI");
+        collision.tagCollision.add("AI");
     } else {
-        collision.tagCollision.push_back("PLAYER");
+        collision.tagCollision.add("PLAYER");
     }
 
     registry.addComponent<NetworkIdentity>(id, {static_cast<uint32_t>(id), 0});
@@ -272,6 +272,7 @@ void ShooterSystem::create_charged_projectile(Registry& registry, Entity owner_e
 }
 
 void ShooterSystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
     auto& shootersIds = registry.getEntities<ShooterComponent>();
 
     Entity player_entity = -1;
@@ -282,15 +283,12 @@ void ShooterSystem::update(Registry& registry, system_context context) {
         if (team.team == TeamComponent::ALLY) {
             if (registry.hasComponent<TagComponent>(entity)) {
                 auto& tags = registry.getConstComponent<TagComponent>(entity);
-                for (const auto& tag : tags.tags) {
-                    if (tag == "PLAYER") {
-                        player_entity = entity;
-                        if (registry.hasComponent<transform_component_s>(entity)) {
-                            auto& player_pos = registry.getConstComponent<transform_component_s>(entity);
-                            player_x = player_pos.x;
-                            player_y = player_pos.y;
-                        }
-                        break;
+                if (tags.tags.has(player_tag)) {
+                    player_entity = entity;
+                    if (registry.hasComponent<transform_component_s>(entity)) {
+                        auto& player_pos = registry.getConstComponent<transform_component_s>(entity);
+                        player_x = player_pos.x;
+                        player_y = player_pos.y;
                     }
                 }
             }
@@ -421,8 +419,8 @@ void ShooterSystem::create_pod_circular_laser(Registry& registry, Entity owner_e
     registry.addComponent<Velocity2D>(laser_id, speed);
 
     TagComponent tags;
-    tags.tags.push_back("FRIENDLY_PROJECTILE");
-    tags.tags.push_back("POD_LASER");
+    tags.tags.add("FRIENDLY_PROJECTILE");
+    tags.tags.add("POD_LASER");
     registry.addComponent<TagComponent>(laser_id, tags);
     registry.addComponent<TeamComponent>(laser_id, {TeamComponent::ALLY});
     registry.addComponent<ProjectileComponent>(laser_id, {static_cast<int>(owner_entity)});
@@ -444,13 +442,13 @@ void ShooterSystem::create_pod_circular_laser(Registry& registry, Entity owner_e
     clip.frames.emplace_back(96, 0, 48, 32);
     clip.frames.emplace_back(144, 0, 48, 32);
 
-    animation.animations.emplace("idle", clip);
-    animation.currentAnimation = "idle";
+    animation.addClip("idle", clip);
+    animation.play("idle");
 
     registry.addComponent<AnimatedSprite2D>(laser_id, animation);
 
     BoxCollisionComponent collision;
-    collision.tagCollision.push_back("AI");
+    collision.tagCollision.add("AI");
     registry.addComponent<BoxCollisionComponent>(laser_id, collision);
 
     registry.addComponent<NetworkIdentity>(laser_id, {static_cast<uint32_t>(laser_id), 0});
@@ -3,13 +3,12 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <fstream>
-#include <sstream>
 #include "Components/StandardComponents.hpp"
 #include "../Entities/Mobs/all_mobs.hpp"
 #include "../Components/game_timer.hpp"
 #include "../Components/scripted_spawn.hpp"
 #include "../../../../Engine/Lib/Components/LobbyIdComponent.hpp"
+#include "../../../../Engine/Core/Scene/SceneLoader.hpp"
 
 const float WORLD_WIDTH = 1920.0f;
 const float WORLD_HEIGHT = 1080.0f;
@@ -57,43 +56,26 @@ float EnemySpawnSystem::getRandomFloat(EnemySpawnComponent& comp, float min, flo
     return min + normalized * (max - min);
 }
 
-void EnemySpawnSystem::loadScriptedSpawns(ScriptedSpawnComponent& scripted_spawn, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open spawn script: " << filename << std::endl;
-        return;
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#')
-            continue;
-
-        if (line.find("spawn=") == 0) {
-            std::string content = line.substr(6);
-            std::stringstream ss(content);
-            std::string segment;
-            std::vector<std::string> parts;
-
-            while (std::getline(ss, segment, ',')) {
-                parts.push_back(segment);
-            }
-
-            if (parts.size() >= 9) {
-                SpawnEvent event;
-                event.trigger_time = std::stof(parts[0]);
-                event.enemy_type = parts[1];
-                event.x_position = std::stof(parts[2]);
-                event.y_position = std::stof(parts[3]);
-                event.count = std::stoi(parts[4]);
-                event.spacing = std::stof(parts[5]);
-                event.formation = parts[6];
-                event.custom_speed = std::stof(parts[7]);
-                event.custom_hp = std::stoi(parts[8]);
-                event.executed = false;
-
-                scripted_spawn.spawn_events.push_back(event);
-            }
+void EnemySpawnSystem::spawnFormation(Registry& registry, system_context context, SpawnFormation formation, float x,
+                                      float y, int count, float spacing, const std::string& enemy_type) {
+    if (formation == SpawnFormation::Single) {
+        spawnEnemy(registry, context, x, y, enemy_type);
+    } else if (formation == SpawnFormation::LineHorizontal) {
+        for (int i = 0; i < count; i++) {
+            spawnEnemy(registry, context, x + (i * spacing), y, enemy_type);
+        }
+    } else if (formation == SpawnFormation::LineVertical) {
+        for (int i = 0; i < count; i++) {
+            spawnEnemy(registry, context, x, y + (i * spacing), enemy_type);
+        }
+    } else if (formation == SpawnFormation::VFormation) {
+        for (int i = 0; i < count; i++) {
+            float y_offset = std::abs(i - count / 2) * spacing;
+            spawnEnemy(registry, context, x + (i * 50), y + y_offset, enemy_type);
+        }
+    } else if (formation == SpawnFormation::Snake) {
+        for (int i = 0; i < count; i++) {
+            spawnEnemy(registry, context, x + (i * spacing), y + std::sin(i) * 50, enemy_type);
         }
     }
 }
@@ -106,49 +88,38 @@ void EnemySpawnSystem::handleScriptedSpawns(Registry& registry, system_context c
 
     scripted_spawn.level_time += context.dt;
 
-    while (scripted_spawn.next_event_index < scripted_spawn.spawn_events.size()) {
-        SpawnEvent& event = scripted_spawn.spawn_events[scripted_spawn.next_event_index];
-
-        if (scripted_spawn.level_time >= event.trigger_time) {
-            // Execute spawn event
-            if (event.formation == "SINGLE") {
-                spawnEnemy(registry, context, event.x_position, event.y_position, event.enemy_type);
-            } else if (event.formation == "LINE_HORIZONTAL") {
-                for (int i = 0; i < event.count; i++) {
-                    spawnEnemy(registry, context, event.x_position + (i * event.spacing), event.y_position,
-                               event.enemy_type);
-                }
-            } else if (event.formation == "LINE_VERTICAL") {
-                for (int i = 0; i < event.count; i++) {
-                    spawnEnemy(registry, context, event.x_position, event.y_position + (i * event.spacing),
-                               event.enemy_type);
-                }
-            } else if (event.formation == "V_FORMATION") {
-                for (int i = 0; i < event.count; i++) {
-                    float y_offset = std::abs(i - event.count / 2) * event.spacing;
-                    spawnEnemy(registry, context, event.x_position + (i * 50), event.y_position + y_offset,
-                               event.enemy_type);
-                }
-            } else if (event.formation == "SNAKE") {
-                for (int i = 0; i < event.count; i++) {
-                    spawnEnemy(registry, context, event.x_position + (i * event.spacing),
-                               event.y_position + std::sin(i) * 50, event.enemy_type);
-                }
-            }
+    // A compiled level is read from the records of its archive, a text one from its parsed events
+    const LevelArchive* archive = scripted_spawn.archive.get();
+    const std::size_t event_count = archive ? archive->spawns().size() : scripted_spawn.spawn_events.size();
 
-            event.executed = true;
-            scripted_spawn.next_event_index++;
+    while (scripted_spawn.next_event_index < event_count) {
+        if (archive) {
+            const level_archive::SpawnRecord& record = archive->spawns()[scripted_spawn.next_event_index];
+
+            if (scripted_spawn.level_time < record.trigger_time)
+                break;  // Events are sorted by time, so we can stop checking
+            spawnFormation(registry, context, record.formation, record.x_position, record.y_position, record.count,
+                           record.spacing, std::string(archive->string(record.enemy_type)));
         } else {
-            break;  // Events are sorted by time, so we can stop checking
+            SpawnEvent& event = scripted_spawn.spawn_events[scripted_spawn.next_event_index];
+
+            if (scripted_spawn.level_time < event.trigger_time)
+                break;
+            spawnFormation(registry, context, event.formation, event.x_position, event.y_position, event.count,
+                           event.spacing, event.enemy_type);
+            event.executed = true;
         }
+        scripted_spawn.next_event_index++;
     }
 
-    if (scripted_spawn.next_event_index >= scripted_spawn.spawn_events.size()) {
+    if (scripted_spawn.next_event_index >= event_count) {
         scripted_spawn.all_events_completed = true;
     }
 }
 
 void EnemySpawnSystem::update(Registry& registry, system_context context) {
+    static const TagSet enemy_tags{"AI", "ENEMY_PROJECTILE", "OBSTACLE"};
+    static const TagId boss_tag = TagRegistry::intern("BOSS");
     auto& spawners = registry.getEntities<EnemySpawnComponent>();
     float windowWidth = WORLD_WIDTH;
     float windowHeight = WORLD_HEIGHT;
@@ -167,17 +138,7 @@ void EnemySpawnSystem::update(Registry& registry, system_context context) {
         if (!registry.hasComponent<TagComponent>(entity))
             continue;
         auto& tags = registry.getConstComponent<TagComponent>(entity);
-        bool is_enemy = false;
-        bool is_boss = false;
-        for (const auto& tag : tags.tags) {
-            if (tag == "AI" || tag == "ENEMY_PROJECTILE" || tag == "OBSTACLE") {
-                is_enemy = true;
-            }
-            if (tag == "BOSS") {
-                is_boss = true;
-            }
-        }
-        if (!is_enemy || is_boss)
+        if (!tags.tags.intersects(enemy_tags) || tags.tags.has(boss_tag))
             continue;  // Ne pas détruire le boss
 
         auto& transform = registry.getConstComponent<transform_component_s>(entity);
@@ -209,10 +170,10 @@ void EnemySpawnSystem::update(Registry& registry, system_context context) {
         }
 
         // Load script if empty (first run)
-        if (scripted_spawn.spawn_events.empty() && !scripted_spawn.all_events_completed) {
+        if (scripted_spawn.spawn_events.empty() && !scripted_spawn.archive && !scripted_spawn.all_events_completed) {
             std::string path = scripted_spawn.script_path.empty() ? "src/RType/Common/content/config/level1_spawns.cfg"
                                                                   : scripted_spawn.script_path;
-            loadScriptedSpawns(scripted_spawn, path);
+            scripted_spawn.spawn_events = SceneLoader::loadSpawnScript(path);
         }
 
         handleScriptedSpawns(registry, context, scripted_spawn, windowWidth, windowHeight);
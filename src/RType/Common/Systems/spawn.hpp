@@ -29,9 +29,10 @@ class EnemySpawnSystem : public ISystem {
     bool handleBossSpawn(Registry& registry, system_context context, EnemySpawnComponent& spawn_comp);
     void spawnWave(Registry& registry, system_context context, EnemySpawnComponent& spawn_comp, float windowWidth,
                    float windowHeight);
-    void loadScriptedSpawns(ScriptedSpawnComponent& scripted_spawn, const std::string& filename);
     void handleScriptedSpawns(Registry& registry, system_context context, ScriptedSpawnComponent& scripted_spawn,
                               float windowWidth, float windowHeight);
+    void spawnFormation(Registry& registry, system_context context, SpawnFormation formation, float x, float y,
+                        int count, float spacing, const std::string& enemy_type);
 
     int getRandomInt(EnemySpawnComponent& comp, int min, int max);
     float getRandomFloat(EnemySpawnComponent& comp, float min, float max);
@@ -19,6 +19,7 @@
 #include "score.hpp"
 
 void StatusDisplaySystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
 #if defined(CLIENT_BUILD)
     auto& statusEntities = registry.getEntities<StatusDisplayComponent>();
     if (!statusEntities.empty()) {
@@ -30,16 +31,11 @@ void StatusDisplaySystem::update(Registry& registry, system_context context) {
                 if (team.team == TeamComponent::ALLY) {
                     if (registry.hasComponent<TagComponent>(entity)) {
                         auto& tags = registry.getConstComponent<TagComponent>(entity);
-                        for (const auto& tag : tags.tags) {
-                            if (tag == "PLAYER") {
-                                // Validate ownership
-                                if (registry.hasComponent<NetworkIdentity>(entity)) {
-                                    auto& netId = registry.getConstComponent<NetworkIdentity>(entity);
-                                    if (netId.ownerId == context.player_id) {
-                                        status.setPlayerEntity(entity);
-                                        break;
-                                    }
-                                }
+                        // Validate ownership
+                        if (tags.tags.has(player_tag) && registry.hasComponent<NetworkIdentity>(entity)) {
+                            auto& netId = registry.getConstComponent<NetworkIdentity>(entity);
+                            if (netId.ownerId == context.player_id) {
+                                status.setPlayerEntity(entity);
                             }
                         }
                     }
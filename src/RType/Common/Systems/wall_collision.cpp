@@ -16,6 +16,8 @@
 #include <iostream>
 
 void WallCollisionSystem::update(Registry& registry, system_context context) {
+    static const TagId player_tag = TagRegistry::intern("PLAYER");
+    static const TagSet projectile_tags{"FRIENDLY_PROJECTILE", "ENEMY_PROJECTILE"};
     auto& walls = registry.getEntities<WallComponent>();
     auto& players = registry.getEntities<TagComponent>();
 
@@ -31,16 +33,8 @@ void WallCollisionSystem::update(Registry& registry, system_context context) {
         const auto& wall_transform = registry.getConstComponent<transform_component_s>(wall_entity);
         const auto& wall_sprite = registry.getConstComponent<AnimatedSprite2D>(wall_entity);
 
-        float wall_width = wall.width > 0 ? wall.width
-                                          : wall_sprite.animations.at(wall_sprite.currentAnimation)
-                                                    .frames.at(wall_sprite.currentFrameIndex)
-                                                    .width *
-                                                wall_transform.scale_x;
-        float wall_height = wall.height > 0 ? wall.height
-                                            : wall_sprite.animations.at(wall_sprite.currentAnimation)
-                                                      .frames.at(wall_sprite.currentFrameIndex)
-                                                      .height *
-                                                  wall_transform.scale_y;
+        float wall_width = wall.width > 0 ? wall.width : wall_sprite.hitboxWidth * wall_transform.scale_x;
+        float wall_height = wall.height > 0 ? wall.height : wall_sprite.hitboxHeight * wall_transform.scale_y;
 
         for (auto entity : players) {
             uint32_t entity_lobby_id = engine::utils::getLobbyId(registry, entity);
@@ -59,18 +53,8 @@ void WallCollisionSystem::update(Registry& registry, system_context context) {
 
             const auto& tags = registry.getConstComponent<TagComponent>(entity);
 
-            bool is_player = false;
-            bool is_projectile = false;
-            for (const auto& tag : tags.tags) {
-                if (tag == "PLAYER") {
-                    is_player = true;
-                    break;
-                }
-                if (tag == "FRIENDLY_PROJECTILE" || tag == "ENEMY_PROJECTILE") {
-                    is_projectile = true;
-                    break;
-                }
-            }
+            bool is_player = tags.tags.has(player_tag);
+            bool is_projectile = !is_player && tags.tags.intersects(projectile_tags);
 
             if (!is_player && !is_projectile)
                 continue;
@@ -78,14 +62,8 @@ void WallCollisionSystem::update(Registry& registry, system_context context) {
             auto& entity_transform = registry.getComponent<transform_component_s>(entity);
             const auto& entity_sprite = registry.getConstComponent<AnimatedSprite2D>(entity);
 
-            float entity_width = entity_sprite.animations.at(entity_sprite.currentAnimation)
-                                     .frames.at(entity_sprite.currentFrameIndex)
-                                     .width *
-                                 entity_transform.scale_x;
-            float entity_height = entity_sprite.animations.at(entity_sprite.currentAnimation)
-                                      .frames.at(entity_sprite.currentFrameIndex)
-                                      .height *
-                                  entity_transform.scale_y;
+            float entity_width = entity_sprite.hitboxWidth * entity_transform.scale_x;
+            float entity_height = entity_sprite.hitboxHeight * entity_transform.scale_y;
 
             float entity_left = entity_transform.x;
             float entity_right = entity_transform.x + entity_width;
@@ -1,7 +1,11 @@
+#include <charconv>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <type_traits>
 #include <string>
+#include <string_view>
 #include "ClientGameEngine.hpp"
 #include "GameEngineConfig.hpp"
 #include "Lib/GameManager/GameManager.hpp"
@@ -16,20 +20,52 @@ void setupPrediction(T& engine, GameManager& gm) {
     }
 }
 
+#if defined(SERVER_BUILD)
+/**
+    @param std::string_view argument given as tick rate
+    @return The rate if it is a whole number of ticks per second the scheduler supports
+*/
+static std::optional<uint32_t> parseTickRate(std::string_view arg) {
+    uint32_t tick_rate = 0;
+    const char* end = arg.data() + arg.size();
+    auto [ptr, error] = std::from_chars(arg.data(), end, tick_rate);
+
+    if (error != std::errc() || ptr != end || tick_rate == 0 || tick_rate > TickScheduler::MAX_TICK_RATE) {
+        return std::nullopt;
+    }
+    return tick_rate;
+}
+#endif
+
 int main(int argc, char* argv[]) {
     std::string ip = "127.0.0.1";
     if (argc > 1) {
         ip = argv[1];
     }
+
+#if defined(SERVER_BUILD)
+    uint32_t tick_rate = TickScheduler::DEFAULT_TICK_RATE;
+    if (argc > 2) {
+        std::optional<uint32_t> parsed = parseTickRate(argv[2]);
+        if (!parsed) {
+            std::cerr << "Usage: " << argv[0] << " [ip] [tick_rate]" << std::endl
+                      << "    tick_rate: ticks per second, between 1 and " << TickScheduler::MAX_TICK_RATE
+                      << " (default " << TickScheduler::DEFAULT_TICK_RATE << ")" << std::endl;
+            return 84;
+        }
+        tick_rate = *parsed;
+    }
+#endif
+
     GameEngine engine(ip);
-    GameManager gm;
 
-#if defined(CLIENT_BUILD)
-    gm.setWindow(&engine.getWindow());
-    gm.setLocalPlayerId(engine.getClientId());
+#if defined(SERVER_BUILD)
+    engine.setTickRate(tick_rate);
+    for (const char* action : GameManager::INPUT_ACTIONS) {
+        engine.getInputManager().registerAction(action);
+    }
 #endif
 
-    setupPrediction(engine, gm);
     engine.registerNetworkComponent<DamageOnCollision>();
     engine.registerNetworkComponent<TeamComponent>();
     engine.registerNetworkComponent<ProjectileComponent>();
@@ -45,9 +81,25 @@ int main(int argc, char* argv[]) {
     engine.registerNetworkComponent<BossSubEntityComponent>();
     engine.registerNetworkComponent<ScoreComponent>();
 
+#if defined(SERVER_BUILD)
+    // A GameManager holds the state of one game, every lobby gets its own
+    engine.setGameFactory([]() {
+        auto gm = std::make_shared<GameManager>();
+        return ServerGameEngine::GameFunctions{
+            [gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm->init(env, inputs); },
+            [gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm->update(env, inputs); }};
+    });
+    engine.run();
+#else
+    GameManager gm;
+    gm.setWindow(&engine.getWindow());
+    gm.setLocalPlayerId(engine.getClientId());
+    setupPrediction(engine, gm);
+
     engine.setInitFunction([&gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm.init(env, inputs); });
 
     engine.setLoopFunction([&gm](std::shared_ptr<Environment> env, InputManager& inputs) { gm.update(env, inputs); });
     engine.run();
+#endif
     return 0;
 }
@@ -0,0 +1,83 @@
+/*
+** EPITECH PROJECT, 2025
+** R-Type
+** File description:
+** level-compiler - Checks the text sources of levels and writes their archives
+*/
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "src/Engine/Core/Scene/LevelArchive.hpp"
+#include "src/Engine/Core/Scene/SceneLoader.hpp"
+#include "src/RType/Common/Components/config.hpp"
+
+// The configs a level names have to load the way the game loads them
+static void checkConfigs(const LevelConfig& level, std::vector<std::string>& problems) {
+    try {
+        auto enemies = ConfigLoader::loadEnemiesConfig(level.enemies_config, ConfigLoader::getRequiredEnemyFields());
+        for (const auto& event : level.spawn_events) {
+            if (enemies.find(event.enemy_type) == enemies.end())
+                problems.push_back(level.spawn_script + ": unknown enemy type '" + event.enemy_type + "'");
+        }
+    } catch (const std::exception& e) {
+        problems.push_back(e.what());
+    }
+
+    try {
+        auto bosses = ConfigLoader::loadMap<EntityConfig>(level.boss_config, ConfigLoader::getRequiredBossFields());
+        if (bosses.find(level.boss_section) == bosses.end())
+            problems.push_back(level.boss_config + ": no [" + level.boss_section + "] section");
+    } catch (const std::exception& e) {
+        problems.push_back(e.what());
+    }
+
+    try {
+        ConfigLoader::loadGameConfig(level.game_config, ConfigLoader::getRequiredGameFields());
+    } catch (const std::exception& e) {
+        problems.push_back(e.what());
+    }
+
+    if (!level.next_level.empty() && !std::filesystem::exists(level.next_level))
+        problems.push_back("next level not found: " + level.next_level);
+}
+
+/**
+    Usage: level-compiler <level.scene>...
+    Writes the archive of each scene where LevelArchive::compiledPath puts it. Run it from the
+    directory the game runs from, as the paths inside a scene are relative to it
+*/
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <level.scene>..." << std::endl;
+        return 2;
+    }
+
+    int status = 0;
+    for (int arg = 1; arg < argc; arg++) {
+        const std::string scene = argv[arg];
+        std::vector<std::string> problems;
+
+        try {
+            LevelConfig level = SceneLoader::loadFromText(scene, &problems);
+            checkConfigs(level, problems);
+
+            if (problems.empty()) {
+                const std::string archive = LevelArchive::compiledPath(scene);
+                LevelArchive::save(level, archive);
+                std::cout << scene << " -> " << archive << " (" << level.entities.size() << " entities, "
+                          << level.spawn_events.size() << " spawns)" << std::endl;
+                continue;
+            }
+        } catch (const std::exception& e) {
+            problems.push_back(scene + ": " + e.what());
+        }
+
+        for (const auto& problem : problems)
+            std::cerr << "error: " << problem << std::endl;
+        status = 1;
+    }
+    return status;
+}
@@ -141,15 +141,15 @@ void GameManager::handleSpecialAttack(ECS& ecs, Player& attacker, const std::str
         AnimationClip clip;
         clip.frames.push_back({64 * 22, 0, 64, 64});
 
-        if (attackerSprite.animations.count("idle")) {
-            clip.handle = attackerSprite.animations.at("idle").handle;
+        if (const AnimationClip* idle = attackerSprite.clip("idle")) {
+            clip.handle = idle->handle;
         }
 
         clip.mode = AnimationMode::Loop;
         clip.frameDuration = 0.1f;
 
-        anim.animations.emplace("move", clip);
-        anim.currentAnimation = "move";
+        anim.addClip("move", clip);
+        anim.play("move");
         anim.flipX = facingLeft;
 
         ecs.registry.addComponent<AnimatedSprite2D>(projectile, anim);
@@ -182,7 +182,7 @@ void GameManager::updateProjectiles(ECS& ecs, float dt) {
                 bool isBlocking = false;
                 if (ecs.registry.hasComponent<AnimatedSprite2D>(p1Id)) {
                     auto& anim = ecs.registry.getComponent<AnimatedSprite2D>(p1Id);
-                    if (anim.currentAnimation == "block")
+                    if (anim.isCurrent("block"))
                         isBlocking = true;
                 }
 
@@ -216,7 +216,7 @@ void GameManager::updateProjectiles(ECS& ecs, float dt) {
                 bool isBlocking = false;
                 if (ecs.registry.hasComponent<AnimatedSprite2D>(p2Id)) {
                     auto& anim = ecs.registry.getComponent<AnimatedSprite2D>(p2Id);
-                    if (anim.currentAnimation == "block")
+                    if (anim.isCurrent("block"))
                         isBlocking = true;
                 }
 
@@ -261,7 +261,7 @@ void GameManager::handleCombat(ECS& ecs, Player& attacker, Player& victim, const
             bool isBlocking = false;
             if (ecs.registry.hasComponent<AnimatedSprite2D>(victim.getId())) {
                 auto& anim = ecs.registry.getComponent<AnimatedSprite2D>(victim.getId());
-                if (anim.currentAnimation == "block")
+                if (anim.isCurrent("block"))
                     isBlocking = true;
             }
 
@@ -43,7 +43,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipIdle.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("idle", clipIdle);
+    animation.addClip("idle", clipIdle);
     // IDLE ANIMATION
 
     // JUMP ANIMATION
@@ -57,7 +57,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipJump.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("jump", clipJump);
+    animation.addClip("jump", clipJump);
     // JUMP ANIMATION
 
     // FALL ANIMATION
@@ -70,7 +70,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipFall.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("fall", clipFall);
+    animation.addClip("fall", clipFall);
 
     // RUN ANIMATION
     AnimationClip clipRun;
@@ -82,7 +82,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipRun.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("run", clipRun);
+    animation.addClip("run", clipRun);
     // RUN ANIMATION
 
     // ATTACK ANIMATION
@@ -98,7 +98,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipAttack.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("attack", clipAttack);
+    animation.addClip("attack", clipAttack);
     // ATTACK ANIMATION
 
     // HEAVY ATTACK ANIMATION
@@ -114,7 +114,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipHeavyAttack.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("attack_heavy", clipHeavyAttack);
+    animation.addClip("attack_heavy", clipHeavyAttack);
     // HEAVY ATTACK ANIMATION
 
     // SPECIAL ATTACK ANIMATION
@@ -129,7 +129,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipSpecialAttack.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("special_attack", clipSpecialAttack);
+    animation.addClip("special_attack", clipSpecialAttack);
     // SPECIAL ATTACK ANIMATION
 
     // BLOCK ANIMATION
@@ -142,7 +142,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipBlock.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("block", clipBlock);
+    animation.addClip("block", clipBlock);
     // BLOCK ANIMATION
 
     // EJECTION ANIMATION
@@ -155,7 +155,7 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipEjection.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("ejection", clipEjection);
+    animation.addClip("ejection", clipEjection);
     // EJECTION ANIMATION
 
     // TAKE DAMAGE ANIMATION
@@ -168,10 +168,10 @@ void Player::setSpriteAnimation(const std::string pathname) {
     } else {
         clipTakeDamage.handle = _ecs._textureManager.load(pathname, sf::Texture(pathname));
     }
-    animation.animations.emplace("take_damage", clipTakeDamage);
+    animation.addClip("take_damage", clipTakeDamage);
     // TAKE DAMAGE ANIMATION
 
-    animation.currentAnimation = "idle";
+    animation.play("idle");
     animation.layer = RenderLayer::Midground;
 
     _ecs.registry.addComponent<AnimatedSprite2D>(_id, animation);
@@ -224,7 +224,6 @@ void Player::resetGravity() {
 
 void Player::resetAnimation() {
     AnimatedSprite2D& sprite = _ecs.registry.getComponent<AnimatedSprite2D>(_id);
-    sprite.currentAnimation = "idle";
     sprite.playIfNotPlaying("idle");
     return;
 }
@@ -322,8 +321,8 @@ void Player::updateAnimation() {
         } else {
             _gravityAccumulate = 0.0f;
         }
-        if (sprite.isPlaying() && (sprite.currentAnimation == "attack" || sprite.currentAnimation == "attack_heavy" ||
-                                   sprite.currentAnimation == "special_attack")) {
+        if (sprite.isPlaying() &&
+            (sprite.isCurrent("attack") || sprite.isCurrent("attack_heavy") || sprite.isCurrent("special_attack"))) {
             return;
         }
         if (_ecs.input.isPressed("attack_simple")) {
@@ -357,8 +356,8 @@ void Player::updateAnimation() {
         } else {
             _gravityAccumulate = 0.0f;
         }
-        if (sprite.isPlaying() && (sprite.currentAnimation == "attack" || sprite.currentAnimation == "attack_heavy" ||
-                                   sprite.currentAnimation == "special_attack")) {
+        if (sprite.isPlaying() &&
+            (sprite.isCurrent("attack") || sprite.isCurrent("attack_heavy") || sprite.isCurrent("special_attack"))) {
             return;
         }
         if (_ecs.input.isPressed("attack_simple2")) {
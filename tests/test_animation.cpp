@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "AnimationSystem/AnimationSystem.hpp"
+#include "Components/serialize/StandardComponents_serialize.hpp"
+
+namespace {
+
+AnimationClip makeClip(handle_t<TextureAsset> handle, int width, int frames, float duration) {
+    AnimationClip clip;
+
+    clip.handle = handle;
+    clip.frameDuration = duration;
+    for (int i = 0; i < frames; i++)
+        clip.frames.push_back({i * width, 0, width, width + i});
+    return clip;
+}
+
+}  // namespace
+
+TEST(AnimationTest, SpritesBuiltAlikeShareTheirClips) {
+    static_assert(std::is_trivially_copyable_v<AnimatedSprite2D>);
+    AnimatedSprite2D first;
+    AnimatedSprite2D second;
+
+    first.addClip("test_idle", makeClip({1, 0}, 16, 4, 0.1f));
+    first.addClip("test_hit", makeClip({1, 0}, 16, 2, 0.05f));
+    second.addClip("test_idle", makeClip({1, 0}, 16, 4, 0.1f));
+    second.addClip("test_hit", makeClip({1, 0}, 16, 2, 0.05f));
+    EXPECT_EQ(first.animations, second.animations);
+    EXPECT_EQ(first.animations->find("test_hit"), 1);
+
+    // Editing one sprite leaves the set the other one uses untouched
+    EXPECT_TRUE(second.editClip("test_hit", [](AnimationClip& clip) { clip.frameDuration = 1.f; }));
+    EXPECT_NE(first.animations, second.animations);
+    EXPECT_FLOAT_EQ(first.clip("test_hit")->frameDuration, 0.05f);
+    EXPECT_FLOAT_EQ(second.clip("test_hit")->frameDuration, 1.f);
+    EXPECT_FALSE(second.editClip("test_missing", [](AnimationClip&) {}));
+}
+
+TEST(AnimationTest, PlayingKeepsTheHitboxOfTheShownFrame) {
+    AnimatedSprite2D sprite;
+
+    sprite.addClip("test_idle", makeClip({2, 0}, 8, 3, 0.1f));
+    EXPECT_EQ(sprite.clip(), nullptr);
+    EXPECT_EQ(sprite.hitboxWidth, 0);
+
+    sprite.play("test_idle");
+    EXPECT_TRUE(sprite.isCurrent("test_idle"));
+    EXPECT_EQ(sprite.currentName(), "test_idle");
+    EXPECT_EQ(sprite.hitboxWidth, 8);
+    EXPECT_EQ(sprite.hitboxHeight, 8);
+
+    AnimationSystem::step(sprite, 0.15f);
+    EXPECT_EQ(sprite.currentFrameIndex, 1u);
+    EXPECT_EQ(sprite.hitboxHeight, 9);
+
+    AnimationSystem::step(sprite, 0.2f);
+    EXPECT_EQ(sprite.currentFrameIndex, 0u);
+    EXPECT_EQ(sprite.hitboxHeight, 8);
+
+    sprite.play("test_missing");
+    EXPECT_EQ(sprite.currentClip, NO_ANIMATION_CLIP);
+    EXPECT_EQ(sprite.frame(), nullptr);
+    EXPECT_EQ(sprite.hitboxWidth, 0);
+}
+
+TEST(AnimationTest, ReplicatesTheClipIndexAndFrame) {
+    ResourceManager<TextureAsset> server;
+    ResourceManager<TextureAsset> client;
+    AnimatedSprite2D sprite;
+
+    sprite.addClip("test_idle", makeClip(server.load("test_idle.png", TextureAsset("test_idle.png")), 32, 4, 0.1f));
+    sprite.addClip("test_run", makeClip(server.load("test_run.png", TextureAsset("test_run.png")), 24, 6, 0.1f));
+    sprite.play("test_run");
+    sprite.flipX = true;
+
+    std::vector<uint8_t> first;
+    std::size_t offset = 0;
+    serialize::serialize(first, sprite, server);
+    uint64_t key = serialize::AnimationSetWire::key(*sprite.animations, server);
+
+    // The record carries the key only, read before the definition it holds a placeholder
+    AnimatedSprite2D early = serialize::deserialize_animated_sprite_2d(first, offset, client);
+    EXPECT_EQ(offset, first.size());
+    EXPECT_TRUE(early.animations->clips.empty());
+    EXPECT_EQ(early.hitboxWidth, 0);
+
+    std::vector<uint8_t> definition;
+    ASSERT_TRUE(serialize::AnimationSetWire::definition(key, definition));
+    EXPECT_GT(definition.size(), first.size());
+    offset = 0;
+    const AnimationSet* set = serialize::AnimationSetWire::define(definition, offset, client);
+    ASSERT_NE(set, nullptr);
+    EXPECT_EQ(offset, definition.size());
+    EXPECT_EQ(serialize::AnimationSetWire::resolve(early.animations), set);
+
+    offset = 0;
+    AnimatedSprite2D received = serialize::deserialize_animated_sprite_2d(first, offset, client);
+    EXPECT_EQ(received.animations, set);
+    EXPECT_TRUE(received.isCurrent("test_run"));
+    EXPECT_TRUE(received.flipX);
+    EXPECT_EQ(received.hitboxWidth, 24);
+    EXPECT_EQ(received.clip()->handle, client.get_handle("test_run.png").value().get());
+
+    // A new frame changes the frame index only
+    AnimationSystem::step(sprite, 0.1f);
+    std::vector<uint8_t> second;
+    serialize::serialize(second, sprite, server);
+    ASSERT_EQ(first.size(), second.size());
+    for (std::size_t idx = 16; idx < first.size(); ++idx)
+        EXPECT_EQ(first[idx], second[idx]) << "byte " << idx;
+
+    offset = 0;
+    AnimatedSprite2D next = serialize::deserialize_animated_sprite_2d(second, offset, client);
+    EXPECT_EQ(offset, second.size());
+    EXPECT_EQ(next.animations, received.animations);
+    EXPECT_EQ(next.currentFrameIndex, 1u);
+    EXPECT_EQ(next.hitboxHeight, 25);
+
+    // A damaged definition is refused
+    definition.back() ^= 1;
+    offset = 0;
+    EXPECT_EQ(serialize::AnimationSetWire::define(definition, offset, client), nullptr);
+}
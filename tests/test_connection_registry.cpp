@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "Network.hpp"
+#include "ServerInterface.hpp"
+
+namespace {
+
+using GameEvents = network::GameEvents;
+using ConnectionPtr = std::shared_ptr<network::Connection<GameEvents>>;
+
+// Connections are opened sockets that never connect, the io_context never runs
+class SimulatedServer : public network::ServerInterface<GameEvents> {
+   public:
+    SimulatedServer() : network::ServerInterface<GameEvents>(0) {}
+
+    ConnectionPtr connect(uint32_t id) {
+        asio::ip::tcp::socket socket(_asioContext);
+        socket.open(asio::ip::tcp::v4());
+        auto connection = std::make_shared<network::Connection<GameEvents>>(
+            network::Connection<GameEvents>::owner::server, _asioContext, std::move(socket), _MessagesIn,
+            _messagePool, _udpSender);
+        connection->ConnectToClient(id);
+        RegisterConnection(connection);
+        return connection;
+    }
+
+    void drop(const ConnectionPtr& connection) {
+        UnregisterConnection(connection);
+        _deqConnections.erase(std::remove(_deqConnections.begin(), _deqConnections.end(), connection),
+                              _deqConnections.end());
+    }
+
+    // Hands one datagram to the server as if the UdpReceiver had just read it
+    void receive(const asio::ip::udp::endpoint& sender, uint32_t userId) {
+        std::vector<network::received_datagram<GameEvents>> batch(1);
+
+        batch[0].sender = sender;
+        batch[0].msg.header.user_id = userId;
+        DispatchUDP(batch);
+    }
+
+    // Connection each datagram handed to the game thread came from
+    std::vector<ConnectionPtr> delivered() {
+        std::vector<network::owned_message<GameEvents>> messages;
+        std::vector<ConnectionPtr> remotes;
+
+        _MessagesIn.pop_all(messages);
+        for (auto& msg : messages) {
+            remotes.push_back(msg.remote);
+        }
+        return remotes;
+    }
+
+    std::size_t size() const { return _deqConnections.size(); }
+};
+
+asio::ip::udp::endpoint loopback(uint16_t port) {
+    return asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), port);
+}
+
+}  // namespace
+
+TEST(ConnectionRegistryTest, FindsEveryConnectionById) {
+    SimulatedServer server;
+    std::vector<ConnectionPtr> connections;
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        connections.push_back(server.connect(10000 + i));
+    }
+    ASSERT_EQ(server.size(), 500u);
+    for (uint32_t i = 0; i < 500; ++i) {
+        EXPECT_EQ(server.GetConnection(10000 + i), connections[i]);
+    }
+    EXPECT_EQ(server.GetConnection(9999), nullptr);
+    EXPECT_EQ(server.GetConnection(10500), nullptr);
+}
+
+TEST(ConnectionRegistryTest, DroppedConnectionsAreForgotten) {
+    SimulatedServer server;
+    std::vector<ConnectionPtr> connections;
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        connections.push_back(server.connect(10000 + i));
+    }
+    for (uint32_t i = 0; i < 500; i += 5) {
+        server.drop(connections[i]);
+    }
+    EXPECT_EQ(server.size(), 400u);
+    for (uint32_t i = 0; i < 500; ++i) {
+        EXPECT_EQ(server.GetConnection(10000 + i), i % 5 == 0 ? nullptr : connections[i]);
+    }
+}
+
+TEST(ConnectionRegistryTest, StaleConnectionDoesNotEraseItsReplacement) {
+    SimulatedServer server;
+    auto first = server.connect(42);
+
+    server.drop(first);
+    auto second = server.connect(42);
+    server.drop(first);
+    EXPECT_EQ(server.GetConnection(42), second);
+}
+
+TEST(ConnectionRegistryTest, LearnsUdpEndpointFromFirstDatagram) {
+    SimulatedServer server;
+    auto first = server.connect(10000);
+    auto second = server.connect(10001);
+
+    server.receive(loopback(5000), 10000);
+    server.receive(loopback(5001), 10001);
+    // Once known, the endpoint wins over the id in the header
+    server.receive(loopback(5000), 0);
+    server.receive(loopback(5002), 0);
+
+    EXPECT_EQ(first->GetUDPEndpoint(), loopback(5000));
+    EXPECT_EQ(second->GetUDPEndpoint(), loopback(5001));
+    EXPECT_EQ(server.delivered(), (std::vector<ConnectionPtr>{first, second, first}));
+}
+
+TEST(ConnectionRegistryTest, DroppedConnectionEndpointIsForgotten) {
+    SimulatedServer server;
+    auto first = server.connect(10000);
+
+    server.receive(loopback(5000), 10000);
+    server.drop(first);
+    server.receive(loopback(5000), 0);
+    auto second = server.connect(10001);
+    server.receive(loopback(5000), 10001);
+
+    EXPECT_EQ(second->GetUDPEndpoint(), loopback(5000));
+    EXPECT_EQ(server.delivered(), (std::vector<ConnectionPtr>{first, second}));
+}
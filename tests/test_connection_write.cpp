@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "Connection.hpp"
+#include "Network.hpp"
+
+using network::GameEvents;
+
+namespace {
+
+// A server-side connection writing to a plain TCP socket on loopback
+class LoopbackConnection {
+   public:
+    LoopbackConnection()
+        : _socket(_context), _udpSocket(_context), _udpSender(_context, _udpSocket, _pool), peer(_context) {
+        asio::ip::tcp::acceptor acceptor(_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        peer.connect(acceptor.local_endpoint());
+        acceptor.accept(_socket);
+
+        connection = std::make_shared<network::Connection<GameEvents>>(
+            network::Connection<GameEvents>::owner::server, _context, std::move(_socket), _in, _pool, _udpSender);
+    }
+
+    ~LoopbackConnection() { connection.reset(); }
+
+    void runAsio() {
+        _context.restart();
+        _context.run();
+    }
+
+    network::message<GameEvents> receive() {
+        network::message<GameEvents> msg;
+
+        asio::read(peer, asio::buffer(&msg.header, sizeof(msg.header)));
+        msg.body.resize(msg.header.size);
+        asio::read(peer, asio::buffer(msg.body.data(), msg.body.size()));
+        return msg;
+    }
+
+    network::MessagePool<GameEvents>& pool() { return _pool; }
+
+   private:
+    asio::io_context _context;
+    network::MessagePool<GameEvents> _pool;
+    network::RingQueue<network::owned_message<GameEvents>> _in{network::INBOUND_QUEUE_CAPACITY};
+    asio::ip::tcp::socket _socket;
+    asio::ip::udp::socket _udpSocket;
+    network::UdpSender<GameEvents> _udpSender;
+
+   public:
+    asio::ip::tcp::socket peer;
+    std::shared_ptr<network::Connection<GameEvents>> connection;
+};
+
+}  // namespace
+
+TEST(ConnectionWriteTest, WritesQueuedMessagesInOrder) {
+    constexpr uint32_t MESSAGES = 300;
+    LoopbackConnection loopback;
+
+    for (uint32_t i = 0; i < MESSAGES; ++i) {
+        network::message<GameEvents> msg;
+        msg.header.id = GameEvents::S_CANCEL_READY_BROADCAST;
+        // Every third message has no body, so header-only messages sit between the others
+        if (i % 3 != 0)
+            msg << i;
+        msg.header.size = msg.body.size();
+        loopback.connection->Send(std::move(msg));
+    }
+    loopback.runAsio();
+
+    for (uint32_t i = 0; i < MESSAGES; ++i) {
+        auto msg = loopback.receive();
+        EXPECT_EQ(msg.header.id, GameEvents::S_CANCEL_READY_BROADCAST);
+        if (i % 3 != 0) {
+            uint32_t value = 0;
+            msg >> value;
+            EXPECT_EQ(value, i);
+        } else {
+            EXPECT_TRUE(msg.body.empty());
+        }
+    }
+}
+
+TEST(ConnectionWriteTest, DropsAndDisconnectsWhenThePeerStopsReading) {
+    constexpr uint32_t EXTRA = 10;
+    LoopbackConnection loopback;
+    network::message<GameEvents> msg;
+
+    msg.header.id = GameEvents::S_CANCEL_READY_BROADCAST;
+    // Nothing drains the queue until asio runs, past its capacity Send must return anyway
+    for (uint32_t i = 0; i < network::OUTBOUND_QUEUE_CAPACITY + EXTRA; ++i) {
+        loopback.connection->Send(msg);
+    }
+    EXPECT_EQ(loopback.connection->GetDroppedMessages(), EXTRA);
+    EXPECT_TRUE(loopback.connection->IsConnected());
+
+    loopback.runAsio();
+    EXPECT_FALSE(loopback.connection->IsConnected());
+}
+
+TEST(ConnectionWriteTest, GivesTheMovedBodyBackToThePoolOnceWritten) {
+    LoopbackConnection loopback;
+    network::message<GameEvents> msg = loopback.pool().acquire(sizeof(uint32_t));
+    const uint8_t* body = nullptr;
+
+    msg.header.id = GameEvents::S_CANCEL_READY_BROADCAST;
+    network::MessageWriter<GameEvents>(msg, sizeof(uint32_t)) << uint32_t{42};
+    body = msg.body.data();
+    loopback.connection->Send(std::move(msg));
+    loopback.runAsio();
+
+    auto received = loopback.receive();
+    uint32_t value = 0;
+    received >> value;
+    EXPECT_EQ(value, 42u);
+
+    // The next packet is built in the very allocation the first one was sent from
+    ASSERT_EQ(loopback.pool().available(), 1u);
+    EXPECT_EQ(loopback.pool().acquire().body.data(), body);
+}
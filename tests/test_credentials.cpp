@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <cctype>
+#include <cstdint>
+#include <set>
+#include <string>
+#include "Credentials.hpp"
+
+namespace {
+
+std::string hex(const credentials::Digest& digest) {
+    static const char* digits = "0123456789abcdef";
+    std::string out;
+
+    for (uint8_t byte : digest) {
+        out += digits[byte >> 4];
+        out += digits[byte & 0x0F];
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(CredentialsTest, MatchesReferenceVectors) {
+    EXPECT_EQ(hex(credentials::Sha256("abc")), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(hex(credentials::Sha256(std::string(1000, 'a'))),
+              "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+    // RFC 7914 section 11
+    EXPECT_EQ(hex(credentials::Pbkdf2Sha256("password", "salt", 1)),
+              "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b");
+    EXPECT_EQ(hex(credentials::Pbkdf2Sha256("password", "salt", 4096)),
+              "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a");
+}
+
+TEST(CredentialsTest, HashesPasswordsIntoVersionedRecords) {
+    std::string record = credentials::HashPassword("hunter2", 1000);
+    std::string again = credentials::HashPassword("hunter2", 1000);
+
+    EXPECT_EQ(record.rfind("pbkdf2-sha256$1000$", 0), 0u);
+    EXPECT_NE(record, again);  // salted
+    EXPECT_TRUE(credentials::VerifyPassword("hunter2", record));
+    EXPECT_TRUE(credentials::VerifyPassword("hunter2", again));
+    EXPECT_FALSE(credentials::VerifyPassword("hunter3", record));
+
+    EXPECT_TRUE(credentials::IsPasswordRecord(record));
+    EXPECT_FALSE(credentials::IsPasswordRecord("hunter2"));
+    EXPECT_FALSE(credentials::IsPasswordRecord("pbkdf2-sha256$0$00$00"));
+    EXPECT_FALSE(credentials::VerifyPassword("hunter2", "hunter2"));
+
+    EXPECT_FALSE(credentials::NeedsRehash(record, 1000));
+    EXPECT_TRUE(credentials::NeedsRehash(record, 2000));
+    EXPECT_TRUE(credentials::NeedsRehash("hunter2", 1));
+}
+
+TEST(CredentialsTest, GeneratesDistinctAlphanumericTokens) {
+    std::set<std::string> tokens;
+
+    for (int idx = 0; idx < 100; ++idx) {
+        std::string token = credentials::GenerateToken();
+
+        ASSERT_EQ(token.size(), credentials::TOKEN_LENGTH);
+        for (char character : token) {
+            EXPECT_TRUE(std::isalnum(static_cast<unsigned char>(character)));
+        }
+        tokens.insert(token);
+    }
+    EXPECT_EQ(tokens.size(), 100u);
+    EXPECT_EQ(credentials::HashToken("abc"), hex(credentials::Sha256("abc")));
+}
+
+TEST(CredentialsTest, ComparesWholeStrings) {
+    EXPECT_TRUE(credentials::ConstantTimeEquals("token", "token"));
+    EXPECT_FALSE(credentials::ConstantTimeEquals("token", "tokem"));
+    EXPECT_FALSE(credentials::ConstantTimeEquals("token", "token2"));
+    EXPECT_TRUE(credentials::ConstantTimeEquals("", ""));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Database.hpp"
+#include "sqlite3.h"
+
+class DatabaseTest : public ::testing::Test {
+   protected:
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "rtype_test_database.db";
+    // Cheap hashes, the tests check what is stored, not how long it takes
+    static constexpr uint32_t ITERATIONS = 1000;
+
+    void SetUp() override { removeFiles(); }
+    void TearDown() override { removeFiles(); }
+
+    // WAL mode keeps its log and shared memory next to the database
+    void removeFiles() {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::filesystem::remove(path.string() + suffix);
+        }
+    }
+};
+
+TEST_F(DatabaseTest, RegistersAndLogsIn) {
+    Database database(path.string(), ITERATIONS);
+
+    auto registered = database.Submit([](Database& db) {
+        int first = db.RegisterUser("alice", "secret");
+        int again = db.RegisterUser("alice", "other");
+        return std::make_pair(first, again);
+    });
+    auto [userID, again] = registered.get();
+    ASSERT_NE(userID, -1);
+    // A taken name is refused, the first password still logs in
+    EXPECT_EQ(again, -1);
+    EXPECT_EQ(database.Submit([](Database& db) { return db.LoginUser("alice", "secret"); }).get(), userID);
+    EXPECT_EQ(database.Submit([](Database& db) { return db.LoginUser("alice", "wrong"); }).get(), -1);
+
+    database.Submit([userID](Database& db) { db.SaveToken(userID, "TOKEN42"); }).get();
+    EXPECT_EQ(database.Submit([](Database& db) { return db.GetUserByToken("TOKEN42"); }).get(), userID);
+    EXPECT_EQ(database.Submit([userID](Database& db) { return db.GetNameById(userID); }).get(), "alice");
+    EXPECT_EQ(database.Submit([](Database& db) { return db.GetUserByToken("TOKEN41"); }).get(), -1);
+}
+
+TEST_F(DatabaseTest, KeepsTheBestScoreAcrossReopening) {
+    int userID = -1;
+    {
+        Database database(path.string(), ITERATIONS);
+
+        userID = database.Submit([](Database& db) { return db.RegisterUser("bob", "pw"); }).get();
+        ASSERT_NE(userID, -1);
+        database.UpdateScore(userID, 1200);
+        database.UpdateScore(userID, 800);
+        // Jobs run in order, this one sees both writes
+        EXPECT_EQ(database.Submit([userID](Database& db) { return db.GetScoreById(userID); }).get(), 1200);
+        // Queued without waiting, the destructor still writes it
+        database.UpdateScore(userID, 5000);
+    }
+
+    Database database(path.string(), ITERATIONS);
+    EXPECT_EQ(database.Submit([userID](Database& db) { return db.GetScoreById(userID); }).get(), 5000);
+}
+
+TEST_F(DatabaseTest, AnswersEveryQueuedJob) {
+    Database database(path.string(), ITERATIONS);
+    std::vector<std::future<int>> results;
+
+    for (int idx = 0; idx < 100; ++idx) {
+        results.push_back(database.Submit(
+            [idx](Database& db) { return db.RegisterUser("user" + std::to_string(idx), "pw"); }));
+    }
+    for (auto& result : results) {
+        EXPECT_NE(result.get(), -1);
+    }
+    EXPECT_NE(database.Submit([](Database& db) { return db.LoginUser("user99", "pw"); }).get(), -1);
+}
+
+TEST_F(DatabaseTest, HashesPlaintextRowsOfOlderServers) {
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(sqlite3_open(path.string().c_str(), &raw), SQLITE_OK);
+    sqlite3_exec(raw,
+                 "CREATE TABLE Users (ID INTEGER PRIMARY KEY AUTOINCREMENT, Username TEXT UNIQUE NOT NULL,"
+                 "Password TEXT NOT NULL, Token TEXT);"
+                 "INSERT INTO Users (Username, Password, Token) VALUES ('carol', 'hunter2', 'aB3dE5gH7j');",
+                 nullptr, nullptr, nullptr);
+    sqlite3_close(raw);
+
+    {
+        Database database(path.string(), ITERATIONS);
+
+        // The old session still works, its token was hashed when the database opened
+        int userID = database.Submit([](Database& db) { return db.GetUserByToken("aB3dE5gH7j"); }).get();
+        ASSERT_NE(userID, -1);
+        EXPECT_EQ(database.Submit([](Database& db) { return db.LoginUser("carol", "wrong"); }).get(), -1);
+        EXPECT_EQ(database.Submit([](Database& db) { return db.LoginUser("carol", "hunter2"); }).get(), userID);
+    }
+
+    std::string password;
+    std::string token;
+    ASSERT_EQ(sqlite3_open(path.string().c_str(), &raw), SQLITE_OK);
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(raw, "SELECT Password, Token FROM Users WHERE Username = 'carol';", -1, &stmt, nullptr);
+    ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+    password = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    token = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+    sqlite3_finalize(stmt);
+    sqlite3_close(raw);
+
+    EXPECT_TRUE(credentials::IsPasswordRecord(password));
+    EXPECT_FALSE(credentials::NeedsRehash(password, ITERATIONS));
+    EXPECT_EQ(token, credentials::HashToken("aB3dE5gH7j"));
+
+    // Logging in again with the hash in place
+    Database database(path.string(), ITERATIONS);
+    EXPECT_NE(database.Submit([](Database& db) { return db.LoginUser("carol", "hunter2"); }).get(), -1);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Context.hpp"
+#include "InputConfig.hpp"
+#include "ResourceConfig.hpp"
+
+#if defined(SERVER_BUILD)
+#include "NetworkEngine/NetworkEngine.hpp"
+#endif
+
+// What a system_context points to, for tests running systems outside of an engine
+struct TestEnvironment {
+    ResourceManager<TextureAsset> textures;
+    ResourceManager<SoundAsset> sounds;
+    ResourceManager<MusicAsset> musics;
+    InputManager input;
+#if defined(SERVER_BUILD)
+    engine::core::NetworkEngine network{engine::core::NetworkEngine::NetworkRole::CLIENT};
+
+    system_context context(float dt = 0.016f) {
+        return system_context{dt, 0, textures, sounds, musics, input, network, {}, nullptr};
+    }
+#else
+    sf::RenderWindow window;
+
+    system_context context(float dt = 0.016f) {
+        return system_context{dt, 0, textures, sounds, musics, window, input, 0, nullptr};
+    }
+#endif
+};
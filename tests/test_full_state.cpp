@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Components/NetworkComponents.hpp"
+#include "NetworkEngine/FullState.hpp"
+
+namespace {
+
+using engine::core::FullStateReader;
+using engine::core::FullStateWriter;
+
+ComponentPacket makePacket(uint32_t guid, uint32_t type, std::size_t size) {
+    ComponentPacket packet;
+    packet.entity_guid = guid;
+    packet.component_type = type;
+    packet.owner_id = guid % 4;
+    packet.data.resize(size);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        packet.data[idx] = static_cast<uint8_t>((guid + idx) % 7);
+    }
+    return packet;
+}
+
+// What a chunk becomes once it went through a message
+network::FullStateChunkPacket sendChunk(const network::FullStateChunkPacket& chunk) {
+    network::message<network::GameEvents> msg;
+    network::FullStateChunkPacket received;
+
+    msg << chunk;
+    msg >> received;
+    return received;
+}
+
+}  // namespace
+
+TEST(Lz77Test, RoundTripsRepetitiveAndRandomBytes) {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> repetitive;
+    std::vector<uint8_t> random(5000);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> out;
+
+    for (int idx = 0; idx < 2000; ++idx) {
+        repetitive.push_back(static_cast<uint8_t>(idx % 24));
+    }
+    for (auto& byte : random) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    engine::core::compressLz77(repetitive.data(), repetitive.size(), compressed);
+    EXPECT_LT(compressed.size(), repetitive.size() / 10);
+    ASSERT_TRUE(engine::core::decompressLz77(compressed.data(), compressed.size(), repetitive.size(), out));
+    EXPECT_EQ(out, repetitive);
+
+    engine::core::compressLz77(random.data(), random.size(), compressed);
+    ASSERT_TRUE(engine::core::decompressLz77(compressed.data(), compressed.size(), random.size(), out));
+    EXPECT_EQ(out, random);
+
+    engine::core::compressLz77(nullptr, 0, compressed);
+    ASSERT_TRUE(engine::core::decompressLz77(compressed.data(), compressed.size(), 0, out));
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(Lz77Test, RejectsMalformedInput) {
+    std::vector<uint8_t> raw(300, 9);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> out;
+
+    engine::core::compressLz77(raw.data(), raw.size(), compressed);
+    EXPECT_FALSE(engine::core::decompressLz77(compressed.data(), compressed.size(), raw.size() - 1, out));
+    EXPECT_FALSE(engine::core::decompressLz77(compressed.data(), compressed.size() - 1, raw.size(), out));
+
+    // A match reaching before the start of the output
+    std::vector<uint8_t> badOffset = {0x10, 'a', 0x05, 0x00};
+    EXPECT_FALSE(engine::core::decompressLz77(badOffset.data(), badOffset.size(), 5, out));
+}
+
+TEST(FullStateTest, StreamsTheWorldWithinTheWindow) {
+    FullStateWriter writer;
+    FullStateReader reader;
+    network::FullStateChunkPacket chunk;
+    std::mt19937 rng(7);
+    std::vector<ComponentPacket> packets;
+
+    writer.begin(12);
+    for (uint32_t guid = 0; guid < 4000; ++guid) {
+        packets.push_back(makePacket(guid, guid % 3, 48));
+        // Some noise so the world spans several chunks once compressed
+        for (std::size_t idx = 0; idx < 16; ++idx) {
+            packets.back().data[idx] = static_cast<uint8_t>(rng());
+        }
+        writer.add(packets.back());
+    }
+    writer.finish();
+    ASSERT_GT(writer.compressedSize(), engine::core::FULL_STATE_WINDOW);
+    EXPECT_LT(writer.compressedSize(), writer.rawSize());
+
+    FullStateReader::Result result = FullStateReader::Result::PENDING;
+    while (!writer.done()) {
+        uint32_t inFlight = 0;
+        while (writer.nextChunk(chunk)) {
+            inFlight += static_cast<uint32_t>(chunk.data.size());
+            result = reader.feed(sendChunk(chunk));
+            ASSERT_NE(result, FullStateReader::Result::MALFORMED);
+        }
+        EXPECT_LE(inFlight, engine::core::FULL_STATE_WINDOW);
+        writer.acknowledge(reader.received());
+    }
+    ASSERT_EQ(result, FullStateReader::Result::COMPLETE);
+    EXPECT_EQ(reader.sequence(), 12u);
+
+    std::size_t idx = 0;
+    ComponentPacket record;
+    EXPECT_TRUE(reader.read(record, [&](const ComponentPacket& packet) {
+        ASSERT_LT(idx, packets.size());
+        EXPECT_EQ(packet.entity_guid, packets[idx].entity_guid);
+        EXPECT_EQ(packet.component_type, packets[idx].component_type);
+        EXPECT_EQ(packet.owner_id, packets[idx].owner_id);
+        EXPECT_EQ(packet.data, packets[idx].data);
+        idx++;
+    }));
+    EXPECT_EQ(idx, packets.size());
+}
+
+TEST(FullStateTest, DropsChunksOutOfOrder) {
+    FullStateWriter writer;
+    FullStateReader reader;
+    network::FullStateChunkPacket first;
+    network::FullStateChunkPacket second;
+    network::FullStateChunkPacket third;
+    std::mt19937 rng(3);
+
+    writer.begin(1);
+    for (uint32_t guid = 0; guid < 1000; ++guid) {
+        ComponentPacket packet = makePacket(guid, 0, 40);
+        for (auto& byte : packet.data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        writer.add(packet);
+    }
+    writer.finish();
+    ASSERT_TRUE(writer.nextChunk(first));
+    ASSERT_TRUE(writer.nextChunk(second));
+    ASSERT_TRUE(writer.nextChunk(third));
+
+    EXPECT_EQ(reader.feed(second), FullStateReader::Result::MALFORMED);
+    EXPECT_EQ(reader.feed(first), FullStateReader::Result::PENDING);
+    EXPECT_EQ(reader.feed(third), FullStateReader::Result::MALFORMED);
+    EXPECT_EQ(reader.received(), 0u);
+
+    // The chunk at offset 0 starts the world over
+    EXPECT_EQ(reader.feed(first), FullStateReader::Result::PENDING);
+    EXPECT_EQ(reader.feed(second), FullStateReader::Result::PENDING);
+}
+
+TEST(FullStateTest, IgnoresTheRestOfADroppedStream) {
+    FullStateWriter writer;
+    FullStateReader reader;
+    network::FullStateChunkPacket first;
+    network::FullStateChunkPacket second;
+    network::FullStateChunkPacket third;
+    std::mt19937 rng(5);
+
+    writer.begin(2);
+    for (uint32_t guid = 0; guid < 1000; ++guid) {
+        ComponentPacket packet = makePacket(guid, 0, 40);
+        for (auto& byte : packet.data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        writer.add(packet);
+    }
+    writer.finish();
+    ASSERT_TRUE(writer.nextChunk(first));
+    ASSERT_TRUE(writer.nextChunk(second));
+    ASSERT_TRUE(writer.nextChunk(third));
+
+    // Only the chunk that broke the stream is malformed, the client asks for the world once
+    EXPECT_EQ(reader.feed(first), FullStateReader::Result::PENDING);
+    EXPECT_EQ(reader.feed(third), FullStateReader::Result::MALFORMED);
+    EXPECT_EQ(reader.feed(second), FullStateReader::Result::IGNORED);
+    EXPECT_EQ(reader.feed(third), FullStateReader::Result::IGNORED);
+    EXPECT_FALSE(reader.assembling());
+
+    EXPECT_EQ(reader.feed(first), FullStateReader::Result::PENDING);
+    EXPECT_EQ(reader.feed(second), FullStateReader::Result::PENDING);
+    EXPECT_TRUE(reader.assembling());
+}
+
+TEST(FullStateTest, SkipsEntitiesDestroyedWhileAssembling) {
+    FullStateWriter writer;
+    FullStateReader reader;
+    network::FullStateChunkPacket chunk;
+    std::mt19937 rng(9);
+
+    writer.begin(3);
+    for (uint32_t guid = 0; guid < 1000; ++guid) {
+        ComponentPacket packet = makePacket(guid, guid % 2, 40);
+        for (auto& byte : packet.data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        writer.add(packet);
+    }
+    writer.finish();
+
+    // Destroyed before the world started, the entity was not captured with it
+    reader.forget(10);
+    FullStateReader::Result result = FullStateReader::Result::PENDING;
+    while (!writer.done()) {
+        while (writer.nextChunk(chunk)) {
+            result = reader.feed(sendChunk(chunk));
+            if (result == FullStateReader::Result::PENDING) {
+                reader.forget(20);
+                reader.forget(5000);
+            }
+        }
+        writer.acknowledge(reader.received());
+    }
+    ASSERT_EQ(result, FullStateReader::Result::COMPLETE);
+    reader.forget(30);
+
+    std::vector<uint32_t> guids;
+    ComponentPacket record;
+    EXPECT_TRUE(reader.read(record, [&](const ComponentPacket& packet) { guids.push_back(packet.entity_guid); }));
+    EXPECT_EQ(guids.size(), 999u);
+    EXPECT_EQ(std::count(guids.begin(), guids.end(), 20u), 0);
+    EXPECT_EQ(std::count(guids.begin(), guids.end(), 10u), 1);
+    EXPECT_EQ(std::count(guids.begin(), guids.end(), 30u), 1);
+
+    // The next world starts with nothing forgotten
+    writer.begin(4);
+    writer.add(makePacket(20, 0, 8));
+    writer.finish();
+    ASSERT_TRUE(writer.nextChunk(chunk));
+    ASSERT_EQ(reader.feed(sendChunk(chunk)), FullStateReader::Result::COMPLETE);
+    guids.clear();
+    EXPECT_TRUE(reader.read(record, [&](const ComponentPacket& packet) { guids.push_back(packet.entity_guid); }));
+    EXPECT_EQ(guids, std::vector<uint32_t>{20});
+}
+
+TEST(FullStateTest, EmptyWorldIsOneChunk) {
+    FullStateWriter writer;
+    FullStateReader reader;
+    network::FullStateChunkPacket chunk;
+
+    writer.begin(5);
+    writer.finish();
+    ASSERT_TRUE(writer.nextChunk(chunk));
+    EXPECT_FALSE(writer.nextChunk(chunk));
+    EXPECT_EQ(reader.feed(sendChunk(chunk)), FullStateReader::Result::COMPLETE);
+    writer.acknowledge(reader.received());
+    EXPECT_TRUE(writer.done());
+
+    ComponentPacket record;
+    int records = 0;
+    EXPECT_TRUE(reader.read(record, [&](const ComponentPacket&) { records++; }));
+    EXPECT_EQ(records, 0);
+}
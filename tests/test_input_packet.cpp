@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Components/NetworkComponents.hpp"
+#include "InputManager/ServerInputManager.hpp"
+
+namespace {
+
+InputActionsPacket makeActions(uint8_t first_id, std::vector<Action> actions) {
+    InputActionsPacket packet;
+    packet.first_id = first_id;
+    packet.actions = std::move(actions);
+    return packet;
+}
+
+// A manager knowing the actions of the game, as the server declares them at startup
+ServerInputManager makeManager() {
+    ServerInputManager manager;
+
+    for (const char* action : {"move_left", "move_right", "shoot"})
+        manager.registerAction(action);
+    return manager;
+}
+
+InputPacket makeInput(uint32_t tick, std::vector<uint32_t> masks) {
+    InputPacket packet;
+    packet.tick = tick;
+    packet.masks = std::move(masks);
+    return packet;
+}
+
+}  // namespace
+
+TEST(InputPacketTest, RoundTripsMasks) {
+    network::message<network::GameEvents> msg;
+    InputPacket read;
+
+    msg << makeInput(42, {0x1u, 0x3u, 0x0u, 0x80000000u});
+    msg >> read;
+
+    EXPECT_EQ(read.tick, 42u);
+    EXPECT_EQ(read.masks, (std::vector<uint32_t>{0x1u, 0x3u, 0x0u, 0x80000000u}));
+    EXPECT_TRUE(msg.body.empty());
+}
+
+TEST(InputPacketTest, RejectsMoreMasksThanTheBody) {
+    network::message<network::GameEvents> msg;
+    InputPacket read;
+
+    msg << static_cast<uint32_t>(1u) << static_cast<uint8_t>(3) << static_cast<uint32_t>(7u);
+    msg >> read;
+
+    EXPECT_TRUE(read.masks.empty());
+}
+
+TEST(InputPacketTest, RoundTripsActionNames) {
+    network::message<network::GameEvents> msg;
+    InputActionsPacket read;
+
+    msg << makeActions(2, {"move_left", "shoot"});
+    msg >> read;
+
+    EXPECT_EQ(read.first_id, 2u);
+    EXPECT_EQ(read.actions, (std::vector<Action>{"move_left", "shoot"}));
+}
+
+TEST(ServerInputManagerTest, ReadsBitsThroughTheClientIds) {
+    ServerInputManager manager = makeManager();
+
+    // Both clients use the same names with different ids
+    manager.registerClientActions(makeActions(0, {"shoot", "move_left"}), 1);
+    manager.registerClientActions(makeActions(0, {"move_left", "shoot"}), 2);
+    manager.updateActionFromPacket(makeInput(10, {0x1u}), 1);
+    manager.updateActionFromPacket(makeInput(10, {0x1u}), 2);
+
+    EXPECT_TRUE(manager.isPressed("shoot", 1));
+    EXPECT_FALSE(manager.isPressed("move_left", 1));
+    EXPECT_TRUE(manager.isPressed("move_left", 2));
+    EXPECT_FALSE(manager.isPressed("shoot", 2));
+    EXPECT_FALSE(manager.isPressed("unknown", 1));
+}
+
+TEST(ServerInputManagerTest, RedundantFramesRecoverLostTicks) {
+    ServerInputManager manager = makeManager();
+
+    manager.registerClientActions(makeActions(0, {"shoot"}), 1);
+    manager.updateActionFromPacket(makeInput(10, {0x0u}), 1);
+    manager.resetFrameFlags();
+
+    // Ticks 11 and 12 were lost: the press and release they held still come through
+    EXPECT_EQ(manager.updateActionFromPacket(makeInput(13, {0x0u, 0x1u, 0x0u, 0x0u}), 1), 3);
+    EXPECT_TRUE(manager.isJustPressed("shoot", 1));
+    EXPECT_TRUE(manager.isJustReleased("shoot", 1));
+    EXPECT_FALSE(manager.isPressed("shoot", 1));
+
+    // A late or duplicated datagram changes nothing
+    manager.resetFrameFlags();
+    EXPECT_EQ(manager.updateActionFromPacket(makeInput(12, {0x1u, 0x1u}), 1), 0);
+    EXPECT_FALSE(manager.isPressed("shoot", 1));
+    EXPECT_FALSE(manager.isJustPressed("shoot", 1));
+}
+
+TEST(ServerInputManagerTest, ForgetsRemovedClients) {
+    ServerInputManager manager = makeManager();
+
+    manager.registerClientActions(makeActions(0, {"shoot"}), 1);
+    manager.updateActionFromPacket(makeInput(1, {0x1u}), 1);
+    manager.removeClient(1);
+
+    EXPECT_FALSE(manager.isPressed("shoot", 1));
+}
+
+TEST(ServerInputManagerTest, IgnoresUndeclaredActions) {
+    ServerInputManager manager = makeManager();
+    std::vector<Action> names;
+
+    // Enough new names to fill the registry if clients could add to it
+    for (std::size_t idx = 0; idx < MAX_INPUT_ACTIONS; ++idx)
+        names.push_back("spam_" + std::to_string(idx));
+    manager.registerClientActions(makeActions(0, names), 1);
+    manager.registerClientActions(makeActions(0, {"move_left", "dance", "shoot"}), 2);
+    manager.updateActionFromPacket(makeInput(1, {0xFFFFFFFFu}), 1);
+    manager.updateActionFromPacket(makeInput(1, {0x7u}), 2);
+
+    EXPECT_EQ(manager.getActionRegistry().size(), 3u);
+    EXPECT_FALSE(manager.isPressed("spam_0", 1));
+    EXPECT_FALSE(manager.isPressed("shoot", 1));
+    EXPECT_TRUE(manager.isPressed("move_left", 2));
+    EXPECT_TRUE(manager.isPressed("shoot", 2));
+    EXPECT_FALSE(manager.isPressed("dance", 2));
+}
+
+TEST(ServerInputManagerTest, MapsEachActionToOneClientId) {
+    ServerInputManager manager = makeManager();
+
+    // Renaming bit 0 to shoot leaves bit 2 free, its state no longer drives shoot
+    manager.registerClientActions(makeActions(0, {"move_left", "move_right", "shoot"}), 1);
+    manager.registerClientActions(makeActions(0, {"shoot"}), 1);
+    manager.updateActionFromPacket(makeInput(1, {0x4u}), 1);
+
+    EXPECT_FALSE(manager.isPressed("shoot", 1));
+    EXPECT_FALSE(manager.isPressed("move_right", 1));
+
+    manager.updateActionFromPacket(makeInput(2, {0x1u}), 1);
+    EXPECT_TRUE(manager.isPressed("shoot", 1));
+}
+
+TEST(ServerInputManagerTest, QueriesByTheIdRegisterActionReturned) {
+    ServerInputManager manager;
+    ActionId shoot = manager.registerAction("shoot");
+    ActionId move_left = manager.registerAction("move_left");
+
+    // Declaring an action again gives back the id it already has
+    EXPECT_EQ(manager.registerAction("shoot"), shoot);
+
+    manager.registerClientActions(makeActions(0, {"move_left", "shoot"}), 1);
+    manager.updateActionFromPacket(makeInput(1, {0x2u}), 1);
+
+    EXPECT_TRUE(manager.isPressed(shoot, 1));
+    EXPECT_TRUE(manager.isJustPressed(shoot, 1));
+    EXPECT_FALSE(manager.isJustReleased(shoot, 1));
+    EXPECT_FALSE(manager.isPressed(move_left, 1));
+    EXPECT_TRUE(manager.getState(shoot, 1).pressed);
+    EXPECT_FALSE(manager.isPressed(shoot, 2));
+    EXPECT_FALSE(manager.isPressed(INVALID_ACTION_ID, 1));
+    EXPECT_EQ(manager.isPressed(shoot, 1), manager.isPressed("shoot", 1));
+}
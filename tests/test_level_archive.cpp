@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <any>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "Components/StandardComponents.hpp"
+#include "Core/Scene/LevelArchive.hpp"
+#include "Core/Scene/SceneLoader.hpp"
+#include "Core/Scene/SceneManager.hpp"
+
+namespace {
+
+// Every property a prefab received, printed with its type
+struct ScenePropsComponent {
+    static constexpr auto name = "TestScenePropsComponent";
+    std::string type;
+    std::map<std::string, std::string> values;
+
+    bool operator==(const ScenePropsComponent& other) const = default;
+};
+
+std::string describe(const std::any& value) {
+    if (const auto* number = std::any_cast<float>(&value))
+        return "float " + std::to_string(*number);
+    if (const auto* integer = std::any_cast<int>(&value))
+        return "int " + std::to_string(*integer);
+    if (const auto* flag = std::any_cast<bool>(&value))
+        return *flag ? "bool true" : "bool false";
+    if (const auto* text = std::any_cast<std::string>(&value))
+        return "string " + *text;
+    return std::string("other ") + value.type().name();
+}
+
+struct SceneEntity {
+    ScenePropsComponent props;
+    float x;
+    float y;
+    uint32_t lobby;
+
+    bool operator==(const SceneEntity& other) const = default;
+};
+
+// What SceneManager puts in a registry for a level, in entity order
+std::vector<SceneEntity> loadRegistry(const LevelConfig& config) {
+    Registry registry;
+    SceneManager scenes(registry);
+
+    for (const char* type : {"Wall", "Turret", "Decor", "Enemy"}) {
+        scenes.registerPrefab(type, [type](Registry& reg, Entity entity,
+                                           const std::unordered_map<std::string, std::any>& props) {
+            ScenePropsComponent component{type, {}};
+            for (const auto& [key, value] : props)
+                component.values[key] = describe(value);
+            reg.addComponent<ScenePropsComponent>(entity, component);
+            reg.addComponent<transform_component_s>(
+                entity, {std::any_cast<float>(props.at("x")), std::any_cast<float>(props.at("y"))});
+        });
+    }
+    scenes.setCurrentLobbyId(7);
+    scenes.loadScene(config);
+
+    std::vector<SceneEntity> entities;
+    registry.each<const ScenePropsComponent, const transform_component_s, const LobbyIdComponent>(
+        [&](Entity, const ScenePropsComponent& props, const transform_component_s& transform,
+            const LobbyIdComponent& lobby) {
+            entities.push_back({props, transform.x, transform.y, lobby.lobby_id});
+        });
+    return entities;
+}
+
+class LevelArchiveTest : public ::testing::Test {
+   protected:
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "rtype_test_level_archive";
+    std::string scene = (dir / "level.scene").string();
+    std::string spawns = (dir / "level_spawns.cfg").string();
+    std::string archive = LevelArchive::compiledPath(scene);
+
+    void SetUp() override {
+        std::filesystem::remove_all(dir);
+        std::filesystem::remove(archive);
+        std::filesystem::create_directories(dir);
+        write(scene,
+              "[LEVEL]\n"
+              "name=Test Level\n"
+              "background=bg.png\n"
+              "music=theme\n"
+              "boss_section=BOSS_TEST\n"
+              "spawn_script=" + spawns + "\n"
+              "next_level=next.scene\n"
+              "[WALL]\n"
+              "wall=2000,900,800,180,wall.gif,true\n"
+              "wall=4000, 0, 600, 160, wall.gif, false, 12\n"
+              "[TURRET]\n"
+              "turret=2200,850,2.5,AIM_PLAYER,turret.gif\n"
+              "[DECOR]\n"
+              "decor=500,200,planet.png,0.5,-1,0.5\n"
+              "[ENEMY]\n"
+              "enemy=5.0,SCOUT,1600,300\n");
+        write(spawns,
+              "# time,enemy_type,x,y,count,spacing,formation,custom_speed,custom_hp\n"
+              "spawn=1.0,SCOUT,1970,200,2,100,LINE_HORIZONTAL,0,0\n"
+              "spawn=4.5,TANK,1970,500,1,0,SINGLE,120.5,80\n"
+              "spawn=9.0,FIGHTER,1970,300,5,120,SNAKE,0,0\n");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+        std::filesystem::remove(archive);
+    }
+
+    static void write(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+};
+
+}  // namespace
+
+TEST_F(LevelArchiveTest, BothPathsBuildTheSameRegistry) {
+    LevelConfig text = SceneLoader::loadFromText(scene);
+    LevelArchive::save(text, archive);
+    LevelArchive mapped(archive);
+    LevelConfig compiled = mapped.toConfig();
+
+    EXPECT_EQ(mapped.header().version, LEVEL_ARCHIVE_VERSION);
+    EXPECT_EQ(mapped.entities().size(), 5u);
+    EXPECT_EQ(mapped.spawns().size(), 3u);
+
+    EXPECT_EQ(compiled.name, "Test Level");
+    EXPECT_EQ(compiled.background_texture, text.background_texture);
+    EXPECT_EQ(compiled.music_track, text.music_track);
+    EXPECT_EQ(compiled.boss_section, "BOSS_TEST");
+    EXPECT_EQ(compiled.spawn_script, spawns);
+    EXPECT_EQ(compiled.next_level, text.next_level);
+
+    std::vector<SceneEntity> fromText = loadRegistry(text);
+    ASSERT_EQ(fromText.size(), 5u);
+    EXPECT_EQ(fromText[1].props.values.at("hp"), "int 12");
+    EXPECT_EQ(fromText[1].props.values.at("destructible"), "bool false");
+    EXPECT_EQ(fromText[3].props.values.at("z_index"), "int -1");
+    EXPECT_EQ(loadRegistry(compiled), fromText);
+
+    // Loaded from its archive, a level keeps it mapped and the scene manager reads the records
+    LevelConfig loaded = SceneLoader::loadFromFile(scene);
+    ASSERT_NE(loaded.archive, nullptr);
+    EXPECT_TRUE(loaded.entities.empty());
+    EXPECT_TRUE(loaded.spawn_events.empty());
+    EXPECT_EQ(loaded.name, "Test Level");
+    EXPECT_EQ(loaded.archive->spawns().size(), 3u);
+    EXPECT_EQ(loadRegistry(loaded), fromText);
+
+    ASSERT_EQ(compiled.spawn_events.size(), text.spawn_events.size());
+    for (std::size_t idx = 0; idx < text.spawn_events.size(); ++idx) {
+        const SpawnEvent& expected = text.spawn_events[idx];
+        const SpawnEvent& actual = compiled.spawn_events[idx];
+
+        EXPECT_EQ(actual.trigger_time, expected.trigger_time);
+        EXPECT_EQ(actual.enemy_type, expected.enemy_type);
+        EXPECT_EQ(actual.x_position, expected.x_position);
+        EXPECT_EQ(actual.y_position, expected.y_position);
+        EXPECT_EQ(actual.count, expected.count);
+        EXPECT_EQ(actual.spacing, expected.spacing);
+        EXPECT_EQ(actual.formation, expected.formation);
+        EXPECT_EQ(actual.custom_speed, expected.custom_speed);
+        EXPECT_EQ(actual.custom_hp, expected.custom_hp);
+        EXPECT_FALSE(actual.executed);
+    }
+    EXPECT_EQ(compiled.spawn_events[1].formation, SpawnFormation::Single);
+    EXPECT_EQ(compiled.spawn_events[2].formation, SpawnFormation::Snake);
+
+    // A level compiles to the same bytes every time
+    EXPECT_EQ(LevelArchive::compile(text), LevelArchive::compile(compiled));
+}
+
+TEST_F(LevelArchiveTest, FallsBackToTextWhenTheArchiveIsStaleOrBroken) {
+    LevelConfig text = SceneLoader::loadFromText(scene);
+    LevelConfig marked = text;
+    marked.name = "From Archive";
+
+    // Archives are build outputs, kept out of the directory of their scene
+    EXPECT_EQ(std::filesystem::path(archive).extension(), LEVEL_ARCHIVE_EXTENSION);
+    EXPECT_EQ(archive.rfind(LEVEL_ARCHIVE_DIR, 0), 0u);
+    EXPECT_FALSE(std::filesystem::exists(archive));
+    EXPECT_EQ(SceneLoader::loadFromFile(scene).name, "Test Level");
+
+    LevelArchive::save(marked, archive);
+    EXPECT_EQ(SceneLoader::loadFromFile(scene).name, "From Archive");
+
+    // Editing the spawn script after compiling makes the archive stale
+    std::filesystem::last_write_time(spawns, std::filesystem::last_write_time(archive) + std::chrono::seconds(5));
+    EXPECT_EQ(SceneLoader::loadFromFile(scene).name, "Test Level");
+
+    std::vector<uint8_t> bytes = LevelArchive::compile(marked);
+    bytes[4] = LEVEL_ARCHIVE_VERSION + 1;
+    write(archive, std::string(bytes.begin(), bytes.end()));
+    std::filesystem::last_write_time(archive, std::filesystem::last_write_time(spawns) + std::chrono::seconds(5));
+    EXPECT_THROW(LevelArchive{archive}, std::runtime_error);
+    EXPECT_EQ(SceneLoader::loadFromFile(scene).name, "Test Level");
+
+    bytes = LevelArchive::compile(marked);
+    bytes.resize(bytes.size() - 8);
+    write(archive, std::string(bytes.begin(), bytes.end()));
+    EXPECT_THROW(LevelArchive{archive}, std::runtime_error);
+}
+
+TEST_F(LevelArchiveTest, ReportsWhatTheTextLoaderSkips) {
+    write(scene,
+          "[LEVEL]\n"
+          "name=Broken\n"
+          "speed=3\n"
+          "spawn_script=" + spawns + "\n"
+          "[WALL]\n"
+          "wall=10,20\n"
+          "wall=10,20,30,abc\n"
+          "wall=1,2,3,4,wall.gif,yes\n"
+          "[DOORS]\n"
+          "turret 1,2\n");
+    write(spawns,
+          "spawn=5.0,SCOUT,1970,200,2,100,LINE_HORIZONTAL,0,0\n"
+          "spawn=2.0,SCOUT,1970,200,2,100,CIRCLE,0,0\n"
+          "spawn=6.0,SCOUT\n");
+
+    std::vector<std::string> problems;
+    LevelConfig level = SceneLoader::loadFromText(scene, &problems);
+
+    std::vector<std::string> expected = {
+        scene + ":3: unknown level property 'speed'",
+        scene + ":6: expected at least 4 fields",
+        scene + ":7: invalid number in '10,20,30,abc'",
+        scene + ":8: destructible should be true or false",
+        scene + ":9: unknown section [DOORS]",
+        scene + ":10: expected key=value",
+        spawns + ":2: unknown formation 'CIRCLE'",
+        spawns + ":2: spawn time goes back to 2.0",
+        spawns + ":3: expected 9 fields",
+    };
+    EXPECT_EQ(problems, expected);
+    EXPECT_EQ(level.spawn_events.size(), 2u);
+
+    // Without a list to fill, a bad number throws as it always did
+    EXPECT_THROW(SceneLoader::loadFromText(scene), std::invalid_argument);
+}
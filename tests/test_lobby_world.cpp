@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "InputConfig.hpp"
+#include "LobbyWorld.hpp"
+#include "NetworkEngine/NetworkEngine.hpp"
+
+namespace {
+
+struct Counter {
+    static constexpr auto name = "TestLobbyCounter";
+    int value;
+};
+
+class CountingSystem : public ISystem {
+   public:
+    void update(Registry& registry, system_context context) override {
+        thread = std::this_thread::get_id();
+        lobby_id = context.lobby_id;
+        registry.each<Counter>([](Entity, Counter& counter) { counter.value++; });
+    }
+
+    std::thread::id thread;
+    uint32_t lobby_id = 0;
+};
+
+// Two of them only finish if their worlds tick at the same time
+class RendezvousSystem : public ISystem {
+   public:
+    explicit RendezvousSystem(std::atomic<int>& arrived) : _arrived(arrived) {}
+    void update(Registry&, system_context) override {
+        _arrived.fetch_add(1);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (_arrived.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        met = _arrived.load() >= 2;
+    }
+    bool met = false;
+
+   private:
+    std::atomic<int>& _arrived;
+};
+
+class ThrowingSystem : public ISystem {
+   public:
+    void update(Registry&, system_context) override { throw std::runtime_error("system failed"); }
+};
+
+struct Server {
+    InputManager input;
+    engine::core::NetworkEngine network{engine::core::NetworkEngine::NetworkRole::CLIENT};
+
+    system_context context(engine::core::LobbyWorld& world) {
+        return system_context{0.016f,
+                              0,
+                              world.getTextureManager(),
+                              world.getSoundManager(),
+                              world.getMusicManager(),
+                              input,
+                              network,
+                              {},
+                              nullptr,
+                              nullptr,
+                              world.getLobbyId()};
+    }
+};
+
+}  // namespace
+
+TEST(LobbyWorldTest, WorldsOnlySeeTheirOwnEntities) {
+    Server server;
+    engine::core::LobbyWorld first(1, server.input);
+    engine::core::LobbyWorld second(2, server.input);
+
+    for (int i = 0; i < 3; ++i) {
+        Entity entity = first.getECS().registry.createEntity();
+        first.getECS().registry.addComponent<Counter>(entity, {0});
+    }
+    Entity entity = second.getECS().registry.createEntity();
+    second.getECS().registry.addComponent<Counter>(entity, {10});
+    first.getECS().systems.addSystem<CountingSystem>();
+    second.getECS().systems.addSystem<CountingSystem>();
+
+    first.step(server.context(first));
+    second.step(server.context(second));
+    first.wait();
+    second.wait();
+
+    EXPECT_EQ(first.getECS().registry.getEntities<Counter>().size(), 3u);
+    for (auto counted : first.getECS().registry.getEntities<Counter>()) {
+        EXPECT_EQ(first.getECS().registry.getConstComponent<Counter>(counted).value, 1);
+    }
+    ASSERT_EQ(second.getECS().registry.getEntities<Counter>().size(), 1u);
+    EXPECT_EQ(second.getECS().registry.getConstComponent<Counter>(entity).value, 11);
+    EXPECT_EQ(first.getECS().systems.getSystem<CountingSystem>()->lobby_id, 1u);
+    EXPECT_EQ(second.getECS().systems.getSystem<CountingSystem>()->lobby_id, 2u);
+}
+
+TEST(LobbyWorldTest, WorldsTickOnTheirOwnThreads) {
+    Server server;
+    engine::core::LobbyWorld first(1, server.input);
+    engine::core::LobbyWorld second(2, server.input);
+    std::atomic<int> arrived{0};
+
+    first.getECS().systems.addSystem<RendezvousSystem>(arrived);
+    second.getECS().systems.addSystem<RendezvousSystem>(arrived);
+    first.getECS().systems.addSystem<CountingSystem>();
+    first.step(server.context(first));
+    second.step(server.context(second));
+    first.wait();
+    second.wait();
+
+    EXPECT_TRUE(first.getECS().systems.getSystem<RendezvousSystem>()->met);
+    EXPECT_TRUE(second.getECS().systems.getSystem<RendezvousSystem>()->met);
+    EXPECT_NE(first.getECS().systems.getSystem<CountingSystem>()->thread, std::this_thread::get_id());
+}
+
+TEST(LobbyWorldTest, ErrorsReachWait) {
+    Server server;
+    engine::core::LobbyWorld world(1, server.input);
+
+    world.getECS().systems.addSystem<ThrowingSystem>();
+    world.step(server.context(world));
+    EXPECT_THROW(world.wait(), std::runtime_error);
+
+    // The world can tick again afterwards
+    world.step(server.context(world));
+    EXPECT_THROW(world.wait(), std::runtime_error);
+    EXPECT_NO_THROW(world.wait());
+}
+
+TEST(LobbyWorldTest, LoopFunctionsBelongToTheirWorld) {
+    Server server;
+    auto state = std::make_shared<int>(0);
+    std::weak_ptr<int> alive = state;
+    std::shared_ptr<Environment> seen;
+
+    {
+        engine::core::LobbyWorld world(1, server.input);
+        world.setLoopFunction([state, &seen](std::shared_ptr<Environment> env, InputManager&) {
+            ++*state;
+            seen = env;
+        });
+        state.reset();
+
+        world.runLoopFunction(server.input);
+        world.runLoopFunction(server.input);
+        EXPECT_EQ(*alive.lock(), 2);
+        EXPECT_EQ(seen, world.getEnvironment());
+        seen.reset();
+    }
+    // What the game kept for this lobby goes away with its world
+    EXPECT_TRUE(alive.expired());
+}
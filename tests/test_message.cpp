@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "Components/NetworkComponents.hpp"
+#include "MessagePool.hpp"
+
+TEST(MessageTest, ComponentPacketRoundTrip) {
+    ComponentPacket sent{12, 34, 56, {1, 2, 3, 4, 5}};
+    ComponentPacket received;
+    network::message<network::GameEvents> msg;
+
+    msg << sent;
+    msg >> received;
+    EXPECT_EQ(received.entity_guid, 12u);
+    EXPECT_EQ(received.component_type, 34u);
+    EXPECT_EQ(received.owner_id, 56u);
+    EXPECT_EQ(received.data, sent.data);
+    EXPECT_TRUE(msg.body.empty());
+    EXPECT_EQ(msg.header.size, 0u);
+}
+
+TEST(MessageTest, ReaderLeavesTheMessageUntouched) {
+    network::message<network::GameEvents> msg;
+    ComponentPacket packet;
+    uint32_t tail = 99;
+
+    msg << tail << ComponentPacket{1, 2, 3, {7, 8, 9}};
+    network::MessageReader<network::GameEvents> reader(msg);
+    reader >> packet;
+    EXPECT_EQ(packet.data, (std::vector<uint8_t>{7, 8, 9}));
+    EXPECT_EQ(reader.remaining(), sizeof(uint32_t));
+    reader >> tail;
+    EXPECT_EQ(tail, 99u);
+    EXPECT_THROW(reader >> tail, std::runtime_error);
+    EXPECT_EQ(msg.body.size(), msg.header.size);
+    EXPECT_EQ(msg.body.size(), 3 + 5 * sizeof(uint32_t));
+}
+
+TEST(MessageTest, OversizedPacketIsDropped) {
+    network::message<network::GameEvents> msg;
+    ComponentPacket packet;
+    uint32_t size = 1000;
+
+    msg << size << uint32_t{3} << uint32_t{2} << uint32_t{1};
+    msg >> packet;
+    EXPECT_TRUE(packet.data.empty());
+    EXPECT_TRUE(msg.body.empty());
+}
+
+TEST(MessageTest, WriterMatchesThePushOperator) {
+    network::message<network::GameEvents> pushed;
+    network::message<network::GameEvents> written;
+    std::vector<uint8_t> bytes = {4, 5, 6};
+
+    pushed << uint8_t{4} << uint8_t{5} << uint8_t{6} << 1.5f;
+    network::MessageWriter<network::GameEvents> writer(written, bytes.size() + sizeof(float));
+    writer.write(bytes.data(), bytes.size()) << 1.5f;
+    EXPECT_EQ(written.body, pushed.body);
+    EXPECT_EQ(written.header.size, pushed.header.size);
+}
+
+TEST(MessageTest, PoolReusesBodies) {
+    network::MessagePool<network::GameEvents> pool(4);
+    auto msg = pool.acquire(512);
+
+    msg.header.id = network::GameEvents::S_SNAPSHOT;
+    msg << uint32_t{1};
+    const uint8_t* storage = msg.body.data();
+    pool.release(std::move(msg));
+    EXPECT_EQ(pool.available(), 1u);
+
+    auto reused = pool.acquire();
+    EXPECT_EQ(reused.body.data(), storage);
+    EXPECT_TRUE(reused.body.empty());
+    EXPECT_GE(reused.body.capacity(), 512u);
+    EXPECT_EQ(reused.header.id, network::GameEvents{});
+    EXPECT_EQ(reused.header.magic_value, MAGIC_VALUE);
+}
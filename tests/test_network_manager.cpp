@@ -204,10 +204,11 @@ TEST_F(NetworkManagerTest, EmptyPayload_InvalidForLogin) {
 
 TEST_F(NetworkManagerTest, ValidInput_PassesValidation) {
     network::message<network::GameEvents> msg;
-    std::string action = "move_left";
-    bool pressed = true;
+    uint32_t mask = 0x1;
+    uint8_t count = 1;
+    uint32_t tick = 42;
 
-    msg << pressed << action;
+    msg << mask << count << tick;
     msg.header.id = network::GameEvents::C_INPUT;
     msg.header.magic_value = MAGIC_VALUE;
     msg.header.size = msg.body.size();
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <vector>
+#include "Components/GravityComponent.hpp"
+#include "PhysicsSystem.hpp"
+#include "registry.hpp"
+#include "test_environment.hpp"
+
+TEST(PhysicsTest, IntegrateMatchesScalarMovement) {
+    constexpr float dt = 1.0f / 60.0f;
+    // Not a multiple of 4 or 8, so every SIMD loop and the scalar tail run
+    constexpr std::size_t COUNT = 23;
+    std::vector<float> x(COUNT), y(COUNT), vx(COUNT), vy(COUNT);
+    std::vector<transform_component_s> expected(COUNT);
+
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        x[idx] = static_cast<float>(idx) * 13.7f;
+        y[idx] = static_cast<float>(idx) * -4.1f;
+        vx[idx] = static_cast<float>(idx) * 31.0f - 150.0f;
+        vy[idx] = 90.0f - static_cast<float>(idx) * 7.3f;
+        expected[idx].x = x[idx];
+        expected[idx].y = y[idx];
+        PhysicsSystem::applyMovement(expected[idx], {vx[idx], vy[idx]}, dt);
+    }
+
+    PhysicsSystem::integrate(x, y, vx, vy, dt);
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        EXPECT_FLOAT_EQ(x[idx], expected[idx].x);
+        EXPECT_FLOAT_EQ(y[idx], expected[idx].y);
+    }
+}
+
+TEST(PhysicsTest, UpdateMovesTransformsLikeTheScalarLoop) {
+    constexpr float dt = 1.0f / 60.0f;
+    TestEnvironment env;
+    Registry registry;
+    PhysicsSystem system;
+    std::vector<Entity> entities;
+
+    for (std::size_t idx = 0; idx < 11; ++idx) {
+        Entity entity = registry.createEntity();
+
+        registry.addComponent<transform_component_s>(entity, {static_cast<float>(idx) * 10.0f, 5.0f});
+        registry.addComponent<Velocity2D>(entity, {static_cast<float>(idx) - 5.0f, 60.0f});
+        if (idx % 3 == 0)
+            registry.addComponent<GravityComponent>(entity, {10.0f, 2.5f, false});
+        entities.push_back(entity);
+    }
+    // Written between two ticks, the physics has to move the new position with the new velocity
+    system.update(registry, env.context(dt));
+    registry.getComponent<transform_component_s>(entities[4]).x = 500.0f;
+    registry.getComponent<Velocity2D>(entities[4]).vx = -30.0f;
+    registry.removeComponent<Velocity2D>(entities[7]);
+
+    std::vector<transform_component_s> expected;
+    for (Entity entity : entities) {
+        transform_component_s transform = registry.getConstComponent<transform_component_s>(entity);
+
+        if (registry.hasComponent<Velocity2D>(entity)) {
+            if (registry.hasComponent<GravityComponent>(entity))
+                transform.y += registry.getConstComponent<GravityComponent>(entity).vectorY;
+            PhysicsSystem::applyMovement(transform, registry.getConstComponent<Velocity2D>(entity), dt);
+        }
+        expected.push_back(transform);
+    }
+    system.update(registry, env.context(dt));
+
+    EXPECT_EQ(registry.getPool<PhysicsBody>().size(), entities.size() - 1);
+    for (std::size_t idx = 0; idx < entities.size(); ++idx) {
+        const auto& transform = registry.getConstComponent<transform_component_s>(entities[idx]);
+
+        EXPECT_FLOAT_EQ(transform.x, expected[idx].x);
+        EXPECT_FLOAT_EQ(transform.y, expected[idx].y);
+    }
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "Components/StandardComponents.hpp"
+#include "registry.hpp"
+
+TEST(RegistryDestroyTest, DestroyEntitiesRemovesEveryComponent) {
+    Registry registry;
+    std::vector<Entity> entities;
+
+    for (int idx = 0; idx < 6; ++idx) {
+        Entity entity = registry.createEntity();
+        registry.addComponent<transform_component_s>(entity, {static_cast<float>(idx), 0.0f});
+        if (idx % 2 == 0)
+            registry.addComponent<Velocity2D>(entity, {1.0f, 1.0f});
+        entities.push_back(entity);
+    }
+
+    std::vector<Entity> doomed = {entities[0], entities[3], entities[4]};
+    registry.destroyEntities(doomed);
+
+    for (auto entity : doomed) {
+        EXPECT_FALSE(registry.hasComponent<transform_component_s>(entity));
+        EXPECT_FALSE(registry.hasComponent<Velocity2D>(entity));
+        EXPECT_FALSE(registry.hasComponent<NetworkIdentity>(entity));
+    }
+    // The components moved into the holes still belong to their entity
+    for (int idx : {1, 2, 5}) {
+        ASSERT_TRUE(registry.hasComponent<transform_component_s>(entities[idx]));
+        EXPECT_FLOAT_EQ(registry.getConstComponent<transform_component_s>(entities[idx]).x, static_cast<float>(idx));
+    }
+    EXPECT_TRUE(registry.hasComponent<Velocity2D>(entities[2]));
+    EXPECT_EQ(registry.getEntities<transform_component_s>().size(), 3u);
+    EXPECT_EQ(registry.getEntities<Velocity2D>().size(), 1u);
+}
+
+TEST(RegistryDestroyTest, DuplicateIdsAreRecycledOnce) {
+    Registry registry;
+    Entity entity = registry.createEntity();
+    Entity other = registry.createEntity();
+    std::vector<Entity> doomed = {entity, other, entity};
+
+    registry.destroyEntities(doomed);
+
+    Entity first = registry.createEntity();
+    Entity second = registry.createEntity();
+    Entity third = registry.createEntity();
+    EXPECT_NE(first, second);
+    EXPECT_NE(first, third);
+    EXPECT_NE(second, third);
+}
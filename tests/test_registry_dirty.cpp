@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Components/StandardComponents.hpp"
+#include "registry.hpp"
+
+namespace {
+
+template <typename Component>
+std::vector<std::size_t> takeDirty(Registry& registry) {
+    return registry.getPool<Component>().getUpdatedEntities();
+}
+
+}  // namespace
+
+TEST(RegistryDirtyTest, ConstReadDoesNotFlag) {
+    Registry registry;
+    Entity entity = registry.createEntity();
+    registry.addComponent<transform_component_s>(entity, {1.0f, 2.0f});
+    takeDirty<transform_component_s>(registry);
+
+    EXPECT_FLOAT_EQ(registry.getConstComponent<transform_component_s>(entity).x, 1.0f);
+    EXPECT_TRUE(takeDirty<transform_component_s>(registry).empty());
+
+    registry.getComponent<transform_component_s>(entity);
+    EXPECT_EQ(takeDirty<transform_component_s>(registry).size(), 1u);
+}
+
+TEST(RegistryDirtyTest, WriteGuardFlagsOnlyRealChanges) {
+    Registry registry;
+    Entity entity = registry.createEntity();
+    registry.addComponent<transform_component_s>(entity, {1.0f, 2.0f});
+    takeDirty<transform_component_s>(registry);
+
+    {
+        auto transform = registry.writeComponent<transform_component_s>(entity);
+        EXPECT_FLOAT_EQ(transform.read().y, 2.0f);
+    }
+    EXPECT_TRUE(takeDirty<transform_component_s>(registry).empty());
+
+    {
+        auto transform = registry.writeComponent<transform_component_s>(entity);
+        transform->x = 1.0f;
+    }
+    EXPECT_TRUE(takeDirty<transform_component_s>(registry).empty());
+
+    {
+        auto transform = registry.writeComponent<transform_component_s>(entity);
+        transform->x += 3.0f;
+    }
+    auto dirty = takeDirty<transform_component_s>(registry);
+    ASSERT_EQ(dirty.size(), 1u);
+    EXPECT_EQ(dirty[0], entity);
+    EXPECT_FLOAT_EQ(registry.getConstComponent<transform_component_s>(entity).x, 4.0f);
+}
+
+TEST(RegistryDirtyTest, WriteGuardOnNonTrivialComponent) {
+    Registry registry;
+    Entity entity = registry.createEntity();
+    registry.addComponent<TagComponent>(entity, TagComponent{{"PLAYER"}});
+    takeDirty<TagComponent>(registry);
+
+    {
+        auto tags = registry.writeComponent<TagComponent>(entity);
+        EXPECT_EQ(tags.read().tags.size(), 1u);
+    }
+    EXPECT_TRUE(takeDirty<TagComponent>(registry).empty());
+
+    {
+        auto tags = registry.writeComponent<TagComponent>(entity);
+        tags->tags.add("ENEMY");
+        tags.commit();
+        EXPECT_EQ(takeDirty<TagComponent>(registry).size(), 1u);
+    }
+    EXPECT_TRUE(takeDirty<TagComponent>(registry).empty());
+}
+
+TEST(RegistryDirtyTest, MarkDirty) {
+    Registry registry;
+    Entity entity = registry.createEntity();
+    registry.addComponent<Velocity2D>(entity, {0.0f, 0.0f});
+    takeDirty<Velocity2D>(registry);
+
+    registry.getView<Velocity2D>()[0].vx = 5.0f;
+    EXPECT_TRUE(takeDirty<Velocity2D>(registry).empty());
+    registry.markDirty<Velocity2D>(entity);
+    EXPECT_EQ(takeDirty<Velocity2D>(registry).size(), 1u);
+}
+
+TEST(RegistryEachTest, VisitsEntitiesHavingEveryComponent) {
+    Registry registry;
+    for (int i = 0; i < 12; ++i) {
+        Entity entity = registry.createEntity();
+        registry.addComponent<transform_component_s>(entity, {static_cast<float>(i), 0.0f});
+        if (i % 2 == 0)
+            registry.addComponent<Velocity2D>(entity, {1.0f, 0.0f});
+        if (i % 3 == 0)
+            registry.addComponent<Scroll>(entity, {0.0f, 0.0f, false});
+    }
+
+    std::vector<Entity> visited;
+    registry.each<const transform_component_s, const Velocity2D, const Scroll>(
+        [&](Entity entity, const transform_component_s& transform, const Velocity2D&, const Scroll&) {
+            EXPECT_FLOAT_EQ(transform.x, static_cast<float>(entity));
+            visited.push_back(entity);
+        });
+    EXPECT_EQ(visited, (std::vector<Entity>{0, 6}));
+}
+
+TEST(RegistryEachTest, FlagsOnlyModifiedComponents) {
+    Registry registry;
+    for (int i = 0; i < 4; ++i) {
+        Entity entity = registry.createEntity();
+        registry.addComponent<transform_component_s>(entity, {0.0f, 0.0f});
+        registry.addComponent<Velocity2D>(entity, {static_cast<float>(i % 2), 0.0f});
+    }
+    takeDirty<transform_component_s>(registry);
+    takeDirty<Velocity2D>(registry);
+
+    registry.each<const Velocity2D, transform_component_s>(
+        [](Entity, const Velocity2D& vel, transform_component_s& transform) { transform.x += vel.vx; });
+    EXPECT_EQ(takeDirty<transform_component_s>(registry), (std::vector<std::size_t>{1, 3}));
+    EXPECT_TRUE(takeDirty<Velocity2D>(registry).empty());
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "RingQueue.hpp"
+
+TEST(RingQueueTest, KeepsOrderAcrossWrapAround) {
+    network::RingQueue<int> queue(4);
+    std::vector<int> out;
+    int value = 0;
+
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_TRUE(queue.try_push(round * 2));
+        EXPECT_TRUE(queue.try_push(round * 2 + 1));
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, round * 2);
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, round * 2 + 1);
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(RingQueueTest, RefusesItemsWhenFull) {
+    network::RingQueue<int> queue(3);
+
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.count(), 4u);
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.pop_all(out, 2), 2u);
+    EXPECT_TRUE(queue.try_push(4));
+    EXPECT_EQ(queue.pop_all(out), 3u);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(RingQueueTest, ReleasesPoppedItems) {
+    network::RingQueue<std::shared_ptr<int>> queue(4);
+    auto item = std::make_shared<int>(1);
+    std::vector<std::shared_ptr<int>> out;
+
+    queue.push_back(item);
+    queue.pop_all(out);
+    out.clear();
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(RingQueueTest, DrainsEveryProducer) {
+    constexpr int PRODUCERS = 3;
+    constexpr int PER_PRODUCER = 20000;
+    network::RingQueue<int> queue(64);
+    std::vector<std::thread> producers;
+    std::vector<int> next(PRODUCERS, 0);
+    std::vector<int> out;
+    int received = 0;
+
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                queue.push_back(p * PER_PRODUCER + i);
+            }
+        });
+    }
+    while (received < PRODUCERS * PER_PRODUCER) {
+        queue.wait();
+        out.clear();
+        queue.pop_all(out);
+        for (int value : out) {
+            // Each producer's items come out in the order it pushed them
+            int producer = value / PER_PRODUCER;
+            EXPECT_EQ(value % PER_PRODUCER, next[producer]);
+            next[producer]++;
+        }
+        received += static_cast<int>(out.size());
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingQueueTest, PushAllWaitsForRoomAndKeepsOrder) {
+    network::RingQueue<int> queue(8);
+    std::vector<int> items(100);
+    std::vector<int> out;
+
+    for (int i = 0; i < 100; ++i) {
+        items[i] = i;
+    }
+    std::thread producer([&queue, &items]() { queue.push_all(items); });
+    while (out.size() < 100) {
+        queue.wait();
+        queue.pop_all(out);
+    }
+    producer.join();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "Components/NetworkComponents.hpp"
+#include "NetworkEngine/SnapshotBaselines.hpp"
+
+namespace {
+
+ComponentPacket makePacket(uint32_t guid, uint32_t type, std::size_t size) {
+    ComponentPacket packet;
+    packet.entity_guid = guid;
+    packet.component_type = type;
+    packet.owner_id = guid + 1;
+    packet.data.resize(size);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        packet.data[idx] = static_cast<uint8_t>(guid + idx);
+    }
+    return packet;
+}
+
+std::vector<network::SnapshotRecord> readAll(network::SnapshotBatchWriter& writer) {
+    std::vector<network::SnapshotRecord> records;
+    network::SnapshotRecord scratch;
+    uint32_t sequence = 0;
+
+    for (std::size_t idx = 0; idx < writer.size(); ++idx) {
+        auto collect = [&](const network::SnapshotRecord& record) { records.push_back(record); };
+        EXPECT_TRUE(network::readSnapshotBatch(writer.at(idx), sequence, scratch, collect));
+    }
+    return records;
+}
+
+}  // namespace
+
+TEST(SnapshotBatchTest, RoundTrip_KeepsRecordsInOrder) {
+    network::SnapshotBatchWriter writer;
+    std::vector<ComponentPacket> sent;
+
+    for (uint32_t guid = 0; guid < 10; ++guid) {
+        sent.push_back(makePacket(guid, 42, guid * 3));
+        writer.add(sent.back());
+    }
+    ASSERT_EQ(writer.size(), 1u);
+    EXPECT_EQ(writer.at(0).header.id, network::GameEvents::S_SNAPSHOT_BATCH);
+    EXPECT_EQ(writer.at(0).header.size, writer.at(0).body.size());
+
+    auto received = readAll(writer);
+    ASSERT_EQ(received.size(), sent.size());
+    for (std::size_t idx = 0; idx < sent.size(); ++idx) {
+        EXPECT_EQ(received[idx].entity_guid, sent[idx].entity_guid);
+        EXPECT_EQ(received[idx].component_type, sent[idx].component_type);
+        EXPECT_EQ(received[idx].owner_id, sent[idx].owner_id);
+        EXPECT_EQ(received[idx].encoding, network::SnapshotEncoding::FULL);
+        EXPECT_EQ(received[idx].data, sent[idx].data);
+    }
+}
+
+TEST(SnapshotBatchTest, SplitsAtDatagramBudget) {
+    network::SnapshotBatchWriter writer;
+
+    for (uint32_t guid = 0; guid < 200; ++guid) {
+        writer.add(makePacket(guid, 7, 24));
+    }
+    EXPECT_GT(writer.size(), 1u);
+    for (std::size_t idx = 0; idx < writer.size(); ++idx) {
+        EXPECT_LE(writer.at(idx).body.size(), network::SNAPSHOT_BATCH_BODY_SIZE);
+    }
+    EXPECT_EQ(readAll(writer).size(), 200u);
+}
+
+TEST(SnapshotBatchTest, OversizedRecord_GetsItsOwnBatch) {
+    network::SnapshotBatchWriter writer;
+
+    writer.add(makePacket(1, 1, 8));
+    writer.add(makePacket(2, 1, network::SNAPSHOT_BATCH_BODY_SIZE * 2));
+    writer.add(makePacket(3, 1, 8));
+    EXPECT_EQ(writer.size(), 3u);
+    EXPECT_EQ(readAll(writer).size(), 3u);
+}
+
+TEST(SnapshotBatchTest, Reset_ReusesBatches) {
+    network::SnapshotBatchWriter writer;
+
+    writer.add(makePacket(1, 1, 8));
+    writer.reset();
+    EXPECT_EQ(writer.size(), 0u);
+    writer.add(makePacket(2, 1, 8));
+    auto received = readAll(writer);
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0].entity_guid, 2u);
+}
+
+TEST(SnapshotBatchTest, Batches_GetConsecutiveSequences) {
+    network::SnapshotBatchWriter writer;
+    network::SnapshotRecord scratch;
+
+    writer.reset(10);
+    EXPECT_EQ(writer.add(makePacket(1, 1, network::SNAPSHOT_BATCH_BODY_SIZE - 64)), 10u);
+    EXPECT_EQ(writer.add(makePacket(2, 1, network::SNAPSHOT_BATCH_BODY_SIZE - 64)), 11u);
+    EXPECT_EQ(writer.nextSequence(), 12u);
+    for (uint32_t idx = 0; idx < 2; ++idx) {
+        uint32_t sequence = 0;
+        network::readSnapshotBatch(writer.at(idx), sequence, scratch, [](const network::SnapshotRecord&) {});
+        EXPECT_EQ(sequence, 10u + idx);
+    }
+}
+
+TEST(SnapshotBatchTest, TruncatedBatch_IsRejected) {
+    network::SnapshotBatchWriter writer;
+    network::SnapshotRecord scratch;
+    uint32_t sequence = 0;
+    int delivered = 0;
+
+    writer.add(makePacket(1, 1, 8));
+    writer.add(makePacket(2, 1, 8));
+    auto msg = writer.at(0);
+    msg.body.resize(msg.body.size() - 4);
+
+    EXPECT_FALSE(
+        network::readSnapshotBatch(msg, sequence, scratch, [&](const network::SnapshotRecord&) { delivered++; }));
+    EXPECT_EQ(delivered, 1);
+}
+
+TEST(SnapshotDeltaTest, Delta_RebuildsValue) {
+    std::vector<uint8_t> baseline(40, 7);
+    std::vector<uint8_t> current = baseline;
+    std::vector<uint8_t> delta;
+    std::vector<uint8_t> rebuilt;
+
+    current[3] = 1;
+    current[39] = 2;
+    ASSERT_TRUE(network::encodeSnapshotDelta(baseline, current, delta));
+    EXPECT_LT(delta.size(), current.size());
+    ASSERT_TRUE(network::applySnapshotDelta(baseline, delta.data(), delta.size(), rebuilt));
+    EXPECT_EQ(rebuilt, current);
+}
+
+TEST(SnapshotDeltaTest, Delta_RefusesSizeChangeAndBigDiffs) {
+    std::vector<uint8_t> baseline(16, 0);
+    std::vector<uint8_t> resized(17, 0);
+    std::vector<uint8_t> different(16, 1);
+    std::vector<uint8_t> delta;
+
+    EXPECT_FALSE(network::encodeSnapshotDelta(baseline, resized, delta));
+    EXPECT_FALSE(network::encodeSnapshotDelta(baseline, different, delta));
+}
+
+TEST(SnapshotBaselinesTest, AckedValue_IsSentAsDeltaThenSkipped) {
+    engine::core::ServerSnapshotBaselines server;
+    engine::core::ClientSnapshotBaselines client;
+    network::SnapshotBatchWriter writer;
+    ComponentPacket packet = makePacket(5, 3, 32);
+    std::vector<uint8_t> value;
+
+    auto sendAndReceive = [&]() {
+        std::vector<network::SnapshotRecord> records;
+        uint32_t sequence = 0;
+        network::SnapshotRecord scratch;
+
+        server.begin(1, writer);
+        server.write(1, packet, writer);
+        server.end(1, writer);
+        for (std::size_t idx = 0; idx < writer.size(); ++idx) {
+            network::readSnapshotBatch(writer.at(idx), sequence, scratch, [&](const network::SnapshotRecord& record) {
+                records.push_back(record);
+                EXPECT_EQ(client.decode(sequence, record, value), engine::core::ClientSnapshotBaselines::Result::APPLY);
+            });
+            server.acknowledge(1, sequence);
+        }
+        return records;
+    };
+
+    auto first = sendAndReceive();
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_EQ(first[0].encoding, network::SnapshotEncoding::FULL);
+    EXPECT_EQ(value, packet.data);
+
+    packet.data[4] = 99;
+    auto second = sendAndReceive();
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(second[0].encoding, network::SnapshotEncoding::DELTA);
+    EXPECT_LT(second[0].data.size(), packet.data.size());
+    EXPECT_EQ(value, packet.data);
+
+    EXPECT_TRUE(sendAndReceive().empty());
+}
+
+TEST(SnapshotBaselinesTest, UnknownBaseline_AsksForResync) {
+    engine::core::ServerSnapshotBaselines server;
+    engine::core::ClientSnapshotBaselines client;
+    network::SnapshotBatchWriter writer;
+    network::SnapshotRecord record;
+    ComponentPacket packet = makePacket(5, 3, 32);
+    std::vector<uint8_t> value;
+    uint32_t sequence = 0;
+
+    server.begin(1, writer);
+    server.write(1, packet, writer);
+    server.end(1, writer);
+    server.acknowledge(1, writer.nextSequence() - 1);
+
+    packet.data[0] = 42;
+    server.begin(1, writer);
+    server.write(1, packet, writer);
+    server.end(1, writer);
+    network::readSnapshotBatch(writer.at(0), sequence, record, [](const network::SnapshotRecord&) {});
+    ASSERT_EQ(record.encoding, network::SnapshotEncoding::DELTA);
+    EXPECT_EQ(client.decode(sequence, record, value), engine::core::ClientSnapshotBaselines::Result::MISSING_BASELINE);
+
+    server.resetClient(1);
+    server.begin(1, writer);
+    server.write(1, packet, writer);
+    server.end(1, writer);
+    network::readSnapshotBatch(writer.at(0), sequence, record, [](const network::SnapshotRecord&) {});
+    EXPECT_EQ(record.encoding, network::SnapshotEncoding::FULL);
+}
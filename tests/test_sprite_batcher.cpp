@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include "NewRenderSystem/SpriteBatcher.hpp"
+
+namespace {
+
+const sf::FloatRect VIEW({0.f, 0.f}, {800.f, 600.f});
+
+}  // namespace
+
+TEST(SpriteBatcherTest, MergesQuadsSharingLayerAndTexture) {
+    sf::Texture ships;
+    sf::Texture bullets;
+    SpriteBatcher batcher;
+
+    batcher.begin(VIEW);
+    // Interleaved textures on one layer, then a background added last
+    for (int i = 0; i < 10; i++) {
+        batcher.add(1, &ships, {0, 0, 32, 32}, {100.f + i, 100.f}, {1.f, 1.f});
+        batcher.add(1, &bullets, {0, 0, 8, 8}, {200.f + i, 100.f}, {1.f, 1.f});
+    }
+    batcher.add(0, &ships, {0, 0, 800, 600}, {400.f, 300.f}, {1.f, 1.f});
+    batcher.build();
+
+    ASSERT_EQ(batcher.size(), 3u);
+    EXPECT_EQ(batcher.at(0).layer, 0);
+    EXPECT_EQ(batcher.at(1).texture, &ships);
+    EXPECT_EQ(batcher.at(2).texture, &bullets);
+    EXPECT_EQ(batcher.at(1).vertices.getVertexCount(), 10u * 6u);
+    EXPECT_EQ(batcher.vertexCount(), 21u * 6u);
+    EXPECT_EQ(batcher.culledCount(), 0u);
+}
+
+TEST(SpriteBatcherTest, CullsQuadsOutsideTheView) {
+    sf::Texture texture;
+    SpriteBatcher batcher;
+
+    batcher.begin(VIEW);
+    EXPECT_TRUE(batcher.add(1, &texture, {0, 0, 32, 32}, {-10.f, 300.f}, {1.f, 1.f}));  // straddles the left edge
+    EXPECT_FALSE(batcher.add(1, &texture, {0, 0, 32, 32}, {-20.f, 300.f}, {1.f, 1.f}));
+    EXPECT_FALSE(batcher.add(1, &texture, {0, 0, 32, 32}, {400.f, 700.f}, {2.f, 2.f}));
+    EXPECT_TRUE(batcher.add(1, &texture, {0, 0, 32, 32}, {400.f, 650.f}, {4.f, -4.f}));  // flipped and scaled up
+    batcher.build();
+
+    EXPECT_EQ(batcher.size(), 1u);
+    EXPECT_EQ(batcher.vertexCount(), 2u * 6u);
+    EXPECT_EQ(batcher.culledCount(), 2u);
+}
+
+TEST(SpriteBatcherTest, PlacesQuadsLikeCenteredSprites) {
+    sf::Texture texture;
+    SpriteBatcher batcher;
+
+    batcher.begin(VIEW);
+    batcher.add(0, &texture, {64, 32, 16, 8}, {100.f, 50.f}, {-2.f, 1.f});
+    batcher.build();
+
+    const sf::VertexArray& vertices = batcher.at(0).vertices;
+    ASSERT_EQ(vertices.getVertexCount(), 6u);
+    // Flipped on x: the left of the texture rect ends up on the right
+    EXPECT_FLOAT_EQ(vertices[0].position.x, 116.f);
+    EXPECT_FLOAT_EQ(vertices[0].position.y, 46.f);
+    EXPECT_FLOAT_EQ(vertices[0].texCoords.x, 64.f);
+    EXPECT_FLOAT_EQ(vertices[2].position.x, 84.f);
+    EXPECT_FLOAT_EQ(vertices[2].position.y, 54.f);
+    EXPECT_FLOAT_EQ(vertices[2].texCoords.x, 80.f);
+    EXPECT_FLOAT_EQ(vertices[2].texCoords.y, 40.f);
+}
+
+TEST(SpriteBatcherTest, ReusesBatchesFromFrameToFrame) {
+    sf::Texture first;
+    sf::Texture second;
+    SpriteBatcher batcher;
+
+    batcher.begin(VIEW);
+    batcher.add(2, &first, {0, 0, 16, 16}, {10.f, 10.f}, {1.f, 1.f});
+    batcher.add(1, &second, {0, 0, 16, 16}, {10.f, 10.f}, {1.f, 1.f});
+    batcher.build();
+    ASSERT_EQ(batcher.size(), 2u);
+    EXPECT_EQ(batcher.at(0).texture, &second);
+
+    batcher.begin(VIEW);
+    batcher.add(1, &first, {0, 0, 16, 16}, {10.f, 10.f}, {1.f, 1.f});
+    batcher.build();
+    EXPECT_EQ(batcher.size(), 1u);
+    EXPECT_EQ(batcher.vertexCount(), 6u);
+
+    batcher.begin(VIEW);
+    batcher.build();
+    EXPECT_EQ(batcher.size(), 0u);
+    EXPECT_EQ(batcher.vertexCount(), 0u);
+}
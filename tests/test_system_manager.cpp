@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "SystemManager/SystemManager.hpp"
+#include "test_environment.hpp"
+
+namespace {
+
+struct CompA {
+    static constexpr auto name = "TestCompA";
+    int value;
+};
+
+struct CompB {
+    static constexpr auto name = "TestCompB";
+    int value;
+};
+
+struct Trace {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+
+    void record(int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(id);
+        threads.push_back(std::this_thread::get_id());
+    }
+};
+
+template <typename Read, typename Write>
+class TracingSystem : public ISystem {
+   public:
+    TracingSystem(Trace& trace, int id) : _trace(trace), _id(id) {}
+    void update(Registry&, system_context) override { _trace.record(_id); }
+    SystemAccess access() const override { return SystemAccess().reads<Read>().template writes<Write>(); }
+
+   private:
+    Trace& _trace;
+    int _id;
+};
+
+class ExclusiveSystem : public ISystem {
+   public:
+    ExclusiveSystem(Trace& trace, int id) : _trace(trace), _id(id) {}
+    void update(Registry&, system_context) override { _trace.record(_id); }
+
+   private:
+    Trace& _trace;
+    int _id;
+};
+
+// Two of them only finish if they run at the same time
+template <typename Write>
+class RendezvousSystem : public ISystem {
+   public:
+    explicit RendezvousSystem(std::atomic<int>& arrived) : _arrived(arrived) {}
+    void update(Registry&, system_context) override {
+        _arrived.fetch_add(1);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (_arrived.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        met = _arrived.load() >= 2;
+    }
+    SystemAccess access() const override { return SystemAccess().writes<Write>(); }
+    bool met = false;
+
+   private:
+    std::atomic<int>& _arrived;
+};
+
+class ThrowingSystem : public ISystem {
+   public:
+    void update(Registry&, system_context) override { throw std::runtime_error("system failed"); }
+    SystemAccess access() const override { return SystemAccess().writes<CompB>(); }
+};
+
+}  // namespace
+
+TEST(SystemManagerTest, ConflictingSystemsKeepInsertionOrder) {
+    TestEnvironment env;
+    Registry registry;
+    WorkStealingPool pool(3);
+    SystemManager systems(registry);
+    Trace trace;
+
+    systems.setWorkerPool(&pool);
+    systems.addSystem<TracingSystem<CompB, CompA>>(trace, 0);
+    systems.addSystem<TracingSystem<CompA, CompB>>(trace, 1);
+    systems.addSystem<ExclusiveSystem>(trace, 2);
+    systems.addSystem<TracingSystem<CompB, CompA>>(trace, 3);
+    for (int tick = 0; tick < 50; ++tick) {
+        systems.updateAll(env.context());
+    }
+
+    ASSERT_EQ(trace.order.size(), 200u);
+    for (std::size_t i = 0; i < trace.order.size(); ++i) {
+        EXPECT_EQ(trace.order[i], static_cast<int>(i % 4));
+    }
+}
+
+TEST(SystemManagerTest, ExclusiveSystemsRunOnCallingThread) {
+    TestEnvironment env;
+    Registry registry;
+    WorkStealingPool pool(2);
+    SystemManager systems(registry);
+    Trace trace;
+
+    systems.setWorkerPool(&pool);
+    systems.addSystem<TracingSystem<CompA, CompB>>(trace, 0);
+    systems.addSystem<ExclusiveSystem>(trace, 1);
+    systems.updateAll(env.context());
+
+    ASSERT_EQ(trace.order.size(), 2u);
+    EXPECT_EQ(trace.threads[1], std::this_thread::get_id());
+}
+
+TEST(SystemManagerTest, IndependentSystemsRunInParallel) {
+    TestEnvironment env;
+    Registry registry;
+    WorkStealingPool pool(2);
+    SystemManager systems(registry);
+    std::atomic<int> arrived{0};
+
+    systems.setWorkerPool(&pool);
+    systems.addSystem<RendezvousSystem<CompA>>(arrived);
+    systems.addSystem<RendezvousSystem<CompB>>(arrived);
+    systems.updateAll(env.context());
+
+    EXPECT_TRUE(systems.getSystem<RendezvousSystem<CompA>>()->met);
+    EXPECT_TRUE(systems.getSystem<RendezvousSystem<CompB>>()->met);
+}
+
+TEST(SystemManagerTest, ErrorsReachTheCaller) {
+    TestEnvironment env;
+    Registry registry;
+    WorkStealingPool pool(2);
+    SystemManager systems(registry);
+    Trace trace;
+
+    systems.setWorkerPool(&pool);
+    systems.addSystem<ThrowingSystem>();
+    systems.addSystem<TracingSystem<CompA, CompA>>(trace, 0);
+    EXPECT_THROW(systems.updateAll(env.context()), std::runtime_error);
+    EXPECT_EQ(trace.order.size(), 1u);
+}
+
+TEST(SystemManagerTest, TimingsFollowTheLongestChain) {
+    TestEnvironment env;
+    Registry registry;
+    SystemManager systems(registry);
+    Trace trace;
+
+    systems.setWorkerPool(nullptr);
+    systems.addSystem<TracingSystem<CompB, CompA>>(trace, 0);
+    systems.addSystem<ExclusiveSystem>(trace, 1);
+    systems.updateAll(env.context());
+
+    const auto& timings = systems.getTimings();
+    ASSERT_EQ(timings.size(), 2u);
+    EXPECT_TRUE(timings[0].on_critical_path);
+    EXPECT_TRUE(timings[1].on_critical_path);
+    EXPECT_GE(systems.getCriticalPathMs(), timings[0].last_ms + timings[1].last_ms);
+}
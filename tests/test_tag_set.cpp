@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Components/serialize/tag_component_serialize.hpp"
+
+TEST(TagSetTest, InternsEachNameOnce) {
+    TagId player = TagRegistry::intern("TEST_PLAYER");
+
+    EXPECT_NE(player, INVALID_TAG_ID);
+    EXPECT_EQ(TagRegistry::intern("TEST_PLAYER"), player);
+    EXPECT_EQ(TagRegistry::find("TEST_PLAYER"), player);
+    EXPECT_EQ(TagRegistry::name(player), "TEST_PLAYER");
+    EXPECT_EQ(TagRegistry::find("TEST_NEVER_USED"), INVALID_TAG_ID);
+}
+
+TEST(TagSetTest, TestsTagsAndIntersections) {
+    TagSet tags{"TEST_AI", "TEST_BOSS"};
+    TagSet projectiles{"TEST_FRIENDLY_PROJECTILE", "TEST_ENEMY_PROJECTILE"};
+
+    EXPECT_TRUE(tags.has("TEST_AI"));
+    EXPECT_TRUE(tags.has(TagRegistry::find("TEST_BOSS")));
+    EXPECT_FALSE(tags.has("TEST_FRIENDLY_PROJECTILE"));
+    EXPECT_FALSE(tags.has(INVALID_TAG_ID));
+    EXPECT_FALSE(tags.intersects(projectiles));
+    EXPECT_EQ(tags.size(), 2u);
+
+    tags.add("TEST_ENEMY_PROJECTILE");
+    tags.add("TEST_ENEMY_PROJECTILE");
+    EXPECT_TRUE(tags.intersects(projectiles));
+    EXPECT_EQ(tags.size(), 3u);
+
+    tags.remove("TEST_AI");
+    tags.remove("TEST_NEVER_USED");
+    EXPECT_FALSE(tags.has("TEST_AI"));
+    EXPECT_EQ(tags.size(), 2u);
+
+    tags.clear();
+    EXPECT_TRUE(tags.empty());
+    EXPECT_FALSE(tags.intersects(projectiles));
+}
+
+TEST(TagSetTest, SerializesNames) {
+    TagSet tags{"TEST_WALL", "TEST_TERRAIN"};
+    std::vector<uint8_t> buffer;
+    std::size_t offset = 0;
+
+    serialize::serialize(buffer, tags);
+
+    // Names on the wire, the receiving process interns them again
+    std::vector<std::string> names = serialize::deserialize_vector<std::string>(buffer, offset);
+    EXPECT_EQ(names.size(), 2u);
+    EXPECT_EQ(TagSet(names), tags);
+
+    offset = 0;
+    EXPECT_EQ(serialize::deserialize_tag_set(buffer, offset), tags);
+    EXPECT_EQ(offset, buffer.size());
+}
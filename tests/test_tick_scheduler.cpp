@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include "PatternSystem/PatternSystem.hpp"
+#include "TickScheduler/TickScheduler.hpp"
+#include "test_environment.hpp"
+
+namespace {
+
+using Clock = TickScheduler::Clock;
+using std::chrono::milliseconds;
+
+// Runs one second of a pattern at the given tick rate
+transform_component_s runPattern(const PatternComponent& pattern, uint32_t tick_rate) {
+    TestEnvironment env;
+    Registry registry;
+    PatternSystem system;
+    TickScheduler scheduler(tick_rate);
+    Entity entity = registry.createEntity();
+
+    registry.addComponent<PatternComponent>(entity, pattern);
+    registry.addComponent<transform_component_s>(entity, {0.0f, 0.0f});
+    for (uint32_t tick = 0; tick < tick_rate; ++tick) {
+        system.update(registry, env.context(scheduler.getTickDt()));
+    }
+    return registry.getConstComponent<transform_component_s>(entity);
+}
+
+}  // namespace
+
+TEST(TickSchedulerTest, AccumulatesWholeTicks) {
+    TickScheduler scheduler(50);
+    auto start = Clock::now();
+
+    scheduler.reset(start);
+    EXPECT_EQ(scheduler.getPeriod(), milliseconds(20));
+    EXPECT_FLOAT_EQ(scheduler.getTickDt(), 0.02f);
+    EXPECT_EQ(scheduler.collectTicks(start + milliseconds(15)), 0u);
+    EXPECT_EQ(scheduler.collectTicks(start + milliseconds(25)), 1u);
+    EXPECT_EQ(scheduler.getNextDeadline(), start + milliseconds(40));
+    EXPECT_EQ(scheduler.collectTicks(start + milliseconds(85)), 3u);
+    EXPECT_EQ(scheduler.getStats().dropped_ticks, 0u);
+}
+
+TEST(TickSchedulerTest, DropsTicksBeyondTheCatchUpLimit) {
+    TickScheduler scheduler(100, 3);
+    auto start = Clock::now();
+
+    scheduler.reset(start);
+    EXPECT_EQ(scheduler.collectTicks(start + milliseconds(105)), 3u);
+    EXPECT_EQ(scheduler.getStats().dropped_ticks, 7u);
+
+    // The partial tick is kept, the lost ones are not owed anymore
+    EXPECT_EQ(scheduler.collectTicks(start + milliseconds(109)), 0u);
+    EXPECT_EQ(scheduler.collectTicks(start + milliseconds(110)), 1u);
+}
+
+TEST(TickSchedulerTest, CountsOverruns) {
+    TickScheduler scheduler(60);
+
+    scheduler.recordTick(milliseconds(5));
+    scheduler.recordTick(milliseconds(30));
+    scheduler.recordTick(milliseconds(10));
+
+    const auto& stats = scheduler.getStats();
+    EXPECT_EQ(stats.ticks, 3u);
+    EXPECT_EQ(stats.overruns, 1u);
+    EXPECT_DOUBLE_EQ(stats.last_work_ms, 10.0);
+    EXPECT_DOUBLE_EQ(stats.max_work_ms, 30.0);
+}
+
+TEST(TickSchedulerTest, WaitsForTheNextDeadline) {
+    TickScheduler scheduler(120);
+    auto start = Clock::now();
+
+    scheduler.reset(start);
+    EXPECT_GE(scheduler.waitForTicks(), 1u);
+    EXPECT_GE(Clock::now() - start, scheduler.getPeriod());
+}
+
+TEST(TickSchedulerTest, RejectsInvalidRates) {
+    EXPECT_THROW(TickScheduler(0), std::invalid_argument);
+    EXPECT_THROW(TickScheduler(60, 0), std::invalid_argument);
+
+    TickScheduler scheduler;
+    EXPECT_THROW(scheduler.setTickRate(5000), std::invalid_argument);
+    EXPECT_EQ(scheduler.getTickRate(), TickScheduler::DEFAULT_TICK_RATE);
+}
+
+TEST(TickSchedulerTest, PatternsDoNotDependOnTheTickRate) {
+    PatternComponent waypoints;
+    waypoints.type = PatternComponent::WAYPOINT;
+    waypoints.waypoints = {{40.0f, 0.0f}, {40.0f, 30.0f}, {100.0f, 30.0f}};
+    waypoints.speed = 90.0f;
+
+    PatternComponent sine;
+    sine.type = PatternComponent::SINUSOIDAL;
+    sine.speed = 60.0f;
+
+    for (const auto& pattern : {waypoints, sine}) {
+        auto slow = runPattern(pattern, 30);
+        auto fast = runPattern(pattern, 120);
+        EXPECT_NEAR(slow.x, fast.x, 0.01f);
+        EXPECT_NEAR(slow.y, fast.y, 0.01f);
+    }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "Network.hpp"
+#include "UdpReceiver.hpp"
+
+using network::GameEvents;
+
+namespace {
+
+// A receiving socket and a client socket sending to it, both on loopback
+class LoopbackReceiver {
+   public:
+    LoopbackReceiver() : _socket(_context), _client(_context), receiver(_socket, _pool) {
+        _socket.open(asio::ip::udp::v4());
+        _socket.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        _socket.set_option(asio::socket_base::receive_buffer_size(1024 * 1024));
+        _client.open(asio::ip::udp::v4());
+        _client.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        receiver.start([this](std::vector<network::received_datagram<GameEvents>>& batch) {
+            batchSizes.push_back(batch.size());
+            for (auto& datagram : batch) {
+                received.push_back(std::move(datagram));
+            }
+        });
+    }
+
+    ~LoopbackReceiver() { _socket.close(); }
+
+    void send(const network::message<GameEvents>& msg) {
+        std::vector<uint8_t> buffer(sizeof(msg.header) + msg.body.size());
+
+        std::memcpy(buffer.data(), &msg.header, sizeof(msg.header));
+        std::memcpy(buffer.data() + sizeof(msg.header), msg.body.data(), msg.body.size());
+        _client.send_to(asio::buffer(buffer), _socket.local_endpoint());
+    }
+
+    void sendRaw(const std::vector<uint8_t>& bytes) { _client.send_to(asio::buffer(bytes), _socket.local_endpoint()); }
+
+    void runAsio() {
+        _context.restart();
+        _context.poll();
+    }
+
+    asio::ip::udp::endpoint clientEndpoint() const { return _client.local_endpoint(); }
+
+   private:
+    asio::io_context _context;
+    network::MessagePool<GameEvents> _pool;
+    asio::ip::udp::socket _socket;
+    asio::ip::udp::socket _client;
+
+   public:
+    network::UdpReceiver<GameEvents> receiver;
+    std::vector<network::received_datagram<GameEvents>> received;
+    std::vector<std::size_t> batchSizes;
+};
+
+network::message<GameEvents> makeDatagram(uint32_t tick, uint32_t value) {
+    network::message<GameEvents> msg;
+    msg.header.id = GameEvents::C_INPUT;
+    msg.header.tick = tick;
+    msg << value;
+    msg.header.size = msg.body.size();
+    return msg;
+}
+
+}  // namespace
+
+TEST(UdpReceiverTest, ReadsWaitingDatagramsInOneWakeup) {
+    constexpr uint32_t DATAGRAMS = 100;
+    LoopbackReceiver loopback;
+
+    for (uint32_t i = 0; i < DATAGRAMS; ++i) {
+        loopback.send(makeDatagram(i, i * 3));
+    }
+    loopback.runAsio();
+
+    ASSERT_EQ(loopback.received.size(), DATAGRAMS);
+    EXPECT_EQ(loopback.batchSizes.size(), 1u);
+    EXPECT_EQ(loopback.receiver.getStats().wakeups, 1u);
+    for (uint32_t i = 0; i < DATAGRAMS; ++i) {
+        auto& datagram = loopback.received[i];
+        uint32_t value = 0;
+        datagram.msg >> value;
+        EXPECT_EQ(datagram.sender, loopback.clientEndpoint());
+        EXPECT_EQ(datagram.msg.header.tick, i);
+        EXPECT_EQ(value, i * 3);
+    }
+#if defined(__linux__)
+    // 100 datagrams fit in 2 calls of UDP_RECEIVE_BATCH_SIZE
+    EXPECT_LE(loopback.receiver.getStats().syscalls, 2u);
+#endif
+}
+
+TEST(UdpReceiverTest, DropsMalformedDatagrams) {
+    LoopbackReceiver loopback;
+    auto badMagic = makeDatagram(1, 1);
+    auto badSize = makeDatagram(2, 2);
+
+    badMagic.header.magic_value = 0;
+    badSize.header.size = 64;
+    loopback.sendRaw({1, 2, 3});
+    loopback.send(badMagic);
+    loopback.send(badSize);
+    loopback.send(makeDatagram(3, 3));
+    loopback.runAsio();
+
+    ASSERT_EQ(loopback.received.size(), 1u);
+    EXPECT_EQ(loopback.received[0].msg.header.tick, 3u);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "Connection.hpp"
+#include "Network.hpp"
+#include "UdpSender.hpp"
+
+using network::GameEvents;
+
+namespace {
+
+// A sending socket and one receiving socket per connection, all on loopback
+class LoopbackSender {
+   public:
+    explicit LoopbackSender(int clients) : _socket(_context), sender(_context, _socket, _pool) {
+        _socket.open(asio::ip::udp::v4());
+        _socket.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        for (int i = 0; i < clients; ++i) {
+            auto& receiver = receivers.emplace_back(std::make_unique<asio::ip::udp::socket>(_context));
+            receiver->open(asio::ip::udp::v4());
+            receiver->bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+            auto connection = std::make_shared<network::Connection<GameEvents>>(
+                network::Connection<GameEvents>::owner::server, _context, asio::ip::tcp::socket(_context), _in, _pool,
+                sender);
+            connection->SetUDPEndpoint(receiver->local_endpoint());
+            connections.push_back(connection);
+        }
+    }
+
+    ~LoopbackSender() { connections.clear(); }
+
+    void runAsio() {
+        _context.restart();
+        _context.run();
+    }
+
+    network::message<GameEvents> receive(std::size_t client) {
+        std::array<uint8_t, 2048> buffer{};
+        asio::ip::udp::endpoint from;
+        network::message<GameEvents> msg;
+
+        std::size_t len = receivers[client]->receive_from(asio::buffer(buffer), from);
+        std::memcpy(&msg.header, buffer.data(), sizeof(msg.header));
+        msg.body.assign(buffer.begin() + sizeof(msg.header), buffer.begin() + len);
+        return msg;
+    }
+
+   private:
+    asio::io_context _context;
+    network::MessagePool<GameEvents> _pool;
+    network::RingQueue<network::owned_message<GameEvents>> _in{network::INBOUND_QUEUE_CAPACITY};
+    asio::ip::udp::socket _socket;
+
+   public:
+    network::UdpSender<GameEvents> sender;
+    std::vector<std::unique_ptr<asio::ip::udp::socket>> receivers;
+    std::vector<std::shared_ptr<network::Connection<GameEvents>>> connections;
+};
+
+network::message<GameEvents> makeDatagram(uint32_t tick, uint32_t value) {
+    network::message<GameEvents> msg;
+    msg.header.id = GameEvents::S_SNAPSHOT;
+    msg.header.tick = tick;
+    msg << value;
+    msg.header.size = msg.body.size();
+    return msg;
+}
+
+}  // namespace
+
+TEST(UdpSenderTest, SendsNothingUntilFlushedWithoutAutoFlush) {
+    LoopbackSender loopback(1);
+
+    loopback.sender.setAutoFlush(false);
+    loopback.connections[0]->SendUdp(makeDatagram(1, 7));
+    loopback.runAsio();
+    EXPECT_EQ(loopback.receivers[0]->available(), 0u);
+    EXPECT_EQ(loopback.sender.getStats().datagrams, 0u);
+
+    loopback.sender.flush();
+    loopback.runAsio();
+    auto msg = loopback.receive(0);
+    uint32_t value = 0;
+    msg >> value;
+    EXPECT_EQ(msg.header.tick, 1u);
+    EXPECT_EQ(value, 7u);
+}
+
+TEST(UdpSenderTest, FlushesEveryEndpointInOrder) {
+    constexpr int CLIENTS = 4;
+    constexpr uint32_t PER_CLIENT = 100;
+    LoopbackSender loopback(CLIENTS);
+
+    loopback.sender.setAutoFlush(false);
+    for (uint32_t i = 0; i < PER_CLIENT; ++i) {
+        for (int client = 0; client < CLIENTS; ++client) {
+            loopback.connections[client]->SendUdp(makeDatagram(i, static_cast<uint32_t>(client)));
+        }
+    }
+    loopback.sender.flush();
+    loopback.runAsio();
+
+    for (int client = 0; client < CLIENTS; ++client) {
+        for (uint32_t i = 0; i < PER_CLIENT; ++i) {
+            auto msg = loopback.receive(client);
+            uint32_t value = 0;
+            msg >> value;
+            EXPECT_EQ(msg.header.tick, i);
+            EXPECT_EQ(value, static_cast<uint32_t>(client));
+        }
+    }
+    EXPECT_EQ(loopback.sender.getStats().datagrams, CLIENTS * PER_CLIENT);
+#if defined(__linux__)
+    // 400 datagrams fit in 7 calls of UDP_SEND_BATCH_SIZE
+    EXPECT_LE(loopback.sender.getStats().syscalls, 7u);
+#endif
+}